@@ -0,0 +1,764 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Checks SDL's MS and IMA ADPCM decoders against the nibble-at-a-time
+   decoders they replaced, which are copied here, then compares their speed.
+
+   The corpus is generated: 1 and 2 channels, odd block sizes, full and
+   short samples-per-block, and data chunks that end in the middle of a
+   block. Block headers have random deltas, samples and step indices,
+   including IMA step indices out of range. Every file is decoded with
+   SDL_LoadWAV_RW() and with SDL_WAVDecoderGet() in odd-sized pieces, with
+   SDL_HINT_WAVE_TRUNCATION unset and set to "dropframe", and must give the
+   same bytes as the old decoder.
+
+   The speed is measured on (seconds) of 44.1 kHz stereo audio, in MB of
+   output per CPU second. It exits with 1 if any output differs.
+
+   Usage: benchadpcm [seconds of audio] */
+
+#include <time.h>
+
+#include "SDL.h"
+
+#define MS_ADPCM_CODE 0x0002
+#define IMA_ADPCM_CODE 0x0011
+
+static const Sint16 ms_adpcm_coeffs[14] = {
+    256, 0, 512, -256, 0, 0, 192, 64, 240, 0, 460, -208, 392, -232
+};
+
+static Uint32 seed = 12345;
+
+static Uint32
+Random(void)
+{
+    seed = (seed * 1664525u) + 1013904223u;
+    return seed >> 8;
+}
+
+/* The old decoders, from SDL_wave.c before the table-driven loops */
+
+typedef struct
+{
+    Uint16 encoding;
+    Uint32 channels;
+    size_t blockalign;
+    size_t samplesperblock;
+    const Uint8 *data;
+    size_t size;
+    SDL_bool dropframe;
+} RefFile;
+
+typedef struct
+{
+    Uint32 channels;
+    size_t blocksize;
+    size_t blockheadersize;
+    size_t samplesperblock;
+    Sint64 framesleft;
+    void *cstate;
+
+    struct {
+        const Uint8 *data;
+        size_t size;
+        size_t pos;
+    } block;
+
+    struct {
+        Sint16 *data;
+        size_t size;
+        size_t pos;
+    } output;
+} RefState;
+
+typedef struct
+{
+    Uint16 delta;
+    Sint16 coeff1;
+    Sint16 coeff2;
+} RefMSChannel;
+
+static Sint64
+RefSampleFrames(const RefFile *file)
+{
+    const Uint32 channels = file->channels;
+    const size_t availableblocks = file->size / file->blockalign;
+    const size_t trailingdata = file->size % file->blockalign;
+    Sint64 sampleframes = (Sint64) availableblocks * file->samplesperblock;
+
+    if (trailingdata > 0 && file->dropframe) {
+        size_t trailingsamples = 0;
+        if (file->encoding == MS_ADPCM_CODE) {
+            const size_t blockheadersize = (size_t) channels * 7;
+            if (trailingdata >= blockheadersize) {
+                trailingsamples = 2 + (trailingdata - blockheadersize) * 8 / (4 * channels);
+            }
+        } else {
+            const size_t blockheadersize = (size_t) channels * 4;
+            const size_t subblockframesize = (size_t) channels * 4;
+            if (trailingdata > blockheadersize - 2) {
+                trailingsamples = 1;
+                if (trailingdata > blockheadersize) {
+                    const size_t trailingblockdata = trailingdata - blockheadersize;
+                    const size_t trailingsubblockdata = trailingblockdata % subblockframesize;
+                    trailingsamples += (trailingblockdata / subblockframesize) * 8;
+                    if (trailingsubblockdata > subblockframesize - 4) {
+                        trailingsamples += (trailingsubblockdata % 4) * 2;
+                    }
+                }
+            }
+        }
+        if (trailingsamples > file->samplesperblock) {
+            trailingsamples = file->samplesperblock;
+        }
+        sampleframes += trailingsamples;
+    }
+    return sampleframes;
+}
+
+static Sint16
+RefMSNibble(RefMSChannel *cstate, Sint32 sample1, Sint32 sample2, Uint8 nybble)
+{
+    static const Uint16 adaptive[] = {
+        230, 230, 230, 230, 307, 409, 512, 614,
+        768, 614, 512, 409, 307, 230, 230, 230
+    };
+    Sint32 new_sample;
+    Sint32 errordelta;
+    Uint32 delta = cstate->delta;
+
+    new_sample = (sample1 * cstate->coeff1 + sample2 * cstate->coeff2) / 256;
+    errordelta = (Sint32) nybble - (nybble >= 0x08 ? 0x10 : 0);
+    new_sample += (Sint32) delta * errordelta;
+    if (new_sample < -32768) {
+        new_sample = -32768;
+    } else if (new_sample > 32767) {
+        new_sample = 32767;
+    }
+    delta = (delta * adaptive[nybble]) / 256;
+    if (delta < 16) {
+        delta = 16;
+    } else if (delta > 65535) {
+        delta = 65535;
+    }
+    cstate->delta = (Uint16) delta;
+    return (Sint16) new_sample;
+}
+
+static void
+RefMSBlockHeader(RefState *state)
+{
+    const Uint32 channels = state->channels;
+    RefMSChannel *cstate = (RefMSChannel *) state->cstate;
+    Sint32 sample;
+    Uint32 c;
+
+    for (c = 0; c < channels; c++) {
+        size_t o = c;
+        const Uint8 coeffindex = state->block.data[o];
+        cstate[c].coeff1 = ms_adpcm_coeffs[coeffindex * 2];
+        cstate[c].coeff2 = ms_adpcm_coeffs[coeffindex * 2 + 1];
+
+        o = channels + c * 2;
+        cstate[c].delta = state->block.data[o] | ((Uint16) state->block.data[o + 1] << 8);
+
+        o = channels * 3 + c * 2;
+        sample = state->block.data[o] | ((Sint32) state->block.data[o + 1] << 8);
+        if (sample >= 0x8000) {
+            sample -= 0x10000;
+        }
+        state->output.data[state->output.pos + channels] = (Sint16) sample;
+
+        o = channels * 5 + c * 2;
+        sample = state->block.data[o] | ((Sint32) state->block.data[o + 1] << 8);
+        if (sample >= 0x8000) {
+            sample -= 0x10000;
+        }
+        state->output.data[state->output.pos] = (Sint16) sample;
+
+        state->output.pos++;
+    }
+    state->block.pos += state->blockheadersize;
+    state->output.pos += state->channels;
+    state->framesleft -= 2;
+}
+
+static int
+RefMSBlockData(RefState *state)
+{
+    Uint16 nybble = 0;
+    Sint16 sample1, sample2;
+    const Uint32 channels = state->channels;
+    RefMSChannel *cstate = (RefMSChannel *) state->cstate;
+    size_t blockpos = state->block.pos;
+    size_t blocksize = state->block.size;
+    size_t outpos = state->output.pos;
+    Sint64 blockframesleft = state->samplesperblock - 2;
+    Uint32 c;
+
+    if (blockframesleft > state->framesleft) {
+        blockframesleft = state->framesleft;
+    }
+    while (blockframesleft > 0) {
+        for (c = 0; c < channels; c++) {
+            if (nybble & 0x4000) {
+                nybble <<= 4;
+            } else if (blockpos < blocksize) {
+                nybble = state->block.data[blockpos++] | 0x4000;
+            } else {
+                state->output.pos = outpos - c;
+                return -1;
+            }
+            sample1 = state->output.data[outpos - channels];
+            sample2 = state->output.data[outpos - channels * 2];
+            sample1 = RefMSNibble(cstate + c, sample1, sample2, (nybble >> 4) & 0x0f);
+            state->output.data[outpos++] = sample1;
+        }
+        state->framesleft--;
+        blockframesleft--;
+    }
+    state->output.pos = outpos;
+    return 0;
+}
+
+static Sint16
+RefIMANibble(Sint8 *cindex, Sint16 lastsample, Uint8 nybble)
+{
+    static const Sint8 index_table_4b[16] = {
+        -1, -1, -1, -1,
+        2, 4, 6, 8,
+        -1, -1, -1, -1,
+        2, 4, 6, 8
+    };
+    static const Uint16 step_table[89] = {
+        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
+        34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130,
+        143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
+        449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282,
+        1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+        3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
+        9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350,
+        22385, 24623, 27086, 29794, 32767
+    };
+    Uint32 step;
+    Sint32 sample, delta;
+    Sint8 index = *cindex;
+
+    if (index > 88) {
+        index = 88;
+    } else if (index < 0) {
+        index = 0;
+    }
+    step = step_table[(size_t) index];
+    *cindex = index + index_table_4b[nybble];
+
+    delta = step >> 3;
+    if (nybble & 0x04)
+        delta += step;
+    if (nybble & 0x02)
+        delta += step >> 1;
+    if (nybble & 0x01)
+        delta += step >> 2;
+    if (nybble & 0x08)
+        delta = -delta;
+
+    sample = lastsample + delta;
+    if (sample > 32767) {
+        sample = 32767;
+    } else if (sample < -32768) {
+        sample = -32768;
+    }
+    return (Sint16) sample;
+}
+
+static void
+RefIMABlockHeader(RefState *state)
+{
+    Sint8 *cstate = (Sint8 *) state->cstate;
+    Sint16 step;
+    Uint32 c;
+
+    for (c = 0; c < state->channels; c++) {
+        const size_t o = state->block.pos + c * 4;
+        Sint32 sample = state->block.data[o] | ((Sint32) state->block.data[o + 1] << 8);
+        if (sample >= 0x8000) {
+            sample -= 0x10000;
+        }
+        state->output.data[state->output.pos++] = (Sint16) sample;
+
+        step = (Sint16) state->block.data[o + 2];
+        cstate[c] = (Sint8) (step > 0x80 ? step - 0x100 : step);
+    }
+    state->block.pos += state->blockheadersize;
+    state->framesleft--;
+}
+
+static int
+RefIMABlockData(RefState *state)
+{
+    int retval = 0;
+    const Uint32 channels = state->channels;
+    const size_t subblockframesize = channels * 4;
+    size_t blockpos = state->block.pos;
+    size_t blockleft = state->block.size - blockpos;
+    size_t outpos = state->output.pos;
+    Sint64 blockframesleft = state->samplesperblock - 1;
+    Uint64 bytesrequired;
+    size_t i;
+    Uint32 c;
+
+    if (blockframesleft > state->framesleft) {
+        blockframesleft = state->framesleft;
+    }
+    bytesrequired = (blockframesleft + 7) / 8 * subblockframesize;
+    if (blockleft < bytesrequired) {
+        const Sint64 framesneeded = blockframesleft;
+        const size_t guaranteedframes = blockleft / subblockframesize;
+        const size_t remainingbytes = blockleft % subblockframesize;
+        blockframesleft = guaranteedframes;
+        if (remainingbytes > subblockframesize - 4) {
+            blockframesleft += (remainingbytes % 4) * 2;
+        }
+        /* The old decoder went on past the samples needed here, and past
+           the end of its output; SDL now stops like this */
+        if (blockframesleft > framesneeded) {
+            blockframesleft = framesneeded;
+        }
+        retval = -1;
+    }
+
+    while (blockframesleft > 0) {
+        const size_t subblocksamples = blockframesleft < 8 ? (size_t) blockframesleft : 8;
+        for (c = 0; c < channels; c++) {
+            Uint8 nybble = 0;
+            Sint16 sample = state->output.data[outpos + c - channels];
+            for (i = 0; i < subblocksamples; i++) {
+                if (i & 1) {
+                    nybble >>= 4;
+                } else {
+                    nybble = state->block.data[blockpos++];
+                }
+                sample = RefIMANibble((Sint8 *) state->cstate + c, sample, nybble & 0x0f);
+                state->output.data[outpos + c + i * channels] = sample;
+            }
+        }
+        outpos += channels * subblocksamples;
+        state->framesleft -= subblocksamples;
+        blockframesleft -= subblocksamples;
+    }
+
+    state->block.pos = blockpos;
+    state->output.pos = outpos;
+    return retval;
+}
+
+/* Decodes (file) like the old MS_ADPCM_Decode() and IMA_ADPCM_Decode(), with
+   no fact chunk and the truncation hint unset or "dropframe". */
+static int
+RefDecode(const RefFile *file, Sint16 **audio_buf, size_t *audio_len)
+{
+    const SDL_bool ms = (file->encoding == MS_ADPCM_CODE) ? SDL_TRUE : SDL_FALSE;
+    RefMSChannel mscstate[2];
+    Sint8 imacstate[2];
+    RefState state;
+    size_t inputpos = 0, bytesleft, outputsize;
+    int result;
+
+    SDL_zero(state);
+    SDL_zeroa(mscstate);
+    SDL_zeroa(imacstate);
+    state.channels = file->channels;
+    state.blocksize = file->blockalign;
+    state.blockheadersize = (size_t) file->channels * (ms ? 7 : 4);
+    state.samplesperblock = file->samplesperblock;
+    state.framesleft = RefSampleFrames(file);
+    state.cstate = ms ? (void *) mscstate : (void *) imacstate;
+
+    *audio_buf = NULL;
+    *audio_len = 0;
+    if (state.framesleft == 0) {
+        return 0;
+    }
+
+    outputsize = (size_t) state.framesleft * file->channels * sizeof (Sint16);
+    state.output.size = outputsize / sizeof (Sint16);
+    state.output.data = (Sint16 *) SDL_calloc(1, outputsize);
+    if (!state.output.data) {
+        return SDL_OutOfMemory();
+    }
+
+    bytesleft = file->size;
+    while (state.framesleft > 0 && bytesleft >= state.blockheadersize) {
+        state.block.data = file->data + inputpos;
+        state.block.size = bytesleft < state.blocksize ? bytesleft : state.blocksize;
+        state.block.pos = 0;
+
+        if (ms) {
+            RefMSBlockHeader(&state);
+            result = RefMSBlockData(&state);
+        } else {
+            RefIMABlockHeader(&state);
+            result = RefIMABlockData(&state);
+        }
+        if (result == -1) {
+            if (!file->dropframe) {
+                state.output.pos -= state.output.pos % (state.samplesperblock * state.channels);
+            }
+            outputsize = state.output.pos * sizeof (Sint16);
+            break;
+        }
+
+        inputpos += state.block.size;
+        bytesleft = file->size - inputpos;
+    }
+
+    /* The old IMA decoder returned an uninitialized frame for a block cut off
+       inside its header; SDL now leaves it out */
+    if (outputsize > state.output.pos * sizeof (Sint16)) {
+        outputsize = state.output.pos * sizeof (Sint16);
+    }
+
+    *audio_buf = state.output.data;
+    *audio_len = outputsize;
+    return 0;
+}
+
+/* WAVE files */
+
+typedef struct
+{
+    Uint8 *data;
+    size_t size;
+    size_t pos;
+} Buffer;
+
+static void
+Put8(Buffer *buf, Uint8 value)
+{
+    buf->data[buf->pos++] = value;
+}
+
+static void
+Put16(Buffer *buf, Uint16 value)
+{
+    Put8(buf, (Uint8) value);
+    Put8(buf, (Uint8) (value >> 8));
+}
+
+static void
+Put32(Buffer *buf, Uint32 value)
+{
+    Put16(buf, (Uint16) value);
+    Put16(buf, (Uint16) (value >> 16));
+}
+
+static void
+PutTag(Buffer *buf, const char *tag)
+{
+    SDL_memcpy(buf->data + buf->pos, tag, 4);
+    buf->pos += 4;
+}
+
+/* Writes a WAVE file for (ref), with (blocks) random blocks and (trailing)
+   bytes of one more, and points (ref->data) at its data chunk. */
+static int
+MakeWAV(Buffer *buf, RefFile *ref, size_t blocks, size_t trailing)
+{
+    const SDL_bool ms = (ref->encoding == MS_ADPCM_CODE) ? SDL_TRUE : SDL_FALSE;
+    const Uint16 ext_size = ms ? (4 + sizeof (ms_adpcm_coeffs)) : 2;
+    const Uint32 fmt_size = 16 + 2 + ext_size;
+    const size_t data_size = (blocks * ref->blockalign) + trailing;
+    size_t i, data_pos;
+    Uint32 c;
+
+    buf->size = 12 + 8 + fmt_size + 8 + data_size + (data_size & 1);
+    buf->data = (Uint8 *) SDL_malloc(buf->size + ref->blockalign);  /* room for the whole last block */
+    buf->pos = 0;
+    if (!buf->data) {
+        return SDL_OutOfMemory();
+    }
+
+    PutTag(buf, "RIFF");
+    Put32(buf, (Uint32) (buf->size - 8));
+    PutTag(buf, "WAVE");
+    PutTag(buf, "fmt ");
+    Put32(buf, fmt_size);
+    Put16(buf, ref->encoding);
+    Put16(buf, (Uint16) ref->channels);
+    Put32(buf, 44100);
+    Put32(buf, (Uint32) ((44100 * ref->blockalign) / ref->samplesperblock));
+    Put16(buf, (Uint16) ref->blockalign);
+    Put16(buf, 4);
+    Put16(buf, ext_size);
+    Put16(buf, (Uint16) ref->samplesperblock);
+    if (ms) {
+        Put16(buf, 7);
+        for (i = 0; i < SDL_arraysize(ms_adpcm_coeffs); i++) {
+            Put16(buf, (Uint16) ms_adpcm_coeffs[i]);
+        }
+    }
+    PutTag(buf, "data");
+    Put32(buf, (Uint32) data_size);
+    data_pos = buf->pos;
+
+    for (i = 0; i <= blocks; i++) {
+        const size_t block_start = buf->pos;
+        if (ms) {
+            for (c = 0; c < ref->channels; c++) {
+                Put8(buf, (Uint8) (Random() % 7));
+            }
+            for (c = 0; c < ref->channels; c++) {
+                /* Mostly ordinary deltas, some at the limits */
+                const Uint32 r = Random();
+                Put16(buf, (Uint16) (((r & 7) == 0) ? ((r & 8) ? 0xffff : 0) : (16 + (r >> 4) % 2048)));
+            }
+            for (c = 0; c < ref->channels * 2; c++) {
+                Put16(buf, (Uint16) Random());
+            }
+        } else {
+            for (c = 0; c < ref->channels; c++) {
+                const Uint32 r = Random();
+                Put16(buf, (Uint16) Random());
+                /* Step indices past 88 and negative ones now and then */
+                Put8(buf, (Uint8) (((r & 7) == 0) ? (r >> 8) : ((r >> 8) % 89)));
+                Put8(buf, 0);
+            }
+        }
+        while (buf->pos < block_start + ref->blockalign) {
+            Put8(buf, (Uint8) Random());
+        }
+    }
+    buf->pos = data_pos + data_size;
+    if (data_size & 1) {
+        Put8(buf, 0);
+    }
+
+    ref->data = buf->data + data_pos;
+    ref->size = data_size;
+    return 0;
+}
+
+/* The corpus */
+
+static SDL_bool
+Check(const Buffer *buf, const RefFile *ref, const char *hint)
+{
+    SDL_AudioSpec spec;
+    SDL_WAVDecoder *decoder;
+    Sint16 *expected = NULL;
+    size_t expected_len = 0;
+    Uint8 *actual = NULL;
+    Uint32 actual_len = 0;
+    Uint8 piece[1000];
+    size_t offset = 0;
+    SDL_bool same;
+    int got;
+
+    SDL_SetHint(SDL_HINT_WAVE_TRUNCATION, hint);
+
+    if (RefDecode(ref, &expected, &expected_len) < 0) {
+        return SDL_FALSE;
+    }
+    if (!SDL_LoadWAV_RW(SDL_RWFromConstMem(buf->data, (int) buf->size), 1, &spec, &actual, &actual_len)) {
+        SDL_free(expected);
+        return SDL_FALSE;
+    }
+    same = (actual_len == expected_len && SDL_memcmp(actual, expected, expected_len) == 0) ? SDL_TRUE : SDL_FALSE;
+    SDL_FreeWAV(actual);
+
+    /* The decoder returns whole frames, so an odd length is rounded down */
+    decoder = SDL_NewWAVDecoder(SDL_RWFromConstMem(buf->data, (int) buf->size), 1, &spec);
+    if (!decoder) {
+        SDL_free(expected);
+        return SDL_FALSE;
+    }
+    while ((got = SDL_WAVDecoderGet(decoder, piece, 4 * (1 + (Random() % 249)) + (Random() & 3))) > 0) {
+        if (offset + got > expected_len || SDL_memcmp((Uint8 *) expected + offset, piece, got) != 0) {
+            same = SDL_FALSE;
+        }
+        offset += got;
+    }
+    if (got < 0 || offset != expected_len) {
+        same = SDL_FALSE;
+    }
+    SDL_FreeWAVDecoder(decoder);
+    SDL_free(expected);
+    return same;
+}
+
+static int
+RunCorpus(void)
+{
+    static const Uint16 encodings[] = { MS_ADPCM_CODE, IMA_ADPCM_CODE };
+    static const size_t datasizes[] = { 1, 2, 3, 5, 20, 249, 1010 };
+    static const char *hints[] = { NULL, "dropframe" };
+    int files = 0, failures = 0;
+    size_t e, channels, d, s, t, h;
+
+    for (e = 0; e < SDL_arraysize(encodings); e++) {
+        const SDL_bool ms = (encodings[e] == MS_ADPCM_CODE) ? SDL_TRUE : SDL_FALSE;
+        for (channels = 1; channels <= 2; channels++) {
+            const size_t headersize = channels * (ms ? 7 : 4);
+            for (d = 0; d < SDL_arraysize(datasizes); d++) {
+                /* IMA blocks hold whole 4 byte words of each channel */
+                const size_t datasize = ms ? datasizes[d] : (datasizes[d] * 4 * channels);
+                const size_t blockalign = headersize + datasize;
+                const size_t maxsamples = ((datasize * 8) / (4 * channels)) + (ms ? 2 : 1);
+                const size_t samples[] = { maxsamples, maxsamples - 1, (maxsamples / 2) + 1 };
+                const size_t trailings[] = { 0, headersize - 1, headersize, headersize + 1, blockalign / 2, blockalign - 1 };
+
+                for (s = 0; s < SDL_arraysize(samples); s++) {
+                    if (samples[s] < (ms ? 2 : 1)) {
+                        continue;
+                    }
+                    for (t = 0; t < SDL_arraysize(trailings); t++) {
+                        RefFile ref;
+                        Buffer buf;
+
+                        if (trailings[t] >= blockalign || (t > 0 && trailings[t] == 0)) {
+                            continue;
+                        }
+                        SDL_zero(ref);
+                        ref.encoding = encodings[e];
+                        ref.channels = (Uint32) channels;
+                        ref.blockalign = blockalign;
+                        ref.samplesperblock = samples[s];
+                        if (MakeWAV(&buf, &ref, 1 + (Random() % 3), trailings[t]) < 0) {
+                            return -1;
+                        }
+                        for (h = 0; h < SDL_arraysize(hints); h++) {
+                            ref.dropframe = hints[h] ? SDL_TRUE : SDL_FALSE;
+                            files++;
+                            if (!Check(&buf, &ref, hints[h])) {
+                                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                                             "%s, %d channels, block %d, %d samples per block, %d trailing bytes, truncation %s: %s",
+                                             ms ? "MS ADPCM" : "IMA ADPCM", (int) channels, (int) blockalign,
+                                             (int) samples[s], (int) trailings[t], hints[h] ? hints[h] : "unset",
+                                             "differs from the old decoder");
+                                failures++;
+                            }
+                        }
+                        SDL_free(buf.data);
+                    }
+                }
+            }
+        }
+    }
+    SDL_SetHint(SDL_HINT_WAVE_TRUNCATION, NULL);
+
+    SDL_Log("%d of %d corpus files decode like the old decoder", files - failures, files);
+    return failures;
+}
+
+/* Throughput */
+
+static double
+MeasureOld(const RefFile *ref, int repeat)
+{
+    Uint64 bytes = 0;
+    clock_t start = clock();
+    int i;
+
+    for (i = 0; i < repeat; i++) {
+        Sint16 *audio;
+        size_t audio_len;
+        if (RefDecode(ref, &audio, &audio_len) < 0) {
+            return -1.0;
+        }
+        bytes += audio_len;
+        SDL_free(audio);
+    }
+    return bytes / ((double) (clock() - start) / CLOCKS_PER_SEC);
+}
+
+static double
+MeasureNew(const Buffer *buf, int repeat)
+{
+    Uint64 bytes = 0;
+    clock_t start = clock();
+    int i;
+
+    for (i = 0; i < repeat; i++) {
+        SDL_AudioSpec spec;
+        Uint8 *audio;
+        Uint32 audio_len;
+        if (!SDL_LoadWAV_RW(SDL_RWFromConstMem(buf->data, (int) buf->size), 1, &spec, &audio, &audio_len)) {
+            return -1.0;
+        }
+        bytes += audio_len;
+        SDL_FreeWAV(audio);
+    }
+    return bytes / ((double) (clock() - start) / CLOCKS_PER_SEC);
+}
+
+static int
+RunThroughput(int seconds)
+{
+    static const Uint16 encodings[] = { MS_ADPCM_CODE, IMA_ADPCM_CODE };
+    size_t e;
+
+    SDL_Log("%d seconds of stereo audio, MB decoded per CPU second", seconds);
+    SDL_Log("%-10s %8s %8s %7s", "format", "old", "new", "speedup");
+
+    for (e = 0; e < SDL_arraysize(encodings); e++) {
+        const SDL_bool ms = (encodings[e] == MS_ADPCM_CODE) ? SDL_TRUE : SDL_FALSE;
+        RefFile ref;
+        Buffer buf;
+        double old_rate, new_rate;
+
+        SDL_zero(ref);
+        ref.encoding = encodings[e];
+        ref.channels = 2;
+        ref.blockalign = 2048;
+        ref.samplesperblock = ((2048 - (ms ? 14 : 8)) * 8) / 8 + (ms ? 2 : 1);
+        if (MakeWAV(&buf, &ref, (44100 * seconds) / ref.samplesperblock, 0) < 0) {
+            return -1;
+        }
+        old_rate = MeasureOld(&ref, 5);
+        new_rate = MeasureNew(&buf, 5);
+        SDL_free(buf.data);
+        if (old_rate < 0.0 || new_rate < 0.0) {
+            return -1;
+        }
+        SDL_Log("%-10s %8.1f %8.1f %6.2fx", ms ? "MS ADPCM" : "IMA ADPCM", old_rate / 1000000.0,
+                new_rate / 1000000.0, (old_rate > 0.0) ? (new_rate / old_rate) : 0.0);
+    }
+    return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+    const int seconds = (argc > 1) ? SDL_max(SDL_atoi(argv[1]), 1) : 180;
+    int failures;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    failures = RunCorpus();
+    if (failures >= 0 && RunThroughput(seconds) < 0) {
+        failures = -1;
+    }
+    if (failures < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", SDL_GetError());
+    }
+
+    SDL_Quit();
+    return (failures != 0) ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
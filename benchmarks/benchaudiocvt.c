@@ -0,0 +1,221 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times SDL_ConvertAudio() over a matrix of common conversions, once with the
+   fused single-pass kernels and once with the generic filter chain
+   (SDL_HINT_AUDIO_FUSED_CONVERSION=0), and checks that both give the same
+   bytes. Each conversion runs on one second of audio; the time reported is
+   the best of all iterations.
+
+   Usage: benchaudiocvt [iterations]
+
+   Exits with 1 if any output differs. */
+
+#include "SDL.h"
+
+static const struct
+{
+    SDL_AudioFormat format;
+    const char *name;
+} formats[] = {
+    { AUDIO_U8, "U8" },
+    { AUDIO_S16SYS, "S16" },
+    { AUDIO_F32SYS, "F32" }
+};
+
+static const int src_rates[] = { 22050, 44100, 48000 };
+static const int dst_rates[] = { 44100, 48000 };
+
+/* Fill (buf) with noise; S16 starts with a sweep of every sample value and
+   F32 goes a little past full scale, so the clamps are covered too. */
+static void
+FillInput(Uint8 *buf, int len, SDL_AudioFormat format)
+{
+    Uint32 seed = 12345;
+    int i;
+
+    for (i = 0; i < len; i++) {
+        seed = (seed * 1664525u) + 1013904223u;
+        buf[i] = (Uint8) (seed >> 24);
+    }
+
+    if (format == AUDIO_S16SYS) {
+        Sint16 *samples = (Sint16 *) buf;
+        for (i = 0; (i < 65536) && (i < (len / 2)); i++) {
+            samples[i] = (Sint16) (i - 32768);
+        }
+    } else if (format == AUDIO_F32SYS) {
+        float *samples = (float *) buf;
+        for (i = 0; i < (len / 4); i++) {
+            seed = (seed * 1664525u) + 1013904223u;
+            samples[i] = ((int) (seed >> 24) - 128) / 100.0f;
+        }
+    }
+}
+
+/* Build the conversion with or without the fused kernels, run it (iterations)
+   times on (input), and leave the result in (*output). Returns the best time
+   in microseconds, or -1.0 on error. */
+static double
+RunConversion(SDL_bool fused, SDL_AudioFormat src_format, int src_channels, int src_rate,
+              int dst_channels, int dst_rate, const Uint8 *input, int len, int iterations,
+              Uint8 **output, int *output_len)
+{
+    SDL_AudioCVT cvt;
+    Uint64 best = ~((Uint64) 0);
+    int i;
+
+    SDL_SetHint(SDL_HINT_AUDIO_FUSED_CONVERSION, fused ? "1" : "0");
+    if (SDL_BuildAudioCVT(&cvt, src_format, src_channels, src_rate, AUDIO_S16SYS, dst_channels, dst_rate) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_BuildAudioCVT failed: %s", SDL_GetError());
+        return -1.0;
+    }
+
+    cvt.buf = (Uint8 *) SDL_malloc(len * cvt.len_mult);
+    if (!cvt.buf) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory");
+        return -1.0;
+    }
+
+    for (i = 0; i < iterations; i++) {
+        Uint64 start, elapsed;
+        SDL_memcpy(cvt.buf, input, len);
+        cvt.len = len;
+        start = SDL_GetPerformanceCounter();
+        if (SDL_ConvertAudio(&cvt) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_ConvertAudio failed: %s", SDL_GetError());
+            SDL_free(cvt.buf);
+            return -1.0;
+        }
+        elapsed = SDL_GetPerformanceCounter() - start;
+        best = SDL_min(best, elapsed);
+    }
+
+    *output = cvt.buf;
+    *output_len = cvt.len_cvt;
+    return (best * 1000000.0) / SDL_GetPerformanceFrequency();
+}
+
+/* Count the samples that differ between the two outputs. On NEON, the chain
+   may convert a full-scale negative float to -32767 where the fused kernels
+   give -32768; those are counted in (*neon_clamps) instead. */
+static int
+CompareOutput(const Uint8 *fused, const Uint8 *chain, int len, int *neon_clamps)
+{
+    const Sint16 *a = (const Sint16 *) fused;
+    const Sint16 *b = (const Sint16 *) chain;
+    const SDL_bool neon = SDL_HasNEON();
+    int differ = 0;
+    int i;
+
+    *neon_clamps = 0;
+    for (i = 0; i < (len / 2); i++) {
+        if (a[i] == b[i]) {
+            continue;
+        } else if (neon && (a[i] == -32768) && (b[i] == -32767)) {
+            (*neon_clamps)++;
+        } else {
+            differ++;
+        }
+    }
+    return differ;
+}
+
+int
+main(int argc, char *argv[])
+{
+    const int iterations = (argc > 1) ? SDL_max(SDL_atoi(argv[1]), 1) : 20;
+    int failures = 0;
+    int f, src_channels, s, dst_channels, d;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%d iterations per conversion, best time of each in microseconds", iterations);
+    SDL_Log("%-30s %10s %10s %7s  %s", "conversion", "chain", "fused", "speedup", "output");
+
+    for (f = 0; f < (int) SDL_arraysize(formats); f++) {
+        for (src_channels = 1; src_channels <= 2; src_channels++) {
+            for (s = 0; s < (int) SDL_arraysize(src_rates); s++) {
+                for (dst_channels = 1; dst_channels <= 2; dst_channels++) {
+                    for (d = 0; d < (int) SDL_arraysize(dst_rates); d++) {
+                        const SDL_AudioFormat format = formats[f].format;
+                        const int src_rate = src_rates[s];
+                        const int dst_rate = dst_rates[d];
+                        const int len = src_rate * src_channels * (SDL_AUDIO_BITSIZE(format) / 8);
+                        Uint8 *input = (Uint8 *) SDL_malloc(len);
+                        Uint8 *fused_output = NULL;
+                        Uint8 *chain_output = NULL;
+                        int fused_len = 0, chain_len = 0;
+                        double fused_us, chain_us;
+                        char name[64];
+                        char result[64];
+
+                        if (!input) {
+                            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory");
+                            SDL_Quit();
+                            return 1;
+                        }
+
+                        FillInput(input, len, format);
+                        SDL_snprintf(name, sizeof (name), "%s %dch %d -> S16 %dch %d",
+                                     formats[f].name, src_channels, src_rate, dst_channels, dst_rate);
+
+                        chain_us = RunConversion(SDL_FALSE, format, src_channels, src_rate, dst_channels, dst_rate,
+                                                 input, len, iterations, &chain_output, &chain_len);
+                        fused_us = RunConversion(SDL_TRUE, format, src_channels, src_rate, dst_channels, dst_rate,
+                                                 input, len, iterations, &fused_output, &fused_len);
+
+                        if ((chain_us < 0.0) || (fused_us < 0.0)) {
+                            SDL_strlcpy(result, "FAILED to convert", sizeof (result));
+                            failures++;
+                        } else if (fused_len != chain_len) {
+                            SDL_snprintf(result, sizeof (result), "DIFFERS: %d bytes, chain %d", fused_len, chain_len);
+                            failures++;
+                        } else {
+                            int neon_clamps;
+                            const int differ = CompareOutput(fused_output, chain_output, fused_len, &neon_clamps);
+                            if (differ) {
+                                SDL_snprintf(result, sizeof (result), "DIFFERS in %d samples", differ);
+                                failures++;
+                            } else if (neon_clamps) {
+                                SDL_snprintf(result, sizeof (result), "same (%d NEON clamps)", neon_clamps);
+                            } else {
+                                SDL_strlcpy(result, "same", sizeof (result));
+                            }
+                        }
+
+                        SDL_Log("%-30s %10.1f %10.1f %6.2fx  %s", name, chain_us, fused_us,
+                                (fused_us > 0.0) ? (chain_us / fused_us) : 0.0, result);
+
+                        SDL_free(fused_output);
+                        SDL_free(chain_output);
+                        SDL_free(input);
+                    }
+                }
+            }
+        }
+    }
+
+    if (failures) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d conversions differ from the filter chain", failures);
+    }
+
+    SDL_Quit();
+    return failures ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,411 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times an SDL_AudioStream that converts without resampling, the way the
+   audio thread uses one, putting and getting one 1024-frame period at a
+   time:
+
+   - old: the stream before it was backed by a ring buffer; the input is
+     copied into a work buffer and converted there with SDL_ConvertAudio(),
+     then copied into a list of packets (SDL_DataQueue), and copied out again;
+   - SDL: SDL_AudioStreamPut() and SDL_AudioStreamGet(), which convert in
+     the stream's ring when a 16-byte aligned run of it is free.
+
+   Both are first fed the same random put and get sizes, down to single
+   frames so the ring's write position goes out of alignment, and must
+   give the same bytes.  Resampling streams aren't covered: their
+   resampler is internal to SDL, so the old path can't be rebuilt here.
+
+   Usage: benchaudiostream [periods] */
+
+#include "SDL.h"
+
+#define PERIOD 1024
+#define PACKET_SIZE 4096
+#define INPUT_SIZE (PERIOD * 6 * 4 * 4)
+
+typedef struct Packet
+{
+    size_t datalen;
+    size_t startpos;
+    struct Packet *next;
+    Uint8 data[PACKET_SIZE];
+} Packet;
+
+/* The conversion part of the old SDL_AudioStream, with its SDL_DataQueue */
+typedef struct
+{
+    SDL_AudioCVT cvt;
+    Uint8 *work_buffer_base;
+    int work_buffer_len;
+    Packet *head;
+    Packet *tail;
+    Packet *pool;
+    size_t queued_bytes;
+} OldStream;
+
+typedef struct
+{
+    SDL_AudioFormat src_format;
+    Uint8 src_channels;
+    SDL_AudioFormat dst_format;
+    Uint8 dst_channels;
+    const char *name;
+} Config;
+
+static Uint32 seed = 12345;
+
+static Uint32
+Random(void)
+{
+    seed = (seed * 1664525u) + 1013904223u;
+    return seed >> 8;
+}
+
+static void
+FreePackets(Packet *packet)
+{
+    while (packet) {
+        Packet *next = packet->next;
+        SDL_free(packet);
+        packet = next;
+    }
+}
+
+static int
+OldInit(OldStream *stream, const Config *config, int rate)
+{
+    int i;
+
+    SDL_zerop(stream);
+    if (SDL_BuildAudioCVT(&stream->cvt, config->src_format, config->src_channels, rate,
+                          config->dst_format, config->dst_channels, rate) < 0) {
+        return -1;
+    }
+    /* SDL_NewDataQueue(packetlen, packetlen * 2) */
+    for (i = 0; i < 2; i++) {
+        Packet *packet = (Packet *) SDL_malloc(sizeof (Packet));
+        if (packet) {
+            packet->next = stream->pool;
+            stream->pool = packet;
+        }
+    }
+    return 0;
+}
+
+static void
+OldQuit(OldStream *stream)
+{
+    FreePackets(stream->head);
+    FreePackets(stream->pool);
+    SDL_free(stream->work_buffer_base);
+}
+
+static Uint8 *
+OldEnsureBufferSize(OldStream *stream, const int newlen)
+{
+    Uint8 *ptr;
+    size_t offset;
+
+    if (stream->work_buffer_len >= newlen) {
+        ptr = stream->work_buffer_base;
+    } else {
+        ptr = (Uint8 *) SDL_realloc(stream->work_buffer_base, newlen + 32);
+        if (!ptr) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        stream->work_buffer_base = ptr;
+        stream->work_buffer_len = newlen;
+    }
+
+    offset = ((size_t) ptr) & 15;
+    return offset ? ptr + (16 - offset) : ptr;
+}
+
+/* SDL_WriteToDataQueue() */
+static int
+OldWriteToQueue(OldStream *stream, const Uint8 *data, size_t len)
+{
+    while (len > 0) {
+        Packet *packet = stream->tail;
+        size_t datalen;
+
+        if (!packet || (packet->datalen >= PACKET_SIZE)) {
+            packet = stream->pool;
+            if (packet) {
+                stream->pool = packet->next;
+            } else {
+                packet = (Packet *) SDL_malloc(sizeof (Packet));
+                if (!packet) {
+                    return SDL_OutOfMemory();
+                }
+            }
+            packet->datalen = 0;
+            packet->startpos = 0;
+            packet->next = NULL;
+            if (!stream->tail) {
+                stream->head = packet;
+            } else {
+                stream->tail->next = packet;
+            }
+            stream->tail = packet;
+        }
+
+        datalen = SDL_min(len, PACKET_SIZE - packet->datalen);
+        SDL_memcpy(packet->data + packet->datalen, data, datalen);
+        data += datalen;
+        len -= datalen;
+        packet->datalen += datalen;
+        stream->queued_bytes += datalen;
+    }
+    return 0;
+}
+
+static int
+OldPut(OldStream *stream, const void *buf, int len)
+{
+    Uint8 *workbuf;
+
+    if (len == 0) {
+        return 0;
+    } else if (!stream->cvt.needed) {
+        return OldWriteToQueue(stream, (const Uint8 *) buf, len);
+    }
+    workbuf = OldEnsureBufferSize(stream, len * stream->cvt.len_mult);
+    if (!workbuf) {
+        return -1;
+    }
+    SDL_memcpy(workbuf, buf, len);
+    stream->cvt.buf = workbuf;
+    stream->cvt.len = len;
+    if (SDL_ConvertAudio(&stream->cvt) < 0) {
+        return -1;
+    }
+    return OldWriteToQueue(stream, workbuf, stream->cvt.len_cvt);
+}
+
+/* SDL_ReadFromDataQueue() */
+static int
+OldGet(OldStream *stream, void *buf, int len)
+{
+    Uint8 *ptr = (Uint8 *) buf;
+    Packet *packet;
+
+    while ((len > 0) && ((packet = stream->head) != NULL)) {
+        const size_t cpy = SDL_min((size_t) len, packet->datalen - packet->startpos);
+
+        SDL_memcpy(ptr, packet->data + packet->startpos, cpy);
+        packet->startpos += cpy;
+        ptr += cpy;
+        stream->queued_bytes -= cpy;
+        len -= (int) cpy;
+
+        if (packet->startpos == packet->datalen) {
+            stream->head = packet->next;
+            packet->next = stream->pool;
+            stream->pool = packet;
+        }
+    }
+    if (!stream->head) {
+        stream->tail = NULL;
+    }
+    return (int) (ptr - (Uint8 *) buf);
+}
+
+static int
+FrameSize(SDL_AudioFormat format, int channels)
+{
+    return (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+}
+
+/* Feeds both streams the same random puts and gets; SDL_TRUE if they gave
+   the same output */
+static SDL_bool
+CheckConfig(const Config *config, const Uint8 *input)
+{
+    const int in_frame = FrameSize(config->src_format, config->src_channels);
+    const int out_frame = FrameSize(config->dst_format, config->dst_channels);
+    SDL_AudioStream *stream = SDL_NewAudioStream(config->src_format, config->src_channels, 48000,
+                                                 config->dst_format, config->dst_channels, 48000);
+    Uint8 *expected = (Uint8 *) SDL_malloc(PERIOD * 8 * 8);
+    Uint8 *actual = (Uint8 *) SDL_malloc(PERIOD * 8 * 8);
+    OldStream old;
+    SDL_bool same = SDL_TRUE;
+    int i;
+
+    if (!stream || !expected || !actual || OldInit(&old, config, 48000) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: %s", config->name, SDL_GetError());
+        SDL_FreeAudioStream(stream);
+        SDL_free(expected);
+        SDL_free(actual);
+        return SDL_FALSE;
+    }
+
+    for (i = 0; (i < 3000) && same; i++) {
+        /* mostly small puts, some as big as a few periods */
+        const int frames = ((i % 10) == 0) ? (Random() % (PERIOD * 3)) : (Random() % 40);
+        const int offset = (Random() % 64) * in_frame;
+        const int drain = (i == 2999) || ((Random() % 3) == 0);
+
+        if (OldPut(&old, input + offset, frames * in_frame) < 0 ||
+            SDL_AudioStreamPut(stream, input + offset, frames * in_frame) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: %s", config->name, SDL_GetError());
+            same = SDL_FALSE;
+            break;
+        }
+        while (same && (drain || (old.queued_bytes > (size_t) (PERIOD * 4 * out_frame)))) {
+            const int want = (int) (((Random() % (PERIOD * 2)) + 1) * out_frame);
+            const int got_old = OldGet(&old, expected, want);
+            const int got = SDL_AudioStreamGet(stream, actual, want);
+
+            if (got != got_old || SDL_memcmp(expected, actual, got) != 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: output differs after %d puts", config->name, i + 1);
+                same = SDL_FALSE;
+            }
+            if (got_old < want) {
+                break;
+            }
+        }
+    }
+
+    OldQuit(&old);
+    SDL_FreeAudioStream(stream);
+    SDL_free(expected);
+    SDL_free(actual);
+    return same;
+}
+
+/* Best time of (periods) put and get periods, in microseconds, or -1.0 on error */
+static double
+Measure(const Config *config, SDL_bool use_old, const Uint8 *input, Uint8 *output, int periods)
+{
+    const int in_len = PERIOD * FrameSize(config->src_format, config->src_channels);
+    const int out_len = PERIOD * FrameSize(config->dst_format, config->dst_channels);
+    SDL_AudioStream *stream = NULL;
+    OldStream old;
+    Uint64 best = ~((Uint64) 0);
+    SDL_bool failed = SDL_FALSE;
+    int i;
+
+    if (use_old) {
+        if (OldInit(&old, config, 48000) < 0) {
+            return -1.0;
+        }
+    } else {
+        stream = SDL_NewAudioStream(config->src_format, config->src_channels, 48000,
+                                    config->dst_format, config->dst_channels, 48000);
+        if (!stream) {
+            return -1.0;
+        }
+    }
+
+    for (i = 0; i < periods; i++) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        int got;
+
+        if (use_old) {
+            OldPut(&old, input, in_len);
+            got = OldGet(&old, output, out_len);
+        } else {
+            SDL_AudioStreamPut(stream, input, in_len);
+            got = SDL_AudioStreamGet(stream, output, out_len);
+        }
+        best = SDL_min(best, SDL_GetPerformanceCounter() - start);
+        if (got != out_len) {
+            SDL_SetError("got %d bytes of %d", got, out_len);
+            failed = SDL_TRUE;
+            break;
+        }
+    }
+
+    if (use_old) {
+        OldQuit(&old);
+    } else {
+        SDL_FreeAudioStream(stream);
+    }
+    return failed ? -1.0 : ((best * 1000000.0) / SDL_GetPerformanceFrequency());
+}
+
+int
+main(int argc, char *argv[])
+{
+    const int periods = (argc > 1) ? SDL_max(SDL_atoi(argv[1]), 1) : 2000;
+    static const Config configs[] = {
+        { AUDIO_S16SYS, 2, AUDIO_S16SYS, 2, "S16 stereo, as is" },
+        { AUDIO_S16SYS, 2, AUDIO_F32SYS, 2, "S16 to F32 stereo" },
+        { AUDIO_F32SYS, 2, AUDIO_S16SYS, 2, "F32 to S16 stereo" },
+        { AUDIO_U8, 1, AUDIO_S16SYS, 2, "U8 mono to S16 stereo" },
+        { AUDIO_F32SYS, 6, AUDIO_S16SYS, 2, "F32 5.1 to S16 stereo" },
+        { AUDIO_S16SYS, 2, AUDIO_F32SYS, 1, "S16 stereo to F32 mono" },
+        { AUDIO_F32SYS, 2, AUDIO_S16SYS, 1, "F32 stereo to S16 mono" }
+    };
+    Uint8 *input, *output;
+    int failures = 0;
+    int c, i;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    /* Room for the largest put of the widest input, past the largest offset */
+    input = (Uint8 *) SDL_malloc(INPUT_SIZE);
+    output = (Uint8 *) SDL_malloc(PERIOD * 8 * 8);
+    if (!input || !output) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory");
+        SDL_free(input);
+        SDL_free(output);
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_Log("%d frames per period at 48 kHz, best of %d periods in microseconds", PERIOD, periods);
+    SDL_Log("%-24s %8s %8s %8s %7s", "stream", "checked", "old", "SDL", "speedup");
+
+    for (c = 0; c < (int) SDL_arraysize(configs); c++) {
+        SDL_bool same;
+        double old_us, sdl_us;
+
+        /* Noise; float input stays within -1.0 to 1.0 */
+        for (i = 0; i < INPUT_SIZE; i++) {
+            input[i] = (Uint8) Random();
+        }
+        if (configs[c].src_format == AUDIO_F32SYS) {
+            float *samples = (float *) input;
+            for (i = 0; i < INPUT_SIZE / 4; i++) {
+                samples[i] = ((float) (Random() & 0xFFFF) / 32768.0f) - 1.0f;
+            }
+        }
+
+        same = CheckConfig(&configs[c], input);
+        old_us = Measure(&configs[c], SDL_TRUE, input, output, periods);
+        sdl_us = Measure(&configs[c], SDL_FALSE, input, output, periods);
+        if (!same || old_us < 0.0 || sdl_us < 0.0) {
+            if (old_us < 0.0 || sdl_us < 0.0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: %s", configs[c].name, SDL_GetError());
+            }
+            failures++;
+        }
+        SDL_Log("%-24s %8s %8.2f %8.2f %6.2fx", configs[c].name, same ? "ok" : "FAILED",
+                old_us, sdl_us, (sdl_us > 0.0) ? (old_us / sdl_us) : 0.0);
+    }
+
+    SDL_free(input);
+    SDL_free(output);
+    SDL_Quit();
+    return failures ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,197 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times getting a BMP image from memory into the pixel format the game draws
+   with, at 320x240 and 1024x1024, from 8, 24 and 32 bpp files to RGB565 and
+   XRGB8888:
+
+   - SDL_LoadBMP_RW() followed by SDL_ConvertSurfaceFormat();
+   - SDL_LoadBMPFormat_RW(), which converts the rows as it reads them.
+
+   Both results are compared pixel for pixel.
+
+   Usage: benchbmp [iterations] */
+
+#include "SDL.h"
+
+typedef struct
+{
+    Uint8 *data;
+    int size;
+} BMPFile;
+
+static int
+MakeBMP(BMPFile *file, int w, int h, Uint32 format)
+{
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, w, h, 0, format);
+    SDL_RWops *rw;
+    int y, x, i;
+
+    if (!surface) {
+        return -1;
+    }
+    if (surface->format->palette) {
+        SDL_Color colors[256];
+        for (i = 0; i < 256; i++) {
+            colors[i].r = (Uint8) i;
+            colors[i].g = (Uint8) (i * 7);
+            colors[i].b = (Uint8) (255 - i);
+            colors[i].a = 255;
+        }
+        SDL_SetPaletteColors(surface->format->palette, colors, 0, 256);
+    }
+    for (y = 0; y < h; y++) {
+        Uint8 *row = (Uint8 *) surface->pixels + (y * surface->pitch);
+        for (x = 0; x < w * surface->format->BytesPerPixel; x++) {
+            row[x] = (Uint8) ((x * 3) ^ y);
+        }
+    }
+
+    file->size = (w * h * 4) + 2048;
+    file->data = (Uint8 *) SDL_malloc(file->size);
+    rw = file->data ? SDL_RWFromMem(file->data, file->size) : NULL;
+    if (!rw || (SDL_SaveBMP_RW(surface, rw, 0) < 0)) {
+        SDL_FreeSurface(surface);
+        if (rw) {
+            SDL_RWclose(rw);
+        }
+        return -1;
+    }
+    file->size = (int) SDL_RWtell(rw);
+    SDL_RWclose(rw);
+    SDL_FreeSurface(surface);
+    return 0;
+}
+
+static SDL_Surface *
+LoadAndConvert(const BMPFile *file, Uint32 format)
+{
+    SDL_Surface *loaded = SDL_LoadBMP_RW(SDL_RWFromConstMem(file->data, file->size), 1);
+    SDL_Surface *converted = NULL;
+
+    if (loaded) {
+        converted = SDL_ConvertSurfaceFormat(loaded, format, 0);
+        SDL_FreeSurface(loaded);
+    }
+    return converted;
+}
+
+static SDL_Surface *
+LoadFormat(const BMPFile *file, Uint32 format)
+{
+    return SDL_LoadBMPFormat_RW(SDL_RWFromConstMem(file->data, file->size), 1, format);
+}
+
+static SDL_bool
+SameSurface(const SDL_Surface *a, const SDL_Surface *b)
+{
+    const int row_bytes = a->w * a->format->BytesPerPixel;
+    int y;
+
+    if (a->w != b->w || a->h != b->h || a->format->format != b->format->format) {
+        return SDL_FALSE;
+    }
+    for (y = 0; y < a->h; y++) {
+        if (SDL_memcmp((const Uint8 *) a->pixels + (y * a->pitch),
+                       (const Uint8 *) b->pixels + (y * b->pitch), row_bytes) != 0) {
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+
+/* Best time of (iterations) loads, in microseconds, or -1.0 on error */
+static double
+Measure(SDL_Surface *(*load)(const BMPFile *, Uint32), const BMPFile *file, Uint32 format, int iterations)
+{
+    Uint64 best = ~((Uint64) 0);
+    int i;
+
+    for (i = 0; i < iterations; i++) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        SDL_Surface *surface = load(file, format);
+        const Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+        if (!surface) {
+            return -1.0;
+        }
+        SDL_FreeSurface(surface);
+        best = SDL_min(best, elapsed);
+    }
+    return (best * 1000000.0) / SDL_GetPerformanceFrequency();
+}
+
+int
+main(int argc, char *argv[])
+{
+    const int iterations = (argc > 1) ? SDL_max(SDL_atoi(argv[1]), 1) : 20;
+    static const struct
+    {
+        int w, h;
+    } sizes[] = { { 320, 240 }, { 1024, 1024 } };
+    static const Uint32 sources[] = { SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_BGR24, SDL_PIXELFORMAT_ARGB8888 };
+    static const Uint32 targets[] = { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_XRGB8888 };
+    int failures = 0;
+    int s, f, t;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("Best of %d loads from memory in microseconds", iterations);
+    SDL_Log("%-10s %-6s %-9s %12s %13s %7s", "size", "file", "format", "load+convert", "LoadBMPFormat", "speedup");
+
+    for (s = 0; s < (int) SDL_arraysize(sizes); s++) {
+        for (f = 0; f < (int) SDL_arraysize(sources); f++) {
+            BMPFile file;
+            char size_name[16];
+
+            SDL_zero(file);
+            if (MakeBMP(&file, sizes[s].w, sizes[s].h, sources[f]) < 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't make the BMP: %s", SDL_GetError());
+                SDL_free(file.data);
+                failures++;
+                continue;
+            }
+            SDL_snprintf(size_name, sizeof (size_name), "%dx%d", sizes[s].w, sizes[s].h);
+
+            for (t = 0; t < (int) SDL_arraysize(targets); t++) {
+                SDL_Surface *expected = LoadAndConvert(&file, targets[t]);
+                SDL_Surface *actual = LoadFormat(&file, targets[t]);
+                double old_us, new_us;
+
+                if (!expected || !actual || !SameSurface(expected, actual)) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s %d bpp to %s: %s", size_name,
+                                 SDL_BITSPERPIXEL(sources[f]), SDL_GetPixelFormatName(targets[t]),
+                                 (expected && actual) ? "results differ" : SDL_GetError());
+                    failures++;
+                }
+                SDL_FreeSurface(expected);
+                SDL_FreeSurface(actual);
+
+                old_us = Measure(LoadAndConvert, &file, targets[t], iterations);
+                new_us = Measure(LoadFormat, &file, targets[t], iterations);
+                SDL_Log("%-10s %2d bpp %-9s %12.1f %13.1f %6.2fx", size_name, SDL_BITSPERPIXEL(sources[f]),
+                        SDL_GetPixelFormatName(targets[t]) + 16, old_us, new_us,
+                        (new_us > 0.0) ? (old_us / new_us) : 0.0);
+            }
+            SDL_free(file.data);
+        }
+    }
+
+    SDL_Quit();
+    return failures ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
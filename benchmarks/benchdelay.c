@@ -0,0 +1,130 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Runs a simulated 60 Hz game loop, where each frame busy-waits for a random
+   1-8 ms of "work", and reports the spread of the frame times it gets with:
+
+   - an SDL_Delay() loop that sleeps for the whole milliseconds left until an
+     absolute deadline, which is the best a millisecond delay can do;
+   - SDL_DelayPeriodic() without spinning;
+   - SDL_DelayPeriodic() with SDL_HINT_TIMER_SPIN_THRESHOLD set to 500 us.
+
+   Usage: benchdelay [frames] */
+
+#include "SDL.h"
+
+#define FRAME_RATE 60
+
+static Uint32 seed = 12345;
+
+/* Busy-wait for 1-8 ms, like a frame of game logic and rendering would. */
+static void
+DoWork(void)
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    Uint64 work;
+
+    seed = (seed * 1664525u) + 1013904223u;
+    work = (SDL_GetPerformanceFrequency() * (1000 + ((seed >> 8) % 7000))) / 1000000;
+    while ((SDL_GetPerformanceCounter() - start) < work) {
+    }
+}
+
+static void
+Report(const char *name, const Uint64 *stamps, int frames)
+{
+    const double freq = (double) SDL_GetPerformanceFrequency();
+    const double target = 1000000.0 / FRAME_RATE;
+    double sum = 0.0, sumsq = 0.0, lo = 1e30, hi = 0.0;
+    double mean, stddev;
+    int late = 0;
+    int i;
+
+    for (i = 1; i < frames; i++) {
+        const double us = ((stamps[i] - stamps[i - 1]) * 1000000.0) / freq;
+        sum += us;
+        sumsq += us * us;
+        lo = SDL_min(lo, us);
+        hi = SDL_max(hi, us);
+        if (SDL_fabs(us - target) > 500.0) {
+            late++;
+        }
+    }
+
+    mean = sum / (frames - 1);
+    stddev = SDL_sqrt(SDL_max((sumsq / (frames - 1)) - (mean * mean), 0.0));
+    SDL_Log("%-26s %9.1f %9.1f %9.1f %9.1f %7d", name, mean, stddev, lo, hi, late);
+}
+
+int
+main(int argc, char *argv[])
+{
+    const int frames = (argc > 1) ? SDL_max(SDL_atoi(argv[1]), 2) : 300;
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    const Uint64 period = freq / FRAME_RATE;
+    Uint64 *stamps;
+    Uint64 deadline;
+    int i;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(SDL_INIT_TIMER) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    stamps = (Uint64 *) SDL_malloc(frames * sizeof (Uint64));
+    if (!stamps) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory");
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_Log("%d frames at %d Hz (target %.1f us), frame times in microseconds", frames, FRAME_RATE,
+            1000000.0 / FRAME_RATE);
+    SDL_Log("%-26s %9s %9s %9s %9s %7s", "loop", "mean", "stddev", "min", "max", ">0.5ms");
+
+    deadline = SDL_GetPerformanceCounter() + period;
+    for (i = 0; i < frames; i++) {
+        Uint64 now;
+        DoWork();
+        now = SDL_GetPerformanceCounter();
+        if (now < deadline) {
+            SDL_Delay((Uint32) (((deadline - now) * 1000) / freq));
+        }
+        stamps[i] = SDL_GetPerformanceCounter();
+        deadline += period;
+    }
+    Report("SDL_Delay", stamps, frames);
+
+    SDL_SetHint(SDL_HINT_TIMER_SPIN_THRESHOLD, "0");
+    deadline = 0;
+    for (i = 0; i < frames; i++) {
+        DoWork();
+        stamps[i] = SDL_DelayPeriodic(&deadline, period);
+    }
+    Report("SDL_DelayPeriodic", stamps, frames);
+
+    SDL_SetHint(SDL_HINT_TIMER_SPIN_THRESHOLD, "500");
+    deadline = 0;
+    for (i = 0; i < frames; i++) {
+        DoWork();
+        stamps[i] = SDL_DelayPeriodic(&deadline, period);
+    }
+    Report("SDL_DelayPeriodic, spin", stamps, frames);
+
+    SDL_free(stamps);
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,348 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times the pixel format calls that surface creation and drawing code make
+   over and over:
+
+   - lookup: SDL_AllocFormat() and SDL_FreeFormat() of an RGB format that
+     is in use, against a copy of the old format cache, a list searched
+     under a spinlock, holding 8 formats;
+   - mapping: SDL_MapRGBA() called for each color of an array, against one
+     SDL_MapColors() call, for RGB565, ARGB8888 and an 8-bit palette, with
+     all different colors and with runs of 8 equal ones.
+
+   The static formats are checked field by field against ones computed from
+   their masks, and SDL_MapColors() against SDL_MapRGBA().
+
+   Usage: benchformat [iterations] */
+
+#include "SDL.h"
+
+#define LOOKUPS 100000
+#define COLORS 4096
+
+static const Uint32 rgb_formats[] = {
+    SDL_PIXELFORMAT_RGB332, SDL_PIXELFORMAT_XRGB4444, SDL_PIXELFORMAT_XBGR4444,
+    SDL_PIXELFORMAT_XRGB1555, SDL_PIXELFORMAT_XBGR1555, SDL_PIXELFORMAT_ARGB4444,
+    SDL_PIXELFORMAT_RGBA4444, SDL_PIXELFORMAT_ABGR4444, SDL_PIXELFORMAT_BGRA4444,
+    SDL_PIXELFORMAT_ARGB1555, SDL_PIXELFORMAT_RGBA5551, SDL_PIXELFORMAT_ABGR1555,
+    SDL_PIXELFORMAT_BGRA5551, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_BGR565,
+    SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_BGR24, SDL_PIXELFORMAT_XRGB8888,
+    SDL_PIXELFORMAT_RGBX8888, SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_BGRX8888,
+    SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888,
+    SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB2101010
+};
+
+/* What a game might have in use, most recently used first in the old cache */
+static const Uint32 used_formats[] = {
+    SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ABGR8888,
+    SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR24, SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ARGB4444
+};
+
+static Uint32 seed = 12345;
+
+static Uint32
+Random(void)
+{
+    seed = (seed * 1664525u) + 1013904223u;
+    return seed >> 8;
+}
+
+/* SDL_InitFormat() for RGB formats */
+static int
+InitFormat(SDL_PixelFormat *format, Uint32 pixel_format)
+{
+    Uint32 masks[4];
+    Uint8 *shifts[4], *losses[4];
+    int bpp, i;
+
+    if (!SDL_PixelFormatEnumToMasks(pixel_format, &bpp, &masks[0], &masks[1], &masks[2], &masks[3])) {
+        return -1;
+    }
+    SDL_zerop(format);
+    format->format = pixel_format;
+    format->BitsPerPixel = (Uint8) bpp;
+    format->BytesPerPixel = (Uint8) ((bpp + 7) / 8);
+    format->Rmask = masks[0];
+    format->Gmask = masks[1];
+    format->Bmask = masks[2];
+    format->Amask = masks[3];
+    shifts[0] = &format->Rshift;
+    shifts[1] = &format->Gshift;
+    shifts[2] = &format->Bshift;
+    shifts[3] = &format->Ashift;
+    losses[0] = &format->Rloss;
+    losses[1] = &format->Gloss;
+    losses[2] = &format->Bloss;
+    losses[3] = &format->Aloss;
+    for (i = 0; i < 4; i++) {
+        Uint32 mask = masks[i];
+        *losses[i] = 8;
+        if (mask) {
+            for (; !(mask & 0x01); mask >>= 1) {
+                ++*shifts[i];
+            }
+            for (; (mask & 0x01); mask >>= 1) {
+                --*losses[i];
+            }
+        }
+    }
+    format->refcount = 1;
+    return 0;
+}
+
+/* SDL_AllocFormat() and SDL_FreeFormat() as they were before the static
+   table: RGB formats are cached in a list searched under a spinlock, and
+   reference counted */
+static SDL_PixelFormat *old_formats;
+static SDL_SpinLock old_formats_lock = 0;
+
+static SDL_PixelFormat *
+OldAllocFormat(Uint32 pixel_format)
+{
+    SDL_PixelFormat *format;
+
+    SDL_AtomicLock(&old_formats_lock);
+    for (format = old_formats; format; format = format->next) {
+        if (pixel_format == format->format) {
+            ++format->refcount;
+            SDL_AtomicUnlock(&old_formats_lock);
+            return format;
+        }
+    }
+    format = (SDL_PixelFormat *) SDL_malloc(sizeof (*format));
+    if (!format) {
+        SDL_AtomicUnlock(&old_formats_lock);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    if (InitFormat(format, pixel_format) < 0) {
+        SDL_AtomicUnlock(&old_formats_lock);
+        SDL_free(format);
+        return NULL;
+    }
+    format->next = old_formats;
+    old_formats = format;
+    SDL_AtomicUnlock(&old_formats_lock);
+    return format;
+}
+
+static void
+OldFreeFormat(SDL_PixelFormat *format)
+{
+    SDL_PixelFormat *prev;
+
+    SDL_AtomicLock(&old_formats_lock);
+    if (--format->refcount > 0) {
+        SDL_AtomicUnlock(&old_formats_lock);
+        return;
+    }
+    if (format == old_formats) {
+        old_formats = format->next;
+    } else if (old_formats) {
+        for (prev = old_formats; prev->next; prev = prev->next) {
+            if (prev->next == format) {
+                prev->next = format->next;
+                break;
+            }
+        }
+    }
+    SDL_AtomicUnlock(&old_formats_lock);
+    SDL_free(format);
+}
+
+/* Returns the number of RGB formats SDL_AllocFormat() describes differently
+   from their masks */
+static int
+CheckFormats(void)
+{
+    int failures = 0;
+    int i;
+
+    for (i = 0; i < (int) SDL_arraysize(rgb_formats); i++) {
+        SDL_PixelFormat expected;
+        SDL_PixelFormat *actual = SDL_AllocFormat(rgb_formats[i]);
+
+        if (!actual || InitFormat(&expected, rgb_formats[i]) < 0 ||
+            actual->format != expected.format || actual->palette ||
+            actual->BitsPerPixel != expected.BitsPerPixel || actual->BytesPerPixel != expected.BytesPerPixel ||
+            actual->Rmask != expected.Rmask || actual->Gmask != expected.Gmask ||
+            actual->Bmask != expected.Bmask || actual->Amask != expected.Amask ||
+            actual->Rloss != expected.Rloss || actual->Gloss != expected.Gloss ||
+            actual->Bloss != expected.Bloss || actual->Aloss != expected.Aloss ||
+            actual->Rshift != expected.Rshift || actual->Gshift != expected.Gshift ||
+            actual->Bshift != expected.Bshift || actual->Ashift != expected.Ashift) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: the format differs from its masks",
+                         SDL_GetPixelFormatName(rgb_formats[i]));
+            failures++;
+        }
+        SDL_FreeFormat(actual);
+    }
+    return failures;
+}
+
+/* Best time of (iterations) runs of LOOKUPS lookups of (pixel_format), in
+   nanoseconds per lookup */
+static double
+MeasureLookup(SDL_bool old, Uint32 pixel_format, int iterations)
+{
+    Uint64 best = ~((Uint64) 0);
+    int i, n;
+
+    for (i = 0; i < iterations; i++) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        if (old) {
+            for (n = 0; n < LOOKUPS; n++) {
+                OldFreeFormat(OldAllocFormat(pixel_format));
+            }
+        } else {
+            for (n = 0; n < LOOKUPS; n++) {
+                SDL_FreeFormat(SDL_AllocFormat(pixel_format));
+            }
+        }
+        best = SDL_min(best, SDL_GetPerformanceCounter() - start);
+    }
+    return (best * 1000000000.0) / SDL_GetPerformanceFrequency() / LOOKUPS;
+}
+
+/* Best time of (iterations) mappings of the colors, in nanoseconds per
+   color */
+static double
+MeasureMapping(SDL_bool batched, const SDL_PixelFormat *format, const SDL_Color *colors,
+               Uint32 *pixels, int iterations)
+{
+    Uint64 best = ~((Uint64) 0);
+    int i, n;
+
+    for (i = 0; i < iterations; i++) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        if (batched) {
+            SDL_MapColors(format, colors, pixels, COLORS);
+        } else {
+            for (n = 0; n < COLORS; n++) {
+                pixels[n] = SDL_MapRGBA(format, colors[n].r, colors[n].g, colors[n].b, colors[n].a);
+            }
+        }
+        best = SDL_min(best, SDL_GetPerformanceCounter() - start);
+    }
+    return (best * 1000000000.0) / SDL_GetPerformanceFrequency() / COLORS;
+}
+
+int
+main(int argc, char *argv[])
+{
+    const int iterations = (argc > 1) ? SDL_max(SDL_atoi(argv[1]), 1) : 20;
+    static const Uint32 map_formats[] = { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_INDEX8 };
+    SDL_PixelFormat *held_old[SDL_arraysize(used_formats)];
+    SDL_PixelFormat *held_new[SDL_arraysize(used_formats)];
+    SDL_Color *colors[2];
+    Uint32 *expected, *actual;
+    int failures;
+    int i, f, r;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    failures = CheckFormats();
+
+    /* The formats stay in use by the surfaces of the game, so neither
+       version frees them between lookups */
+    for (i = (int) SDL_arraysize(used_formats) - 1; i >= 0; i--) {
+        held_old[i] = OldAllocFormat(used_formats[i]);
+        held_new[i] = SDL_AllocFormat(used_formats[i]);
+    }
+
+    SDL_Log("Best of %d runs, nanoseconds per call", iterations);
+    SDL_Log("%-22s %10s %10s %7s", "lookup", "old cache", "SDL", "speedup");
+    for (i = 0; i < (int) SDL_arraysize(used_formats); i++) {
+        const double old_ns = MeasureLookup(SDL_TRUE, used_formats[i], iterations);
+        const double new_ns = MeasureLookup(SDL_FALSE, used_formats[i], iterations);
+        SDL_Log("%-22s %10.1f %10.1f %6.2fx", SDL_GetPixelFormatName(used_formats[i]) + 16,
+                old_ns, new_ns, (new_ns > 0.0) ? (old_ns / new_ns) : 0.0);
+    }
+    for (i = 0; i < (int) SDL_arraysize(used_formats); i++) {
+        OldFreeFormat(held_old[i]);
+        SDL_FreeFormat(held_new[i]);
+    }
+
+    /* All different colors, and the same colors in runs of 8 */
+    colors[0] = (SDL_Color *) SDL_malloc(COLORS * sizeof (SDL_Color));
+    colors[1] = (SDL_Color *) SDL_malloc(COLORS * sizeof (SDL_Color));
+    expected = (Uint32 *) SDL_malloc(COLORS * sizeof (Uint32));
+    actual = (Uint32 *) SDL_malloc(COLORS * sizeof (Uint32));
+    if (!colors[0] || !colors[1] || !expected || !actual) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory");
+        SDL_Quit();
+        return 1;
+    }
+    for (i = 0; i < COLORS; i++) {
+        const Uint32 value = Random();
+        colors[0][i].r = (Uint8) value;
+        colors[0][i].g = (Uint8) (value >> 8);
+        colors[0][i].b = (Uint8) (value >> 16);
+        colors[0][i].a = (Uint8) (i * 7);
+        colors[1][i] = colors[0][i & ~7];
+    }
+
+    SDL_Log("%-22s %10s %10s %7s", "mapping", "MapRGBA", "MapColors", "speedup");
+    for (f = 0; f < (int) SDL_arraysize(map_formats); f++) {
+        SDL_PixelFormat *format = SDL_AllocFormat(map_formats[f]);
+
+        if (!format) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't get the format: %s", SDL_GetError());
+            failures++;
+            continue;
+        }
+        if (SDL_ISPIXELFORMAT_INDEXED(map_formats[f])) {
+            SDL_Palette *palette = SDL_AllocPalette(256);
+            if (palette) {
+                for (i = 0; i < palette->ncolors; i++) {
+                    palette->colors[i].r = (Uint8) i;
+                    palette->colors[i].g = (Uint8) (i * 7);
+                    palette->colors[i].b = (Uint8) (255 - i);
+                    palette->colors[i].a = 255;
+                }
+                SDL_SetPixelFormatPalette(format, palette);
+                SDL_FreePalette(palette);
+            }
+        }
+        for (r = 0; r < 2; r++) {
+            char name[32];
+            double map_ns, colors_ns;
+
+            map_ns = MeasureMapping(SDL_FALSE, format, colors[r], expected, iterations);
+            colors_ns = MeasureMapping(SDL_TRUE, format, colors[r], actual, iterations);
+            SDL_snprintf(name, sizeof (name), "%s, %s", SDL_GetPixelFormatName(map_formats[f]) + 16,
+                         r ? "runs" : "different");
+            if (SDL_memcmp(expected, actual, COLORS * sizeof (Uint32)) != 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: SDL_MapColors() differs from SDL_MapRGBA()", name);
+                failures++;
+            }
+            SDL_Log("%-22s %10.1f %10.1f %6.2fx", name, map_ns, colors_ns,
+                    (colors_ns > 0.0) ? (map_ns / colors_ns) : 0.0);
+        }
+        SDL_FreeFormat(format);
+    }
+
+    SDL_free(colors[0]);
+    SDL_free(colors[1]);
+    SDL_free(expected);
+    SDL_free(actual);
+    SDL_Quit();
+    return failures ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
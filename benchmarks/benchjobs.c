@@ -0,0 +1,214 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures how the job system scales from 1 thread up to one per CPU (or the
+   count given on the command line), restarting SDL with SDL_HINT_JOB_WORKERS
+   set to one less each time, since the calling thread works too:
+
+   - convert: SDL_ParallelFor() over the rows of a 1024x1024 XRGB8888 to
+     RGB565 conversion, which is mostly memory bound;
+   - compute: SDL_ParallelFor() over a floating point loop with no memory
+     traffic;
+   - jobs: 64 batches of 64 small jobs, each batch waited for by one job that
+     depends on all of them, for the cost of creating and scheduling jobs.
+
+   The results of every thread count are checked against the single
+   threaded ones.
+
+   Usage: benchjobs [max threads] */
+
+#include "SDL.h"
+
+#define CONVERT_SIZE 1024
+#define COMPUTE_ITEMS 4096
+#define JOB_BATCHES 64
+#define JOBS_PER_BATCH 64
+
+static Uint32 *convert_src;
+static Uint16 *convert_dst;
+static float compute_out[COMPUTE_ITEMS];
+static SDL_atomic_t jobs_done;
+
+static void SDLCALL
+ConvertRows(void *userdata, int start, int end)
+{
+    int y, x;
+
+    for (y = start; y < end; y++) {
+        const Uint32 *src = convert_src + (y * CONVERT_SIZE);
+        Uint16 *dst = convert_dst + (y * CONVERT_SIZE);
+        for (x = 0; x < CONVERT_SIZE; x++) {
+            const Uint32 p = src[x];
+            dst[x] = (Uint16) (((p >> 8) & 0xF800) | ((p >> 5) & 0x07E0) | ((p >> 3) & 0x001F));
+        }
+    }
+}
+
+static void SDLCALL
+Compute(void *userdata, int start, int end)
+{
+    int i, j;
+
+    for (i = start; i < end; i++) {
+        float x = (float) i;
+        for (j = 0; j < 256; j++) {
+            x = (x * 0.999f) + 1.0f;
+        }
+        compute_out[i] = x;
+    }
+}
+
+static void SDLCALL
+CountJob(void *userdata)
+{
+    SDL_AtomicIncRef(&jobs_done);
+}
+
+static void
+RunConvert(void)
+{
+    SDL_ParallelFor(0, CONVERT_SIZE, 0, ConvertRows, NULL);
+}
+
+static void
+RunCompute(void)
+{
+    SDL_ParallelFor(0, COMPUTE_ITEMS, 0, Compute, NULL);
+}
+
+static void
+RunJobs(void)
+{
+    int b, i;
+
+    for (b = 0; b < JOB_BATCHES; b++) {
+        SDL_Job *batch = SDL_CreateJob(CountJob, NULL);
+        for (i = 0; i < JOBS_PER_BATCH; i++) {
+            SDL_Job *job = SDL_CreateJob(CountJob, NULL);
+            if (job) {
+                SDL_AddJobDependency(batch, job);
+                SDL_SubmitJob(job);
+                SDL_DetachJob(job);
+            }
+        }
+        if (batch) {
+            SDL_SubmitJob(batch);
+            SDL_WaitJob(batch);
+        }
+    }
+}
+
+static Uint32
+Checksum(void)
+{
+    Uint32 sum = 0;
+    int i;
+
+    for (i = 0; i < CONVERT_SIZE * CONVERT_SIZE; i++) {
+        sum = (sum * 31) + convert_dst[i];
+    }
+    for (i = 0; i < COMPUTE_ITEMS; i++) {
+        sum = (sum * 31) + (Uint32) compute_out[i];
+    }
+    return sum;
+}
+
+/* Best time of a few runs, in microseconds */
+static double
+Measure(void (*run)(void))
+{
+    Uint64 best = ~((Uint64) 0);
+    int i;
+
+    for (i = 0; i < 10; i++) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        run();
+        best = SDL_min(best, SDL_GetPerformanceCounter() - start);
+    }
+    return (best * 1000000.0) / SDL_GetPerformanceFrequency();
+}
+
+int
+main(int argc, char *argv[])
+{
+    const int max_threads = (argc > 1) ? SDL_max(SDL_atoi(argv[1]), 1) : SDL_GetCPUCount();
+    double base_convert = 0.0, base_compute = 0.0, base_jobs = 0.0;
+    Uint32 base_checksum = 0;
+    int failures = 0;
+    int threads, i;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    convert_src = (Uint32 *) SDL_malloc(CONVERT_SIZE * CONVERT_SIZE * sizeof (Uint32));
+    convert_dst = (Uint16 *) SDL_malloc(CONVERT_SIZE * CONVERT_SIZE * sizeof (Uint16));
+    if (!convert_src || !convert_dst) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory");
+        return 1;
+    }
+    for (i = 0; i < CONVERT_SIZE * CONVERT_SIZE; i++) {
+        convert_src[i] = (Uint32) i * 2654435761u;
+    }
+
+    SDL_Log("%d CPUs, best time of 10 runs in microseconds (speedup over 1 thread)", SDL_GetCPUCount());
+    SDL_Log("%7s %19s %19s %19s", "threads", "convert", "compute", "jobs");
+
+    for (threads = 1; threads <= max_threads; threads++) {
+        char workers[16];
+        double convert_us, compute_us, jobs_us;
+
+        if (SDL_Init(0) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+            return 1;
+        }
+        SDL_snprintf(workers, sizeof (workers), "%d", threads - 1);
+        SDL_SetHint(SDL_HINT_JOB_WORKERS, workers);
+        if (SDL_GetJobWorkerCount() != threads - 1) {
+            SDL_Log("Only %d job workers available", SDL_GetJobWorkerCount());
+            SDL_Quit();
+            break;
+        }
+
+        SDL_AtomicSet(&jobs_done, 0);
+        SDL_memset(convert_dst, 0, CONVERT_SIZE * CONVERT_SIZE * sizeof (Uint16));
+        SDL_zeroa(compute_out);
+        convert_us = Measure(RunConvert);
+        compute_us = Measure(RunCompute);
+        jobs_us = Measure(RunJobs);
+
+        if (SDL_AtomicGet(&jobs_done) != 10 * JOB_BATCHES * (JOBS_PER_BATCH + 1)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d threads: %d jobs ran, expected %d", threads,
+                         SDL_AtomicGet(&jobs_done), 10 * JOB_BATCHES * (JOBS_PER_BATCH + 1));
+            failures++;
+        }
+        if ((threads > 1) && (Checksum() != base_checksum)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d threads: results differ from 1 thread", threads);
+            failures++;
+        }
+        if (threads == 1) {
+            base_checksum = Checksum();
+            base_convert = convert_us;
+            base_compute = compute_us;
+            base_jobs = jobs_us;
+        }
+        SDL_Log("%7d %10.1f (%5.2fx) %10.1f (%5.2fx) %10.1f (%5.2fx)", threads,
+                convert_us, base_convert / convert_us,
+                compute_us, base_compute / compute_us,
+                jobs_us, base_jobs / jobs_us);
+        SDL_Quit();
+    }
+
+    SDL_free(convert_src);
+    SDL_free(convert_dst);
+    return failures ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,272 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times loading a large BMP (2048x2048, 24 bpp, 12 MB) and a large WAV
+   (60 seconds of 44.1 kHz stereo S16, 10 MB):
+
+   - SDL_LoadFile() as it is now, sized once from SDL_RWsize(), and as it
+     was before, with its 1 KB growth steps;
+   - SDL_LoadBMP_RW() and SDL_LoadWAV_RW() from SDL_RWFromFile() and from
+     SDL_RWFromMappedFile().
+
+   The files are written to the given directory, which should be on the
+   storage being measured, and removed afterwards. With "cold", the files
+   are dropped from the page cache before every load, as after a reboot.
+
+   Usage: benchload [directory] [cold] */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "SDL.h"
+
+#define BMP_SIZE 2048
+#define WAV_SECONDS 60
+#define ITERATIONS 5
+
+static SDL_bool cold = SDL_FALSE;
+
+static void
+DropFromCache(const char *file)
+{
+#ifdef POSIX_FADV_DONTNEED
+    const int fd = open(file, O_RDONLY);
+    if (fd >= 0) {
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+#endif
+}
+
+static int
+WriteBMP(const char *file)
+{
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, BMP_SIZE, BMP_SIZE, 24, SDL_PIXELFORMAT_BGR24);
+    int y, x, result;
+
+    if (!surface) {
+        return -1;
+    }
+    for (y = 0; y < BMP_SIZE; y++) {
+        Uint8 *row = (Uint8 *) surface->pixels + (y * surface->pitch);
+        for (x = 0; x < BMP_SIZE * 3; x++) {
+            row[x] = (Uint8) (x ^ y);
+        }
+    }
+    result = SDL_SaveBMP(surface, file);
+    SDL_FreeSurface(surface);
+    return result;
+}
+
+static int
+WriteWAV(const char *file)
+{
+    const Uint32 frames = 44100 * WAV_SECONDS;
+    SDL_RWops *rw = SDL_RWFromFile(file, "wb");
+    Sint16 block[2048];
+    Uint32 written;
+    int i;
+
+    if (!rw) {
+        return -1;
+    }
+    SDL_RWwrite(rw, "RIFF", 4, 1);
+    SDL_WriteLE32(rw, 36 + (frames * 4));
+    SDL_RWwrite(rw, "WAVEfmt ", 8, 1);
+    SDL_WriteLE32(rw, 16);
+    SDL_WriteLE16(rw, 1);            /* PCM */
+    SDL_WriteLE16(rw, 2);            /* channels */
+    SDL_WriteLE32(rw, 44100);
+    SDL_WriteLE32(rw, 44100 * 4);    /* bytes per second */
+    SDL_WriteLE16(rw, 4);            /* block align */
+    SDL_WriteLE16(rw, 16);
+    SDL_RWwrite(rw, "data", 4, 1);
+    SDL_WriteLE32(rw, frames * 4);
+    for (written = 0; written < frames * 2; written += SDL_arraysize(block)) {
+        for (i = 0; i < (int) SDL_arraysize(block); i++) {
+            block[i] = (Sint16) SDL_SwapLE16((Uint16) ((written + i) * 7));
+        }
+        SDL_RWwrite(rw, block, sizeof (block), 1);
+    }
+    return SDL_RWclose(rw);
+}
+
+/* SDL_LoadFile_RW() as it was before it sized its buffer once: after the
+   first read it grows the buffer by 1 KB and reads until it gets nothing,
+   so a whole file is always copied by one more realloc */
+static void *
+LoadFileOld(const char *file, size_t *datasize)
+{
+    const int FILE_CHUNK_SIZE = 1024;
+    SDL_RWops *src = SDL_RWFromFile(file, "rb");
+    Sint64 size;
+    size_t size_read, size_total = 0;
+    char *data, *newdata;
+
+    if (!src) {
+        return NULL;
+    }
+    size = SDL_RWsize(src);
+    if (size < 0) {
+        size = FILE_CHUNK_SIZE;
+    }
+    data = (char *) SDL_malloc((size_t) (size + 1));
+    for (;;) {
+        if ((((Sint64) size_total) + FILE_CHUNK_SIZE) > size) {
+            size = (size_total + FILE_CHUNK_SIZE);
+            newdata = (char *) SDL_realloc(data, (size_t) (size + 1));
+            if (!newdata) {
+                SDL_free(data);
+                data = NULL;
+                break;
+            }
+            data = newdata;
+        }
+        size_read = SDL_RWread(src, data + size_total, 1, (size_t) (size - size_total));
+        if (size_read == 0) {
+            break;
+        }
+        size_total += size_read;
+    }
+    SDL_RWclose(src);
+    if (data) {
+        *datasize = size_total;
+    }
+    return data;
+}
+
+typedef enum
+{
+    LOAD_FILE,
+    LOAD_FILE_OLD,
+    LOAD_BMP_STDIO,
+    LOAD_BMP_MAPPED,
+    LOAD_WAV_STDIO,
+    LOAD_WAV_MAPPED
+} LoadMethod;
+
+static SDL_bool
+Load(LoadMethod method, const char *file)
+{
+    SDL_bool ok = SDL_FALSE;
+    size_t size;
+    void *data;
+    SDL_Surface *surface;
+    SDL_AudioSpec spec;
+    Uint8 *audio;
+    Uint32 audio_len;
+
+    switch (method) {
+    case LOAD_FILE:
+    case LOAD_FILE_OLD:
+        data = (method == LOAD_FILE) ? SDL_LoadFile(file, &size) : LoadFileOld(file, &size);
+        ok = data ? SDL_TRUE : SDL_FALSE;
+        SDL_free(data);
+        break;
+    case LOAD_BMP_STDIO:
+    case LOAD_BMP_MAPPED:
+        surface = SDL_LoadBMP_RW((method == LOAD_BMP_STDIO) ? SDL_RWFromFile(file, "rb") : SDL_RWFromMappedFile(file), 1);
+        ok = surface ? SDL_TRUE : SDL_FALSE;
+        SDL_FreeSurface(surface);
+        break;
+    case LOAD_WAV_STDIO:
+    case LOAD_WAV_MAPPED:
+        ok = SDL_LoadWAV_RW((method == LOAD_WAV_STDIO) ? SDL_RWFromFile(file, "rb") : SDL_RWFromMappedFile(file), 1,
+                            &spec, &audio, &audio_len) ? SDL_TRUE : SDL_FALSE;
+        if (ok) {
+            SDL_FreeWAV(audio);
+        }
+        break;
+    }
+    return ok;
+}
+
+/* Best time of a few loads in milliseconds, or -1.0 on error */
+static double
+Measure(LoadMethod method, const char *file)
+{
+    Uint64 best = ~((Uint64) 0);
+    int i;
+
+    for (i = 0; i < ITERATIONS; i++) {
+        Uint64 start;
+        if (cold) {
+            DropFromCache(file);
+        }
+        start = SDL_GetPerformanceCounter();
+        if (!Load(method, file)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load %s: %s", file, SDL_GetError());
+            return -1.0;
+        }
+        best = SDL_min(best, SDL_GetPerformanceCounter() - start);
+    }
+    return (best * 1000.0) / SDL_GetPerformanceFrequency();
+}
+
+int
+main(int argc, char *argv[])
+{
+    const char *dir = (argc > 1) ? argv[1] : ".";
+    static const struct
+    {
+        LoadMethod method;
+        SDL_bool bmp;
+        const char *name;
+    } tests[] = {
+        { LOAD_FILE_OLD, SDL_TRUE, "BMP, old LoadFile" },
+        { LOAD_FILE, SDL_TRUE, "BMP, SDL_LoadFile" },
+        { LOAD_BMP_STDIO, SDL_TRUE, "BMP, stdio" },
+        { LOAD_BMP_MAPPED, SDL_TRUE, "BMP, mapped" },
+        { LOAD_FILE_OLD, SDL_FALSE, "WAV, old LoadFile" },
+        { LOAD_FILE, SDL_FALSE, "WAV, SDL_LoadFile" },
+        { LOAD_WAV_STDIO, SDL_FALSE, "WAV, stdio" },
+        { LOAD_WAV_MAPPED, SDL_FALSE, "WAV, mapped" }
+    };
+    char bmp_file[1024], wav_file[1024];
+    int failures = 0;
+    int i;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+    cold = ((argc > 2) && (SDL_strcmp(argv[2], "cold") == 0)) ? SDL_TRUE : SDL_FALSE;
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    SDL_snprintf(bmp_file, sizeof (bmp_file), "%s/benchload.bmp", dir);
+    SDL_snprintf(wav_file, sizeof (wav_file), "%s/benchload.wav", dir);
+    if ((WriteBMP(bmp_file) < 0) || (WriteWAV(wav_file) < 0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't write the test files: %s", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_Log("%s page cache, best of %d loads in milliseconds", cold ? "Cold" : "Warm", ITERATIONS);
+    for (i = 0; i < (int) SDL_arraysize(tests); i++) {
+        const double ms = Measure(tests[i].method, tests[i].bmp ? bmp_file : wav_file);
+        if (ms < 0.0) {
+            failures++;
+        } else {
+            SDL_Log("%-20s %8.2f", tests[i].name, ms);
+        }
+    }
+
+    remove(bmp_file);
+    remove(wav_file);
+    SDL_Quit();
+    return failures ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
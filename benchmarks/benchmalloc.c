@@ -0,0 +1,183 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times allocation-heavy workloads through SDL_malloc() and through the C
+   library's malloc(), which is what SDL_malloc() uses on this target when
+   SDL is built without SDL_MALLOC_CACHE:
+
+   - small: random 16-512 byte blocks, freed in random order from a window
+     of 256 live blocks, like event entries and render commands;
+   - small, N threads: the same on every CPU at once;
+   - surface: allocating and freeing a 320x240 RGB565 buffer every frame,
+     with a few other blocks of the same order in between.
+
+   Usage: benchmalloc [operations] */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define WINDOW 256
+
+typedef struct
+{
+    SDL_bool use_sdl;
+    int operations;
+    Uint64 elapsed;
+} Workload;
+
+static void *
+Alloc(SDL_bool use_sdl, size_t size)
+{
+    return use_sdl ? SDL_malloc(size) : malloc(size);
+}
+
+static void
+Free(SDL_bool use_sdl, void *ptr)
+{
+    if (use_sdl) {
+        SDL_free(ptr);
+    } else {
+        free(ptr);
+    }
+}
+
+static int SDLCALL
+RunSmall(void *data)
+{
+    Workload *work = (Workload *) data;
+    void *live[WINDOW];
+    Uint32 seed = 12345;
+    Uint64 start;
+    int i;
+
+    SDL_zeroa(live);
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < work->operations; i++) {
+        int slot;
+        seed = (seed * 1664525u) + 1013904223u;
+        slot = (int) ((seed >> 8) % WINDOW);
+        if (live[slot]) {
+            Free(work->use_sdl, live[slot]);
+        }
+        live[slot] = Alloc(work->use_sdl, 16 + ((seed >> 20) % 497));
+        if (live[slot]) {
+            *(Uint8 *) live[slot] = (Uint8) i;  /* touch it */
+        }
+    }
+    for (i = 0; i < WINDOW; i++) {
+        if (live[i]) {
+            Free(work->use_sdl, live[i]);
+        }
+    }
+    work->elapsed = SDL_GetPerformanceCounter() - start;
+    return 0;
+}
+
+static int SDLCALL
+RunSurface(void *data)
+{
+    Workload *work = (Workload *) data;
+    const size_t sizes[] = { 320 * 240 * 2, 64 * 1024, 320 * 240 * 4 };
+    Uint64 start;
+    int i, j;
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < work->operations; i++) {
+        void *blocks[SDL_arraysize(sizes)];
+        for (j = 0; j < (int) SDL_arraysize(sizes); j++) {
+            blocks[j] = Alloc(work->use_sdl, sizes[j]);
+            if (blocks[j]) {
+                *(Uint8 *) blocks[j] = (Uint8) i;
+            }
+        }
+        for (j = 0; j < (int) SDL_arraysize(sizes); j++) {
+            Free(work->use_sdl, blocks[j]);
+        }
+    }
+    work->elapsed = SDL_GetPerformanceCounter() - start;
+    return 0;
+}
+
+/* Run (func) on (threads) threads at once; returns nanoseconds per
+   operation, averaged over the threads. */
+static double
+Measure(SDL_ThreadFunction func, SDL_bool use_sdl, int threads, int operations)
+{
+    Workload work[64];
+    SDL_Thread *thread[64];
+    double total = 0.0;
+    int i;
+
+    for (i = 0; i < threads; i++) {
+        work[i].use_sdl = use_sdl;
+        work[i].operations = operations;
+        work[i].elapsed = 0;
+    }
+    if (threads == 1) {
+        func(&work[0]);
+    } else {
+        for (i = 0; i < threads; i++) {
+            thread[i] = SDL_CreateThread(func, "benchmalloc", &work[i]);
+        }
+        for (i = 0; i < threads; i++) {
+            SDL_WaitThread(thread[i], NULL);
+        }
+    }
+    for (i = 0; i < threads; i++) {
+        total += (work[i].elapsed * 1000000000.0) / SDL_GetPerformanceFrequency();
+    }
+    return total / (threads * (double) operations);
+}
+
+static void
+Report(const char *name, SDL_ThreadFunction func, int threads, int operations)
+{
+    /* Warm up both allocators once, so neither pays for growing the heap */
+    Measure(func, SDL_FALSE, threads, operations / 10);
+    Measure(func, SDL_TRUE, threads, operations / 10);
+    {
+        const double libc_ns = Measure(func, SDL_FALSE, threads, operations);
+        const double sdl_ns = Measure(func, SDL_TRUE, threads, operations);
+        SDL_Log("%-22s %10.1f %10.1f %7.2fx", name, libc_ns, sdl_ns, (sdl_ns > 0.0) ? (libc_ns / sdl_ns) : 0.0);
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    const int operations = (argc > 1) ? SDL_max(SDL_atoi(argv[1]), 10) : 2000000;
+    const int threads = SDL_min(SDL_max(SDL_GetCPUCount(), 2), 64);
+    SDL_MemoryClassStats stats;
+    char name[32];
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("SDL_malloc is %s", (SDL_GetMemoryClassStats(&stats, 1) < 0) ? "the C library's malloc" : "the thread-caching allocator");
+    SDL_Log("%d operations per thread, nanoseconds per operation", operations);
+    SDL_Log("%-22s %10s %10s %7s", "workload", "malloc", "SDL_malloc", "speedup");
+
+    Report("small", RunSmall, 1, operations);
+    SDL_snprintf(name, sizeof (name), "small, %d threads", threads);
+    Report(name, RunSmall, threads, operations);
+    Report("surface", RunSurface, 1, operations / 20);
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
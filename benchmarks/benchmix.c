@@ -0,0 +1,356 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Checks and times SDL_MixAudioFormat() on native-endian S16, S32 and F32,
+   the formats it mixes with SSE2 or NEON:
+
+   - exactness: random source and destination offsets inside a 16-byte
+     block, random lengths and volumes from 0 to above SDL_MIX_MAXVOLUME,
+     with samples drawn from noise and from edge values (full scale S16 and
+     S32 to force saturation, +-FLT_MAX, infinities and NaN to force the F32
+     clamp), compared bit for bit with the scalar loops SDL used before the
+     kernels.  Bytes around the destination must stay untouched.  Denormals
+     are left out, since 32-bit ARM NEON flushes them to zero;
+   - throughput: mixing 4096 aligned samples with the scalar loops and with
+     SDL_MixAudioFormat().
+
+   Usage: benchmix [iterations] */
+
+#include "SDL.h"
+
+#define TRIALS 4000
+#define MAX_SAMPLES 700
+#define GUARD 16
+#define BENCH_SAMPLES 4096
+
+static Uint32 seed = 12345;
+
+static Uint32
+Random(void)
+{
+    seed = (seed * 1664525u) + 1013904223u;
+    return seed >> 8;
+}
+
+/* The native-endian scalar loops of SDL_MixAudioFormat() before the SIMD
+   kernels, with the byte swaps dropped */
+static void
+RefMixS16(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    Sint16 src1, src2;
+    int dst_sample;
+    const int max_audioval = SDL_MAX_SINT16;
+    const int min_audioval = SDL_MIN_SINT16;
+
+    len /= 2;
+    while (len--) {
+        src1 = *(Sint16 *)src;
+        src1 = (src1 * volume) / SDL_MIX_MAXVOLUME;
+        src2 = *(Sint16 *)dst;
+        src += 2;
+        dst_sample = src1 + src2;
+        if (dst_sample > max_audioval) {
+            dst_sample = max_audioval;
+        } else if (dst_sample < min_audioval) {
+            dst_sample = min_audioval;
+        }
+        *(Sint16 *)dst = dst_sample;
+        dst += 2;
+    }
+}
+
+static void
+RefMixS32(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    const Uint32 *src32 = (Uint32 *) src;
+    Uint32 *dst32 = (Uint32 *) dst;
+    Sint64 src1, src2;
+    Sint64 dst_sample;
+    const Sint64 max_audioval = SDL_MAX_SINT32;
+    const Sint64 min_audioval = SDL_MIN_SINT32;
+
+    len /= 4;
+    while (len--) {
+        src1 = (Sint64) ((Sint32) *src32);
+        src32++;
+        src1 = (src1 * volume) / SDL_MIX_MAXVOLUME;
+        src2 = (Sint64) ((Sint32) *dst32);
+        dst_sample = src1 + src2;
+        if (dst_sample > max_audioval) {
+            dst_sample = max_audioval;
+        } else if (dst_sample < min_audioval) {
+            dst_sample = min_audioval;
+        }
+        *(dst32++) = (Uint32) ((Sint32) dst_sample);
+    }
+}
+
+static void
+RefMixF32(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    const float fmaxvolume = 1.0f / ((float) SDL_MIX_MAXVOLUME);
+    const float fvolume = (float) volume;
+    const float *src32 = (float *) src;
+    float *dst32 = (float *) dst;
+    float src1, src2;
+    double dst_sample;
+    const double max_audioval = 3.402823466e+38F;
+    const double min_audioval = -3.402823466e+38F;
+
+    len /= 4;
+    while (len--) {
+        src1 = ((*src32 * fvolume) * fmaxvolume);
+        src2 = *dst32;
+        src32++;
+
+        dst_sample = ((double) src1) + ((double) src2);
+        if (dst_sample > max_audioval) {
+            dst_sample = max_audioval;
+        } else if (dst_sample < min_audioval) {
+            dst_sample = min_audioval;
+        }
+        *(dst32++) = (float) dst_sample;
+    }
+}
+
+static void
+RefMix(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 len, int volume)
+{
+    if (volume == 0) {
+        return;
+    }
+    switch (format) {
+    case AUDIO_S16SYS:
+        RefMixS16(dst, src, len, volume);
+        break;
+    case AUDIO_S32SYS:
+        RefMixS32(dst, src, len, volume);
+        break;
+    default:
+        RefMixF32(dst, src, len, volume);
+        break;
+    }
+}
+
+static void
+SDLMix(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 len, int volume)
+{
+    SDL_MixAudioFormat(dst, src, format, len, volume);
+}
+
+/* Fills (count) samples with noise, about a third of them edge values */
+static void
+FillSamples(Uint8 *buffer, SDL_AudioFormat format, Uint32 count)
+{
+    static const Sint16 edges16[] = { SDL_MAX_SINT16, SDL_MIN_SINT16, SDL_MAX_SINT16 - 1, -1, 1, -127, -128, 0 };
+    static const Sint32 edges32[] = { SDL_MAX_SINT32, SDL_MIN_SINT32, SDL_MAX_SINT32 - 1, SDL_MIN_SINT32 + 1,
+                                      -1, -127, -129, 0x40000000 };
+    Uint32 i;
+
+    for (i = 0; i < count; i++) {
+        const SDL_bool edge = (Random() % 3) == 0;
+        const Uint32 bits = (Random() << 8) ^ Random();
+
+        if (format == AUDIO_S16SYS) {
+            ((Sint16 *) buffer)[i] = edge ? edges16[Random() % SDL_arraysize(edges16)] : (Sint16) bits;
+        } else if (format == AUDIO_S32SYS) {
+            ((Sint32 *) buffer)[i] = edge ? edges32[Random() % SDL_arraysize(edges32)] : (Sint32) bits;
+        } else {
+            float value;
+
+            if (edge) {
+                switch (Random() % 8) {
+                case 0: value = 3.402823466e+38F; break;
+                case 1: value = -3.402823466e+38F; break;
+                case 2: value = 3.0e+38F; break;
+                case 3: value = -2.0e+38F; break;
+                case 4: value = 3.402823466e+38F * 2.0f; break; /* infinity */
+                case 5: value = -3.402823466e+38F * 2.0f; break;
+                case 6: value = SDL_sqrtf(-1.0f); break; /* NaN */
+                default: value = -0.0f; break;
+                }
+            } else {
+                value = ((float) (Sint32) bits) / 1048576.0f;
+            }
+            ((float *) buffer)[i] = value;
+        }
+    }
+}
+
+/* SDL_TRUE if (count) samples are the same; NaNs only need to be NaN */
+static SDL_bool
+SameSamples(const Uint8 *a, const Uint8 *b, SDL_AudioFormat format, Uint32 count, Uint32 *where)
+{
+    const int size = SDL_AUDIO_BITSIZE(format) / 8;
+    Uint32 i;
+
+    for (i = 0; i < count; i++) {
+        if (SDL_memcmp(a + (i * size), b + (i * size), size) != 0) {
+            if (format == AUDIO_F32SYS) {
+                const float x = ((const float *) a)[i], y = ((const float *) b)[i];
+                if (x != x && y != y) {
+                    continue;
+                }
+            }
+            *where = i;
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+
+static int
+CheckFormat(SDL_AudioFormat format, const char *name)
+{
+    static const int volumes[] = { 0, 1, 2, 37, 64, 100, 127, SDL_MIX_MAXVOLUME, SDL_MIX_MAXVOLUME + 1, 200, 255 };
+    const int size = SDL_AUDIO_BITSIZE(format) / 8;
+    const size_t bytes = (MAX_SAMPLES * size) + (2 * GUARD) + 16;
+    Uint8 *src = (Uint8 *) SDL_SIMDAlloc(bytes);
+    Uint8 *expected = (Uint8 *) SDL_SIMDAlloc(bytes);
+    Uint8 *actual = (Uint8 *) SDL_SIMDAlloc(bytes);
+    int failures = 0;
+    int trial;
+
+    if (!src || !expected || !actual) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory");
+        SDL_SIMDFree(src);
+        SDL_SIMDFree(expected);
+        SDL_SIMDFree(actual);
+        return 1;
+    }
+
+    for (trial = 0; trial < TRIALS && !failures; trial++) {
+        /* Natural alignment for the sample type, anywhere in a 16-byte block */
+        const Uint32 src_offset = (Random() % (16 / size)) * size;
+        const Uint32 dst_offset = GUARD + ((Random() % (16 / size)) * size);
+        const Uint32 count = ((trial % 8) == 0) ? (Random() % 16) : (Random() % MAX_SAMPLES);
+        const int volume = volumes[Random() % SDL_arraysize(volumes)];
+        const Uint32 len = count * size;
+        Uint32 where = 0;
+
+        FillSamples(src, format, (Uint32) (bytes / size));
+        FillSamples(expected, format, (Uint32) (bytes / size));
+        SDL_memcpy(actual, expected, bytes);
+
+        RefMix(expected + dst_offset, src + src_offset, format, len, volume);
+        SDL_MixAudioFormat(actual + dst_offset, src + src_offset, format, len, volume);
+
+        if (!SameSamples(expected + dst_offset, actual + dst_offset, format, count, &where)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                         "%s: sample %u of %u differs (offsets %u/%u, volume %d)",
+                         name, (unsigned int) where, (unsigned int) count,
+                         (unsigned int) src_offset, (unsigned int) dst_offset, volume);
+            failures++;
+        } else if (SDL_memcmp(expected, actual, dst_offset) != 0 ||
+                   SDL_memcmp(expected + dst_offset + len, actual + dst_offset + len, bytes - dst_offset - len) != 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                         "%s: wrote outside the buffer (offsets %u/%u, %u samples)",
+                         name, (unsigned int) src_offset, (unsigned int) dst_offset, (unsigned int) count);
+            failures++;
+        }
+    }
+
+    SDL_SIMDFree(src);
+    SDL_SIMDFree(expected);
+    SDL_SIMDFree(actual);
+    return failures;
+}
+
+/* Best time of (iterations) mixes of BENCH_SAMPLES samples into a fresh copy
+   of (base), in microseconds */
+static double
+Measure(void (*mix)(Uint8 *, const Uint8 *, SDL_AudioFormat, Uint32, int),
+        Uint8 *dst, const Uint8 *base, const Uint8 *src, SDL_AudioFormat format, int volume, int iterations)
+{
+    const Uint32 len = BENCH_SAMPLES * (SDL_AUDIO_BITSIZE(format) / 8);
+    Uint64 best = ~((Uint64) 0);
+    int i;
+
+    for (i = 0; i < iterations; i++) {
+        Uint64 start;
+
+        SDL_memcpy(dst, base, len);
+        start = SDL_GetPerformanceCounter();
+        mix(dst, src, format, len, volume);
+        best = SDL_min(best, SDL_GetPerformanceCounter() - start);
+    }
+    return (best * 1000000.0) / SDL_GetPerformanceFrequency();
+}
+
+int
+main(int argc, char *argv[])
+{
+    const int iterations = (argc > 1) ? SDL_max(SDL_atoi(argv[1]), 1) : 2000;
+    static const struct
+    {
+        SDL_AudioFormat format;
+        const char *name;
+    } formats[] = { { AUDIO_S16SYS, "S16" }, { AUDIO_S32SYS, "S32" }, { AUDIO_F32SYS, "F32" } };
+    Uint8 *src, *base, *dst;
+    int failures = 0;
+    int f, i;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    src = (Uint8 *) SDL_SIMDAlloc(BENCH_SAMPLES * 4);
+    base = (Uint8 *) SDL_SIMDAlloc(BENCH_SAMPLES * 4);
+    dst = (Uint8 *) SDL_SIMDAlloc(BENCH_SAMPLES * 4);
+    if (!src || !base || !dst) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory");
+        SDL_SIMDFree(src);
+        SDL_SIMDFree(base);
+        SDL_SIMDFree(dst);
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_Log("CPU has NEON: %s, SSE2: %s; best of %d mixes of %d samples in microseconds",
+            SDL_HasNEON() ? "yes" : "no", SDL_HasSSE2() ? "yes" : "no", iterations, BENCH_SAMPLES);
+    SDL_Log("%-6s %8s %10s %10s %7s", "format", "checked", "scalar", "SDL", "speedup");
+
+    for (f = 0; f < (int) SDL_arraysize(formats); f++) {
+        const int check = CheckFormat(formats[f].format, formats[f].name);
+        double ref_us, sdl_us;
+
+        failures += check;
+
+        /* Half scale noise into half scale noise, so few samples saturate */
+        for (i = 0; i < BENCH_SAMPLES * 2; i++) {
+            Uint8 *buffer = (i < BENCH_SAMPLES) ? src : base;
+            const int s = i % BENCH_SAMPLES;
+            if (formats[f].format == AUDIO_S16SYS) {
+                ((Sint16 *) buffer)[s] = (Sint16) (((Sint32) (Random() & 0xFFFF) - 32768) / 2);
+            } else if (formats[f].format == AUDIO_S32SYS) {
+                ((Sint32 *) buffer)[s] = ((Sint32) (Random() << 8)) / 2;
+            } else {
+                ((float *) buffer)[s] = (((float) (Random() & 0xFFFF) / 32768.0f) - 1.0f) / 2.0f;
+            }
+        }
+        ref_us = Measure(RefMix, dst, base, src, formats[f].format, SDL_MIX_MAXVOLUME / 2, iterations);
+        sdl_us = Measure(SDLMix, dst, base, src, formats[f].format, SDL_MIX_MAXVOLUME / 2, iterations);
+        SDL_Log("%-6s %8s %10.2f %10.2f %6.2fx", formats[f].name, check ? "FAILED" : "ok",
+                ref_us, sdl_us, (sdl_us > 0.0) ? (ref_us / sdl_us) : 0.0);
+    }
+
+    SDL_SIMDFree(src);
+    SDL_SIMDFree(base);
+    SDL_SIMDFree(dst);
+    SDL_Quit();
+    return failures ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
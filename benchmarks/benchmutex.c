@@ -0,0 +1,257 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Compares SDL's mutexes and semaphores with the pthread ones that SDL's
+   pthread backend wraps (recursive mutexes and POSIX semaphores), so on a
+   build with SDL_FUTEX this is futex against pthread:
+
+   - short: several threads taking a lock around a few dozen instructions,
+     like the audio mixer lock and the event queue lock;
+   - long: one thread holding a lock for 2 ms out of every 3, while the
+     others take it briefly once a millisecond; reports the CPU time the
+     waiters used;
+   - ping-pong: two threads handing a pair of semaphores back and forth.
+
+   Usage: benchmutex [seconds per test] */
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <time.h>
+
+#include "SDL.h"
+
+typedef struct
+{
+    SDL_bool use_sdl;
+    SDL_mutex *sdl_mutex;
+    pthread_mutex_t pthread_mutex;
+    SDL_sem *sdl_sem[2];
+    sem_t posix_sem[2];
+    SDL_atomic_t stop;
+    volatile Uint32 counter;
+} Shared;
+
+typedef struct
+{
+    Shared *shared;
+    int index;
+    Uint64 operations;
+    double cpu_seconds;
+} Worker;
+
+static void
+Lock(Shared *shared)
+{
+    if (shared->use_sdl) {
+        SDL_LockMutex(shared->sdl_mutex);
+    } else {
+        pthread_mutex_lock(&shared->pthread_mutex);
+    }
+}
+
+static void
+Unlock(Shared *shared)
+{
+    if (shared->use_sdl) {
+        SDL_UnlockMutex(shared->sdl_mutex);
+    } else {
+        pthread_mutex_unlock(&shared->pthread_mutex);
+    }
+}
+
+static void
+Post(Shared *shared, int which)
+{
+    if (shared->use_sdl) {
+        SDL_SemPost(shared->sdl_sem[which]);
+    } else {
+        sem_post(&shared->posix_sem[which]);
+    }
+}
+
+static void
+Wait(Shared *shared, int which)
+{
+    if (shared->use_sdl) {
+        SDL_SemWait(shared->sdl_sem[which]);
+    } else {
+        while (sem_wait(&shared->posix_sem[which]) != 0) {
+        }
+    }
+}
+
+static double
+ThreadCPUSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + (ts.tv_nsec / 1000000000.0);
+}
+
+static int SDLCALL
+RunShort(void *data)
+{
+    Worker *worker = (Worker *) data;
+    Shared *shared = worker->shared;
+    int i;
+
+    while (!SDL_AtomicGet(&shared->stop)) {
+        Lock(shared);
+        for (i = 0; i < 16; i++) {
+            shared->counter = (shared->counter * 1664525u) + 1013904223u;
+        }
+        Unlock(shared);
+        worker->operations++;
+    }
+    return 0;
+}
+
+static int SDLCALL
+RunLong(void *data)
+{
+    Worker *worker = (Worker *) data;
+    Shared *shared = worker->shared;
+    const double start = ThreadCPUSeconds();
+
+    while (!SDL_AtomicGet(&shared->stop)) {
+        Lock(shared);
+        if (worker->index == 0) {
+            SDL_Delay(2);
+        }
+        Unlock(shared);
+        worker->operations++;
+        SDL_Delay(1);
+    }
+    worker->cpu_seconds = ThreadCPUSeconds() - start;
+    return 0;
+}
+
+static int SDLCALL
+RunPingPong(void *data)
+{
+    Worker *worker = (Worker *) data;
+    Shared *shared = worker->shared;
+    const int me = worker->index;
+
+    while (!SDL_AtomicGet(&shared->stop)) {
+        if (me == 0) {
+            Post(shared, 1);
+            Wait(shared, 0);
+        } else {
+            Wait(shared, 1);
+            Post(shared, 0);
+        }
+        worker->operations++;
+    }
+    /* Let the other thread out of its wait */
+    Post(shared, me ^ 1);
+    return 0;
+}
+
+/* Run (func) on (threads) threads for (seconds); returns the operations
+   per second of all threads together, and the CPU time used by the
+   threads other than the first in (*waiter_cpu). */
+static double
+Measure(SDL_ThreadFunction func, SDL_bool use_sdl, int threads, double seconds, double *waiter_cpu)
+{
+    Shared shared;
+    Worker workers[16];
+    SDL_Thread *thread[16];
+    pthread_mutexattr_t attr;
+    Uint64 total = 0;
+    Uint64 start, elapsed;
+    int i;
+
+    SDL_zero(shared);
+    shared.use_sdl = use_sdl;
+    shared.sdl_mutex = SDL_CreateMutex();
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&shared.pthread_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+    for (i = 0; i < 2; i++) {
+        shared.sdl_sem[i] = SDL_CreateSemaphore(0);
+        sem_init(&shared.posix_sem[i], 0, 0);
+    }
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < threads; i++) {
+        SDL_zero(workers[i]);
+        workers[i].shared = &shared;
+        workers[i].index = i;
+        thread[i] = SDL_CreateThread(func, "benchmutex", &workers[i]);
+    }
+    SDL_Delay((Uint32) (seconds * 1000.0));
+    SDL_AtomicSet(&shared.stop, 1);
+
+    *waiter_cpu = 0.0;
+    for (i = 0; i < threads; i++) {
+        SDL_WaitThread(thread[i], NULL);
+        total += workers[i].operations;
+        if (i > 0) {
+            *waiter_cpu += workers[i].cpu_seconds;
+        }
+    }
+    elapsed = SDL_GetPerformanceCounter() - start;
+
+    SDL_DestroyMutex(shared.sdl_mutex);
+    pthread_mutex_destroy(&shared.pthread_mutex);
+    for (i = 0; i < 2; i++) {
+        SDL_DestroySemaphore(shared.sdl_sem[i]);
+        sem_destroy(&shared.posix_sem[i]);
+    }
+    return total / ((double) elapsed / SDL_GetPerformanceFrequency());
+}
+
+static void
+Report(const char *name, SDL_ThreadFunction func, int threads, double seconds, SDL_bool show_cpu)
+{
+    double pthread_cpu, sdl_cpu;
+    const double pthread_rate = Measure(func, SDL_FALSE, threads, seconds, &pthread_cpu);
+    const double sdl_rate = Measure(func, SDL_TRUE, threads, seconds, &sdl_cpu);
+
+    if (show_cpu) {
+        SDL_Log("%-18s %12.0f %12.0f   waiters used %.2f s CPU with pthread, %.2f s with SDL",
+                name, pthread_rate, sdl_rate, pthread_cpu, sdl_cpu);
+    } else {
+        SDL_Log("%-18s %12.0f %12.0f", name, pthread_rate, sdl_rate);
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    const double seconds = (argc > 1) ? SDL_max(SDL_atof(argv[1]), 0.1) : 1.0;
+    const int threads = SDL_clamp(SDL_GetCPUCount(), 2, 16);
+    char name[32];
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%d CPUs, %.1f s per test, operations per second", SDL_GetCPUCount(), seconds);
+    SDL_Log("%-18s %12s %12s", "test", "pthread", "SDL");
+
+    SDL_snprintf(name, sizeof (name), "short, %d threads", threads);
+    Report(name, RunShort, threads, seconds, SDL_FALSE);
+    SDL_snprintf(name, sizeof (name), "long, %d threads", threads);
+    Report(name, RunLong, threads, seconds, SDL_TRUE);
+    Report("ping-pong", RunPingPong, 2, seconds, SDL_FALSE);
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,229 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times drawing 320x240 8-bit indexed frames to an RGB565 surface, the way
+   emulators and old games do:
+
+   - static palette: SDL_BlitSurface() against the loop Blit1to2() used
+     before, one table lookup and one 16-bit store per pixel, at an even
+     and an odd destination column;
+   - palette animation: one palette entry changed before every frame, which
+     SDL patches into the existing color map, against the full remap that
+     used to happen, forced here by switching between two palette objects
+     with the same colors.
+
+   Every frame is compared with SDL_MapRGB() of its pixels.
+
+   Usage: benchpalette [frames] */
+
+#include "SDL.h"
+
+#define WIDTH 320
+#define HEIGHT 240
+
+typedef enum
+{
+    DRAW_OLD_LOOP,
+    DRAW_BLIT,
+    DRAW_PATCH,
+    DRAW_REMAP
+} DrawMethod;
+
+typedef struct
+{
+    SDL_Surface *src;
+    SDL_Surface *dst;
+    SDL_Palette *palettes[2];
+    Uint16 map[256];
+    int frame;
+} Scene;
+
+/* Blit1to2() before it was unrolled: one pixel at a time */
+static void
+OldBlit1to2(const SDL_Surface *src, SDL_Surface *dst, int dstx, const Uint16 *map)
+{
+    int y, x;
+
+    for (y = 0; y < src->h; y++) {
+        const Uint8 *s = (const Uint8 *) src->pixels + (y * src->pitch);
+        Uint8 *d = (Uint8 *) dst->pixels + (y * dst->pitch) + (dstx * 2);
+        for (x = 0; x < src->w; x++) {
+            *(Uint16 *) d = map[*s++];
+            d += 2;
+        }
+    }
+}
+
+/* Changes one palette entry, in both palettes */
+static void
+AnimatePalette(Scene *scene)
+{
+    const int index = (scene->frame * 37) & 0xFF;
+    SDL_Color color;
+    int p;
+
+    color.r = (Uint8) (scene->frame * 3);
+    color.g = (Uint8) (scene->frame * 5);
+    color.b = (Uint8) (scene->frame * 7);
+    color.a = 255;
+    for (p = 0; p < 2; p++) {
+        SDL_SetPaletteColors(scene->palettes[p], &color, index, 1);
+    }
+}
+
+static int
+Draw(Scene *scene, DrawMethod method, int dstx)
+{
+    SDL_Rect dstrect;
+
+    dstrect.x = dstx;
+    dstrect.y = 0;
+    dstrect.w = WIDTH;
+    dstrect.h = HEIGHT;
+
+    switch (method) {
+    case DRAW_OLD_LOOP:
+        OldBlit1to2(scene->src, scene->dst, dstx, scene->map);
+        return 0;
+    case DRAW_PATCH:
+        AnimatePalette(scene);
+        break;
+    case DRAW_REMAP:
+        AnimatePalette(scene);
+        SDL_SetSurfacePalette(scene->src, scene->palettes[scene->frame & 1]);
+        break;
+    default:
+        break;
+    }
+    scene->frame++;
+    return SDL_BlitSurface(scene->src, NULL, scene->dst, &dstrect);
+}
+
+/* SDL_TRUE if the frame at (dstx) shows the source through its palette */
+static SDL_bool
+CheckFrame(const Scene *scene, int dstx)
+{
+    const SDL_Palette *palette = scene->src->format->palette;
+    Uint16 map[256];
+    int y, x, i;
+
+    for (i = 0; i < palette->ncolors; i++) {
+        map[i] = (Uint16) SDL_MapRGB(scene->dst->format, palette->colors[i].r,
+                                     palette->colors[i].g, palette->colors[i].b);
+    }
+    for (y = 0; y < HEIGHT; y++) {
+        const Uint8 *s = (const Uint8 *) scene->src->pixels + (y * scene->src->pitch);
+        const Uint16 *d = (const Uint16 *) ((const Uint8 *) scene->dst->pixels + (y * scene->dst->pitch)) + dstx;
+        for (x = 0; x < WIDTH; x++) {
+            if (d[x] != map[s[x]]) {
+                return SDL_FALSE;
+            }
+        }
+    }
+    return SDL_TRUE;
+}
+
+/* Best time of (frames) frames, in microseconds, or -1.0 on error */
+static double
+Measure(Scene *scene, DrawMethod method, int dstx, int frames)
+{
+    Uint64 best = ~((Uint64) 0);
+    int i;
+
+    for (i = 0; i < frames; i++) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        if (Draw(scene, method, dstx) < 0) {
+            return -1.0;
+        }
+        best = SDL_min(best, SDL_GetPerformanceCounter() - start);
+        if (method != DRAW_OLD_LOOP && !CheckFrame(scene, dstx)) {
+            SDL_SetError("frame %d differs from its palette", scene->frame);
+            return -1.0;
+        }
+    }
+    return (best * 1000000.0) / SDL_GetPerformanceFrequency();
+}
+
+static int
+Report(Scene *scene, const char *name, DrawMethod old_method, DrawMethod new_method, int dstx, int frames)
+{
+    const double old_us = Measure(scene, old_method, dstx, frames);
+    const double new_us = Measure(scene, new_method, dstx, frames);
+
+    if (old_us < 0.0 || new_us < 0.0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: %s", name, SDL_GetError());
+        return 1;
+    }
+    SDL_Log("%-26s %10.1f %10.1f %6.2fx", name, old_us, new_us, (new_us > 0.0) ? (old_us / new_us) : 0.0);
+    return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+    const int frames = (argc > 1) ? SDL_max(SDL_atoi(argv[1]), 1) : 200;
+    Scene scene;
+    SDL_Color colors[256];
+    int failures = 0;
+    int y, x, i;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    SDL_zero(scene);
+    scene.src = SDL_CreateRGBSurfaceWithFormat(0, WIDTH, HEIGHT, 8, SDL_PIXELFORMAT_INDEX8);
+    scene.dst = SDL_CreateRGBSurfaceWithFormat(0, WIDTH + 1, HEIGHT, 16, SDL_PIXELFORMAT_RGB565);
+    scene.palettes[0] = SDL_AllocPalette(256);
+    scene.palettes[1] = SDL_AllocPalette(256);
+    if (!scene.src || !scene.dst || !scene.palettes[0] || !scene.palettes[1]) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create the surfaces: %s", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    for (i = 0; i < 256; i++) {
+        colors[i].r = (Uint8) i;
+        colors[i].g = (Uint8) (i * 7);
+        colors[i].b = (Uint8) (255 - i);
+        colors[i].a = 255;
+        scene.map[i] = (Uint16) SDL_MapRGB(scene.dst->format, colors[i].r, colors[i].g, colors[i].b);
+    }
+    SDL_SetPaletteColors(scene.palettes[0], colors, 0, 256);
+    SDL_SetPaletteColors(scene.palettes[1], colors, 0, 256);
+    SDL_SetSurfacePalette(scene.src, scene.palettes[0]);
+    for (y = 0; y < HEIGHT; y++) {
+        Uint8 *row = (Uint8 *) scene.src->pixels + (y * scene.src->pitch);
+        for (x = 0; x < WIDTH; x++) {
+            row[x] = (Uint8) ((x / 4) ^ (y * 3));
+        }
+    }
+
+    SDL_Log("%dx%d INDEX8 to RGB565, best of %d frames in microseconds", WIDTH, HEIGHT, frames);
+    SDL_Log("%-26s %10s %10s %7s", "static palette", "old loop", "SDL", "speedup");
+    failures += Report(&scene, "even column", DRAW_OLD_LOOP, DRAW_BLIT, 0, frames);
+    failures += Report(&scene, "odd column", DRAW_OLD_LOOP, DRAW_BLIT, 1, frames);
+    SDL_Log("%-26s %10s %10s %7s", "one color per frame", "remap", "patch", "speedup");
+    failures += Report(&scene, "even column", DRAW_REMAP, DRAW_PATCH, 0, frames);
+    failures += Report(&scene, "odd column", DRAW_REMAP, DRAW_PATCH, 1, frames);
+
+    SDL_FreeSurface(scene.src);
+    SDL_FreeSurface(scene.dst);
+    SDL_FreePalette(scene.palettes[0]);
+    SDL_FreePalette(scene.palettes[1]);
+    SDL_Quit();
+    return failures ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
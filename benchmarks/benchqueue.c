@@ -0,0 +1,305 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Stresses SDL_QueueAudio() under each SDL_HINT_AUDIO_QUEUE_OVERFLOW
+   policy (grow, block and drop), without a sound card:
+
+   - a FIFO stands in for the OSS device, which the dsp driver then treats
+     as raw PCM; a consumer thread reads it at 48 kHz in real time, so the
+     audio thread plays at the pace a device would;
+   - a producer thread queues numbered S16 stereo frames in chunks of 1 to
+     1024 frames, as fast as the policy lets it, keeping at most half a
+     second queued; a dropped chunk is queued again 1 ms later;
+   - halfway through, the device is paused for 200 ms.
+
+   Every frame that comes out of the FIFO must be silence or the next one
+   in sequence, and all of them must come out.  Reports the longest
+   SDL_QueueAudio() call and the queue's counters.
+
+   Usage: benchqueue [seconds per policy] [fifo path] */
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "SDL.h"
+
+#define FREQUENCY 48000
+#define SAMPLES 1024
+#define FRAME_SIZE 4
+#define MAX_QUEUED (FREQUENCY / 2 * FRAME_SIZE)
+
+typedef struct
+{
+    SDL_AudioDeviceID dev;
+    int fd;
+    SDL_atomic_t stop_producer;
+    SDL_atomic_t stop_consumer;
+    SDL_atomic_t produced;    /* frames queued so far */
+    SDL_atomic_t consumed;    /* frames checked so far */
+    SDL_atomic_t bad;         /* frames out of sequence */
+    Uint32 silent;            /* silent frames played between queued ones */
+    Uint32 drops;             /* SDL_QueueAudio() calls that failed */
+    Uint64 max_call;          /* longest SDL_QueueAudio() call, in counter ticks */
+} Run;
+
+static Uint32 seed = 12345;
+
+static Uint32
+Random(void)
+{
+    seed = (seed * 1664525u) + 1013904223u;
+    return seed >> 8;
+}
+
+/* Frame n; the high bits can't be all zero, so it never looks like silence */
+static void
+MakeFrame(Sint16 *frame, Uint32 n)
+{
+    frame[0] = (Sint16) (n & 0xFFFF);
+    frame[1] = (Sint16) (0x4000 | ((n >> 16) & 0x3FFF));
+}
+
+static int SDLCALL
+Producer(void *data)
+{
+    Run *run = (Run *) data;
+    Sint16 chunk[SAMPLES * 2];
+    Uint32 next = 0;
+
+    while (!SDL_AtomicGet(&run->stop_producer)) {
+        const Uint32 frames = 1 + (Random() % SAMPLES);
+        Uint64 start, elapsed;
+        Uint32 i;
+        int rc;
+
+        if (SDL_GetQueuedAudioSize(run->dev) >= MAX_QUEUED) {
+            SDL_Delay(1);
+            continue;
+        }
+        for (i = 0; i < frames; i++) {
+            MakeFrame(&chunk[i * 2], next + i);
+        }
+
+        /* a dropped chunk goes again, so the sequence has no holes */
+        for (;;) {
+            start = SDL_GetPerformanceCounter();
+            rc = SDL_QueueAudio(run->dev, chunk, frames * FRAME_SIZE);
+            elapsed = SDL_GetPerformanceCounter() - start;
+            run->max_call = SDL_max(run->max_call, elapsed);
+            if (rc == 0 || SDL_AtomicGet(&run->stop_producer)) {
+                break;
+            }
+            run->drops++;
+            SDL_Delay(1);
+        }
+        if (rc < 0) {
+            break;
+        }
+        next += frames;
+        SDL_AtomicSet(&run->produced, (int) next);
+    }
+    return 0;
+}
+
+/* Reads the FIFO no faster than the device would play, and checks it */
+static int SDLCALL
+Consumer(void *data)
+{
+    Run *run = (Run *) data;
+    const Uint64 start = SDL_GetPerformanceCounter();
+    const double frequency = (double) SDL_GetPerformanceFrequency();
+    Uint8 buffer[SAMPLES * FRAME_SIZE * 4];
+    size_t held = 0;
+    Uint64 read_bytes = 0;
+    Uint32 expected = 0;
+
+    while (!SDL_AtomicGet(&run->stop_consumer)) {
+        const Uint64 due = (Uint64) (((SDL_GetPerformanceCounter() - start) / frequency) * (FREQUENCY * FRAME_SIZE));
+        const size_t want = (size_t) SDL_min(due - read_bytes, (Uint64) (sizeof (buffer) - held));
+        const ssize_t got = (want > 0) ? read(run->fd, buffer + held, want) : 0;
+        size_t i;
+
+        if (got <= 0) {
+            read_bytes = due;  /* nothing there: the device underran, and played on */
+            SDL_Delay(1);
+            continue;
+        }
+        read_bytes += got;
+        held += got;
+
+        for (i = 0; i + FRAME_SIZE <= held; i += FRAME_SIZE) {
+            const Sint16 *frame = (const Sint16 *) (buffer + i);
+            Sint16 want_frame[2];
+
+            if (frame[0] == 0 && frame[1] == 0) {
+                if (expected && ((Uint32) SDL_AtomicGet(&run->produced) > expected)) {
+                    run->silent++;  /* an underrun, or the pause */
+                }
+                continue;
+            }
+            MakeFrame(want_frame, expected);
+            if (frame[0] != want_frame[0] || frame[1] != want_frame[1]) {
+                SDL_AtomicAdd(&run->bad, 1);
+            }
+            expected++;
+        }
+        SDL_memmove(buffer, buffer + i, held - i);
+        held -= i;
+        SDL_AtomicSet(&run->consumed, (int) expected);
+    }
+    return 0;
+}
+
+/* Empties the FIFO of whatever the last device left in it */
+static void
+DrainFifo(int fd)
+{
+    Uint8 buffer[4096];
+    while (read(fd, buffer, sizeof (buffer)) > 0) {
+    }
+}
+
+static int
+RunPolicy(const char *policy, const char *path, int fd, double seconds)
+{
+    SDL_AudioSpec desired;
+    SDL_AudioQueueStats stats;
+    SDL_Thread *producer, *consumer;
+    Run run;
+    Uint64 deadline;
+    int produced, consumed, bad;
+
+    SDL_zero(run);
+    run.fd = fd;
+    DrainFifo(fd);
+
+    SDL_zero(desired);
+    desired.freq = FREQUENCY;
+    desired.format = AUDIO_S16SYS;
+    desired.channels = 2;
+    desired.samples = SAMPLES;
+
+    SDL_SetHint(SDL_HINT_AUDIO_QUEUE_OVERFLOW, policy);
+    consumer = SDL_CreateThread(Consumer, "consumer", &run);
+    run.dev = SDL_OpenAudioDevice(path, 0, &desired, NULL, 0);
+    if (!run.dev || !consumer) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: %s", policy, SDL_GetError());
+        SDL_AtomicSet(&run.stop_consumer, 1);
+        SDL_WaitThread(consumer, NULL);
+        return 1;
+    }
+    producer = SDL_CreateThread(Producer, "producer", &run);
+    if (!producer) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: %s", policy, SDL_GetError());
+        SDL_CloseAudioDevice(run.dev);
+        SDL_AtomicSet(&run.stop_consumer, 1);
+        SDL_WaitThread(consumer, NULL);
+        return 1;
+    }
+    SDL_PauseAudioDevice(run.dev, 0);
+
+    SDL_Delay((Uint32) (seconds * 500.0));
+    SDL_PauseAudioDevice(run.dev, 1);
+    SDL_Delay(200);
+    SDL_PauseAudioDevice(run.dev, 0);
+    SDL_Delay((Uint32) (seconds * 500.0));
+
+    /* Stop queueing, then wait for the device and the FIFO to play out */
+    SDL_AtomicSet(&run.stop_producer, 1);
+    SDL_WaitThread(producer, NULL);
+    produced = SDL_AtomicGet(&run.produced);
+    deadline = SDL_GetTicks64() + 3000;
+    while (SDL_AtomicGet(&run.consumed) < produced && SDL_GetTicks64() < deadline) {
+        SDL_Delay(10);
+    }
+
+    SDL_GetAudioQueueStats(run.dev, &stats);
+    SDL_CloseAudioDevice(run.dev);
+    SDL_AtomicSet(&run.stop_consumer, 1);
+    SDL_WaitThread(consumer, NULL);
+
+    consumed = SDL_AtomicGet(&run.consumed);
+    bad = SDL_AtomicGet(&run.bad);
+    SDL_Log("%-6s %9d %9d %7u %6u %9u %5u %6u %9.2f", policy, produced, consumed, (unsigned int) run.silent,
+            (unsigned int) run.drops, (unsigned int) stats.overflows, (unsigned int) stats.grows,
+            (unsigned int) (stats.high_water / 1024),
+            (run.max_call * 1000.0) / SDL_GetPerformanceFrequency());
+
+    if (bad || consumed != produced) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: %d frames out of sequence, %d of %d played",
+                     policy, bad, consumed, produced);
+        return 1;
+    }
+    if (SDL_strcmp(policy, "drop") == 0 && stats.grows) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "drop: the queue grew %u times", (unsigned int) stats.grows);
+        return 1;
+    }
+    return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+    static const char *policies[] = { "grow", "block", "drop" };
+    const double seconds = (argc > 1) ? SDL_max(SDL_atof(argv[1]), 0.5) : 3.0;
+    char path[256];
+    int failures = 0;
+    int fd, i;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 2) {
+        SDL_strlcpy(path, argv[2], sizeof (path));
+    } else {
+        SDL_snprintf(path, sizeof (path), "/tmp/benchqueue-%d", (int) getpid());
+    }
+    if (mkfifo(path, 0600) < 0 && errno != EEXIST) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't make the FIFO %s", path);
+        return 1;
+    }
+
+    /* The read end has to be open before SDL looks for devices, or opening
+       the write end fails and the FIFO isn't listed */
+    fd = open(path, O_RDONLY | O_NONBLOCK);
+    if (fd < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open the FIFO %s", path);
+        unlink(path);
+        return 1;
+    }
+    SDL_setenv("AUDIODEV", path, 1);
+
+    if (SDL_Init(0) < 0 || SDL_AudioInit("dsp") < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize the dsp audio driver: %s", SDL_GetError());
+        close(fd);
+        unlink(path);
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_Log("S16 stereo, %d frames at %d Hz, %.1f s per policy, through %s", SAMPLES, FREQUENCY, seconds, path);
+    SDL_Log("%-6s %9s %9s %7s %6s %9s %5s %6s %9s", "policy", "queued", "played", "silent", "drops",
+            "overflows", "grows", "max KB", "max ms");
+    for (i = 0; i < (int) SDL_arraysize(policies); i++) {
+        failures += RunPolicy(policies[i], path, fd, seconds);
+    }
+
+    SDL_AudioQuit();
+    SDL_Quit();
+    close(fd);
+    unlink(path);
+    return failures ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
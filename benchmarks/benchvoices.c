@@ -0,0 +1,214 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures what mixing 8, 16 and 32 looping S16 stereo sounds costs the
+   audio thread of the default playback device, with S16 and F32 callbacks
+   of 1024 frames at 48 kHz:
+
+   - callback: the application's callback calls SDL_MixAudioFormat() once
+     per sound, as games did before voices;
+   - voices: the callback leaves silence and every sound is an
+     SDL_AudioVoice, which SDL mixes in one pass over a float bus.
+
+   The time comes from SDL_GetAudioDeviceTiming(), which covers the callback
+   and the voices; the device plays in real time for the given number of
+   seconds per test.
+
+   Usage: benchvoices [seconds per test] */
+
+#include "SDL.h"
+
+#define FREQUENCY 48000
+#define SAMPLES 1024
+#define MAX_SOUNDS 32
+
+typedef struct
+{
+    const Sint16 *data;
+    Uint32 len;
+    int sounds;
+    Uint32 pos[MAX_SOUNDS];
+    SDL_AudioFormat format;
+    Uint8 *scratch;
+} Mix;
+
+static void SDLCALL
+MixCallback(void *userdata, Uint8 *stream, int len)
+{
+    Mix *mix = (Mix *) userdata;
+    int i;
+
+    SDL_memset(stream, 0, len);
+    for (i = 0; i < mix->sounds; i++) {
+        /* The sounds are S16; a F32 device needs them converted first */
+        const int frames = len / ((mix->format == AUDIO_F32SYS) ? 8 : 4);
+        Uint32 left = frames * 4;
+        Uint8 *out = (mix->format == AUDIO_F32SYS) ? mix->scratch : stream;
+        Uint8 *dst = out;
+
+        while (left > 0) {
+            const Uint32 n = SDL_min(left, mix->len - mix->pos[i]);
+            SDL_memcpy(dst, (const Uint8 *) mix->data + mix->pos[i], n);
+            dst += n;
+            left -= n;
+            mix->pos[i] = (mix->pos[i] + n) % mix->len;
+        }
+        if (mix->format == AUDIO_F32SYS) {
+            float converted[SAMPLES * 2];
+            const Sint16 *samples = (const Sint16 *) mix->scratch;
+            int s;
+            for (s = 0; s < frames * 2; s++) {
+                converted[s] = samples[s] * (1.0f / 32768.0f);
+            }
+            SDL_MixAudioFormat(stream, (const Uint8 *) converted, AUDIO_F32SYS, len, SDL_MIX_MAXVOLUME / 2);
+        } else {
+            SDL_MixAudioFormat(stream, out, AUDIO_S16SYS, len, SDL_MIX_MAXVOLUME / 2);
+        }
+    }
+}
+
+static void SDLCALL
+SilenceCallback(void *userdata, Uint8 *stream, int len)
+{
+    SDL_memset(stream, 0, len);
+}
+
+/* Plays (sounds) sounds for (seconds); returns the mean time the audio
+   thread spent per period in microseconds, or -1.0 on error */
+static double
+Measure(SDL_AudioFormat format, SDL_bool voices, int sounds, const Sint16 *data, Uint32 len,
+        double seconds, Uint32 *max_us, Uint32 *late)
+{
+    SDL_AudioVoice *voice[MAX_SOUNDS];
+    SDL_AudioSpec desired, obtained;
+    SDL_AudioTimingStats timing;
+    SDL_AudioDeviceID dev;
+    Uint8 scratch[SAMPLES * 4];
+    Mix mix;
+    int i;
+
+    SDL_zero(mix);
+    mix.data = data;
+    mix.len = len;
+    mix.sounds = voices ? 0 : sounds;
+    mix.format = format;
+    mix.scratch = scratch;
+    for (i = 0; i < sounds; i++) {
+        mix.pos[i] = (Uint32) ((i * 4099 * 4) % len);
+    }
+
+    SDL_zero(desired);
+    desired.freq = FREQUENCY;
+    desired.format = format;
+    desired.channels = 2;
+    desired.samples = SAMPLES;
+    desired.callback = voices ? SilenceCallback : MixCallback;
+    desired.userdata = &mix;
+
+    SDL_SetHint(SDL_HINT_AUDIO_TIMING, "1");
+    dev = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+    if (!dev) {
+        return -1.0;
+    }
+    if (voices) {
+        for (i = 0; i < sounds; i++) {
+            voice[i] = SDL_CreateAudioVoice(dev);
+            if (!voice[i] ||
+                SDL_SetAudioVoiceData(voice[i], AUDIO_S16SYS, 2, (const Uint8 *) data + mix.pos[i],
+                                      len - mix.pos[i], -1) < 0) {
+                SDL_CloseAudioDevice(dev);
+                return -1.0;
+            }
+            SDL_SetAudioVoiceGain(voice[i], 0.5f, ((i % 5) - 2) / 2.0f);
+            SDL_PauseAudioVoice(voice[i], 0);
+        }
+    }
+
+    SDL_PauseAudioDevice(dev, 0);
+    SDL_Delay((Uint32) (seconds * 1000.0));
+    SDL_GetAudioDeviceTiming(dev, &timing);
+    SDL_CloseAudioDevice(dev);
+
+    if (!timing.callbacks) {
+        SDL_SetError("the device didn't run");
+        return -1.0;
+    }
+    *max_us = timing.callback_max_us;
+    *late = timing.late_callbacks;
+    return (double) timing.callback_total_us / timing.callbacks;
+}
+
+int
+main(int argc, char *argv[])
+{
+    const double seconds = (argc > 1) ? SDL_max(SDL_atof(argv[1]), 0.1) : 2.0;
+    static const int counts[] = { 8, 16, 32 };
+    static const struct
+    {
+        SDL_AudioFormat format;
+        const char *name;
+    } formats[] = { { AUDIO_S16SYS, "S16" }, { AUDIO_F32SYS, "F32" } };
+    const Uint32 len = FREQUENCY * 4;
+    Sint16 *data;
+    Uint32 seed = 12345;
+    int failures = 0;
+    Uint32 i;
+    int f, c;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    /* One second of stereo noise, shared by all the sounds */
+    data = (Sint16 *) SDL_malloc(len);
+    if (!data) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory");
+        SDL_Quit();
+        return 1;
+    }
+    for (i = 0; i < len / 2; i++) {
+        seed = (seed * 1664525u) + 1013904223u;
+        data[i] = (Sint16) (seed >> 16);
+    }
+
+    SDL_Log("%s, %d frames at %d Hz, %.1f s per test", SDL_GetCurrentAudioDriver(), SAMPLES, FREQUENCY, seconds);
+    SDL_Log("Microseconds per period, mean (max), and late periods");
+    SDL_Log("%-10s %20s %20s %7s", "sounds", "callback", "voices", "speedup");
+
+    for (f = 0; f < (int) SDL_arraysize(formats); f++) {
+        for (c = 0; c < (int) SDL_arraysize(counts); c++) {
+            Uint32 mix_max = 0, mix_late = 0, voice_max = 0, voice_late = 0;
+            const double mix_us = Measure(formats[f].format, SDL_FALSE, counts[c], data, len, seconds, &mix_max, &mix_late);
+            const double voice_us = Measure(formats[f].format, SDL_TRUE, counts[c], data, len, seconds, &voice_max, &voice_late);
+            char name[16], mix_text[32], voice_text[32];
+
+            if (mix_us < 0.0 || voice_us < 0.0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s, %d sounds: %s", formats[f].name, counts[c], SDL_GetError());
+                failures++;
+                continue;
+            }
+            SDL_snprintf(name, sizeof (name), "%d %s", counts[c], formats[f].name);
+            SDL_snprintf(mix_text, sizeof (mix_text), "%.1f (%u) %u", mix_us, (unsigned int) mix_max, (unsigned int) mix_late);
+            SDL_snprintf(voice_text, sizeof (voice_text), "%.1f (%u) %u", voice_us, (unsigned int) voice_max, (unsigned int) voice_late);
+            SDL_Log("%-10s %20s %20s %6.2fx", name, mix_text, voice_text, (voice_us > 0.0) ? (mix_us / voice_us) : 0.0);
+        }
+    }
+
+    SDL_free(data);
+    SDL_Quit();
+    return failures ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,302 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures decoded bytes per CPU second for 3 minutes of 44.1 kHz stereo
+   audio in memory, as PCM S16, MS ADPCM and IMA ADPCM:
+
+   - whole file: SDL_LoadWAV_RW(), which decodes everything up front into
+     one buffer;
+   - incremental: SDL_NewWAVDecoder() and SDL_WAVDecoderGet() called for
+     4 KB at a time, like an audio callback would.
+
+   The two outputs are compared byte for byte.
+
+   Usage: benchwav [seconds of audio] */
+
+#include <time.h>
+
+#include "SDL.h"
+
+#define MS_ADPCM_CODE 0x0002
+#define IMA_ADPCM_CODE 0x0011
+#define BLOCK_ALIGN 2048
+#define GET_SIZE 4096
+
+typedef struct
+{
+    Uint8 *data;
+    size_t size;
+    size_t pos;
+} Buffer;
+
+static Uint32 seed = 12345;
+
+static Uint32
+Random(void)
+{
+    seed = (seed * 1664525u) + 1013904223u;
+    return seed >> 8;
+}
+
+static void
+Put8(Buffer *buf, Uint8 value)
+{
+    buf->data[buf->pos++] = value;
+}
+
+static void
+Put16(Buffer *buf, Uint16 value)
+{
+    Put8(buf, (Uint8) value);
+    Put8(buf, (Uint8) (value >> 8));
+}
+
+static void
+Put32(Buffer *buf, Uint32 value)
+{
+    Put16(buf, (Uint16) value);
+    Put16(buf, (Uint16) (value >> 16));
+}
+
+static void
+PutTag(Buffer *buf, const char *tag)
+{
+    SDL_memcpy(buf->data + buf->pos, tag, 4);
+    buf->pos += 4;
+}
+
+/* A stereo 44.1 kHz WAVE file of (seconds) in (encoding), with random ADPCM
+   nibbles behind valid block headers */
+static int
+MakeWAV(Buffer *buf, Uint16 encoding, int seconds)
+{
+    static const Sint16 coeffs[14] = { 256, 0, 512, -256, 0, 0, 192, 64, 240, 0, 460, -208, 392, -232 };
+    const Uint32 frames = 44100 * seconds;
+    Uint32 data_size, samples_per_block = 0, blocks, i;
+    Uint16 bits = 16, block_align = 4, ext_size = 0;
+    Uint32 fmt_size;
+    size_t riff_size_pos;
+    int c;
+
+    if (encoding == MS_ADPCM_CODE) {
+        bits = 4;
+        block_align = BLOCK_ALIGN;
+        samples_per_block = (((BLOCK_ALIGN - 14) * 8) / 8) + 2;
+        ext_size = 4 + sizeof (coeffs);
+    } else if (encoding == IMA_ADPCM_CODE) {
+        bits = 4;
+        block_align = BLOCK_ALIGN;
+        samples_per_block = (((BLOCK_ALIGN - 8) * 8) / 8) + 1;
+        ext_size = 2;
+    }
+    blocks = samples_per_block ? ((frames + samples_per_block - 1) / samples_per_block) : 0;
+    data_size = samples_per_block ? (blocks * block_align) : (frames * 4);
+    fmt_size = 16 + (ext_size ? (2 + ext_size) : 0);
+
+    buf->size = 12 + 8 + fmt_size + 8 + data_size;
+    buf->data = (Uint8 *) SDL_malloc(buf->size);
+    buf->pos = 0;
+    if (!buf->data) {
+        return SDL_OutOfMemory();
+    }
+
+    PutTag(buf, "RIFF");
+    riff_size_pos = buf->pos;
+    Put32(buf, 0);
+    PutTag(buf, "WAVE");
+    PutTag(buf, "fmt ");
+    Put32(buf, fmt_size);
+    Put16(buf, encoding);
+    Put16(buf, 2);
+    Put32(buf, 44100);
+    Put32(buf, samples_per_block ? ((44100 * block_align) / samples_per_block) : (44100 * 4));
+    Put16(buf, block_align);
+    Put16(buf, bits);
+    if (ext_size) {
+        Put16(buf, ext_size);
+        Put16(buf, (Uint16) samples_per_block);
+        if (encoding == MS_ADPCM_CODE) {
+            Put16(buf, 7);
+            for (c = 0; c < (int) SDL_arraysize(coeffs); c++) {
+                Put16(buf, (Uint16) coeffs[c]);
+            }
+        }
+    }
+    PutTag(buf, "data");
+    Put32(buf, data_size);
+
+    if (!samples_per_block) {
+        for (i = 0; i < frames * 2; i++) {
+            Put16(buf, (Uint16) Random());
+        }
+    } else {
+        for (i = 0; i < blocks; i++) {
+            const size_t block_start = buf->pos;
+            if (encoding == MS_ADPCM_CODE) {
+                for (c = 0; c < 2; c++) {
+                    Put8(buf, (Uint8) (Random() % 7));
+                }
+                for (c = 0; c < 2; c++) {
+                    Put16(buf, (Uint16) (16 + (Random() % 512)));
+                }
+                for (c = 0; c < 4; c++) {
+                    Put16(buf, (Uint16) Random());
+                }
+            } else {
+                for (c = 0; c < 2; c++) {
+                    Put16(buf, (Uint16) Random());
+                    Put8(buf, (Uint8) (Random() % 89));
+                    Put8(buf, 0);
+                }
+            }
+            while (buf->pos < block_start + block_align) {
+                Put8(buf, (Uint8) Random());
+            }
+        }
+    }
+    buf->pos = riff_size_pos;
+    Put32(buf, (Uint32) (buf->size - 8));
+    buf->pos = buf->size;
+    return 0;
+}
+
+/* Decodes the whole file (repeat) times; returns the decoded bytes per CPU
+   second, or -1.0 on error. (*output) gets the first result, to be freed
+   with SDL_FreeWAV(). */
+static double
+MeasureWhole(const Buffer *file, int repeat, Uint8 **output, Uint32 *output_len)
+{
+    Uint64 bytes = 0;
+    clock_t start = clock();
+    int i;
+
+    for (i = 0; i < repeat; i++) {
+        SDL_AudioSpec spec;
+        Uint8 *audio;
+        Uint32 audio_len;
+        if (!SDL_LoadWAV_RW(SDL_RWFromConstMem(file->data, (int) file->size), 1, &spec, &audio, &audio_len)) {
+            return -1.0;
+        }
+        bytes += audio_len;
+        if (i == 0) {
+            *output = audio;
+            *output_len = audio_len;
+        } else {
+            SDL_FreeWAV(audio);
+        }
+    }
+    return bytes / ((double) (clock() - start) / CLOCKS_PER_SEC);
+}
+
+/* Decodes the file (repeat) times in GET_SIZE pieces; returns the decoded
+   bytes per CPU second, or -1.0 on error. With (expected), decodes it once
+   and returns 1.0 if the output is the same, 0.0 if not. */
+static double
+MeasureIncremental(const Buffer *file, int repeat, const Uint8 *expected, Uint32 expected_len)
+{
+    Uint8 piece[GET_SIZE];
+    Uint64 bytes = 0;
+    SDL_bool same = SDL_TRUE;
+    clock_t start = clock();
+    int i;
+
+    for (i = 0; i < repeat; i++) {
+        SDL_AudioSpec spec;
+        SDL_WAVDecoder *decoder = SDL_NewWAVDecoder(SDL_RWFromConstMem(file->data, (int) file->size), 1, &spec);
+        int got;
+
+        if (!decoder) {
+            return -1.0;
+        }
+        while ((got = SDL_WAVDecoderGet(decoder, piece, sizeof (piece))) > 0) {
+            if (expected) {
+                if (bytes + got > expected_len || SDL_memcmp(expected + bytes, piece, got) != 0) {
+                    same = SDL_FALSE;
+                }
+            }
+            bytes += got;
+        }
+        SDL_FreeWAVDecoder(decoder);
+        if (got < 0) {
+            return -1.0;
+        }
+    }
+    if (expected) {
+        return (same && bytes == expected_len) ? 1.0 : 0.0;
+    }
+    return bytes / ((double) (clock() - start) / CLOCKS_PER_SEC);
+}
+
+int
+main(int argc, char *argv[])
+{
+    const int seconds = (argc > 1) ? SDL_max(SDL_atoi(argv[1]), 1) : 180;
+    static const struct
+    {
+        Uint16 encoding;
+        const char *name;
+    } formats[] = {
+        { 0x0001, "PCM S16" },
+        { MS_ADPCM_CODE, "MS ADPCM" },
+        { IMA_ADPCM_CODE, "IMA ADPCM" }
+    };
+    const int repeat = 5;
+    int failures = 0;
+    int f;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%d seconds of stereo audio, MB decoded per CPU second", seconds);
+    SDL_Log("%-10s %10s %12s", "format", "whole file", "incremental");
+
+    for (f = 0; f < (int) SDL_arraysize(formats); f++) {
+        Buffer file;
+        Uint8 *whole = NULL;
+        Uint32 whole_len = 0;
+        double whole_rate, piece_rate = -1.0;
+        SDL_bool same = SDL_FALSE;
+
+        SDL_zero(file);
+        if (MakeWAV(&file, formats[f].encoding, seconds) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't make the file: %s", SDL_GetError());
+            failures++;
+            continue;
+        }
+        whole_rate = MeasureWhole(&file, repeat, &whole, &whole_len);
+        if (whole_rate >= 0.0) {
+            same = (MeasureIncremental(&file, 1, whole, whole_len) > 0.0) ? SDL_TRUE : SDL_FALSE;
+            piece_rate = MeasureIncremental(&file, repeat, NULL, 0);
+        }
+        if (whole_rate < 0.0 || piece_rate < 0.0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: %s", formats[f].name, SDL_GetError());
+            failures++;
+        } else {
+            if (!same) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: the decoder's output differs", formats[f].name);
+                failures++;
+            }
+            SDL_Log("%-10s %10.1f %12.1f", formats[f].name, whole_rate / 1000000.0, piece_rate / 1000000.0);
+        }
+        SDL_FreeWAV(whole);
+        SDL_free(file.data);
+    }
+
+    SDL_Quit();
+    return failures ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,271 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times converting video frames from YV12, NV12 and YUY2 to RGB565 and
+   XRGB8888 at 320x240, 640x480, 1280x720 and an odd 321x241:
+
+   - plain C: one pixel at a time, with the same BT.601 fixed point
+     arithmetic as SDL's scalar row kernels;
+   - SDL_ConvertPixels(), which uses the NEON or SSE2 row kernels where SDL
+     was built with them and the CPU has them.
+
+   Both results are compared byte for byte, so this also checks that the
+   SIMD kernels match the scalar ones on the machine it runs on.
+
+   Usage: benchyuv [iterations] */
+
+#include "SDL.h"
+
+/* BT.601, as in SDL_yuv.c: the luma factor is 7.7 fixed point and halved,
+   the bias and the chroma factors are 10.6 fixed point */
+#define Y_FACTOR 149
+#define Y_BIAS 1192
+#define V_R 102
+#define U_G 25
+#define V_G 52
+#define U_B 129
+
+typedef struct
+{
+    Uint32 format;
+    int w, h;
+    int pitch;
+    size_t size;
+    Uint8 *pixels;
+} Frame;
+
+static Uint32 seed = 12345;
+
+static Uint32
+Random(void)
+{
+    seed = (seed * 1664525u) + 1013904223u;
+    return seed >> 8;
+}
+
+static Uint8
+Clamp(int value)
+{
+    value = (value + 32) >> 6;
+    if (value < 0) {
+        return 0;
+    } else if (value > 255) {
+        return 255;
+    }
+    return (Uint8) value;
+}
+
+static int
+MakeFrame(Frame *frame, Uint32 format, int w, int h)
+{
+    const size_t chroma = (size_t) ((w + 1) / 2) * ((h + 1) / 2);
+    size_t i;
+
+    frame->format = format;
+    frame->w = w;
+    frame->h = h;
+    if (format == SDL_PIXELFORMAT_YUY2) {
+        frame->pitch = 4 * ((w + 1) / 2);
+        frame->size = (size_t) frame->pitch * h;
+    } else {
+        frame->pitch = w;
+        frame->size = ((size_t) w * h) + (2 * chroma);
+    }
+    frame->pixels = (Uint8 *) SDL_malloc(frame->size);
+    if (!frame->pixels) {
+        return SDL_OutOfMemory();
+    }
+    /* Noise, with some full range rows so the clamping gets exercised */
+    for (i = 0; i < frame->size; i++) {
+        frame->pixels[i] = (Uint8) (((i / 64) % 5 == 0) ? ((Random() & 1) ? 255 : 0) : Random());
+    }
+    return 0;
+}
+
+/* The Y, U and V samples of pixel (x, y) */
+static void
+GetSamples(const Frame *frame, int x, int y, int *Y, int *U, int *V)
+{
+    const Uint8 *p = frame->pixels;
+    const int cx = x / 2, cy = y / 2;
+    const int uv_pitch = (frame->pitch + 1) / 2;
+    const Uint8 *chroma = p + ((size_t) frame->h * frame->pitch);
+
+    switch (frame->format) {
+    case SDL_PIXELFORMAT_YV12:
+        *Y = p[(y * frame->pitch) + x];
+        *V = chroma[(cy * uv_pitch) + cx];
+        *U = chroma[((((frame->h + 1) / 2) + cy) * uv_pitch) + cx];
+        break;
+    case SDL_PIXELFORMAT_NV12:
+        *Y = p[(y * frame->pitch) + x];
+        *U = chroma[(cy * 2 * uv_pitch) + (2 * cx)];
+        *V = chroma[(cy * 2 * uv_pitch) + (2 * cx) + 1];
+        break;
+    default: /* YUY2 */
+        *Y = p[(y * frame->pitch) + (2 * x)];
+        *U = p[(y * frame->pitch) + (4 * cx) + 1];
+        *V = p[(y * frame->pitch) + (4 * cx) + 3];
+        break;
+    }
+}
+
+static int
+ConvertPlainC(const Frame *frame, Uint32 dst_format, Uint8 *dst, int dst_pitch)
+{
+    int x, y;
+
+    for (y = 0; y < frame->h; y++) {
+        Uint16 *d16 = (Uint16 *) (dst + (y * dst_pitch));
+        Uint32 *d32 = (Uint32 *) (dst + (y * dst_pitch));
+        for (x = 0; x < frame->w; x++) {
+            int Y, U, V, luma;
+            Uint8 r, g, b;
+
+            GetSamples(frame, x, y, &Y, &U, &V);
+            U -= 128;
+            V -= 128;
+            luma = ((Y * Y_FACTOR) >> 1) - Y_BIAS;
+            r = Clamp(luma + (V * V_R));
+            g = Clamp(luma - ((U * U_G) + (V * V_G)));
+            b = Clamp(luma + (U * U_B));
+            if (dst_format == SDL_PIXELFORMAT_RGB565) {
+                d16[x] = (Uint16) (((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+            } else {
+                d32[x] = 0xFF000000 | ((Uint32) r << 16) | ((Uint32) g << 8) | b;
+            }
+        }
+    }
+    return 0;
+}
+
+static int
+ConvertSDL(const Frame *frame, Uint32 dst_format, Uint8 *dst, int dst_pitch)
+{
+    return SDL_ConvertPixels(frame->w, frame->h, frame->format, frame->pixels, frame->pitch,
+                             dst_format, dst, dst_pitch);
+}
+
+/* Best time of (iterations) conversions, in microseconds, or -1.0 on error */
+static double
+Measure(int (*convert)(const Frame *, Uint32, Uint8 *, int), const Frame *frame,
+        Uint32 dst_format, Uint8 *dst, int dst_pitch, int iterations)
+{
+    Uint64 best = ~((Uint64) 0);
+    int i;
+
+    for (i = 0; i < iterations; i++) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        if (convert(frame, dst_format, dst, dst_pitch) < 0) {
+            return -1.0;
+        }
+        best = SDL_min(best, SDL_GetPerformanceCounter() - start);
+    }
+    return (best * 1000000.0) / SDL_GetPerformanceFrequency();
+}
+
+int
+main(int argc, char *argv[])
+{
+    const int iterations = (argc > 1) ? SDL_max(SDL_atoi(argv[1]), 1) : 50;
+    static const struct
+    {
+        int w, h;
+    } sizes[] = { { 320, 240 }, { 640, 480 }, { 1280, 720 }, { 321, 241 } };
+    static const Uint32 sources[] = { SDL_PIXELFORMAT_YV12, SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_YUY2 };
+    static const struct
+    {
+        Uint32 format;
+        const char *name;
+    } targets[] = { { SDL_PIXELFORMAT_RGB565, "RGB565" }, { SDL_PIXELFORMAT_XRGB8888, "XRGB8888" } };
+    int failures = 0;
+    int s, f, t;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+    SDL_SetYUVConversionMode(SDL_YUV_CONVERSION_BT601);
+
+    SDL_Log("CPU has NEON: %s, SSE2: %s; best of %d frames in microseconds",
+            SDL_HasNEON() ? "yes" : "no", SDL_HasSSE2() ? "yes" : "no", iterations);
+    SDL_Log("%-10s %-5s %-9s %9s %17s %7s %9s", "size", "from", "to", "plain C", "SDL_ConvertPixels", "speedup", "Mpixel/s");
+
+    for (s = 0; s < (int) SDL_arraysize(sizes); s++) {
+        const int w = sizes[s].w, h = sizes[s].h;
+        const int dst_pitch = w * 4;
+        Uint8 *expected = (Uint8 *) SDL_malloc((size_t) dst_pitch * h);
+        Uint8 *actual = (Uint8 *) SDL_malloc((size_t) dst_pitch * h);
+        char size_name[16];
+
+        if (!expected || !actual) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory");
+            SDL_free(expected);
+            SDL_free(actual);
+            failures++;
+            continue;
+        }
+        SDL_snprintf(size_name, sizeof (size_name), "%dx%d", w, h);
+
+        for (f = 0; f < (int) SDL_arraysize(sources); f++) {
+            Frame frame;
+
+            SDL_zero(frame);
+            if (MakeFrame(&frame, sources[f], w, h) < 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't make the frame: %s", SDL_GetError());
+                failures++;
+                continue;
+            }
+
+            for (t = 0; t < (int) SDL_arraysize(targets); t++) {
+                const int row_bytes = w * SDL_BYTESPERPIXEL(targets[t].format);
+                double c_us, sdl_us;
+                int y;
+
+                SDL_memset(expected, 0, (size_t) dst_pitch * h);
+                SDL_memset(actual, 0xAA, (size_t) dst_pitch * h);
+                ConvertPlainC(&frame, targets[t].format, expected, dst_pitch);
+                if (ConvertSDL(&frame, targets[t].format, actual, dst_pitch) < 0) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: %s", size_name, SDL_GetError());
+                    failures++;
+                    continue;
+                }
+                for (y = 0; y < h; y++) {
+                    if (SDL_memcmp(expected + (y * dst_pitch), actual + (y * dst_pitch), row_bytes) != 0) {
+                        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s %s to %s: row %d differs", size_name,
+                                     SDL_GetPixelFormatName(sources[f]) + 16,
+                                     targets[t].name, y);
+                        failures++;
+                        break;
+                    }
+                }
+
+                c_us = Measure(ConvertPlainC, &frame, targets[t].format, expected, dst_pitch, iterations);
+                sdl_us = Measure(ConvertSDL, &frame, targets[t].format, actual, dst_pitch, iterations);
+                SDL_Log("%-10s %-5s %-9s %9.1f %17.1f %6.2fx %9.1f", size_name,
+                        SDL_GetPixelFormatName(sources[f]) + 16, targets[t].name,
+                        c_us, sdl_us, (sdl_us > 0.0) ? (c_us / sdl_us) : 0.0,
+                        (sdl_us > 0.0) ? ((w * h) / sdl_us) : 0.0);
+            }
+            SDL_free(frame.pixels);
+        }
+        SDL_free(expected);
+        SDL_free(actual);
+    }
+
+    SDL_Quit();
+    return failures ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
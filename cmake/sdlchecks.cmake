@@ -1014,18 +1014,39 @@ macro(CheckPTHREAD)
         endif()
       endif()
 
+      if(LINUX AND SDL_FUTEX)
+        check_c_source_compiles("
+            #include <linux/futex.h>
+            #include <sys/syscall.h>
+            #include <unistd.h>
+            int main(int argc, char **argv) {
+              return syscall(SYS_futex, (int *)0, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG,
+                             0, (void *)0, (void *)0, FUTEX_BITSET_MATCH_ANY);
+            }" HAVE_LINUX_FUTEX)
+      endif()
+
       set(SOURCE_FILES ${SOURCE_FILES}
           ${SDL2_SOURCE_DIR}/src/thread/pthread/SDL_systhread.c
-          ${SDL2_SOURCE_DIR}/src/thread/pthread/SDL_sysmutex.c   # Can be faked, if necessary
-          ${SDL2_SOURCE_DIR}/src/thread/pthread/SDL_syscond.c    # Can be faked, if necessary
           ${SDL2_SOURCE_DIR}/src/thread/pthread/SDL_systls.c
           )
-      if(HAVE_PTHREADS_SEM)
+      if(HAVE_LINUX_FUTEX)
+        # Threads still come from pthreads, synchronization goes straight to the kernel
         set(SOURCE_FILES ${SOURCE_FILES}
-            ${SDL2_SOURCE_DIR}/src/thread/pthread/SDL_syssem.c)
+            ${SDL2_SOURCE_DIR}/src/thread/linux/SDL_sysmutex.c
+            ${SDL2_SOURCE_DIR}/src/thread/linux/SDL_syscond.c
+            ${SDL2_SOURCE_DIR}/src/thread/linux/SDL_syssem.c)
       else()
         set(SOURCE_FILES ${SOURCE_FILES}
-            ${SDL2_SOURCE_DIR}/src/thread/generic/SDL_syssem.c)
+            ${SDL2_SOURCE_DIR}/src/thread/pthread/SDL_sysmutex.c   # Can be faked, if necessary
+            ${SDL2_SOURCE_DIR}/src/thread/pthread/SDL_syscond.c    # Can be faked, if necessary
+            )
+        if(HAVE_PTHREADS_SEM)
+          set(SOURCE_FILES ${SOURCE_FILES}
+              ${SDL2_SOURCE_DIR}/src/thread/pthread/SDL_syssem.c)
+        else()
+          set(SOURCE_FILES ${SOURCE_FILES}
+              ${SDL2_SOURCE_DIR}/src/thread/generic/SDL_syssem.c)
+        endif()
       endif()
       set(HAVE_SDL_THREADS TRUE)
     endif()
@@ -32,6 +32,7 @@
 #include "SDL_main.h"
 #include "SDL_stdinc.h"
 #include "SDL_assert.h"
+#include "SDL_asyncload.h"
 #include "SDL_atomic.h"
 #include "SDL_audio.h"
 #include "SDL_clipboard.h"
@@ -45,6 +46,7 @@
 #include "SDL_haptic.h"
 #include "SDL_hidapi.h"
 #include "SDL_hints.h"
+#include "SDL_jobs.h"
 #include "SDL_joystick.h"
 #include "SDL_loadso.h"
 #include "SDL_log.h"
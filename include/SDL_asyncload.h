@@ -0,0 +1,258 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_asyncload_h_
+#define SDL_asyncload_h_
+
+/**
+ *  \file SDL_asyncload.h
+ *
+ *  Header for loading files in the background.
+ *
+ *  Requests are read one at a time, highest priority first, by a dedicated
+ *  I/O thread. Decoding then runs on the job system (see SDL_jobs.h), so
+ *  reading the next file overlaps with decoding the last one. When a load
+ *  finishes, its status can be polled and an ::SDL_ASYNCLOADCOMPLETE event
+ *  is posted if the event subsystem is initialized.
+ *
+ *  The I/O thread is started the first time it is needed and stopped by
+ *  SDL_Quit(), which cancels any loads still waiting to be read.
+ */
+
+#include "SDL_stdinc.h"
+#include "SDL_error.h"
+#include "SDL_audio.h"
+#include "SDL_surface.h"
+
+#include "begin_code.h"
+/* Set up for C function definitions, even when using C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The asynchronous load structure, defined in SDL_asyncload.c */
+struct SDL_AsyncLoad;
+typedef struct SDL_AsyncLoad SDL_AsyncLoad;
+
+/**
+ * The state of an asynchronous load.
+ */
+typedef enum
+{
+    SDL_ASYNCLOAD_PENDING,      /**< Waiting to be read, or being read or decoded */
+    SDL_ASYNCLOAD_COMPLETE,     /**< Finished, the result is ready */
+    SDL_ASYNCLOAD_FAILED,       /**< Finished, see SDL_GetAsyncLoadError() */
+    SDL_ASYNCLOAD_CANCELED      /**< Canceled with SDL_CancelAsyncLoad() */
+} SDL_AsyncLoadStatus;
+
+/**
+ * Start loading all the data from a file in the background.
+ *
+ * Loads with a higher `priority` are read first; loads with equal priority
+ * are read in the order they were requested. Prefetches can be given a low
+ * priority: waiting on a load with SDL_WaitAsyncLoad() moves it to the front
+ * of the queue.
+ *
+ * When the load finishes, an ::SDL_ASYNCLOADCOMPLETE event is posted with
+ * the handle in `user.data1` and the SDL_AsyncLoadStatus in `user.code`.
+ * The handle in the event stays valid until the application frees it, so
+ * an application that matches events to handles should free a handle only
+ * after its event has been handled. Event filters and watchers can run
+ * while the loader holds its lock, so they must not call
+ * SDL_WaitAsyncLoad(), SDL_CancelAsyncLoad() or SDL_FreeAsyncLoad().
+ *
+ * The handle must be released with SDL_FreeAsyncLoad().
+ *
+ * \param file the path to read
+ * \param priority the priority of this load relative to others
+ * \returns a handle for the load, or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_FreeAsyncLoad
+ * \sa SDL_GetAsyncLoadData
+ * \sa SDL_GetAsyncLoadStatus
+ * \sa SDL_WaitAsyncLoad
+ */
+extern DECLSPEC SDL_AsyncLoad *SDLCALL SDL_LoadFileAsync(const char *file, int priority);
+
+/**
+ * Start loading a BMP image in the background.
+ *
+ * This works like SDL_LoadFileAsync(), and the file is then decoded as if
+ * by SDL_LoadBMP().
+ *
+ * \param file the path of the BMP file
+ * \param priority the priority of this load relative to others
+ * \returns a handle for the load, or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_GetAsyncLoadSurface
+ * \sa SDL_LoadFileAsync
+ */
+extern DECLSPEC SDL_AsyncLoad *SDLCALL SDL_LoadBMPAsync(const char *file, int priority);
+
+/**
+ * Start loading a WAVE file in the background.
+ *
+ * This works like SDL_LoadFileAsync(), and the file is then decoded as if
+ * by SDL_LoadWAV(), including ADPCM decompression.
+ *
+ * \param file the path of the WAVE file
+ * \param priority the priority of this load relative to others
+ * \returns a handle for the load, or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_GetAsyncLoadWAV
+ * \sa SDL_LoadFileAsync
+ */
+extern DECLSPEC SDL_AsyncLoad *SDLCALL SDL_LoadWAVAsync(const char *file, int priority);
+
+/**
+ * Get the current state of an asynchronous load, without waiting.
+ *
+ * \param load the load to query
+ * \returns the SDL_AsyncLoadStatus of the load.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_WaitAsyncLoad
+ */
+extern DECLSPEC SDL_AsyncLoadStatus SDLCALL SDL_GetAsyncLoadStatus(SDL_AsyncLoad *load);
+
+/**
+ * Wait for an asynchronous load to finish.
+ *
+ * If the load hasn't been read yet, it is moved ahead of every other
+ * waiting load.
+ *
+ * \param load the load to wait for
+ * \returns the SDL_AsyncLoadStatus of the load, which is never
+ *          SDL_ASYNCLOAD_PENDING.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_GetAsyncLoadStatus
+ */
+extern DECLSPEC SDL_AsyncLoadStatus SDLCALL SDL_WaitAsyncLoad(SDL_AsyncLoad *load);
+
+/**
+ * Cancel an asynchronous load.
+ *
+ * A load that is still waiting to be read is canceled immediately. One that
+ * is being read or decoded finishes in the background and its result is
+ * thrown away. Either way the status becomes SDL_ASYNCLOAD_CANCELED once
+ * the load stops; loads that have already finished are left alone.
+ *
+ * \param load the load to cancel
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_FreeAsyncLoad
+ */
+extern DECLSPEC void SDLCALL SDL_CancelAsyncLoad(SDL_AsyncLoad *load);
+
+/**
+ * Take the data read by a load started with SDL_LoadFileAsync().
+ *
+ * The data has a zero byte at the end, like SDL_LoadFile(). The caller owns
+ * it and should free it with SDL_free(); later calls return NULL.
+ *
+ * \param load a completed load
+ * \param datasize if not NULL, will store the number of bytes read
+ * \returns the data, or NULL if the load didn't complete or the data was
+ *          already taken.
+ *
+ * \since This function is available since SDL 2.26.5.
+ */
+extern DECLSPEC void *SDLCALL SDL_GetAsyncLoadData(SDL_AsyncLoad *load, size_t *datasize);
+
+/**
+ * Take the surface decoded by a load started with SDL_LoadBMPAsync().
+ *
+ * The caller owns the surface and should free it with SDL_FreeSurface();
+ * later calls return NULL.
+ *
+ * \param load a completed load
+ * \returns the surface, or NULL if the load didn't complete or the surface
+ *          was already taken.
+ *
+ * \since This function is available since SDL 2.26.5.
+ */
+extern DECLSPEC SDL_Surface *SDLCALL SDL_GetAsyncLoadSurface(SDL_AsyncLoad *load);
+
+/**
+ * Take the audio decoded by a load started with SDL_LoadWAVAsync().
+ *
+ * The caller owns the buffer and should free it with SDL_FreeWAV(); later
+ * calls return NULL.
+ *
+ * \param load a completed load
+ * \param spec an SDL_AudioSpec that will be filled in with the format of the
+ *             audio data
+ * \param audio_len if not NULL, will store the length of the audio data in
+ *                  bytes
+ * \returns the audio data, or NULL if the load didn't complete or the data
+ *          was already taken.
+ *
+ * \since This function is available since SDL 2.26.5.
+ */
+extern DECLSPEC Uint8 *SDLCALL SDL_GetAsyncLoadWAV(SDL_AsyncLoad *load, SDL_AudioSpec *spec, Uint32 *audio_len);
+
+/**
+ * Get the error message of a failed asynchronous load.
+ *
+ * \param load a load with the status SDL_ASYNCLOAD_FAILED
+ * \returns the message, valid until the load is freed, or an empty string if
+ *          the load didn't fail.
+ *
+ * \since This function is available since SDL 2.26.5.
+ */
+extern DECLSPEC const char *SDLCALL SDL_GetAsyncLoadError(SDL_AsyncLoad *load);
+
+/**
+ * Release an asynchronous load handle.
+ *
+ * A load that hasn't finished is canceled, and any result that wasn't taken
+ * is freed. The handle must not be used after this call.
+ *
+ * \param load the load to release
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_CancelAsyncLoad
+ */
+extern DECLSPEC void SDLCALL SDL_FreeAsyncLoad(SDL_AsyncLoad *load);
+
+/* Ends C function definitions when using C++ */
+#ifdef __cplusplus
+}
+#endif
+#include "close_code.h"
+
+#endif /* SDL_asyncload_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -897,6 +897,102 @@ extern DECLSPEC SDL_AudioSpec *SDLCALL SDL_LoadWAV_RW(SDL_RWops * src,
  */
 extern DECLSPEC void SDLCALL SDL_FreeWAV(Uint8 * audio_buf);
 
+/* SDL_WAVDecoder decodes a WAVE file a piece at a time, as the samples are
+   needed, instead of all of it up front like SDL_LoadWAV_RW() does. */
+/* this is opaque to the outside world. */
+struct SDL_WAVDecoder;
+typedef struct SDL_WAVDecoder SDL_WAVDecoder;
+
+/**
+ * Open a WAVE file for incremental decoding.
+ *
+ * This reads the headers of the file and fills in `spec` like
+ * SDL_LoadWAV_RW() does. The samples are read and decoded later, by
+ * SDL_WAVDecoderGet(), so `src` must stay valid until the decoder is freed.
+ * All formats supported by SDL_LoadWAV_RW() are supported, and the decoded
+ * data is the same.
+ *
+ * \param src the data source for the WAVE data
+ * \param freesrc if non-zero, the data source gets automatically closed and
+ *                freed when the decoder is freed, or right away on failure
+ * \param spec an SDL_AudioSpec that will be filled in with the format of the
+ *             decoded data
+ * \returns a new decoder, or NULL on error; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_WAVDecoderGet
+ * \sa SDL_WAVDecoderSeek
+ * \sa SDL_FreeWAVDecoder
+ */
+extern DECLSPEC SDL_WAVDecoder * SDLCALL SDL_NewWAVDecoder(SDL_RWops * src,
+                                                           int freesrc,
+                                                           SDL_AudioSpec * spec);
+
+/**
+ * Decode the next samples of a WAVE file.
+ *
+ * Only whole sample frames are returned. This doesn't allocate memory and
+ * reads at most one ADPCM block at a time from the data source, so it may be
+ * called from an audio callback when the data source is in memory or
+ * otherwise fast.
+ *
+ * \param decoder the decoder to read from
+ * \param buf a buffer to fill with decoded audio data
+ * \param len the maximum number of bytes to fill
+ * \returns the number of bytes filled, 0 at the end of the data, or -1 on
+ *          error; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_NewWAVDecoder
+ * \sa SDL_WAVDecoderSeek
+ */
+extern DECLSPEC int SDLCALL SDL_WAVDecoderGet(SDL_WAVDecoder * decoder, void * buf, int len);
+
+/**
+ * Move a WAVE decoder to a sample frame.
+ *
+ * ADPCM files can only be read from the start of a block, so this decodes
+ * the block that contains the frame.
+ *
+ * \param decoder the decoder to seek
+ * \param frame the index of the next sample frame to be returned
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_WAVDecoderGet
+ * \sa SDL_WAVDecoderLength
+ */
+extern DECLSPEC int SDLCALL SDL_WAVDecoderSeek(SDL_WAVDecoder * decoder, Sint64 frame);
+
+/**
+ * Get the number of sample frames a WAVE decoder will return.
+ *
+ * \param decoder the decoder to query
+ * \returns the number of sample frames, or a negative error code on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_WAVDecoderSeek
+ */
+extern DECLSPEC Sint64 SDLCALL SDL_WAVDecoderLength(SDL_WAVDecoder * decoder);
+
+/**
+ * Free a WAVE decoder.
+ *
+ * \param decoder the decoder to free; it is safe to pass NULL here
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_NewWAVDecoder
+ */
+extern DECLSPEC void SDLCALL SDL_FreeWAVDecoder(SDL_WAVDecoder * decoder);
+
 /**
  * Initialize an SDL_AudioCVT structure for conversion.
  *
@@ -1180,6 +1276,146 @@ extern DECLSPEC void SDLCALL SDL_MixAudioFormat(Uint8 * dst,
                                                 SDL_AudioFormat format,
                                                 Uint32 len, int volume);
 
+/* SDL_AudioVoice is a sound that SDL mixes into a playback device for you,
+   on top of whatever the device's callback or queue provides. All playing
+   voices are summed with their gain and pan and clipped once per callback,
+   which is much cheaper than calling SDL_MixAudioFormat() for each sound. */
+/* this is opaque to the outside world. */
+struct SDL_AudioVoice;
+typedef struct SDL_AudioVoice SDL_AudioVoice;
+
+/**
+ * Create a voice to be mixed into an open playback device.
+ *
+ * The voice starts out paused, with no sound, a gain of 1.0 and centered.
+ * Give it something to play with SDL_SetAudioVoiceData() or
+ * SDL_SetAudioVoiceStream() and start it with SDL_PauseAudioVoice().
+ *
+ * Voices are mixed in the device's callback format, which must be AUDIO_U8,
+ * AUDIO_S8, AUDIO_S16SYS, AUDIO_S32SYS or AUDIO_F32SYS. Mono and stereo
+ * voices are mixed into the first two channels of the device.
+ *
+ * Voices belong to the device: they are all destroyed when it is closed.
+ *
+ * \param dev the ID of an open playback device
+ * \returns a new voice, or NULL on error; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_DestroyAudioVoice
+ * \sa SDL_SetAudioVoiceData
+ * \sa SDL_SetAudioVoiceStream
+ */
+extern DECLSPEC SDL_AudioVoice * SDLCALL SDL_CreateAudioVoice(SDL_AudioDeviceID dev);
+
+/**
+ * Make a voice play from audio data in memory.
+ *
+ * The data is not copied, so it must stay valid until the voice is given
+ * something else to play or destroyed. It must be at the device's frequency
+ * and aligned to its sample size; use SDL_SetAudioVoiceStream() for anything
+ * that needs resampling. Playback starts from the beginning of the data.
+ *
+ * \param voice the voice to play the data
+ * \param format AUDIO_U8, AUDIO_S8, AUDIO_S16SYS, AUDIO_S32SYS or
+ *               AUDIO_F32SYS
+ * \param channels 1 for mono or 2 for stereo
+ * \param data the samples to play
+ * \param len the number of bytes (not samples!) to which `data` points
+ * \param loops the number of times to repeat the data after it has played
+ *              once, or -1 to repeat it forever
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_GetAudioVoiceStatus
+ */
+extern DECLSPEC int SDLCALL SDL_SetAudioVoiceData(SDL_AudioVoice * voice,
+                                                  SDL_AudioFormat format,
+                                                  Uint8 channels,
+                                                  const void * data,
+                                                  Uint32 len, int loops);
+
+/**
+ * Make a voice play whatever is put into an audio stream.
+ *
+ * The stream must produce mono or stereo audio at the device's frequency,
+ * in one of the formats SDL_SetAudioVoiceData() accepts. SDL reads from it
+ * on the audio thread, so lock the device with SDL_LockAudioDevice() while
+ * putting data into it. If the stream runs dry, the voice is silent until
+ * more data arrives.
+ *
+ * The stream is not freed with the voice.
+ *
+ * \param voice the voice to play the stream
+ * \param stream the stream to play, or NULL to stop playing one
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_NewAudioStream
+ */
+extern DECLSPEC int SDLCALL SDL_SetAudioVoiceStream(SDL_AudioVoice * voice,
+                                                    SDL_AudioStream * stream);
+
+/**
+ * Set the gain and pan of a voice.
+ *
+ * A pan of -1.0 is fully left and 1.0 is fully right. Panning only
+ * attenuates the opposite side, so a centered voice plays at full gain on
+ * both. On a mono device the pan is ignored.
+ *
+ * \param voice the voice to change
+ * \param gain the volume scale, 1.0 for unchanged
+ * \param pan the stereo position, from -1.0 to 1.0
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ */
+extern DECLSPEC int SDLCALL SDL_SetAudioVoiceGain(SDL_AudioVoice * voice,
+                                                  float gain, float pan);
+
+/**
+ * Pause or unpause a voice.
+ *
+ * \param voice the voice to pause or unpause
+ * \param pause_on non-zero to pause, 0 to play
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ */
+extern DECLSPEC int SDLCALL SDL_PauseAudioVoice(SDL_AudioVoice * voice,
+                                                int pause_on);
+
+/**
+ * Get whether a voice is playing.
+ *
+ * A voice is stopped when it has nothing left to play: it has no data or
+ * stream, its data has played through, or its stream is empty.
+ *
+ * \param voice the voice to query
+ * \returns the SDL_AudioStatus of the voice.
+ *
+ * \since This function is available since SDL 2.26.5.
+ */
+extern DECLSPEC SDL_AudioStatus SDLCALL SDL_GetAudioVoiceStatus(SDL_AudioVoice * voice);
+
+/**
+ * Destroy a voice, removing it from its device.
+ *
+ * \param voice the voice to destroy
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_CreateAudioVoice
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyAudioVoice(SDL_AudioVoice * voice);
+
 /**
  * Queue more audio on non-callback devices.
  *
@@ -1192,8 +1428,9 @@ extern DECLSPEC void SDLCALL SDL_MixAudioFormat(Uint8 * dst,
  * method), or you can supply no callback, and then SDL will expect you to
  * supply data at regular intervals (push method) with this function.
  *
- * There are no limits on the amount of data you can queue, short of
- * exhaustion of address space. Queued data will drain to the device as
+ * By default there are no limits on the amount of data you can queue, short
+ * of exhaustion of address space; SDL_HINT_AUDIO_QUEUE_OVERFLOW can make a
+ * full queue wait or fail instead. Queued data will drain to the device as
  * necessary without further intervention from you. If the device needs audio
  * but there is not enough queued, it will play silence to make up the
  * difference. This means you will have skips in your audio playback if you
@@ -1344,6 +1581,301 @@ extern DECLSPEC Uint32 SDLCALL SDL_GetQueuedAudioSize(SDL_AudioDeviceID dev);
  */
 extern DECLSPEC void SDLCALL SDL_ClearQueuedAudio(SDL_AudioDeviceID dev);
 
+/**
+ * Counters describing the audio queue of a non-callback device.
+ *
+ * \sa SDL_GetAudioQueueStats
+ */
+typedef struct SDL_AudioQueueStats
+{
+    Uint32 queued;      /**< Bytes in the queue now, as SDL_GetQueuedAudioSize() reports */
+    Uint32 capacity;    /**< Bytes the queue holds before it is full */
+    Uint32 high_water;  /**< The most bytes that have been in the queue at once */
+    Uint32 starved;     /**< Playback periods the queue couldn't fill, padded with silence */
+    Uint32 overflows;   /**< Times data didn't fit in a full queue */
+    Uint32 grows;       /**< Times the queue was reallocated to make room */
+} SDL_AudioQueueStats;
+
+/**
+ * Get statistics about the audio queue of a non-callback device.
+ *
+ * A playback device counts a period as starved whenever the queue runs out
+ * before the device buffer is full, including while nothing has been queued
+ * yet. What happens on an overflow is decided by
+ * SDL_HINT_AUDIO_QUEUE_OVERFLOW; capture devices drop the data that doesn't
+ * fit if the queue can't grow right away.
+ *
+ * The counters start at zero when the device is opened, and
+ * SDL_ClearQueuedAudio() doesn't reset them.
+ *
+ * \param dev the device ID of which to query the queue
+ * \param stats an SDL_AudioQueueStats structure filled in with the counters
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_GetQueuedAudioSize
+ * \sa SDL_HINT_AUDIO_QUEUE_CAPACITY
+ * \sa SDL_HINT_AUDIO_QUEUE_OVERFLOW
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioQueueStats(SDL_AudioDeviceID dev, SDL_AudioQueueStats * stats);
+
+/**
+ * Get the part of a non-callback playback device's queue that can be
+ * written in place.
+ *
+ * This is the zero-copy way to queue audio: render straight into `*buffer`,
+ * then hand what you wrote to the device with SDL_CommitAudioQueueBuffer().
+ * Neither call takes a lock or copies anything, and when the device plays the
+ * audio format you opened it with, SDL hands full periods of the queue to the
+ * device without copying them either. Use SDL_WaitAudioQueueSpace() to sleep
+ * until the device has played enough to make room, on a thread whose
+ * priority you choose.
+ *
+ * The region is contiguous, so it stops at the end of the queue's memory;
+ * once that is committed, the next call starts at the beginning. `*len` is
+ * 0 when the queue is full. The queue never grows here, whatever
+ * SDL_HINT_AUDIO_QUEUE_OVERFLOW says; SDL_HINT_AUDIO_QUEUE_CAPACITY sets its
+ * size. Write data in the format the device was opened with, as for
+ * SDL_QueueAudio(); a region may end partway through a sample frame if the
+ * frame size isn't a power of two.
+ *
+ * Only one thread may write to a device's queue this way, and it must not
+ * call SDL_QueueAudio() or SDL_ClearQueuedAudio() between acquiring a region
+ * and committing it, as either may move the queue's memory.
+ *
+ * \param dev the device ID to which we will queue audio
+ * \param buffer a pointer filled in with the writable region
+ * \param len a pointer filled in with the number of bytes in the region
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_CommitAudioQueueBuffer
+ * \sa SDL_WaitAudioQueueSpace
+ */
+extern DECLSPEC int SDLCALL SDL_AcquireAudioQueueBuffer(SDL_AudioDeviceID dev, void **buffer, Uint32 * len);
+
+/**
+ * Queue audio written in place after SDL_AcquireAudioQueueBuffer().
+ *
+ * The first `len` bytes of the acquired region are queued for playback. You
+ * may commit less than you acquired, and the rest of the region stays
+ * yours to write; committing more than is free fails.
+ *
+ * \param dev the device ID to which we queued audio
+ * \param len the number of bytes (not samples!) written to the region
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_AcquireAudioQueueBuffer
+ */
+extern DECLSPEC int SDLCALL SDL_CommitAudioQueueBuffer(SDL_AudioDeviceID dev, Uint32 len);
+
+/**
+ * Wait until a non-callback playback device's queue has room.
+ *
+ * The audio thread wakes the caller as soon as it has taken enough data out
+ * of the queue that `len` bytes are free, so a thread rendering audio with
+ * SDL_AcquireAudioQueueBuffer() can sleep between periods instead of polling.
+ * A `len` larger than the queue waits for the queue to be empty.
+ *
+ * A paused device doesn't take anything out of its queue, so this fails if
+ * the device is paused, disconnected or closed, before or during the wait.
+ * Only one thread waits on a device at a time; another thread calling this
+ * waits for it to finish first.
+ *
+ * \param dev the device ID of which to wait for the queue
+ * \param len the number of bytes that must be free
+ * \param timeout the maximum time to wait, in milliseconds, or
+ *                `SDL_MUTEX_MAXWAIT` to wait indefinitely
+ * \returns 0 if the room is there, `SDL_MUTEX_TIMEDOUT` if it wasn't by the
+ *          timeout, or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_AcquireAudioQueueBuffer
+ * \sa SDL_GetQueuedAudioSize
+ */
+extern DECLSPEC int SDLCALL SDL_WaitAudioQueueSpace(SDL_AudioDeviceID dev, Uint32 len, Uint32 timeout);
+
+/**
+ * Counters describing the work of an audio device's thread.
+ *
+ * \sa SDL_GetAudioDeviceStats
+ */
+typedef struct SDL_AudioDeviceStats
+{
+    Uint32 periods;             /**< Callback periods run since the device was opened */
+    Uint32 period_bytes_copied; /**< Bytes copied between buffers in the last full period */
+    Uint64 bytes_copied;        /**< Bytes copied between buffers in all periods */
+} SDL_AudioDeviceStats;
+
+/**
+ * Get statistics about the work an audio device's thread does.
+ *
+ * Copies are the passes that move audio from one buffer to another without
+ * converting it, between the callback and the device. When the device can
+ * take the callback's format, or only the format and channel count differ
+ * and the converted data fits in the device's buffer, a playback period
+ * makes no copies at all.
+ *
+ * The counters start at zero when the device is opened. They are updated
+ * once per period, so they trail the audio thread by up to one period.
+ *
+ * \param dev the device ID to query
+ * \param stats an SDL_AudioDeviceStats structure filled in with the counters
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_OpenAudioDevice
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioDeviceStats(SDL_AudioDeviceID dev, SDL_AudioDeviceStats * stats);
+
+/**
+ * The number of buckets in SDL_AudioTimingStats::callback_histogram.
+ */
+#define SDL_AUDIO_TIMING_BUCKETS 16
+
+/**
+ * How long an audio device's thread spends on each part of its work.
+ *
+ * A period is one device buffer; a callback run may cover more or fewer
+ * than one when the stream resamples. Totals are in microseconds, so
+ * dividing by periods or callbacks gives the mean.
+ *
+ * \sa SDL_GetAudioDeviceTiming
+ */
+typedef struct SDL_AudioTimingStats
+{
+    Uint32 period_us;           /**< Nominal length of a device period */
+    Uint32 callbacks;           /**< Callback runs timed */
+    Uint32 periods;             /**< Device periods timed */
+
+    /** Callback durations: bucket 0 counts runs shorter than 2
+        microseconds, bucket i runs from 2^i up to 2^(i+1) microseconds,
+        and the last bucket everything longer. */
+    Uint32 callback_histogram[SDL_AUDIO_TIMING_BUCKETS];
+    Uint32 callback_max_us;
+    Uint64 callback_total_us;
+
+    Uint32 convert_max_us;      /**< Format conversion, resampling and copies, per callback run */
+    Uint64 convert_total_us;
+
+    Uint32 play_max_us;         /**< Handing a period to the device, including blocking until it has room */
+    Uint64 play_total_us;
+
+    Uint32 wait_max_us;         /**< Blocked afterwards until the device wants another period; capture blocks here reading one */
+    Uint64 wait_total_us;
+
+    Uint32 jitter_max_us;       /**< Difference between a period's actual and nominal length */
+    Uint64 jitter_total_us;
+
+    Uint32 late_callbacks;      /**< Callback runs whose callback and conversion took longer than they play */
+    Uint32 underruns;           /**< Times playback ran dry, as far as the device can tell */
+    Uint32 overruns;            /**< Times capture lost data, as far as the device can tell */
+} SDL_AudioTimingStats;
+
+/**
+ * Get timing statistics for an audio device's thread.
+ *
+ * Timing has a small cost on every period, so a device only collects it if
+ * SDL_HINT_AUDIO_TIMING was enabled when it was opened. Underruns and
+ * overruns come from the audio driver; drivers that can't report them
+ * leave those counters at zero.
+ *
+ * The counters start at zero when the device is opened. They are updated
+ * once per callback run, so they trail the audio thread by up to one run.
+ *
+ * \param dev the device ID to query
+ * \param timing an SDL_AudioTimingStats structure filled in with the timing
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_GetAudioDeviceStats
+ * \sa SDL_HINT_AUDIO_TIMING
+ * \sa SDL_HINT_AUDIO_TIMING_LOG_INTERVAL
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioDeviceTiming(SDL_AudioDeviceID dev, SDL_AudioTimingStats * timing);
+
+/**
+ * Get when the audio handed to a capture callback was captured.
+ *
+ * Called from a capture device's callback, this returns the
+ * SDL_GetPerformanceCounter() time at which the first sample frame of the
+ * buffer being delivered was captured, as far as the audio driver can tell.
+ * Elsewhere, it returns that time for the last buffer delivered. With
+ * SDL_DequeueAudio(), that buffer is the newest data in the queue, the last
+ * `spec.size` bytes of what SDL_GetQueuedAudioSize() reports.
+ *
+ * \param dev the ID of a capture device
+ * \returns the performance counter value, or 0 if nothing was captured yet
+ *          or on error; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_GetPerformanceCounter
+ * \sa SDL_HINT_AUDIO_CAPTURE_LOW_LATENCY
+ */
+extern DECLSPEC Uint64 SDLCALL SDL_GetAudioCaptureTimestamp(SDL_AudioDeviceID dev);
+
+/**
+ * How far an audio device's playback had got, and when.
+ *
+ * \sa SDL_GetAudioDeviceClock
+ */
+typedef struct SDL_AudioClock
+{
+    Uint64 frames;      /**< Sample frames played since the device was opened */
+    Uint64 timestamp;   /**< SDL_GetPerformanceCounter() when frames was measured, or 0 if nothing has played yet */
+    Uint32 delay;       /**< Sample frames handed to the device but not played yet, at that time */
+    int freq;           /**< The device's sample frames per second */
+} SDL_AudioClock;
+
+/**
+ * Get the playback position of an audio device.
+ *
+ * Each time the audio thread hands a buffer to the device, it measures how
+ * many sample frames have been played: all frames written so far, less the
+ * ones the device reports as still waiting to be played. Between
+ * measurements playback carries on at `freq` frames per second, though
+ * never past what was written, so the frame playing now is
+ *
+ * ```c
+ * Uint64 elapsed = SDL_GetPerformanceCounter() - clock.timestamp;
+ * Uint64 ahead = elapsed * clock.freq / SDL_GetPerformanceFrequency();
+ * Uint64 now = clock.frames + SDL_min(ahead, clock.delay);
+ * ```
+ *
+ * Frames are counted at the device's rate. When SDL resamples between the
+ * rate the device was opened with and the rate the hardware runs at, scale
+ * by the ratio of the two. Every frame the device plays counts, including
+ * silence while it's paused or its queue has run dry. Audio still buffered
+ * inside SDL, such as data queued with SDL_QueueAudio(), hasn't reached the
+ * device yet and isn't counted. A driver that can't tell how much is waiting
+ * counts frames as played as soon as they are written.
+ *
+ * \param dev the ID of a playback device
+ * \param clock an SDL_AudioClock structure filled in with the position
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_GetPerformanceCounter
+ * \sa SDL_GetAudioCaptureTimestamp
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioDeviceClock(SDL_AudioDeviceID dev, SDL_AudioClock * clock);
+
 
 /**
  *  \name Audio lock functions
@@ -206,6 +206,8 @@
 #cmakedefine HAVE_GETAUXVAL 1
 #cmakedefine HAVE_ELF_AUX_INFO 1
 #cmakedefine HAVE_POLL 1
+#cmakedefine HAVE_MMAP 1
+#cmakedefine HAVE_MADVISE 1
 #cmakedefine HAVE__EXIT 1
 
 #else
@@ -523,6 +525,10 @@
 #cmakedefine SDL_ARM_SIMD_BLITTERS @SDL_ARM_SIMD_BLITTERS@
 #cmakedefine SDL_ARM_NEON_BLITTERS @SDL_ARM_NEON_BLITTERS@
 
+/* Enable the thread-caching allocator front end */
+#cmakedefine SDL_MALLOC_CACHE 1
+#define SDL_MALLOC_CACHE_BIG_BUDGET @SDL_MALLOC_CACHE_BIG_BUDGET@
+
 /* Whether SDL_DYNAMIC_API needs dlopen */
 #cmakedefine DYNAPI_NEEDS_DLOPEN  @DYNAPI_NEEDS_DLOPEN@
 
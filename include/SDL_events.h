@@ -162,6 +162,9 @@ typedef enum
     SDL_RENDER_TARGETS_RESET = 0x2000, /**< The render targets have been reset and their contents need to be updated */
     SDL_RENDER_DEVICE_RESET, /**< The device has been reset and all textures need to be recreated */
 
+    /* Asynchronous loading events */
+    SDL_ASYNCLOADCOMPLETE = 0x2100, /**< An asynchronous load has finished, see SDL_LoadFileAsync() */
+
     /* Internal events */
     SDL_POLLSENTINEL = 0x7F00, /**< Signals the end of an event poll cycle */
 
@@ -193,6 +193,22 @@ extern "C" {
  */
 #define SDL_HINT_APPLE_TV_REMOTE_ALLOW_ROTATION "SDL_APPLE_TV_REMOTE_ALLOW_ROTATION"
 
+/**
+ *  \brief  A variable controlling whether audio capture favors latency over efficiency.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Capture in device buffers the size of the callback's (default)
+ *    "1"       - Capture in small pieces as soon as the device has them, and
+ *                keep reading while the device is paused, so the callback gets
+ *                its audio as soon as possible after it was captured
+ *
+ *  Only the OSS driver captures any differently, using fragments an eighth
+ *  of the callback's buffer. SDL_GetAudioCaptureTimestamp() works either way.
+ *
+ *  This hint is read when a capture device is opened.
+ */
+#define SDL_HINT_AUDIO_CAPTURE_LOW_LATENCY "SDL_AUDIO_CAPTURE_LOW_LATENCY"
+
 /**
  *  \brief  A variable controlling the audio category on iOS and Mac OS X
  *
@@ -268,6 +284,55 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_DEVICE_STREAM_ROLE "SDL_AUDIO_DEVICE_STREAM_ROLE"
 
+/**
+ *  \brief  A variable controlling whether SDL_BuildAudioCVT() uses fused conversion kernels.
+ *
+ *  A few common conversions, such as S16 mono to stereo or S16 upsampling,
+ *  can run as a single pass over the data instead of a chain of filters.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Always use the chain of filters
+ *    "1"       - Use a single pass where there is one for the conversion (default)
+ *
+ *  Both give the same output, except that on NEON builds the chain may turn
+ *  full-scale negative samples into -32767 rather than -32768, so this is
+ *  mostly useful for comparing the two.
+ *
+ *  This hint is read when the conversion is built.
+ */
+#define SDL_HINT_AUDIO_FUSED_CONVERSION "SDL_AUDIO_FUSED_CONVERSION"
+
+/**
+ *  \brief  A variable controlling how much audio the queue of a device opened without a callback preallocates, in milliseconds.
+ *
+ *  SDL_QueueAudio() and the audio thread pass data through a ring buffer
+ *  without locking each other out, as long as the data fits. The ring is
+ *  rounded up to a power of two bytes. By default it holds two device buffers.
+ *  A playback queue gets room for one more device buffer on top, for the one
+ *  the device may be playing straight out of it.
+ *
+ *  This hint is read when the device is opened.
+ */
+#define SDL_HINT_AUDIO_QUEUE_CAPACITY "SDL_AUDIO_QUEUE_CAPACITY"
+
+/**
+ *  \brief  A variable controlling what SDL_QueueAudio() does when the queue is full.
+ *
+ *  This variable can be set to the following values:
+ *    "grow"  - Reallocate the queue bigger, holding the device lock while the
+ *              queued data is moved (default)
+ *    "block" - Wait for the device to play enough of the queue. A paused
+ *              device grows the queue instead
+ *    "drop"  - Queue nothing and return an error; SDL_QueueAudio() can be
+ *              called again later
+ *
+ *  A capture device's queue only grows if SDL_DequeueAudio() isn't running
+ *  at that moment; otherwise the captured data that doesn't fit is dropped.
+ *
+ *  This hint is read when the device is opened.
+ */
+#define SDL_HINT_AUDIO_QUEUE_OVERFLOW "SDL_AUDIO_QUEUE_OVERFLOW"
+
 /**
  *  \brief  A variable controlling speed/quality tradeoff of audio resampling.
  *
@@ -291,6 +356,30 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_RESAMPLING_MODE   "SDL_AUDIO_RESAMPLING_MODE"
 
+/**
+ *  \brief  A variable controlling whether audio devices time their audio thread.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Don't time anything (default)
+ *    "1"       - Time the callback, conversion and the device for every period,
+ *                so SDL_GetAudioDeviceTiming() can report them
+ *
+ *  This hint is read when the device is opened.
+ */
+#define SDL_HINT_AUDIO_TIMING "SDL_AUDIO_TIMING"
+
+/**
+ *  \brief  A variable controlling how often timed audio devices log their timing.
+ *
+ *  If set to a number of milliseconds, every device opened with
+ *  SDL_HINT_AUDIO_TIMING enabled logs a summary of its timing with
+ *  SDL_Log(), from its audio thread, that often. By default nothing is
+ *  logged.
+ *
+ *  This hint is read when the device is opened.
+ */
+#define SDL_HINT_AUDIO_TIMING_LOG_INTERVAL "SDL_AUDIO_TIMING_LOG_INTERVAL"
+
 /**
  *  \brief  A variable controlling whether SDL updates joystick state when getting input events
  *
@@ -607,6 +696,20 @@ extern "C" {
  */
 #define SDL_HINT_IOS_HIDE_HOME_INDICATOR "SDL_IOS_HIDE_HOME_INDICATOR"
 
+/**
+ *  \brief  A variable controlling the number of worker threads used by the job system.
+ *
+ *  The thread that waits on a job helps to run queued work, so by default
+ *  one worker is started for each CPU except one. Setting this variable to
+ *  "0" runs every job on the thread that submits it.
+ *
+ *  On Linux each worker is pinned to its own CPU, skipping the first one.
+ *
+ *  This hint is read when the job system first starts, the first time a job
+ *  is created.
+ */
+#define SDL_HINT_JOB_WORKERS "SDL_JOB_WORKERS"
+
 /**
  *  \brief  A variable that lets you enable joystick (and gamecontroller) events even when your app is in the background.
  *
@@ -1483,6 +1586,21 @@ extern "C" {
  */
 #define SDL_HINT_RPI_VIDEO_LAYER           "SDL_RPI_VIDEO_LAYER"
 
+/**
+ * \brief A variable controlling whether SDL_RWFromFile() memory-maps files opened for reading
+ *
+ * This variable can be set to the following values:
+ *   "0"       - Files are always read through stdio (default)
+ *   "1"       - Regular files of 64 KB or more opened with mode "r" or "rb" are memory-mapped
+ *
+ * Mapping avoids a copy through the stdio buffer and lets the kernel read
+ * ahead, which helps most when the file isn't in the page cache yet. For
+ * files that are, setting up the mapping can cost more than it saves.
+ *
+ * The value of this hint is used at runtime, so it can be changed at any time.
+ */
+#define SDL_HINT_RWOPS_MMAP "SDL_RWOPS_MMAP"
+
 /**
  *  \brief Specify an "activity name" for screensaver inhibition.
  *
@@ -1569,6 +1687,17 @@ extern "C" {
  */
 #define SDL_HINT_TIMER_RESOLUTION "SDL_TIMER_RESOLUTION"
 
+/**
+ *  \brief A variable that controls how long SDL_DelayUntil() busy-waits, in microseconds.
+ *
+ *  SDL_DelayUntil() and SDL_DelayPeriodic() sleep until this many
+ *  microseconds before the deadline and spin for the remainder, trading
+ *  CPU time for wakeup precision.
+ *
+ *  The default value is "0", which never spins. This hint may be set at any time.
+ */
+#define SDL_HINT_TIMER_SPIN_THRESHOLD "SDL_TIMER_SPIN_THRESHOLD"
+
 /**
  *  \brief  A variable controlling whether touch events should generate synthetic mouse events
  *
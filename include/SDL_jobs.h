@@ -0,0 +1,196 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_jobs_h_
+#define SDL_jobs_h_
+
+/**
+ *  \file SDL_jobs.h
+ *
+ *  Header for the SDL job system.
+ *
+ *  Jobs run on a pool of worker threads, one per CPU by default (see
+ *  SDL_HINT_JOB_WORKERS). Each worker keeps its own queue and steals from
+ *  the others when it runs dry. A thread waiting for a job runs queued work
+ *  in the meantime, so jobs may create and wait for other jobs.
+ *
+ *  The pool is started the first time it is needed and stopped by SDL_Quit().
+ */
+
+#include "SDL_stdinc.h"
+#include "SDL_error.h"
+
+#include "begin_code.h"
+/* Set up for C function definitions, even when using C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The function run by a job.
+ *
+ * \param userdata what was passed as `userdata` to SDL_CreateJob()
+ */
+typedef void (SDLCALL * SDL_JobFunction) (void *userdata);
+
+/**
+ * The function run by SDL_ParallelFor() on each piece of the range.
+ *
+ * \param userdata what was passed as `userdata` to SDL_ParallelFor()
+ * \param start the first index of this piece
+ * \param end one past the last index of this piece
+ */
+typedef void (SDLCALL * SDL_ParallelForFunction) (void *userdata, int start, int end);
+
+/* The SDL job structure, defined in SDL_jobs.c */
+struct SDL_Job;
+typedef struct SDL_Job SDL_Job;
+
+/**
+ * Create a job.
+ *
+ * The job does not run until it is passed to SDL_SubmitJob(). Before that,
+ * SDL_AddJobDependency() may be used to make it wait for other jobs.
+ *
+ * Every job must eventually be passed to either SDL_WaitJob() or
+ * SDL_DetachJob() to release it.
+ *
+ * \param fn the function to run
+ * \param userdata a pointer that is passed to `fn`
+ * \returns the new job, or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_AddJobDependency
+ * \sa SDL_SubmitJob
+ * \sa SDL_WaitJob
+ */
+extern DECLSPEC SDL_Job *SDLCALL SDL_CreateJob(SDL_JobFunction fn, void *userdata);
+
+/**
+ * Make a job wait for another job to finish before it runs.
+ *
+ * This must be called before `job` is submitted. `dependency` may be in any
+ * state; if it has already finished, this does nothing.
+ *
+ * \param job the job that should wait
+ * \param dependency the job to wait for
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_CreateJob
+ * \sa SDL_SubmitJob
+ */
+extern DECLSPEC int SDLCALL SDL_AddJobDependency(SDL_Job *job, SDL_Job *dependency);
+
+/**
+ * Queue a job to run once all of its dependencies have finished.
+ *
+ * A job may only be submitted once. If the job system has no worker
+ * threads, a job that is ready runs immediately on the calling thread.
+ *
+ * \param job the job to submit
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_CreateJob
+ * \sa SDL_WaitJob
+ */
+extern DECLSPEC int SDLCALL SDL_SubmitJob(SDL_Job *job);
+
+/**
+ * Wait for a submitted job to finish, and release it.
+ *
+ * While waiting, the calling thread runs other queued jobs. The job must
+ * have been submitted, or this will never return.
+ *
+ * \param job the job to wait for
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_DetachJob
+ * \sa SDL_SubmitJob
+ */
+extern DECLSPEC void SDLCALL SDL_WaitJob(SDL_Job *job);
+
+/**
+ * Release a job without waiting for it.
+ *
+ * The job still runs once it has been submitted and its dependencies have
+ * finished, and is freed automatically afterwards. The pointer must not be
+ * used after this call.
+ *
+ * \param job the job to release
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_WaitJob
+ */
+extern DECLSPEC void SDLCALL SDL_DetachJob(SDL_Job *job);
+
+/**
+ * Run a function over a range of indices, split across the job workers.
+ *
+ * The range `[start, end)` is cut into pieces of `grain` indices, and `fn`
+ * is called once for each piece, from any thread, in no particular order.
+ * The calling thread takes part and this function returns when every piece
+ * has been processed.
+ *
+ * \param start the first index of the range
+ * \param end one past the last index of the range
+ * \param grain the number of indices to process per call of `fn`, or 0 to
+ *              pick a size from the number of workers
+ * \param fn the function to run on each piece
+ * \param userdata a pointer that is passed to `fn`
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ */
+extern DECLSPEC int SDLCALL SDL_ParallelFor(int start, int end, int grain, SDL_ParallelForFunction fn, void *userdata);
+
+/**
+ * Get the number of worker threads in the job system.
+ *
+ * This starts the job system if it isn't running yet. The thread waiting
+ * for a job also runs work, so up to one more thread than this may be
+ * busy with jobs at a time.
+ *
+ * \returns the number of worker threads, which may be 0.
+ *
+ * \since This function is available since SDL 2.26.5.
+ */
+extern DECLSPEC int SDLCALL SDL_GetJobWorkerCount(void);
+
+/* Ends C function definitions when using C++ */
+#ifdef __cplusplus
+}
+#endif
+#include "close_code.h"
+
+#endif /* SDL_jobs_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -565,6 +565,29 @@ extern DECLSPEC Uint32 SDLCALL SDL_MapRGBA(const SDL_PixelFormat * format,
                                            Uint8 r, Uint8 g, Uint8 b,
                                            Uint8 a);
 
+/**
+ * Map an array of colors to pixel values for a given pixel format.
+ *
+ * This gives the same results as calling SDL_MapRGBA() on each color, but
+ * examines the format only once, so it is much cheaper when mapping many
+ * colors at a time.
+ *
+ * \param format an SDL_PixelFormat structure describing the format of the
+ *               pixels
+ * \param colors an array of colors to map
+ * \param pixels an array of `count` values filled in with the pixel values
+ * \param count the number of colors to map
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_MapRGBA
+ */
+extern DECLSPEC int SDLCALL SDL_MapColors(const SDL_PixelFormat * format,
+                                          const SDL_Color * colors,
+                                          Uint32 * pixels, int count);
+
 /**
  * Get RGB values from a pixel in the specified format.
  *
@@ -565,6 +565,48 @@ extern DECLSPEC int SDLCALL SDL_SetTextureUserData(SDL_Texture * texture,
  */
 extern DECLSPEC void * SDLCALL SDL_GetTextureUserData(SDL_Texture * texture);
 
+/**
+ * The cost of drawing a texture with and without RLE acceleration.
+ *
+ * Times are in performance counter ticks, see SDL_GetPerformanceFrequency().
+ *
+ * \sa SDL_GetTextureRLEStats
+ */
+typedef struct SDL_TextureRLEStats
+{
+    SDL_bool rle;           /**< SDL_TRUE if copies of the texture may currently use RLE */
+    Uint32 rle_copies;      /**< Copies drawn from the RLE encoding */
+    Uint64 rle_pixels;      /**< Pixels drawn by those copies */
+    Uint64 rle_ticks;       /**< Time spent in those copies */
+    Uint32 plain_copies;    /**< Copies drawn with the regular blitters */
+    Uint64 plain_pixels;    /**< Pixels drawn by those copies */
+    Uint64 plain_ticks;     /**< Time spent in those copies */
+    Uint32 encodes;         /**< Copies that had to RLE encode the texture first */
+    Uint64 encode_ticks;    /**< Time spent in those copies, including the encoding */
+} SDL_TextureRLEStats;
+
+/**
+ * Get statistics on drawing a texture with and without RLE acceleration.
+ *
+ * The software renderer draws static textures without an alpha channel
+ * through RLE when that is possible, and measures what unscaled copies of
+ * each texture cost. After a few copies with RLE and a few without, it
+ * keeps drawing the texture the way that was cheaper per pixel, counting
+ * the time spent encoding against RLE. A texture that has to be encoded
+ * again for most of its RLE copies stops using RLE without the second half
+ * of the trial. Textures that keep RLE hold their original pixels next to
+ * the encoding.
+ *
+ * \param texture the texture to query.
+ * \param stats a pointer filled in with the statistics of the texture.
+ * \returns 0 on success, or -1 if the texture is not valid or its renderer
+ *          doesn't use RLE; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ */
+extern DECLSPEC int SDLCALL SDL_GetTextureRLEStats(SDL_Texture * texture,
+                                                   SDL_TextureRLEStats *stats);
+
 /**
  * Update the given texture rectangle with new pixel data.
  *
@@ -45,6 +45,7 @@ extern "C" {
 #define SDL_RWOPS_JNIFILE   3U  /**< Android asset */
 #define SDL_RWOPS_MEMORY    4U  /**< Memory stream */
 #define SDL_RWOPS_MEMORY_RO 5U  /**< Read-Only memory stream */
+#define SDL_RWOPS_MAPPED    6U  /**< Read-only memory-mapped file */
 
 /**
  * This is the read/write operation structure -- very basic.
@@ -166,6 +167,9 @@ typedef struct SDL_RWops
  * As a fallback, SDL_RWFromFile() will transparently open a matching filename
  * in an Android app's `assets`.
  *
+ * If SDL_HINT_RWOPS_MMAP is set to "1", regular files of 64 KB or more opened
+ * with mode "r" or "rb" are mapped as if by SDL_RWFromMappedFile().
+ *
  * Closing the SDL_RWops will close the file handle SDL is holding internally.
  *
  * \param file a UTF-8 string representing the filename to open
@@ -296,6 +300,29 @@ extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromMem(void *mem, int size);
 extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromConstMem(const void *mem,
                                                       int size);
 
+/**
+ * Use this function to open a file for reading through a memory mapping.
+ *
+ * The whole file is mapped read-only and reads are copies straight out of
+ * the page cache, with no stdio buffering in between. The kernel is told the
+ * file will be read sequentially and soon, so it can start reading ahead.
+ *
+ * Attempting to write to this RWops stream will report an error. The file
+ * should not be truncated while it is open.
+ *
+ * \param file a UTF-8 string representing the filename to open
+ * \returns a pointer to a new SDL_RWops structure, or NULL if it fails; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_RWclose
+ * \sa SDL_RWFromFile
+ * \sa SDL_RWread
+ * \sa SDL_RWseek
+ */
+extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromMappedFile(const char *file);
+
 /* @} *//* RWFrom functions */
 
 
@@ -439,6 +439,40 @@ extern DECLSPEC int SDLCALL SDL_SetMemoryFunctions(SDL_malloc_func malloc_func,
  */
 extern DECLSPEC int SDLCALL SDL_GetNumAllocations(void);
 
+/**
+ * Allocation statistics for one size class of SDL's allocator.
+ *
+ * \sa SDL_GetMemoryClassStats
+ */
+typedef struct SDL_MemoryClassStats
+{
+    size_t block_size;  /**< Largest request served by this class, 0 for the large block class */
+    int live;           /**< Blocks of this class currently allocated */
+    int cached;         /**< Free blocks held in the shared cache, not counting per-thread caches */
+    int allocations;    /**< Allocations served by this class since startup */
+} SDL_MemoryClassStats;
+
+/**
+ * Get live allocation statistics by size class.
+ *
+ * This is only available when SDL was built with the thread-caching
+ * allocator front end (the SDL_MALLOC_CACHE build option), and only
+ * covers memory allocated through SDL's original memory functions.
+ *
+ * The last class always describes allocations too big for any size class.
+ *
+ * \param stats an array to be filled in with the statistics of each class
+ * \param maxstats the number of elements in `stats`
+ * \returns the total number of size classes, which may be more than
+ *          `maxstats`, or -1 if the allocator doesn't keep statistics; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_GetNumAllocations
+ */
+extern DECLSPEC int SDLCALL SDL_GetMemoryClassStats(SDL_MemoryClassStats *stats, int maxstats);
+
 extern DECLSPEC char *SDLCALL SDL_getenv(const char *name);
 extern DECLSPEC int SDLCALL SDL_setenv(const char *name, const char *value, int overwrite);
 
@@ -354,6 +354,41 @@ extern DECLSPEC SDL_Surface *SDLCALL SDL_LoadBMP_RW(SDL_RWops * src,
  */
 #define SDL_LoadBMP(file)   SDL_LoadBMP_RW(SDL_RWFromFile(file, "rb"), 1)
 
+/**
+ * Load a BMP image from a seekable SDL data stream into a surface of the
+ * given pixel format.
+ *
+ * This gives the same result as SDL_LoadBMP_RW() followed by
+ * SDL_ConvertSurfaceFormat(), but for uncompressed images the rows are
+ * converted as they are read, without a full size surface in the file's
+ * format in between. A paletted image loaded as the format of the file keeps
+ * its own palette.
+ *
+ * \param src the data stream for the surface
+ * \param freesrc non-zero to close the stream after being read
+ * \param format the SDL_PixelFormatEnum for the new surface, or
+ *               SDL_PIXELFORMAT_UNKNOWN to keep the format of the file
+ * \returns a pointer to a new SDL_Surface structure or NULL if there was an
+ *          error; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_ConvertSurfaceFormat
+ * \sa SDL_FreeSurface
+ * \sa SDL_LoadBMP_RW
+ */
+extern DECLSPEC SDL_Surface *SDLCALL SDL_LoadBMPFormat_RW(SDL_RWops * src,
+                                                          int freesrc,
+                                                          Uint32 format);
+
+/**
+ * Load a surface of the given pixel format from a file.
+ *
+ * Convenience macro.
+ */
+#define SDL_LoadBMPFormat(file, format) \
+        SDL_LoadBMPFormat_RW(SDL_RWFromFile(file, "rb"), 1, format)
+
 /**
  * Save a surface to a seekable SDL data stream in BMP format.
  *
@@ -727,7 +762,9 @@ extern DECLSPEC int SDLCALL SDL_ConvertPixels(int width, int height,
  *
  * This is safe to use with src == dst, but not for other overlapping areas.
  *
- * This function is currently only implemented for SDL_PIXELFORMAT_ARGB8888.
+ * This function is currently only implemented for SDL_PIXELFORMAT_ARGB8888,
+ * SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGBA8888 and
+ * SDL_PIXELFORMAT_BGRA8888, with `dst_format` the same as `src_format`.
  *
  * \param width the width of the block to convert, in pixels
  * \param height the height of the block to convert, in pixels
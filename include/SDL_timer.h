@@ -146,6 +146,60 @@ extern DECLSPEC Uint64 SDLCALL SDL_GetPerformanceFrequency(void);
  */
 extern DECLSPEC void SDLCALL SDL_Delay(Uint32 ms);
 
+/**
+ * Wait until the high resolution counter reaches a deadline.
+ *
+ * Unlike SDL_Delay(), the deadline is absolute and has the resolution of
+ * SDL_GetPerformanceCounter(), so repeated waits do not accumulate rounding
+ * or scheduling error. Where available the wait is done with an absolute
+ * monotonic sleep; if SDL_HINT_TIMER_SPIN_THRESHOLD is set, the last
+ * stretch before the deadline is busy-waited to hide wakeup latency.
+ *
+ * If the deadline has already passed, this function returns immediately.
+ *
+ * \param deadline the SDL_GetPerformanceCounter() value to wait for
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_DelayPeriodic
+ * \sa SDL_GetPerformanceCounter
+ */
+extern DECLSPEC void SDLCALL SDL_DelayUntil(Uint64 deadline);
+
+/**
+ * Wait for the next tick of a fixed period, for frame pacing.
+ *
+ * `deadline` holds the SDL_GetPerformanceCounter() value of the next tick
+ * and should be initialized to 0; the first call then starts the period
+ * from the current time. Each call waits for the tick with SDL_DelayUntil()
+ * and advances `deadline` by `period`. If the caller has fallen more than
+ * a whole period behind, the schedule restarts from the current time
+ * rather than returning immediately for every missed tick.
+ *
+ * For example, to run a loop at 60 Hz:
+ *
+ * ```c
+ * const Uint64 period = SDL_GetPerformanceFrequency() / 60;
+ * Uint64 deadline = 0;
+ * while (running) {
+ *     // ... update and render a frame
+ *     SDL_DelayPeriodic(&deadline, period);
+ * }
+ * ```
+ *
+ * \param deadline a pointer to the counter value of the next tick, updated
+ *                 on return
+ * \param period the length of the period, in SDL_GetPerformanceCounter()
+ *               units
+ * \returns the SDL_GetPerformanceCounter() value when the wait finished.
+ *
+ * \since This function is available since SDL 2.26.5.
+ *
+ * \sa SDL_DelayUntil
+ * \sa SDL_GetPerformanceFrequency
+ */
+extern DECLSPEC Uint64 SDLCALL SDL_DelayPeriodic(Uint64 *deadline, Uint64 period);
+
 /**
  * Function prototype for the timer callback function.
  *
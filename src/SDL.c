@@ -33,6 +33,9 @@
 #include "SDL_assert_c.h"
 #include "SDL_log_c.h"
 #include "events/SDL_events_c.h"
+#include "file/SDL_asyncload_c.h"
+#include "stdlib/SDL_malloc_c.h"
+#include "thread/SDL_jobs_c.h"
 
 /* Initialization/Cleanup routines */
 #if !SDL_TIMERS_DISABLED
@@ -320,6 +323,11 @@ SDL_Quit(void)
 {
     SDL_bInMainQuit = SDL_TRUE;
 
+    /* Finish background loads and jobs first: they can still push
+       completion events or touch subsystem state. */
+    SDL_QuitAsyncLoad();
+    SDL_QuitJobs();
+
     /* Quit all subsystems */
     SDL_QuitSubSystem(SDL_INIT_EVERYTHING);
 
@@ -343,6 +351,8 @@ SDL_Quit(void)
 
     SDL_TLSCleanup();
 
+    SDL_QuitMemoryCache();
+
     SDL_bInMainQuit = SDL_FALSE;
 }
 
@@ -277,8 +277,5 @@ SDL_DUMMY(Uint16, SDL_JoystickGetFirmwareVersion, (SDL_Joystick * a), -1)
 SDL_DUMMY_VOID(SDL_GetJoystickGUIDInfo, (SDL_JoystickGUID a, Uint16 *b, Uint16 *c, Uint16 *d, Uint16 *e))
 SDL_DUMMY(int, SDL_GameControllerGetSensorDataWithTimestamp, (SDL_GameController * a, SDL_SensorType b, Uint64 *c, float *d, int e), -1)
 SDL_DUMMY(int, SDL_SensorGetDataWithTimestamp, (SDL_Sensor * a, Uint64 *b, float *c, int d), -1)
-SDL_DUMMY(SDL_YUV_CONVERSION_MODE,SDL_GetYUVConversionMode,(void),SDL_YUV_CONVERSION_AUTOMATIC)
-SDL_DUMMY(SDL_YUV_CONVERSION_MODE,SDL_GetYUVConversionModeForResolution,(int a, int b),SDL_YUV_CONVERSION_AUTOMATIC)
-SDL_DUMMY_VOID(SDL_SetYUVConversionMode,(SDL_YUV_CONVERSION_MODE a))
 
 #undef SDL_DUMMY
@@ -0,0 +1,234 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "./SDL_internal.h"
+
+#include "SDL.h"
+#include "./SDL_ringbuffer.h"
+
+/* The positions run freely and wrap at 32 bits; their difference is the
+   amount of data, which stays right as long as the ring is no bigger than this. */
+#define SDL_RINGBUFFER_MAXLEN (((size_t) 1) << 30)
+
+struct SDL_RingBuffer
+{
+    Uint8 *data;
+    Uint32 mask;  /* ring size - 1 */
+    volatile Uint32 writepos;  /* only the writer moves this. */
+    volatile Uint32 readpos;  /* only the reader moves this. */
+};
+
+static Uint32
+RingBufferLength(const size_t minlen)
+{
+    Uint32 len = 64;
+    while (len < minlen) {
+        len <<= 1;
+    }
+    return len;
+}
+
+SDL_RingBuffer *
+SDL_NewRingBuffer(const size_t minlen)
+{
+    SDL_RingBuffer *ring;
+    Uint32 len;
+
+    if (minlen > SDL_RINGBUFFER_MAXLEN) {
+        SDL_SetError("Ring buffer too large");
+        return NULL;
+    }
+
+    ring = (SDL_RingBuffer *) SDL_calloc(1, sizeof (SDL_RingBuffer));
+    if (!ring) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    len = RingBufferLength(minlen);
+    ring->data = (Uint8 *) SDL_SIMDAlloc(len);  /* aligned, so writers can convert in place with SIMD. */
+    if (!ring->data) {
+        SDL_free(ring);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    ring->mask = len - 1;
+    return ring;
+}
+
+void
+SDL_FreeRingBuffer(SDL_RingBuffer *ring)
+{
+    if (ring) {
+        SDL_SIMDFree(ring->data);
+        SDL_free(ring);
+    }
+}
+
+void
+SDL_ClearRingBuffer(SDL_RingBuffer *ring)
+{
+    if (ring) {
+        ring->readpos = ring->writepos = 0;
+    }
+}
+
+/* copies up to len bytes starting at pos, without moving either position. */
+static void
+CopyFromRingBuffer(SDL_RingBuffer *ring, Uint32 pos, Uint8 *buf, size_t len)
+{
+    const Uint32 offset = pos & ring->mask;
+    const size_t cpy = SDL_min(len, (size_t) (ring->mask + 1 - offset));
+
+    SDL_memcpy(buf, ring->data + offset, cpy);
+    SDL_memcpy(buf + cpy, ring->data, len - cpy);
+}
+
+int
+SDL_ResizeRingBuffer(SDL_RingBuffer *ring, const size_t minlen)
+{
+    const size_t count = SDL_CountRingBuffer(ring);
+    Uint32 len;
+    Uint8 *data;
+
+    if (minlen <= (size_t) ring->mask + 1) {
+        return 0;  /* already big enough. */
+    } else if (minlen > SDL_RINGBUFFER_MAXLEN) {
+        return SDL_SetError("Ring buffer too large");
+    }
+
+    len = RingBufferLength(minlen);
+    data = (Uint8 *) SDL_SIMDAlloc(len);
+    if (!data) {
+        return SDL_OutOfMemory();
+    }
+
+    /* straighten the data out at the start of the new ring. */
+    CopyFromRingBuffer(ring, ring->readpos, data, count);
+    SDL_SIMDFree(ring->data);
+    ring->data = data;
+    ring->mask = len - 1;
+    ring->readpos = 0;
+    ring->writepos = (Uint32) count;
+    return 0;
+}
+
+size_t
+SDL_CountRingBuffer(SDL_RingBuffer *ring)
+{
+    return ring ? (size_t) (ring->writepos - ring->readpos) : 0;
+}
+
+size_t
+SDL_RingBufferSpace(SDL_RingBuffer *ring)
+{
+    return ring ? ((size_t) ring->mask + 1) - SDL_CountRingBuffer(ring) : 0;
+}
+
+void *
+SDL_ReserveRingBuffer(SDL_RingBuffer *ring, size_t *len)
+{
+    const Uint32 writepos = ring->writepos;
+    const Uint32 readpos = ring->readpos;
+    const Uint32 offset = writepos & ring->mask;
+    const size_t space = ((size_t) ring->mask + 1) - (size_t) (writepos - readpos);
+
+    SDL_MemoryBarrierAcquire();  /* the reader is done with anything before readpos. */
+    *len = SDL_min(space, (size_t) (ring->mask + 1 - offset));
+    return ring->data + offset;
+}
+
+void
+SDL_CommitRingBuffer(SDL_RingBuffer *ring, const size_t len)
+{
+    SDL_assert(len <= SDL_RingBufferSpace(ring));
+    SDL_MemoryBarrierRelease();  /* the data lands before the reader can see it. */
+    ring->writepos += (Uint32) len;
+}
+
+const void *
+SDL_PeekRingBuffer(SDL_RingBuffer *ring, size_t *len)
+{
+    return SDL_PeekRingBufferAt(ring, 0, len);
+}
+
+const void *
+SDL_PeekRingBufferAt(SDL_RingBuffer *ring, const size_t skip, size_t *len)
+{
+    const Uint32 readpos = ring->readpos + (Uint32) skip;
+    const Uint32 writepos = ring->writepos;
+    const Uint32 offset = readpos & ring->mask;
+    const size_t count = (size_t) (writepos - readpos);
+
+    SDL_assert(skip <= (size_t) (writepos - ring->readpos));
+    SDL_MemoryBarrierAcquire();  /* the writer's data up to writepos is visible. */
+    *len = SDL_min(count, (size_t) (ring->mask + 1 - offset));
+    return ring->data + offset;
+}
+
+void
+SDL_ConsumeRingBuffer(SDL_RingBuffer *ring, const size_t len)
+{
+    SDL_assert(len <= SDL_CountRingBuffer(ring));
+    SDL_MemoryBarrierRelease();  /* done reading before the writer can reuse it. */
+    ring->readpos += (Uint32) len;
+}
+
+size_t
+SDL_WriteToRingBuffer(SDL_RingBuffer *ring, const void *_data, const size_t len)
+{
+    const Uint8 *data = (const Uint8 *) _data;
+    size_t written = 0;
+
+    while (written < len) {
+        size_t avail;
+        Uint8 *ptr = (Uint8 *) SDL_ReserveRingBuffer(ring, &avail);
+        const size_t cpy = SDL_min(len - written, avail);
+        if (!cpy) {
+            break;  /* full. */
+        }
+        SDL_memcpy(ptr, data + written, cpy);
+        SDL_CommitRingBuffer(ring, cpy);
+        written += cpy;
+    }
+    return written;
+}
+
+size_t
+SDL_ReadFromRingBuffer(SDL_RingBuffer *ring, void *_buf, const size_t len)
+{
+    Uint8 *buf = (Uint8 *) _buf;
+    size_t total = 0;
+
+    while (total < len) {
+        size_t avail;
+        const Uint8 *ptr = (const Uint8 *) SDL_PeekRingBuffer(ring, &avail);
+        const size_t cpy = SDL_min(len - total, avail);
+        if (!cpy) {
+            break;  /* empty. */
+        }
+        SDL_memcpy(buf + total, ptr, cpy);
+        SDL_ConsumeRingBuffer(ring, cpy);
+        total += cpy;
+    }
+    return total;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,69 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#ifndef SDL_ringbuffer_h_
+#define SDL_ringbuffer_h_
+
+/* A contiguous byte ring with a power-of-two size.
+
+   The ring hands out its memory directly: reserve a region at the write
+   position, fill it, then commit it; peek at the region at the read position,
+   use it, then consume it.  Each region is contiguous, so at the wrap point it
+   is shorter than the total space or data available and you go around again.
+
+   One thread may write while another reads without a lock.  Only clearing and
+   resizing need the caller to keep both sides out. */
+
+struct SDL_RingBuffer;
+typedef struct SDL_RingBuffer SDL_RingBuffer;
+
+/* the size is rounded up to a power of two */
+SDL_RingBuffer *SDL_NewRingBuffer(const size_t minlen);
+void SDL_FreeRingBuffer(SDL_RingBuffer *ring);
+void SDL_ClearRingBuffer(SDL_RingBuffer *ring);
+
+/* grows the ring to hold at least minlen bytes, keeping its data.  Not
+   thread safe.  Returns 0 on success, -1 on error. */
+int SDL_ResizeRingBuffer(SDL_RingBuffer *ring, const size_t minlen);
+
+size_t SDL_CountRingBuffer(SDL_RingBuffer *ring);  /* bytes that can be read */
+size_t SDL_RingBufferSpace(SDL_RingBuffer *ring);  /* bytes that can be written */
+
+/* writer side: *len is set to the number of contiguous bytes that may be
+   written at the returned pointer.  Commit makes (len) of them readable. */
+void *SDL_ReserveRingBuffer(SDL_RingBuffer *ring, size_t *len);
+void SDL_CommitRingBuffer(SDL_RingBuffer *ring, const size_t len);
+
+/* reader side: *len is set to the number of contiguous bytes that may be
+   read at the returned pointer.  Consume gives (len) of them back to the writer. */
+const void *SDL_PeekRingBuffer(SDL_RingBuffer *ring, size_t *len);
+/* the same, (skip) readable bytes past the read position; skip the first
+   region to get the one after the wrap point. */
+const void *SDL_PeekRingBufferAt(SDL_RingBuffer *ring, const size_t skip, size_t *len);
+void SDL_ConsumeRingBuffer(SDL_RingBuffer *ring, const size_t len);
+
+/* copy in and out across the wrap point; these return the number of bytes
+   actually copied, which is less than (len) if the ring is full or empty. */
+size_t SDL_WriteToRingBuffer(SDL_RingBuffer *ring, const void *data, const size_t len);
+size_t SDL_ReadFromRingBuffer(SDL_RingBuffer *ring, void *buf, const size_t len);
+
+#endif /* SDL_ringbuffer_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
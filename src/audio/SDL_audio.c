@@ -143,6 +143,12 @@ get_audio_device(SDL_AudioDeviceID id)
     return open_devices[id];
 }
 
+SDL_AudioDevice *
+SDL_GetAudioDeviceFromID(SDL_AudioDeviceID id)
+{
+    return get_audio_device(id);
+}
+
 
 /* stubs for audio drivers that don't need a specific entry point... */
 static void
@@ -396,6 +402,28 @@ SDL_AddAudioDevice(const SDL_bool iscapture, const char *name, SDL_AudioSpec *sp
     }
 }
 
+/* Wake SDL_WaitAudioQueueSpace() if the playback ring has the room it wants,
+   or (always) if it has to look at why it doesn't, after a pause, disconnect
+   or close. */
+static void
+WakeAudioQueueWaiter(SDL_AudioDevice *device, SDL_bool always)
+{
+    int wanted;
+
+    if (!device->queue_space_sem) {
+        return;  /* capture, or not set for queueing. */
+    }
+
+    /* Adding 0 reads the request with a full barrier, so the room we just
+       made (or the flag we just set) is visible before we look: either we
+       see the request or the waiter sees what we did. */
+    wanted = SDL_AtomicAdd(&device->queue_space_wanted, 0);
+    if (wanted && (always || (SDL_RingBufferSpace(device->buffer_queue) >= (size_t) wanted)) &&
+        SDL_AtomicCAS(&device->queue_space_wanted, wanted, 0)) {
+        SDL_SemPost(device->queue_space_sem);
+    }
+}
+
 /* The audio backends call this when a currently-opened device is lost. */
 void SDL_OpenedAudioDeviceDisconnected(SDL_AudioDevice *device)
 {
@@ -414,6 +442,7 @@ void SDL_OpenedAudioDeviceDisconnected(SDL_AudioDevice *device)
     current_audio.impl.LockDevice(device);
     SDL_AtomicSet(&device->enabled, 0);
     current_audio.impl.UnlockDevice(device);
+    WakeAudioQueueWaiter(device, SDL_TRUE);
 
     /* Post the event, if desired */
     if (SDL_GetEventState(SDL_AUDIODEVICEREMOVED) == SDL_ENABLE) {
@@ -491,6 +520,84 @@ SDL_RemoveAudioDevice(const SDL_bool iscapture, void *handle)
 
 /* buffer queueing support... */
 
+/* Why nothing will take data out of a playback ring, or NULL if something will. */
+static const char *
+GetAudioQueueStall(SDL_AudioDevice *device)
+{
+    if (SDL_AtomicGet(&device->shutdown)) {
+        return "Audio device is closing";
+    } else if (!SDL_AtomicGet(&device->enabled)) {
+        return "Audio device is disconnected";
+    } else if (SDL_AtomicGet(&device->paused)) {
+        return "Audio device is paused";
+    }
+    return NULL;
+}
+
+/* Sleep until len bytes of the playback ring are free; the caller holds
+   queue_wait_lock. Fails if the device is paused, disconnected or closed,
+   before or during the wait, as nothing would make the room. */
+static int
+WaitAudioQueueSpace(SDL_AudioDevice *device, Uint32 len, Uint32 timeout)
+{
+    SDL_RingBuffer *ring = device->buffer_queue;
+    const char *stall;
+    Uint64 deadline = 0;
+    int rc = 0;
+
+    if (timeout != SDL_MUTEX_MAXWAIT) {
+        deadline = SDL_GetTicks64() + timeout;
+    }
+
+    /* Publish what we want (the CAS is a full barrier), then look again, so
+       whoever makes the room or stops the device either sees the request or
+       has already done it. Every wake comes back through here. */
+    while (SDL_RingBufferSpace(ring) < len) {
+        SDL_AtomicCAS(&device->queue_space_wanted, 0, (int) len);
+        stall = GetAudioQueueStall(device);
+        if (!stall && (SDL_RingBufferSpace(ring) < len)) {
+            if (timeout == SDL_MUTEX_MAXWAIT) {
+                rc = SDL_SemWait(device->queue_space_sem);
+            } else {
+                const Uint64 now = SDL_GetTicks64();
+                rc = SDL_SemWaitTimeout(device->queue_space_sem, (now < deadline) ? (Uint32) (deadline - now) : 0);
+            }
+            if (rc == 0) {
+                continue;  /* whoever posted took the request back. */
+            }
+        }
+
+        /* take the request back; if someone beat us to it, collect their post. */
+        if (!SDL_AtomicCAS(&device->queue_space_wanted, (int) len, 0)) {
+            SDL_SemWait(device->queue_space_sem);
+        }
+        if (stall) {
+            return SDL_SetError("%s", stall);
+        } else if (rc < 0) {
+            return rc;
+        } else if (SDL_RingBufferSpace(ring) < len) {
+            return SDL_MUTEX_TIMEDOUT;
+        }
+    }
+    return 0;
+}
+
+/* Keep the audio thread out of the playback ring: take mixer_lock, and if it
+   is playing straight out of the ring, let go of the lock until it's done.
+   The caller holds queue_lock, so nothing else waits for it at once. */
+static void
+LockAudioQueue(SDL_AudioDevice *device)
+{
+    current_audio.impl.LockDevice(device);
+    if (SDL_AtomicCAS(&device->queue_pinned, 1, 3)) {
+        /* it won't pin the ring again until we're done, so this is one wait. */
+        current_audio.impl.UnlockDevice(device);
+        SDL_SemWait(device->queue_unpin_sem);
+        current_audio.impl.LockDevice(device);
+    }
+    SDL_AtomicSet(&device->queue_pinned, 0);
+}
+
 static void SDLCALL
 SDL_BufferQueueDrainCallback(void *userdata, Uint8 *stream, int len)
 {
@@ -502,14 +609,18 @@ SDL_BufferQueueDrainCallback(void *userdata, Uint8 *stream, int len)
     SDL_assert(!device->iscapture);  /* this shouldn't ever happen, right?! */
     SDL_assert(len >= 0);  /* this shouldn't ever happen, right?! */
 
-    dequeued = SDL_ReadFromDataQueue(device->buffer_queue, stream, len);
+    /* SDL_QueueAudio() only ever adds to the ring (or grows it while holding
+       this lock), so this reads it without waiting for the app. */
+    dequeued = SDL_ReadFromRingBuffer(device->buffer_queue, stream, len);
     stream += dequeued;
     len -= (int) dequeued;
 
     if (len > 0) {  /* fill any remaining space in the stream with silence. */
-        SDL_assert(SDL_CountDataQueue(device->buffer_queue) == 0);
+        device->queue_stats.starved++;
         SDL_memset(stream, device->callbackspec.silence, len);
     }
+
+    WakeAudioQueueWaiter(device, SDL_FALSE);
 }
 
 static void SDLCALL
@@ -522,10 +633,85 @@ SDL_BufferQueueFillCallback(void *userdata, Uint8 *stream, int len)
     SDL_assert(device->iscapture);  /* this shouldn't ever happen, right?! */
     SDL_assert(len >= 0);  /* this shouldn't ever happen, right?! */
 
-    /* note that if this needs to allocate more space and run out of memory,
-       we have no choice but to quietly drop the data and hope it works out
-       later, but you probably have bigger problems in this case anyhow. */
-    SDL_WriteToDataQueue(device->buffer_queue, stream, len);
+    /* The ring can only grow while SDL_DequeueAudio() is out of it, and we
+       won't wait for that here. If it can't grow (or runs out of memory), we
+       have no choice but to quietly drop the data and hope it works out later. */
+    if (SDL_RingBufferSpace(device->buffer_queue) < (size_t) len) {
+        device->queue_stats.overflows++;
+        if ((device->queue_overflow == SDL_AUDIOQUEUE_DROP) || (SDL_TryLockMutex(device->queue_lock) != 0)) {
+            return;
+        }
+        if (SDL_ResizeRingBuffer(device->buffer_queue, SDL_CountRingBuffer(device->buffer_queue) + len) == 0) {
+            device->queue_stats.grows++;
+        }
+        SDL_UnlockMutex(device->queue_lock);
+        if (SDL_RingBufferSpace(device->buffer_queue) < (size_t) len) {
+            return;
+        }
+    }
+
+    SDL_WriteToRingBuffer(device->buffer_queue, stream, len);
+    device->queue_stats.high_water = SDL_max(device->queue_stats.high_water, (Uint32) SDL_CountRingBuffer(device->buffer_queue));
+}
+
+/* Add to a playback device's queue; the caller holds queue_lock. The mixer
+   lock is only taken to grow the ring, so the audio thread keeps draining
+   while the data is copied in. */
+static int
+SDL_QueueAudioData(SDL_AudioDevice *device, const Uint8 *data, Uint32 len)
+{
+    SDL_RingBuffer *ring = device->buffer_queue;
+
+    if (SDL_RingBufferSpace(ring) < len) {
+        const Uint32 capacity = (Uint32) (SDL_CountRingBuffer(ring) + SDL_RingBufferSpace(ring));
+        int rc = 0;
+
+        device->queue_stats.overflows++;
+
+        switch (device->queue_overflow) {
+        case SDL_AUDIOQUEUE_DROP:
+            return SDL_SetError("Audio queue is full");
+
+        case SDL_AUDIOQUEUE_BLOCK:
+            /* Write what fits, then sleep until the audio thread has played a
+               period (or made room for the rest) and go again. A paused device
+               won't play anything, so the rest grows the ring instead. */
+            SDL_LockMutex(device->queue_wait_lock);
+            for (;;) {
+                const size_t written = SDL_WriteToRingBuffer(ring, data, len);
+                data += written;
+                len -= (Uint32) written;
+                device->queue_stats.high_water = SDL_max(device->queue_stats.high_water, (Uint32) SDL_CountRingBuffer(ring));
+                if (!len || (SDL_AtomicGet(&device->paused) && !SDL_AtomicGet(&device->shutdown))) {
+                    rc = 0;
+                    break;
+                }
+                rc = WaitAudioQueueSpace(device, SDL_min(SDL_min(len, device->callbackspec.size), capacity), SDL_MUTEX_MAXWAIT);
+                if ((rc < 0) && (!SDL_AtomicGet(&device->paused) || SDL_AtomicGet(&device->shutdown))) {
+                    break;  /* disconnected or closing; a pause goes around to grow. */
+                }
+            }
+            SDL_UnlockMutex(device->queue_wait_lock);
+            if ((rc < 0) || !len) {
+                return rc;
+            }
+            SDL_FALLTHROUGH;
+
+        default:
+            LockAudioQueue(device);
+            rc = SDL_ResizeRingBuffer(ring, SDL_CountRingBuffer(ring) + len);
+            current_audio.impl.UnlockDevice(device);
+            if (rc < 0) {
+                return rc;
+            }
+            device->queue_stats.grows++;
+            break;
+        }
+    }
+
+    SDL_WriteToRingBuffer(ring, data, len);
+    device->queue_stats.high_water = SDL_max(device->queue_stats.high_water, (Uint32) SDL_CountRingBuffer(ring));
+    return 0;
 }
 
 int
@@ -543,11 +729,91 @@ SDL_QueueAudio(SDL_AudioDeviceID devid, const void *data, Uint32 len)
     }
 
     if (len > 0) {
-        current_audio.impl.LockDevice(device);
-        rc = SDL_WriteToDataQueue(device->buffer_queue, data, len);
-        current_audio.impl.UnlockDevice(device);
+        SDL_LockMutex(device->queue_lock);
+        rc = SDL_QueueAudioData(device, (const Uint8 *) data, len);
+        SDL_UnlockMutex(device->queue_lock);
+    }
+
+    return rc;
+}
+
+/* The checks SDL_QueueAudio() makes, for the functions that fill its ring in place. */
+static SDL_AudioDevice *
+get_audio_queue_device(SDL_AudioDeviceID devid)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+
+    if (!device) {
+        return NULL;  /* get_audio_device() will have set the error state */
+    } else if (device->iscapture) {
+        SDL_SetError("This is a capture device, queueing not allowed");
+        return NULL;
+    } else if (device->callbackspec.callback != SDL_BufferQueueDrainCallback) {
+        SDL_SetError("Audio device has a callback, queueing not allowed");
+        return NULL;
+    }
+    return device;
+}
+
+int
+SDL_AcquireAudioQueueBuffer(SDL_AudioDeviceID devid, void **buffer, Uint32 *len)
+{
+    SDL_AudioDevice *device = get_audio_queue_device(devid);
+    size_t avail;
+
+    if (!device) {
+        return -1;
+    } else if (!buffer) {
+        return SDL_InvalidParamError("buffer");
+    } else if (!len) {
+        return SDL_InvalidParamError("len");
+    }
+
+    *buffer = SDL_ReserveRingBuffer(device->buffer_queue, &avail);
+    *len = (Uint32) avail;
+    return 0;
+}
+
+int
+SDL_CommitAudioQueueBuffer(SDL_AudioDeviceID devid, Uint32 len)
+{
+    SDL_AudioDevice *device = get_audio_queue_device(devid);
+    SDL_RingBuffer *ring;
+    size_t avail;
+
+    if (!device) {
+        return -1;
+    }
+
+    ring = device->buffer_queue;
+    SDL_ReserveRingBuffer(ring, &avail);
+    if (len > avail) {
+        return SDL_InvalidParamError("len");
     }
 
+    SDL_CommitRingBuffer(ring, len);
+    device->queue_stats.high_water = SDL_max(device->queue_stats.high_water, (Uint32) SDL_CountRingBuffer(ring));
+    return 0;
+}
+
+int
+SDL_WaitAudioQueueSpace(SDL_AudioDeviceID devid, Uint32 len, Uint32 timeout)
+{
+    SDL_AudioDevice *device = get_audio_queue_device(devid);
+    SDL_RingBuffer *ring;
+    int rc;
+
+    if (!device) {
+        return -1;
+    }
+
+    ring = device->buffer_queue;
+    len = (Uint32) SDL_min(len, SDL_CountRingBuffer(ring) + SDL_RingBufferSpace(ring));
+    len = SDL_max(len, 1);
+
+    SDL_LockMutex(device->queue_wait_lock);
+    rc = WaitAudioQueueSpace(device, len, timeout);
+    SDL_UnlockMutex(device->queue_wait_lock);
     return rc;
 }
 
@@ -564,9 +830,9 @@ SDL_DequeueAudio(SDL_AudioDeviceID devid, void *data, Uint32 len)
         return 0;  /* just report zero bytes dequeued. */
     }
 
-    current_audio.impl.LockDevice(device);
-    rc = (Uint32) SDL_ReadFromDataQueue(device->buffer_queue, data, len);
-    current_audio.impl.UnlockDevice(device);
+    SDL_LockMutex(device->queue_lock);
+    rc = (Uint32) SDL_ReadFromRingBuffer(device->buffer_queue, data, len);
+    SDL_UnlockMutex(device->queue_lock);
     return rc;
 }
 
@@ -584,14 +850,106 @@ SDL_GetQueuedAudioSize(SDL_AudioDeviceID devid)
     if (device->callbackspec.callback == SDL_BufferQueueDrainCallback ||
         device->callbackspec.callback == SDL_BufferQueueFillCallback)
     {
-        current_audio.impl.LockDevice(device);
-        retval = (Uint32) SDL_CountDataQueue(device->buffer_queue);
-        current_audio.impl.UnlockDevice(device);
+        retval = (Uint32) SDL_CountRingBuffer(device->buffer_queue);
     }
 
     return retval;
 }
 
+int
+SDL_GetAudioQueueStats(SDL_AudioDeviceID devid, SDL_AudioQueueStats *stats)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+
+    if (!device) {
+        return -1;  /* get_audio_device() will have set the error state */
+    } else if (!stats) {
+        return SDL_InvalidParamError("stats");
+    } else if (!device->buffer_queue) {
+        return SDL_SetError("Audio device has a callback, queueing not allowed");
+    }
+
+    *stats = device->queue_stats;
+    stats->queued = (Uint32) SDL_CountRingBuffer(device->buffer_queue);
+    stats->capacity = stats->queued + (Uint32) SDL_RingBufferSpace(device->buffer_queue);
+    return 0;
+}
+
+int
+SDL_GetAudioDeviceStats(SDL_AudioDeviceID devid, SDL_AudioDeviceStats *stats)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+
+    if (!device) {
+        return -1;  /* get_audio_device() will have set the error state */
+    } else if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    current_audio.impl.LockDevice(device);
+    *stats = device->stats;
+    current_audio.impl.UnlockDevice(device);
+    return 0;
+}
+
+int
+SDL_GetAudioDeviceTiming(SDL_AudioDeviceID devid, SDL_AudioTimingStats *timing)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+
+    if (!device) {
+        return -1;  /* get_audio_device() will have set the error state */
+    } else if (!timing) {
+        return SDL_InvalidParamError("timing");
+    } else if (!device->timing_enabled) {
+        return SDL_SetError("Audio device wasn't opened with SDL_HINT_AUDIO_TIMING");
+    }
+
+    current_audio.impl.LockDevice(device);
+    *timing = device->timing;
+    current_audio.impl.UnlockDevice(device);
+    return 0;
+}
+
+Uint64
+SDL_GetAudioCaptureTimestamp(SDL_AudioDeviceID devid)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+    Uint64 timestamp;
+
+    if (!device) {
+        return 0;  /* get_audio_device() will have set the error state */
+    } else if (!device->iscapture) {
+        SDL_SetError("Audio device isn't capturing");
+        return 0;
+    }
+
+    current_audio.impl.LockDevice(device);
+    timestamp = device->capture_timestamp;
+    current_audio.impl.UnlockDevice(device);
+    return timestamp;
+}
+
+int
+SDL_GetAudioDeviceClock(SDL_AudioDeviceID devid, SDL_AudioClock *clock)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+
+    if (!device) {
+        return -1;  /* get_audio_device() will have set the error state */
+    } else if (!clock) {
+        return SDL_InvalidParamError("clock");
+    } else if (device->iscapture) {
+        return SDL_SetError("Audio device is capturing");
+    }
+
+    SDL_AtomicLock(&device->clock_lock);
+    *clock = device->clock;
+    SDL_AtomicUnlock(&device->clock_lock);
+    clock->freq = device->spec.freq;
+    return 0;
+}
+
 void
 SDL_ClearQueuedAudio(SDL_AudioDeviceID devid)
 {
@@ -601,15 +959,250 @@ SDL_ClearQueuedAudio(SDL_AudioDeviceID devid)
         return;  /* nothing to do. */
     }
 
-    /* Blank out the device and release the mutex. Free it afterwards. */
-    current_audio.impl.LockDevice(device);
-
-    /* Keep up to two packets in the pool to reduce future memory allocation pressure. */
-    SDL_ClearDataQueue(device->buffer_queue, SDL_AUDIOBUFFERQUEUE_PACKETLEN * 2);
+    if (!device->buffer_queue) {
+        return;  /* not set for queueing. */
+    }
 
+    /* Both sides of the ring have to be out of it; the ring keeps its size. */
+    SDL_LockMutex(device->queue_lock);
+    LockAudioQueue(device);
+    SDL_ClearRingBuffer(device->buffer_queue);
     current_audio.impl.UnlockDevice(device);
+    SDL_UnlockMutex(device->queue_lock);
+
+    WakeAudioQueueWaiter(device, SDL_FALSE);
+}
+
+
+/* Audio thread timing, if SDL_HINT_AUDIO_TIMING was set. */
+static Uint32
+AudioTimingMicroseconds(const Uint64 start, const Uint64 end)
+{
+    return (Uint32) (((end - start) * 1000000) / SDL_GetPerformanceFrequency());
+}
+
+static void
+AddAudioTiming(Uint32 *max_us, Uint64 *total_us, const Uint32 us)
+{
+    *total_us += us;
+    if (us > *max_us) {
+        *max_us = us;
+    }
+}
+
+static void
+AddAudioCallbackTiming(SDL_AudioTimingStats *timing, const Uint32 us)
+{
+    int bucket = 0;
+    while ((bucket < (SDL_AUDIO_TIMING_BUCKETS - 1)) && (us >> (bucket + 1))) {
+        bucket++;
+    }
+    timing->callback_histogram[bucket]++;
+    timing->callbacks++;
+    AddAudioTiming(&timing->callback_max_us, &timing->callback_total_us, us);
+}
+
+/* A device period starts now: measure how far the last one was off. */
+static void
+StartAudioTimingPeriod(SDL_AudioDevice *device, const Uint64 now)
+{
+    SDL_AudioTimingStats *pending = &device->timing_pending;
+
+    if (device->timing_last_period) {
+        const Uint32 period_us = device->timing.period_us;
+        const Uint32 us = AudioTimingMicroseconds(device->timing_last_period, now);
+        AddAudioTiming(&pending->jitter_max_us, &pending->jitter_total_us, (us > period_us) ? (us - period_us) : (period_us - us));
+    }
+    device->timing_last_period = now;
+    pending->periods++;
+
+    if (current_audio.impl.GetDeviceXruns) {
+        current_audio.impl.GetDeviceXruns(device, &pending->underruns, &pending->overruns);
+    }
+}
+
+/* Called by the audio thread under mixer_lock. */
+static void
+FlushAudioTiming(SDL_AudioDevice *device)
+{
+    SDL_AudioTimingStats *timing = &device->timing;
+    SDL_AudioTimingStats *pending = &device->timing_pending;
+    int i;
+
+    timing->callbacks += pending->callbacks;
+    timing->periods += pending->periods;
+    for (i = 0; i < SDL_AUDIO_TIMING_BUCKETS; i++) {
+        timing->callback_histogram[i] += pending->callback_histogram[i];
+    }
+    timing->callback_max_us = SDL_max(timing->callback_max_us, pending->callback_max_us);
+    timing->callback_total_us += pending->callback_total_us;
+    timing->convert_max_us = SDL_max(timing->convert_max_us, pending->convert_max_us);
+    timing->convert_total_us += pending->convert_total_us;
+    timing->play_max_us = SDL_max(timing->play_max_us, pending->play_max_us);
+    timing->play_total_us += pending->play_total_us;
+    timing->wait_max_us = SDL_max(timing->wait_max_us, pending->wait_max_us);
+    timing->wait_total_us += pending->wait_total_us;
+    timing->jitter_max_us = SDL_max(timing->jitter_max_us, pending->jitter_max_us);
+    timing->jitter_total_us += pending->jitter_total_us;
+    timing->late_callbacks += pending->late_callbacks;
+    timing->underruns += pending->underruns;
+    timing->overruns += pending->overruns;
+    SDL_zerop(pending);
+}
+
+/* Called by the audio thread, which is the only one changing device->timing. */
+static void
+LogAudioTiming(SDL_AudioDevice *device)
+{
+    const SDL_AudioTimingStats *timing = &device->timing;
+    const Uint64 now = SDL_GetTicks64();
+    const Uint32 callbacks = SDL_max(timing->callbacks, 1);
+    const Uint32 periods = SDL_max(timing->periods, 1);
+
+    if (!device->timing_log_interval || (now < device->timing_next_log)) {
+        return;
+    }
+    device->timing_next_log = now + device->timing_log_interval;
+
+    SDL_Log("Audio device %u: %u callbacks, %u periods of %u us; "
+            "callback %u/%u us, convert %u/%u us, play %u/%u us, wait %u/%u us, jitter %u/%u us (mean/max); "
+            "%u late, %u underruns, %u overruns",
+            (unsigned int) device->id, (unsigned int) timing->callbacks, (unsigned int) timing->periods, (unsigned int) timing->period_us,
+            (unsigned int) (timing->callback_total_us / callbacks), (unsigned int) timing->callback_max_us,
+            (unsigned int) (timing->convert_total_us / callbacks), (unsigned int) timing->convert_max_us,
+            (unsigned int) (timing->play_total_us / periods), (unsigned int) timing->play_max_us,
+            (unsigned int) (timing->wait_total_us / periods), (unsigned int) timing->wait_max_us,
+            (unsigned int) (timing->jitter_total_us / periods), (unsigned int) timing->jitter_max_us,
+            (unsigned int) timing->late_callbacks, (unsigned int) timing->underruns, (unsigned int) timing->overruns);
 }
 
+/* A period was just handed to the device: measure what has played. */
+static void
+UpdateAudioClock(SDL_AudioDevice *device)
+{
+    const Uint32 framesize = (SDL_AUDIO_BITSIZE(device->spec.format) / 8) * device->spec.channels;
+    Uint64 before, after, frames;
+    Uint32 delay = 0;
+
+    device->frames_written += device->spec.size / framesize;
+
+    before = SDL_GetPerformanceCounter();
+    if (current_audio.impl.GetPlaybackDelay) {
+        const int bytes = current_audio.impl.GetPlaybackDelay(device);
+        if (bytes > 0) {
+            delay = (Uint32) SDL_min((Uint64) bytes / framesize, device->frames_written);
+        }
+    }
+    after = SDL_GetPerformanceCounter();
+
+    /* the device can only go forwards, however it rounds its delay. */
+    frames = SDL_max(device->frames_written - delay, device->clock.frames);
+
+    SDL_AtomicLock(&device->clock_lock);
+    device->clock.frames = frames;
+    device->clock.delay = (Uint32) (device->frames_written - frames);
+    device->clock.timestamp = before + ((after - before) / 2);
+    SDL_AtomicUnlock(&device->clock_lock);
+}
+
+/* Hand the device buffer to the device, or if buffer isn't NULL, buflen
+   bytes of it and the rest of the period from wrapped. */
+static void
+WriteAudioPeriod(SDL_AudioDevice *device, const Uint8 *buffer, const Uint8 *wrapped, int buflen)
+{
+    if (!buffer) {
+        current_audio.impl.PlayDevice(device);
+        return;
+    }
+    current_audio.impl.PlayDeviceBuffer(device, buffer, buflen);
+    if (buflen < device->spec.size) {
+        current_audio.impl.PlayDeviceBuffer(device, wrapped, device->spec.size - buflen);
+    }
+}
+
+/* Write a period (see WriteAudioPeriod()) and wait until the device wants another. */
+static void
+PlayAudioPeriod(SDL_AudioDevice *device, const Uint8 *buffer, const Uint8 *wrapped, int buflen)
+{
+    if (device->timing_enabled) {
+        SDL_AudioTimingStats *pending = &device->timing_pending;
+        Uint64 start = SDL_GetPerformanceCounter();
+        Uint64 end;
+
+        StartAudioTimingPeriod(device, start);
+        WriteAudioPeriod(device, buffer, wrapped, buflen);
+        UpdateAudioClock(device);
+        end = SDL_GetPerformanceCounter();
+        AddAudioTiming(&pending->play_max_us, &pending->play_total_us, AudioTimingMicroseconds(start, end));
+        current_audio.impl.WaitDevice(device);
+        start = end;
+        end = SDL_GetPerformanceCounter();
+        AddAudioTiming(&pending->wait_max_us, &pending->wait_total_us, AudioTimingMicroseconds(start, end));
+    } else {
+        WriteAudioPeriod(device, buffer, wrapped, buflen);
+        UpdateAudioClock(device);
+        current_audio.impl.WaitDevice(device);
+    }
+}
+
+/* A period starts: count the bytes the last one copied. Called under mixer_lock. */
+static void
+CountAudioPeriod(SDL_AudioDevice *device, Uint32 *copied)
+{
+    device->stats.periods++;
+    device->stats.period_bytes_copied = *copied;
+    device->stats.bytes_copied += *copied;
+    *copied = 0;
+    if (device->timing_enabled) {
+        FlushAudioTiming(device);
+    }
+}
+
+/* Queued playback in the device's own format can go to the device straight
+   out of the ring, without the drain callback copying it to the device buffer.
+   Returns SDL_FALSE, having done nothing, unless a whole period is queued and
+   nothing else needs mixing into it. */
+static SDL_bool
+PlayQueuedAudioInPlace(SDL_AudioDevice *device, Uint32 *copied)
+{
+    SDL_RingBuffer *ring = device->buffer_queue;
+    const Uint8 *data = NULL;
+    const Uint8 *wrapped = NULL;
+    size_t len = 0;
+    SDL_bool pinned = SDL_FALSE;
+
+    SDL_LockMutex(device->mixer_lock);
+    if (SDL_AtomicGet(&device->enabled) && !SDL_AtomicGet(&device->paused) && !device->voices &&
+        (SDL_CountRingBuffer(ring) >= device->spec.size) && SDL_AtomicCAS(&device->queue_pinned, 0, 1)) {
+        /* growing or clearing the ring waits for this; see LockAudioQueue(). */
+        CountAudioPeriod(device, copied);
+        pinned = SDL_TRUE;
+    }
+    SDL_UnlockMutex(device->mixer_lock);
+
+    if (!pinned) {
+        return SDL_FALSE;
+    }
+
+    /* A starved drain leaves the read position off a period boundary, so the
+       period may straddle the wrap point; the device gets it in two writes. */
+    data = (const Uint8 *) SDL_PeekRingBuffer(ring, &len);
+    if (len < device->spec.size) {
+        size_t wrappedlen;
+        wrapped = (const Uint8 *) SDL_PeekRingBufferAt(ring, len, &wrappedlen);
+    } else {
+        len = device->spec.size;
+    }
+
+    PlayAudioPeriod(device, data, wrapped, (int) len);
+    SDL_ConsumeRingBuffer(device->buffer_queue, device->spec.size);
+    if (!SDL_AtomicCAS(&device->queue_pinned, 1, 0)) {
+        SDL_AtomicSet(&device->queue_pinned, 2);  /* something waits to grow or clear the ring. */
+        SDL_SemPost(device->queue_unpin_sem);
+    }
+    WakeAudioQueueWaiter(device, SDL_FALSE);
+    return SDL_TRUE;
+}
 
 /* The general mixing thread function */
 static int SDLCALL
@@ -620,6 +1213,12 @@ SDL_RunAudio(void *devicep)
     SDL_AudioCallback callback = device->callbackspec.callback;
     int data_len = 0;
     Uint8 *data;
+    Uint32 copied = 0;  /* this period's, counted at the start of the next. */
+    const SDL_bool timed = device->timing_enabled;
+    const SDL_bool in_place = ((callback == SDL_BufferQueueDrainCallback) && !device->stream &&
+                               !device->convert.needed && current_audio.impl.PlayDeviceBuffer) ? SDL_TRUE : SDL_FALSE;
+    const Uint32 callback_period_us = (Uint32) (((Uint64) device->callbackspec.samples * 1000000) / device->callbackspec.freq);
+    SDL_AudioTimingStats *pending = &device->timing_pending;
 
     SDL_assert(!device->iscapture);
 
@@ -632,19 +1231,35 @@ SDL_RunAudio(void *devicep)
 
     /* Loop, filling the audio buffers */
     while (!SDL_AtomicGet(&device->shutdown)) {
+        const SDL_bool enabled = SDL_AtomicGet(&device->enabled) ? SDL_TRUE : SDL_FALSE;
+        Uint32 callback_us = 0;
+        Uint32 convert_us = 0;
+        Uint64 mark = 0;
         data_len = device->callbackspec.size;
 
-        /* Fill the current buffer with sound */
-        if (!device->stream && SDL_AtomicGet(&device->enabled)) {
-            SDL_assert(data_len == device->spec.size);
-            data = current_audio.impl.GetDeviceBuf(device);
-        } else {
+        if (in_place && PlayQueuedAudioInPlace(device, &copied)) {
+            if (timed) {
+                LogAudioTiming(device);
+            }
+            continue;
+        }
+
+        /* Fill the current buffer with sound: straight into the device's
+           buffer if it takes our format, or if converting in place fits
+           in it; straight into the stream's work buffer if resampling. */
+        if (!enabled) {
             /* if the device isn't enabled, we still write to the
                work_buffer, so the app's callback will fire with
                a regular frequency, in case they depend on that
                for timing or progress. They can use hotplug
-               now to know if the device failed.
-               Streaming playback uses work_buffer, too. */
+               now to know if the device failed. */
+            data = NULL;
+        } else if (device->stream) {
+            data = SDL_AudioStreamPutBuffer(device->stream, data_len);
+        } else if (!device->convert.needed || device->convert_in_device_buf) {
+            SDL_assert(device->convert.needed || (data_len == device->spec.size));
+            data = current_audio.impl.GetDeviceBuf(device);
+        } else {
             data = NULL;
         }
 
@@ -654,43 +1269,106 @@ SDL_RunAudio(void *devicep)
 
         /* !!! FIXME: this should be LockDevice. */
         SDL_LockMutex(device->mixer_lock);
+        CountAudioPeriod(device, &copied);
         if (SDL_AtomicGet(&device->paused)) {
             SDL_memset(data, device->callbackspec.silence, data_len);
         } else {
+            if (timed) {
+                mark = SDL_GetPerformanceCounter();
+            }
             callback(udata, data, data_len);
+            if (device->voices) {
+                SDL_MixAudioVoices(device, data, data_len);
+            }
+            if (timed) {
+                callback_us = AudioTimingMicroseconds(mark, SDL_GetPerformanceCounter());
+                AddAudioCallbackTiming(pending, callback_us);
+            }
         }
         SDL_UnlockMutex(device->mixer_lock);
 
+        if (timed) {
+            mark = SDL_GetPerformanceCounter();
+        }
+
+        if (device->convert.needed) {
+            /* Format-only conversion can't fail once it's built. */
+            device->convert.buf = data;
+            device->convert.len = data_len;
+            SDL_ConvertAudio(&device->convert);
+            SDL_assert(device->convert.len_cvt == device->spec.size);
+        }
+
         if (device->stream) {
             /* Stream available audio to device, converting/resampling. */
             /* if this fails...oh well. We'll play silence here. */
+            if (data == device->work_buffer) {
+                copied += data_len;
+            }
             SDL_AudioStreamPut(device->stream, data, data_len);
 
             while (SDL_AudioStreamAvailable(device->stream) >= ((int) device->spec.size)) {
                 int got;
+                if (timed) {
+                    mark = mark ? mark : SDL_GetPerformanceCounter();
+                }
                 data = SDL_AtomicGet(&device->enabled) ? current_audio.impl.GetDeviceBuf(device) : NULL;
                 got = SDL_AudioStreamGet(device->stream, data ? data : device->work_buffer, device->spec.size);
                 SDL_assert((got <= 0) || (got == device->spec.size));
+                if (data && (got != device->spec.size)) {
+                    SDL_memset(data, device->spec.silence, device->spec.size);
+                } else if (data) {
+                    copied += got;
+                }
+                if (timed) {
+                    convert_us += AudioTimingMicroseconds(mark, SDL_GetPerformanceCounter());
+                    mark = 0;
+                }
 
                 if (data == NULL) {  /* device is having issues... */
                     const Uint32 delay = ((device->spec.samples * 1000) / device->spec.freq);
                     SDL_Delay(delay);  /* wait for as long as this buffer would have played. Maybe device recovers later? */
                 } else {
-                    if (got != device->spec.size) {
-                        SDL_memset(data, device->spec.silence, device->spec.size);
-                    }
-                    current_audio.impl.PlayDevice(device);
-                    current_audio.impl.WaitDevice(device);
+                    PlayAudioPeriod(device, NULL, NULL, 0);
                 }
             }
         } else if (data == device->work_buffer) {
-            /* nothing to do; pause like we queued a buffer to play. */
-            const Uint32 delay = ((device->spec.samples * 1000) / device->spec.freq);
-            SDL_Delay(delay);
+            Uint8 *devbuf = enabled ? current_audio.impl.GetDeviceBuf(device) : NULL;
+            if (devbuf) {  /* converted, but too big to do it in the device's buffer. */
+                SDL_memcpy(devbuf, data, device->spec.size);
+                copied += device->spec.size;
+                if (timed) {
+                    convert_us += AudioTimingMicroseconds(mark, SDL_GetPerformanceCounter());
+                    mark = 0;
+                }
+                PlayAudioPeriod(device, NULL, NULL, 0);
+            } else {
+                /* nothing to do; pause like we queued a buffer to play. */
+                const Uint32 delay = ((device->spec.samples * 1000) / device->spec.freq);
+                if (timed) {
+                    convert_us += AudioTimingMicroseconds(mark, SDL_GetPerformanceCounter());
+                    mark = 0;
+                }
+                SDL_Delay(delay);
+            }
         } else {  /* writing directly to the device. */
+            if (timed) {
+                convert_us += AudioTimingMicroseconds(mark, SDL_GetPerformanceCounter());
+                mark = 0;
+            }
             /* queue this buffer and wait for it to finish playing. */
-            current_audio.impl.PlayDevice(device);
-            current_audio.impl.WaitDevice(device);
+            PlayAudioPeriod(device, NULL, NULL, 0);
+        }
+
+        if (timed) {
+            if (mark) {  /* converted, but didn't play anything. */
+                convert_us += AudioTimingMicroseconds(mark, SDL_GetPerformanceCounter());
+            }
+            AddAudioTiming(&pending->convert_max_us, &pending->convert_total_us, convert_us);
+            if ((callback_us + convert_us) > callback_period_us) {
+                pending->late_callbacks++;
+            }
+            LogAudioTiming(device);
         }
     }
 
@@ -702,6 +1380,47 @@ SDL_RunAudio(void *devicep)
     return 0;
 }
 
+/* Performance counter ticks that len bytes of audio in spec last. */
+static Uint64
+AudioBytesToTicks(const SDL_AudioSpec *spec, const Uint64 len)
+{
+    const Uint64 framesize = (SDL_AUDIO_BITSIZE(spec->format) / 8) * spec->channels;
+    return ((len / framesize) * SDL_GetPerformanceFrequency()) / spec->freq;
+}
+
+/* Hand the capture callback a buffer of audio, captured starting at
+   timestamp, under the device lock. */
+static void
+RunCaptureCallback(SDL_AudioDevice *device, Uint8 *data, Uint32 *copied, const Uint64 timestamp)
+{
+    /* !!! FIXME: this should be LockDevice. */
+    SDL_LockMutex(device->mixer_lock);
+    device->capture_timestamp = timestamp;
+    device->stats.periods++;
+    device->stats.period_bytes_copied = *copied;
+    device->stats.bytes_copied += *copied;
+    *copied = 0;
+    if (device->timing_enabled) {
+        FlushAudioTiming(device);
+    }
+    if (!SDL_AtomicGet(&device->paused)) {
+        if (device->timing_enabled) {
+            const Uint32 callback_period_us = (Uint32) (((Uint64) device->callbackspec.samples * 1000000) / device->callbackspec.freq);
+            const Uint64 start = SDL_GetPerformanceCounter();
+            Uint32 us;
+            device->callbackspec.callback(device->callbackspec.userdata, data, device->callbackspec.size);
+            us = AudioTimingMicroseconds(start, SDL_GetPerformanceCounter());
+            AddAudioCallbackTiming(&device->timing_pending, us);
+            if (us > callback_period_us) {
+                device->timing_pending.late_callbacks++;
+            }
+        } else {
+            device->callbackspec.callback(device->callbackspec.userdata, data, device->callbackspec.size);
+        }
+    }
+    SDL_UnlockMutex(device->mixer_lock);
+}
+
 /* !!! FIXME: this needs to deal with device spec changes. */
 /* The general capture thread function */
 static int SDLCALL
@@ -712,8 +1431,9 @@ SDL_CaptureAudio(void *devicep)
     const Uint32 delay = ((device->spec.samples * 1000) / device->spec.freq);
     const int data_len = device->spec.size;
     Uint8 *data;
-    void *udata = device->callbackspec.userdata;
-    SDL_AudioCallback callback = device->callbackspec.callback;
+    Uint32 copied = 0;  /* this period's, counted at the start of the next. */
+    const SDL_bool timed = device->timing_enabled;
+    SDL_AudioTimingStats *pending = &device->timing_pending;
 
     SDL_assert(device->iscapture);
 
@@ -728,13 +1448,25 @@ SDL_CaptureAudio(void *devicep)
     while (!SDL_AtomicGet(&device->shutdown)) {
         int still_need;
         Uint8 *ptr;
+        Uint64 mark = 0;
+        Uint64 captured;  /* when the last sample frame we've read was captured. */
 
         if (SDL_AtomicGet(&device->paused)) {
-            SDL_Delay(delay);  /* just so we don't cook the CPU. */
             if (device->stream) {
                 SDL_AudioStreamClear(device->stream);
             }
-            current_audio.impl.FlushCapture(device);  /* dump anything pending. */
+            if (device->low_latency_capture && SDL_AtomicGet(&device->enabled)) {
+                /* keep reading at the device's pace, so there's nothing
+                   stale to flush and no sleep to overshoot when unpaused. */
+                if ((current_audio.impl.CaptureFromDevice(device, device->work_buffer, data_len) < 0) &&
+                    !SDL_AtomicGet(&device->shutdown)) {
+                    SDL_OpenedAudioDeviceDisconnected(device);
+                }
+            } else {
+                SDL_Delay(delay);  /* just so we don't cook the CPU. */
+                current_audio.impl.FlushCapture(device);  /* dump anything pending. */
+            }
+            device->timing_last_period = 0;  /* don't count the pause as jitter. */
             continue;
         }
 
@@ -754,6 +1486,9 @@ SDL_CaptureAudio(void *devicep)
         if (!SDL_AtomicGet(&device->enabled)) {
             SDL_Delay(delay);  /* try to keep callback firing at normal pace. */
         } else {
+            if (timed) {
+                mark = SDL_GetPerformanceCounter();
+            }
             while (still_need > 0) {
                 const int rc = current_audio.impl.CaptureFromDevice(device, ptr, still_need);
                 SDL_assert(rc <= still_need);  /* device should not overflow buffer. :) */
@@ -761,10 +1496,22 @@ SDL_CaptureAudio(void *devicep)
                     still_need -= rc;
                     ptr += rc;
                 } else {  /* uhoh, device failed for some reason! */
-                    SDL_OpenedAudioDeviceDisconnected(device);
+                    if (!SDL_AtomicGet(&device->shutdown)) {
+                        SDL_OpenedAudioDeviceDisconnected(device);
+                    }
                     break;
                 }
             }
+            if (timed) {
+                const Uint64 now = SDL_GetPerformanceCounter();
+                AddAudioTiming(&pending->wait_max_us, &pending->wait_total_us, AudioTimingMicroseconds(mark, now));
+                StartAudioTimingPeriod(device, now);
+            }
+        }
+
+        captured = SDL_GetPerformanceCounter();
+        if (current_audio.impl.GetCaptureBacklog && SDL_AtomicGet(&device->enabled)) {
+            captured -= AudioBytesToTicks(&device->spec, current_audio.impl.GetCaptureBacklog(device));
         }
 
         if (still_need > 0) {
@@ -773,30 +1520,54 @@ SDL_CaptureAudio(void *devicep)
         }
 
         if (device->stream) {
+            Uint32 convert_us = 0;
+
+            if (timed) {
+                mark = SDL_GetPerformanceCounter();
+            }
             /* if this fails...oh well. */
             SDL_AudioStreamPut(device->stream, data, data_len);
+            copied += data_len;
 
             while (SDL_AudioStreamAvailable(device->stream) >= ((int) device->callbackspec.size)) {
-                const int got = SDL_AudioStreamGet(device->stream, device->work_buffer, device->callbackspec.size);
-                SDL_assert((got < 0) || (got == device->callbackspec.size));
-                if (got != device->callbackspec.size) {
-                    SDL_memset(device->work_buffer, device->spec.silence, device->callbackspec.size);
+                const int len = device->callbackspec.size;
+                const Uint64 timestamp = captured - AudioBytesToTicks(&device->callbackspec, SDL_AudioStreamAvailable(device->stream));
+                Uint8 *output = SDL_AudioStreamPeek(device->stream, len);
+
+                if (!output) {  /* it wraps around the stream's buffer. */
+                    const int got = SDL_AudioStreamGet(device->stream, device->work_buffer, len);
+                    SDL_assert((got < 0) || (got == len));
+                    if (got != len) {
+                        SDL_memset(device->work_buffer, device->spec.silence, len);
+                    } else {
+                        copied += got;
+                    }
+                }
+                if (timed) {
+                    convert_us += AudioTimingMicroseconds(mark, SDL_GetPerformanceCounter());
                 }
 
-                /* !!! FIXME: this should be LockDevice. */
-                SDL_LockMutex(device->mixer_lock);
-                if (!SDL_AtomicGet(&device->paused)) {
-                    callback(udata, device->work_buffer, device->callbackspec.size);
+                /* the app reads straight out of the stream when it can. */
+                RunCaptureCallback(device, output ? output : device->work_buffer, &copied, timestamp);
+                if (output) {
+                    SDL_AudioStreamDiscard(device->stream, len);
+                }
+
+                if (timed) {
+                    mark = SDL_GetPerformanceCounter();
                 }
-                SDL_UnlockMutex(device->mixer_lock);
             }
-        } else {  /* feeding user callback directly without streaming. */
-            /* !!! FIXME: this should be LockDevice. */
-            SDL_LockMutex(device->mixer_lock);
-            if (!SDL_AtomicGet(&device->paused)) {
-                callback(udata, data, device->callbackspec.size);
+
+            if (timed) {
+                convert_us += AudioTimingMicroseconds(mark, SDL_GetPerformanceCounter());
+                AddAudioTiming(&pending->convert_max_us, &pending->convert_total_us, convert_us);
             }
-            SDL_UnlockMutex(device->mixer_lock);
+        } else {  /* feeding user callback directly without streaming. */
+            RunCaptureCallback(device, data, &copied, captured - AudioBytesToTicks(&device->spec, data_len));
+        }
+
+        if (timed) {
+            LogAudioTiming(device);
         }
     }
 
@@ -1093,6 +1864,7 @@ close_audio_device(SDL_AudioDevice * device)
     SDL_AtomicSet(&device->shutdown, 1);
     SDL_AtomicSet(&device->enabled, 0);
     current_audio.impl.UnlockDevice(device);
+    WakeAudioQueueWaiter(device, SDL_TRUE);
 
     if (device->thread != NULL) {
         SDL_WaitThread(device->thread, NULL);
@@ -1103,6 +1875,7 @@ close_audio_device(SDL_AudioDevice * device)
 
     SDL_free(device->work_buffer);
     SDL_FreeAudioStream(device->stream);
+    SDL_FreeAudioVoices(device);
 
     if (device->id > 0) {
         SDL_AudioDevice *opendev = open_devices[device->id - 1];
@@ -1116,7 +1889,24 @@ close_audio_device(SDL_AudioDevice * device)
         current_audio.impl.CloseDevice(device);
     }
 
-    SDL_FreeDataQueue(device->buffer_queue);
+    /* a woken waiter still has to leave its lock before that goes away. */
+    if (device->queue_lock != NULL) {
+        SDL_LockMutex(device->queue_lock);
+        SDL_UnlockMutex(device->queue_lock);
+        SDL_DestroyMutex(device->queue_lock);
+    }
+    if (device->queue_wait_lock != NULL) {
+        SDL_LockMutex(device->queue_wait_lock);
+        SDL_UnlockMutex(device->queue_wait_lock);
+        SDL_DestroyMutex(device->queue_wait_lock);
+    }
+    if (device->queue_space_sem != NULL) {
+        SDL_DestroySemaphore(device->queue_space_sem);
+    }
+    if (device->queue_unpin_sem != NULL) {
+        SDL_DestroySemaphore(device->queue_unpin_sem);
+    }
+    SDL_FreeRingBuffer(device->buffer_queue);
 
     SDL_free(device);
 }
@@ -1324,6 +2114,10 @@ open_audio_device(const char *devname, int iscapture,
         device->spec.samples = SDL_powerof2(device->spec.samples);
     }
 
+    if (iscapture) {
+        device->low_latency_capture = SDL_GetHintBoolean(SDL_HINT_AUDIO_CAPTURE_LOW_LATENCY, SDL_FALSE);
+    }
+
     if (current_audio.impl.OpenDevice(device, devname) < 0) {
         close_audio_device(device);
         SDL_UnlockMutex(current_audio.detectionLock);
@@ -1369,6 +2163,20 @@ open_audio_device(const char *devname, int iscapture,
 
     device->callbackspec = *obtained;
 
+    if (build_stream && !iscapture &&
+        (obtained->freq == device->spec.freq) && (obtained->samples == device->spec.samples)) {
+        /* Only the format or channels change, so a period converts to a
+           period in place, without the stream's buffering. */
+        if (SDL_BuildAudioCVT(&device->convert, obtained->format, obtained->channels, obtained->freq,
+                              device->spec.format, device->spec.channels, device->spec.freq) < 0) {
+            close_audio_device(device);
+            SDL_UnlockMutex(current_audio.detectionLock);
+            return 0;
+        }
+        device->convert_in_device_buf = ((obtained->size * device->convert.len_mult) <= device->spec.size) ? SDL_TRUE : SDL_FALSE;
+        build_stream = SDL_FALSE;
+    }
+
     if (build_stream) {
         if (iscapture) {
             device->stream = SDL_NewAudioStream(device->spec.format,
@@ -1388,8 +2196,34 @@ open_audio_device(const char *devname, int iscapture,
     }
 
     if (device->spec.callback == NULL) {  /* use buffer queueing? */
-        /* pool a few packets to start. Enough for two callbacks. */
-        device->buffer_queue = SDL_NewDataQueue(SDL_AUDIOBUFFERQUEUE_PACKETLEN, obtained->size * 2);
+        const char *hint = SDL_GetHint(SDL_HINT_AUDIO_QUEUE_CAPACITY);
+        size_t capacity = obtained->size * 2;  /* enough for two callbacks. */
+        if (hint && SDL_atoi(hint) > 0) {
+            const int frame_size = (SDL_AUDIO_BITSIZE(obtained->format) / 8) * obtained->channels;
+            capacity = (size_t) ((Sint64) SDL_atoi(hint) * obtained->freq / 1000) * frame_size;
+        }
+        if (!iscapture) {
+            /* a period played straight out of the ring stays in it until the
+               device has taken it; don't let that eat into the capacity. */
+            capacity += obtained->size;
+        }
+
+        hint = SDL_GetHint(SDL_HINT_AUDIO_QUEUE_OVERFLOW);
+        if (hint && SDL_strcasecmp(hint, "block") == 0) {
+            device->queue_overflow = SDL_AUDIOQUEUE_BLOCK;
+        } else if (hint && SDL_strcasecmp(hint, "drop") == 0) {
+            device->queue_overflow = SDL_AUDIOQUEUE_DROP;
+        } else {
+            device->queue_overflow = SDL_AUDIOQUEUE_GROW;
+        }
+
+        device->queue_lock = SDL_CreateMutex();
+        if (!iscapture) {
+            device->queue_wait_lock = SDL_CreateMutex();
+            device->queue_space_sem = SDL_CreateSemaphore(0);
+            device->queue_unpin_sem = SDL_CreateSemaphore(0);
+        }
+        device->buffer_queue = (device->queue_lock && (iscapture || (device->queue_wait_lock && device->queue_space_sem && device->queue_unpin_sem))) ? SDL_NewRingBuffer(capacity) : NULL;
         if (!device->buffer_queue) {
             close_audio_device(device);
             SDL_UnlockMutex(current_audio.detectionLock);
@@ -1402,6 +2236,9 @@ open_audio_device(const char *devname, int iscapture,
 
     /* Allocate a scratch audio buffer */
     device->work_buffer_len = build_stream ? device->callbackspec.size : 0;
+    if (device->convert.needed) {
+        device->work_buffer_len = device->callbackspec.size * device->convert.len_mult;
+    }
     if (device->spec.size > device->work_buffer_len) {
         device->work_buffer_len = device->spec.size;
     }
@@ -1415,6 +2252,14 @@ open_audio_device(const char *devname, int iscapture,
         return 0;
     }
 
+    if (SDL_GetHintBoolean(SDL_HINT_AUDIO_TIMING, SDL_FALSE)) {
+        const char *hint = SDL_GetHint(SDL_HINT_AUDIO_TIMING_LOG_INTERVAL);
+        device->timing_enabled = SDL_TRUE;
+        device->timing.period_us = (Uint32) (((Uint64) device->spec.samples * 1000000) / device->spec.freq);
+        device->timing_log_interval = (hint && SDL_atoi(hint) > 0) ? (Uint32) SDL_atoi(hint) : 0;
+        device->timing_next_log = SDL_GetTicks64() + device->timing_log_interval;
+    }
+
     open_devices[id] = device;  /* add it to our list of open devices. */
 
     /* Start the audio thread if necessary */
@@ -1515,6 +2360,9 @@ SDL_PauseAudioDevice(SDL_AudioDeviceID devid, int pause_on)
         current_audio.impl.LockDevice(device);
         SDL_AtomicSet(&device->paused, pause_on ? 1 : 0);
         current_audio.impl.UnlockDevice(device);
+        if (pause_on) {
+            WakeAudioQueueWaiter(device, SDL_TRUE);  /* nothing will make room now. */
+        }
     }
 }
 
@@ -56,6 +56,20 @@ extern SDL_AudioFormat SDL_NextAudioFormat(void);
 extern Uint8 SDL_SilenceValueForFormat(const SDL_AudioFormat format);
 extern void SDL_CalculateAudioSpec(SDL_AudioSpec * spec);
 
+/* Get what an SDL_AudioStream produces */
+extern void SDL_GetAudioStreamOutputFormat(SDL_AudioStream *stream, SDL_AudioFormat *format, Uint8 *channels, int *rate);
+
+/* Memory inside a resampling stream that len bytes of input can be written
+   to, and then passed to SDL_AudioStreamPut() without being copied in.
+   NULL if this put can't go straight through; use your own buffer then. */
+extern Uint8 *SDL_AudioStreamPutBuffer(SDL_AudioStream *stream, int len);
+
+/* The next len bytes of a stream's output, if they're all in one piece
+   and available; NULL if not, so use SDL_AudioStreamGet() instead.
+   SDL_AudioStreamDiscard() drops them once you're done with them. */
+extern Uint8 *SDL_AudioStreamPeek(SDL_AudioStream *stream, int len);
+extern void SDL_AudioStreamDiscard(SDL_AudioStream *stream, int len);
+
 /* Choose the audio filter functions below */
 extern void SDL_ChooseAudioConverters(void);
 
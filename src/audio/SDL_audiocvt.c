@@ -27,7 +27,7 @@
 #include "SDL_audio_c.h"
 
 #include "SDL_loadso.h"
-#include "../SDL_dataqueue.h"
+#include "../SDL_ringbuffer.h"
 #include "SDL_cpuinfo.h"
 
 #define DEBUG_AUDIOSTREAM 0
@@ -532,6 +532,251 @@ SDL_BuildAudioResampleCVT(SDL_AudioCVT * cvt, const int dst_channels,
     return 1;               /* added a converter. */
 }
 
+/* Fused conversion plans.
+
+   The generic chain makes one full pass over the buffer per filter, which is
+   mostly memory traffic for the simple cases. A few common conversions get a
+   single kernel instead that reads each source sample once and writes the
+   final format directly. The per-sample math is the same as the scalar
+   filters in SDL_audiotypecvt.c and the resampler above, in the same order,
+   so the output matches the chain. (The resampler sums are only identical as
+   long as the compiler doesn't reassociate them differently in the two
+   places, which -ffast-math allows.) */
+
+/* Output frames produced per block by the fused resampler. */
+#define FUSED_BLOCK_FRAMES 256
+
+/* Input frames the resampler can touch on either side of (srcindex). */
+#define FUSED_RESAMPLER_WING (RESAMPLER_ZERO_CROSSINGS + 1)
+
+static SDL_INLINE Sint16
+FusedF32ToS16(const float sample)
+{
+    if (sample >= 1.0f) {
+        return 32767;
+    } else if (sample <= -1.0f) {
+        return -32768;
+    }
+    return (Sint16)(sample * 32767.0f);
+}
+
+static SDL_INLINE float
+FusedS16ToF32(const Sint16 sample)
+{
+    return ((float) sample) * 0.000030517578125f;  /* 1/32768 */
+}
+
+static SDL_INLINE float
+FusedU8ToF32(const Uint8 sample)
+{
+    return (((float) sample) * 0.0078125f) - 1.0f;  /* 1/128 */
+}
+
+static void SDLCALL
+SDL_ConvertFused_S16Mono_to_S16Stereo(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const Sint16 *src = ((const Sint16 *) (cvt->buf + cvt->len_cvt)) - 1;
+    Sint16 *dst = ((Sint16 *) (cvt->buf + (cvt->len_cvt * 2))) - 2;
+    int i;
+
+    LOG_DEBUG_CONVERT("AUDIO_S16 mono", "AUDIO_S16 stereo (fused)");
+
+    /* convert backwards, since output is growing in-place. */
+    for (i = cvt->len_cvt / sizeof (Sint16); i; i--, src--, dst -= 2) {
+        const Sint16 sample = FusedF32ToS16(FusedS16ToF32(*src));
+        dst[1] = sample;
+        dst[0] = sample;
+    }
+
+    cvt->len_cvt *= 2;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_S16SYS);
+    }
+}
+
+static void SDLCALL
+SDL_ConvertFused_U8Mono_to_S16Stereo(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const Uint8 *src = (cvt->buf + cvt->len_cvt) - 1;
+    Sint16 *dst = ((Sint16 *) (cvt->buf + (cvt->len_cvt * 4))) - 2;
+    int i;
+
+    LOG_DEBUG_CONVERT("AUDIO_U8 mono", "AUDIO_S16 stereo (fused)");
+
+    /* convert backwards, since output is growing in-place. */
+    for (i = cvt->len_cvt; i; i--, src--, dst -= 2) {
+        const Sint16 sample = FusedF32ToS16(FusedU8ToF32(*src));
+        dst[1] = sample;
+        dst[0] = sample;
+    }
+
+    cvt->len_cvt *= 4;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_S16SYS);
+    }
+}
+
+/* S16 in, S16 out, upsampling only, optionally widening mono to stereo on
+   the way (the chain would resample two identical channels, so each output
+   sample is simply written twice). The input is moved to the end of the
+   buffer and the output written forwards from the start, so the two never
+   overlap. Each block of output frames widens just the input frames it needs
+   into a small float window, padded with silence past either end of the
+   buffer like SDL_ResampleCVT does, and then runs the same filter sums as
+   SDL_ResampleAudio over it. */
+static void
+SDL_ResampleFusedCVT(SDL_AudioCVT *cvt, const int chans, const int dst_chans)
+{
+    const int inrate = (int) (size_t) cvt->filters[SDL_AUDIOCVT_MAX_FILTERS-1];
+    const int outrate = (int) (size_t) cvt->filters[SDL_AUDIOCVT_MAX_FILTERS];
+    const int framelen = chans * (int)sizeof (Sint16);
+    const int dst_framelen = dst_chans * (int)sizeof (Sint16);
+    const int inframes = cvt->len_cvt / framelen;
+    const int outframes = (int) (((Sint64) inframes) * outrate / inrate);
+    const Sint16 *src = (const Sint16 *) (cvt->buf + (outframes * dst_framelen));
+    Sint16 *dst = (Sint16 *) cvt->buf;
+    float window[(FUSED_BLOCK_FRAMES + (FUSED_RESAMPLER_WING * 2) + 1) * 2];
+    int blockstart, blockend, first, last;
+    int i, j, chan;
+
+    SDL_assert(chans <= 2);
+    SDL_assert((dst_chans == chans) || ((chans == 1) && (dst_chans == 2)));
+    SDL_assert(inrate < outrate);
+    SDL_assert((outframes * dst_framelen) + (inframes * framelen) <= cvt->len * cvt->len_mult);
+
+    LOG_DEBUG_CONVERT("AUDIO_S16", "AUDIO_S16 resampled (fused)");
+
+    SDL_memmove((Uint8 *) src, cvt->buf, inframes * framelen);
+
+    for (blockstart = 0; blockstart < outframes; blockstart = blockend) {
+        blockend = SDL_min(blockstart + FUSED_BLOCK_FRAMES, outframes);
+        first = (int) (((Sint64) blockstart) * inrate / outrate) - FUSED_RESAMPLER_WING;
+        last = (int) (((Sint64) (blockend - 1)) * inrate / outrate) + FUSED_RESAMPLER_WING;
+
+        for (j = first; j <= last; j++) {
+            float *windowframe = window + ((j - first) * chans);
+            if ((j < 0) || (j >= inframes)) {
+                for (chan = 0; chan < chans; chan++) {
+                    windowframe[chan] = 0.0f;
+                }
+            } else {
+                for (chan = 0; chan < chans; chan++) {
+                    windowframe[chan] = FusedS16ToF32(src[(j * chans) + chan]);
+                }
+            }
+        }
+
+        for (i = blockstart; i < blockend; i++) {
+            /* See SDL_ResampleAudio for the reasoning behind this arithmetic. */
+            const int srcindex = (int) (((Sint64) i) * inrate / outrate);
+            const int srcfraction = (int) (((Sint64) i) * inrate % outrate);
+            const float interpolation1 = ((float) srcfraction) / ((float) outrate);
+            const int filterindex1 = ((Sint32) srcfraction) * RESAMPLER_SAMPLES_PER_ZERO_CROSSING / outrate;
+            const float interpolation2 = 1.0f - interpolation1;
+            const int filterindex2 = ((Sint32) (outrate - srcfraction)) * RESAMPLER_SAMPLES_PER_ZERO_CROSSING / outrate;
+            const float *in = window + ((srcindex - first) * chans);
+
+            for (chan = 0; chan < chans; chan++) {
+                float outsample = 0.0f;
+
+                for (j = 0; (filterindex1 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)) < RESAMPLER_FILTER_SIZE; j++) {
+                    const int filt_ind = filterindex1 + j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING;
+                    const float insample = in[(-j * chans) + chan];
+                    outsample += (float)(insample * (ResamplerFilter[filt_ind] + (interpolation1 * ResamplerFilterDifference[filt_ind])));
+                }
+
+                for (j = 0; (filterindex2 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)) < RESAMPLER_FILTER_SIZE; j++) {
+                    const int filt_ind = filterindex2 + j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING;
+                    const float insample = in[((1 + j) * chans) + chan];
+                    outsample += (float)(insample * (ResamplerFilter[filt_ind] + (interpolation2 * ResamplerFilterDifference[filt_ind])));
+                }
+
+                *(dst++) = FusedF32ToS16(outsample);
+            }
+
+            if (dst_chans != chans) {
+                *dst = dst[-1];
+                dst++;
+            }
+        }
+    }
+
+    cvt->len_cvt = outframes * dst_framelen;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_S16SYS);
+    }
+}
+
+#define RESAMPLER_FUNCS(chans, dst_chans) \
+    static void SDLCALL \
+    SDL_ResampleFusedCVT_c##chans##_to_c##dst_chans(SDL_AudioCVT *cvt, SDL_AudioFormat format) { \
+        SDL_ResampleFusedCVT(cvt, chans, dst_chans); \
+    }
+RESAMPLER_FUNCS(1, 1)
+RESAMPLER_FUNCS(1, 2)
+RESAMPLER_FUNCS(2, 2)
+#undef RESAMPLER_FUNCS
+
+/* Returns 1 and sets up (cvt) if a fused kernel covers the whole conversion,
+   0 if the generic filter chain is needed. */
+static int
+SDL_BuildAudioFusedCVT(SDL_AudioCVT *cvt,
+                       const SDL_AudioFormat src_fmt, const int src_channels, const int src_rate,
+                       const SDL_AudioFormat dst_fmt, const int dst_channels, const int dst_rate)
+{
+    SDL_AudioFilter filter = NULL;
+
+    if (dst_fmt != AUDIO_S16SYS) {
+        return 0;
+    }
+
+    if (src_rate == dst_rate) {
+        if ((src_channels == 1) && (dst_channels == 2)) {
+            if (src_fmt == AUDIO_S16SYS) {
+                filter = SDL_ConvertFused_S16Mono_to_S16Stereo;
+                cvt->len_mult = 2;
+            } else if (src_fmt == AUDIO_U8) {
+                filter = SDL_ConvertFused_U8Mono_to_S16Stereo;
+                cvt->len_mult = 4;
+            }
+        }
+    } else if ((src_fmt == AUDIO_S16SYS) && (src_rate < dst_rate)) {
+        #ifdef HAVE_LIBSAMPLERATE_H
+        if (SRC_available) {
+            return 0;  /* libsamplerate resamples differently; keep its chain. */
+        }
+        #endif
+
+        if ((src_channels == 1) && (dst_channels == 1)) {
+            filter = SDL_ResampleFusedCVT_c1_to_c1;
+        } else if ((src_channels == 1) && (dst_channels == 2)) {
+            filter = SDL_ResampleFusedCVT_c1_to_c2;
+        } else if ((src_channels == 2) && (dst_channels == 2)) {
+            filter = SDL_ResampleFusedCVT_c2_to_c2;
+        }
+
+        if (filter) {
+            /* output, then the input moved out of its way. */
+            const double mult = (((double) dst_rate) / ((double) src_rate)) * (dst_channels / src_channels);
+            cvt->len_mult = ((int) SDL_ceil(mult)) + 1;
+            cvt->filters[SDL_AUDIOCVT_MAX_FILTERS-1] = (SDL_AudioFilter) (uintptr_t) src_rate;
+            cvt->filters[SDL_AUDIOCVT_MAX_FILTERS] = (SDL_AudioFilter) (uintptr_t) dst_rate;
+        }
+    }
+
+    if (!filter) {
+        return 0;
+    }
+
+    if (SDL_AddAudioCVTFilter(cvt, filter) < 0) {
+        return -1;
+    }
+
+    cvt->len_ratio = (((double) dst_channels * SDL_AUDIO_BITSIZE(dst_fmt)) / ((double) src_channels * SDL_AUDIO_BITSIZE(src_fmt))) *
+                     (((double) dst_rate) / ((double) src_rate));
+    return 1;
+}
+
 static SDL_bool
 SDL_SupportedAudioFormat(const SDL_AudioFormat fmt)
 {
@@ -658,6 +903,15 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
         }
     }
 
+    /* see if a single fused pass can do the whole job. */
+    if (SDL_GetHintBoolean(SDL_HINT_AUDIO_FUSED_CONVERSION, SDL_TRUE)) {
+        switch (SDL_BuildAudioFusedCVT(cvt, src_fmt, src_channels, src_rate, dst_fmt, dst_channels, dst_rate)) {
+            case -1: return -1;
+            case 1: cvt->needed = 1; return 1;
+            default: break;
+        }
+    }
+
     /* Convert data types, if necessary. Updates (cvt). */
     if (SDL_BuildAudioTypeCVTToFloat(cvt, src_fmt) < 0) {
         return -1;              /* shouldn't happen, but just in case... */
@@ -718,7 +972,7 @@ struct _SDL_AudioStream
 {
     SDL_AudioCVT cvt_before_resampling;
     SDL_AudioCVT cvt_after_resampling;
-    SDL_DataQueue *queue;
+    SDL_RingBuffer *ring;  /* converted output, written to in place when it fits. */
     SDL_bool first_run;
     Uint8 *staging_buffer;
     int staging_buffer_size;
@@ -767,6 +1021,33 @@ EnsureStreamBufferSize(SDL_AudioStream *stream, const int newlen)
     return offset ? ptr + (16 - offset) : ptr;
 }
 
+/* Make sure the ring can take another len bytes, growing it if needed. */
+static int
+EnsureStreamRingSpace(SDL_AudioStream *stream, const int len)
+{
+    const size_t count = SDL_CountRingBuffer(stream->ring);
+
+    if (!count) {
+        SDL_ClearRingBuffer(stream->ring);  /* start over at the front, so the whole ring is contiguous. */
+    } else if (SDL_RingBufferSpace(stream->ring) >= (size_t) len) {
+        return 0;
+    }
+    return SDL_ResizeRingBuffer(stream->ring, count + len);
+}
+
+/* A contiguous region of len bytes at the end of the ring, or NULL if the
+   free space wraps around and the output has to be copied in afterwards.
+   The converters run in this region, so it also has to be 16-byte aligned
+   like the work buffer: they use aligned SIMD loads, and the float
+   intermediates would be misaligned otherwise (SIGBUS on some ARMs). */
+static Uint8 *
+ReserveStreamOutput(SDL_AudioStream *stream, const int len)
+{
+    size_t avail;
+    Uint8 *ptr = (Uint8 *) SDL_ReserveRingBuffer(stream->ring, &avail);
+    return ((avail >= (size_t) len) && !(((size_t) ptr) & 15)) ? ptr : NULL;
+}
+
 #ifdef HAVE_LIBSAMPLERATE_H
 static int
 SDL_ResampleAudioStream_SRC(SDL_AudioStream *stream, const void *_inbuf, const int inbuflen, void *_outbuf, const int outbuflen)
@@ -983,15 +1264,50 @@ SDL_NewAudioStream(const SDL_AudioFormat src_format,
         }
     }
 
-    retval->queue = SDL_NewDataQueue(packetlen, packetlen * 2);
-    if (!retval->queue) {
+    retval->ring = SDL_NewRingBuffer(packetlen * 2);
+    if (!retval->ring) {
         SDL_FreeAudioStream(retval);
-        return NULL;  /* SDL_NewDataQueue should have called SDL_SetError. */
+        return NULL;  /* SDL_NewRingBuffer should have called SDL_SetError. */
     }
 
     return retval;
 }
 
+/* How big a work buffer putting buflen bytes needs; also how much of it
+   the resampler writes, and how big the final output can get. */
+static int
+StreamWorkBufferLength(SDL_AudioStream *stream, const int buflen, int *resamplebuflen, int *outbuflen)
+{
+    int workbuflen = buflen;
+
+    *resamplebuflen = 0;
+    if (stream->cvt_before_resampling.needed) {
+        workbuflen *= stream->cvt_before_resampling.len_mult;
+    }
+
+    if (stream->dst_rate != stream->src_rate) {
+        /* resamples can't happen in place, so make space for second buf. */
+        const int framesize = stream->pre_resample_channels * sizeof (float);
+        const int frames = workbuflen / framesize;
+        *resamplebuflen = ((int) SDL_ceil(frames * stream->rate_incr)) * framesize;
+        #if DEBUG_AUDIOSTREAM
+        SDL_Log("AUDIOSTREAM: will resample %d bytes to %d (ratio=%.6f)\n", workbuflen, *resamplebuflen, stream->rate_incr);
+        #endif
+        *outbuflen = *resamplebuflen;
+        workbuflen += *resamplebuflen;
+    } else {
+        *outbuflen = workbuflen;
+    }
+
+    if (stream->cvt_after_resampling.needed) {
+        /* !!! FIXME: buffer might be big enough already? */
+        workbuflen *= stream->cvt_after_resampling.len_mult;
+        *outbuflen *= stream->cvt_after_resampling.len_mult;
+    }
+
+    return workbuflen + (stream->resampler_padding_samples * sizeof (float));
+}
+
 static int
 SDL_AudioStreamPutInternal(SDL_AudioStream *stream, const void *buf, int len, int *maxputbytes)
 {
@@ -1000,6 +1316,8 @@ SDL_AudioStreamPutInternal(SDL_AudioStream *stream, const void *buf, int len, in
     Uint8 *workbuf;
     Uint8 *resamplebuf = NULL;
     int resamplebuflen = 0;
+    Uint8 *outbuf;
+    int outbuflen;
     int neededpaddingbytes;
     int paddingbytes;
 
@@ -1017,41 +1335,33 @@ SDL_AudioStreamPutInternal(SDL_AudioStream *stream, const void *buf, int len, in
     stream->first_run = SDL_FALSE;
 
     /* Make sure the work buffer can hold all the data we need at once... */
-    workbuflen = buflen;
-    if (stream->cvt_before_resampling.needed) {
-        workbuflen *= stream->cvt_before_resampling.len_mult;
-    }
-
-    if (stream->dst_rate != stream->src_rate) {
-        /* resamples can't happen in place, so make space for second buf. */
-        const int framesize = stream->pre_resample_channels * sizeof (float);
-        const int frames = workbuflen / framesize;
-        resamplebuflen = ((int) SDL_ceil(frames * stream->rate_incr)) * framesize;
-        #if DEBUG_AUDIOSTREAM
-        SDL_Log("AUDIOSTREAM: will resample %d bytes to %d (ratio=%.6f)\n", workbuflen, resamplebuflen, stream->rate_incr);
-        #endif
-        workbuflen += resamplebuflen;
-    }
-
-    if (stream->cvt_after_resampling.needed) {
-        /* !!! FIXME: buffer might be big enough already? */
-        workbuflen *= stream->cvt_after_resampling.len_mult;
-    }
-
-    workbuflen += neededpaddingbytes;
+    workbuflen = StreamWorkBufferLength(stream, buflen, &resamplebuflen, &outbuflen);
 
     #if DEBUG_AUDIOSTREAM
     SDL_Log("AUDIOSTREAM: Putting %d bytes of preconverted audio, need %d byte work buffer\n", buflen, workbuflen);
     #endif
 
-    workbuf = EnsureStreamBufferSize(stream, workbuflen);
-    if (!workbuf) {
+    /* The last step writes (or converts in place) straight into the ring
+       when there's a contiguous run of it free, saving a copy. */
+    if (EnsureStreamRingSpace(stream, outbuflen) < 0) {
         return -1;  /* probably out of memory. */
     }
+    outbuf = ReserveStreamOutput(stream, outbuflen);
+
+    if (outbuf && (stream->dst_rate == stream->src_rate)) {
+        workbuf = outbuf;  /* no resampling, so the whole conversion happens in the ring. */
+    } else {
+        workbuf = EnsureStreamBufferSize(stream, workbuflen);
+        if (!workbuf) {
+            return -1;  /* probably out of memory. */
+        }
+    }
 
     resamplebuf = workbuf;  /* default if not resampling. */
 
-    SDL_memcpy(workbuf + paddingbytes, buf, buflen);
+    if (buf != workbuf + paddingbytes) {  /* else it was written there through SDL_AudioStreamPutBuffer(). */
+        SDL_memcpy(workbuf + paddingbytes, buf, buflen);
+    }
 
     if (stream->cvt_before_resampling.needed) {
         stream->cvt_before_resampling.buf = workbuf + paddingbytes;
@@ -1080,7 +1390,7 @@ SDL_AudioStreamPutInternal(SDL_AudioStream *stream, const void *buf, int len, in
         /* save off the data at the end for the next run. */
         SDL_memcpy(stream->resampler_padding, workbuf + (buflen - neededpaddingbytes), neededpaddingbytes);
 
-        resamplebuf = workbuf + buflen;  /* skip to second piece of workbuf. */
+        resamplebuf = outbuf ? outbuf : workbuf + buflen;  /* else skip to second piece of workbuf. */
         SDL_assert(buflen >= neededpaddingbytes);
         if (buflen > neededpaddingbytes) {
             buflen = stream->resampler_func(stream, workbuf, buflen - neededpaddingbytes, resamplebuf, resamplebuflen);
@@ -1118,7 +1428,12 @@ SDL_AudioStreamPutInternal(SDL_AudioStream *stream, const void *buf, int len, in
     }
 
     /* resamplebuf holds the final output, even if we didn't resample. */
-    return buflen ? SDL_WriteToDataQueue(stream->queue, resamplebuf, buflen) : 0;
+    if (resamplebuf == outbuf) {
+        SDL_CommitRingBuffer(stream->ring, buflen);
+    } else {
+        SDL_WriteToRingBuffer(stream->ring, resamplebuf, buflen);
+    }
+    return 0;
 }
 
 int
@@ -1155,7 +1470,11 @@ SDL_AudioStreamPut(SDL_AudioStream *stream, const void *buf, int len)
         #if DEBUG_AUDIOSTREAM
         SDL_Log("AUDIOSTREAM: no conversion needed at all, queueing %d bytes.\n", len);
         #endif
-        return SDL_WriteToDataQueue(stream->queue, buf, len);
+        if (EnsureStreamRingSpace(stream, len) < 0) {
+            return -1;
+        }
+        SDL_WriteToRingBuffer(stream->ring, buf, len);
+        return 0;
     }
 
     while (len > 0) {
@@ -1189,6 +1508,28 @@ SDL_AudioStreamPut(SDL_AudioStream *stream, const void *buf, int len)
     return 0;
 }
 
+Uint8 *
+SDL_AudioStreamPutBuffer(SDL_AudioStream *stream, int len)
+{
+    int resamplebuflen, outbuflen;
+    Uint8 *workbuf;
+
+    /* Only when SDL_AudioStreamPut() would pass all of it right on to
+       SDL_AudioStreamPutInternal(), and that would convert it in the work
+       buffer rather than in the ring. */
+    if (!stream || (len <= 0) || ((len % stream->src_sample_frame_size) != 0) ||
+        stream->staging_buffer_filled || (len < stream->staging_buffer_size) ||
+        (stream->dst_rate == stream->src_rate)) {
+        return NULL;
+    }
+
+    workbuf = EnsureStreamBufferSize(stream, StreamWorkBufferLength(stream, len, &resamplebuflen, &outbuflen));
+    if (!workbuf) {
+        return NULL;
+    }
+    return stream->first_run ? workbuf : workbuf + (stream->resampler_padding_samples * sizeof (float));
+}
+
 int SDL_AudioStreamFlush(SDL_AudioStream *stream)
 {
     if (!stream) {
@@ -1262,14 +1603,43 @@ SDL_AudioStreamGet(SDL_AudioStream *stream, void *buf, int len)
         return SDL_SetError("Can't request partial sample frames");
     }
 
-    return (int) SDL_ReadFromDataQueue(stream->queue, buf, len);
+    return (int) SDL_ReadFromRingBuffer(stream->ring, buf, len);
+}
+
+Uint8 *
+SDL_AudioStreamPeek(SDL_AudioStream *stream, int len)
+{
+    size_t avail = 0;
+    const Uint8 *ptr;
+
+    if (!stream || (len <= 0) || ((len % stream->dst_sample_frame_size) != 0)) {
+        return NULL;
+    }
+    ptr = (const Uint8 *) SDL_PeekRingBuffer(stream->ring, &avail);
+    return (avail >= (size_t) len) ? (Uint8 *) ptr : NULL;
+}
+
+void
+SDL_AudioStreamDiscard(SDL_AudioStream *stream, int len)
+{
+    if (stream && (len > 0)) {
+        SDL_ConsumeRingBuffer(stream->ring, SDL_min((size_t) len, SDL_CountRingBuffer(stream->ring)));
+    }
+}
+
+void
+SDL_GetAudioStreamOutputFormat(SDL_AudioStream *stream, SDL_AudioFormat *format, Uint8 *channels, int *rate)
+{
+    *format = stream->dst_format;
+    *channels = stream->dst_channels;
+    *rate = stream->dst_rate;
 }
 
 /* number of converted/resampled bytes available */
 int
 SDL_AudioStreamAvailable(SDL_AudioStream *stream)
 {
-    return stream ? (int) SDL_CountDataQueue(stream->queue) : 0;
+    return stream ? (int) SDL_CountRingBuffer(stream->ring) : 0;
 }
 
 void
@@ -1278,7 +1648,7 @@ SDL_AudioStreamClear(SDL_AudioStream *stream)
     if (!stream) {
         SDL_InvalidParamError("stream");
     } else {
-        SDL_ClearDataQueue(stream->queue, stream->packetlen * 2);
+        SDL_ClearRingBuffer(stream->ring);
         if (stream->reset_resampler_func) {
             stream->reset_resampler_func(stream);
         }
@@ -1295,7 +1665,7 @@ SDL_FreeAudioStream(SDL_AudioStream *stream)
         if (stream->cleanup_resampler_func) {
             stream->cleanup_resampler_func(stream);
         }
-        SDL_FreeDataQueue(stream->queue);
+        SDL_FreeRingBuffer(stream->ring);
         SDL_free(stream->staging_buffer);
         SDL_free(stream->work_buffer_base);
         SDL_free(stream->resampler_padding);
@@ -47,10 +47,11 @@
 #endif
 
 static void
-test_device(const int iscapture, const char *fname, int flags, int (*test) (int fd))
+test_device(const int iscapture, const char *fname, int flags, int (*test) (int fd), const SDL_bool allow_files)
 {
     struct stat sb;
-    if ((stat(fname, &sb) == 0) && (S_ISCHR(sb.st_mode))) {
+    if ((stat(fname, &sb) == 0) &&
+        (S_ISCHR(sb.st_mode) || (allow_files && (S_ISFIFO(sb.st_mode) || S_ISREG(sb.st_mode))))) {
         const int audio_fd = open(fname, flags | O_CLOEXEC, 0);
         if (audio_fd >= 0) {
             const int okay = test(audio_fd);
@@ -83,6 +84,7 @@ SDL_EnumUnixAudioDevices_Internal(const int iscapture, const int classic, int (*
     const int flags = iscapture ? OPEN_FLAGS_INPUT : OPEN_FLAGS_OUTPUT;
     const char *audiodev;
     char audiopath[1024];
+    SDL_bool from_env = SDL_TRUE;
 
     if (test == NULL)
         test = test_stub;
@@ -90,6 +92,7 @@ SDL_EnumUnixAudioDevices_Internal(const int iscapture, const int classic, int (*
     /* Figure out what our audio device is */
     if (((audiodev = SDL_getenv("SDL_PATH_DSP")) == NULL) &&
         ((audiodev = SDL_getenv("AUDIODEV")) == NULL)) {
+        from_env = SDL_FALSE;
         if (classic) {
             audiodev = _PATH_DEV_AUDIO;
         } else {
@@ -105,7 +108,8 @@ SDL_EnumUnixAudioDevices_Internal(const int iscapture, const int classic, int (*
             }
         }
     }
-    test_device(iscapture, audiodev, flags, test);
+    /* A pipe or file named explicitly can stand in for the device, for testing. */
+    test_device(iscapture, audiodev, flags, test, from_env);
 
     if (SDL_strlen(audiodev) < (sizeof(audiopath) - 3)) {
         int instance = 0;
@@ -113,7 +117,7 @@ SDL_EnumUnixAudioDevices_Internal(const int iscapture, const int classic, int (*
             SDL_snprintf(audiopath, SDL_arraysize(audiopath),
                          "%s%d", audiodev, instance);
             instance++;
-            test_device(iscapture, audiopath, flags, test);
+            test_device(iscapture, audiopath, flags, test, SDL_FALSE);
         }
     }
 }
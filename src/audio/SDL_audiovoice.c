@@ -0,0 +1,661 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* Voices that SDL mixes itself, on top of whatever the device's callback (or
+   its queue) produced for the period.
+
+   The period is loaded into a float bus once, every playing voice is added to
+   it with its gains, and the bus is clamped and stored back once.  Voices
+   play from memory or from an SDL_AudioStream; both are read straight into
+   the bus a chunk at a time, so nothing is copied up front.
+
+   Everything here runs on the audio thread with the device lock held, and the
+   API functions take the same lock, so a voice never changes mid-period.
+ */
+
+#include "SDL_audio.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_sysaudio.h"
+
+#if defined(__SSE2__) && !defined(SDL_DISABLE_EMMINTRIN_H)
+#include <emmintrin.h>
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
+#ifdef __ARM_NEON
+#define HAVE_NEON_INTRINSICS 1
+#endif
+
+#define DIVBY128 0.0078125f
+#define DIVBY32768 0.000030517578125f
+#define DIVBY8388608 0.00000011920928955078125f
+
+struct SDL_AudioVoice
+{
+    SDL_AudioDevice *device;
+    SDL_AudioFormat format;     /* of the source samples */
+    Uint8 channels;
+    int frame_size;
+    const Uint8 *data;          /* in-memory source, or NULL */
+    Uint32 len;
+    Uint32 pos;
+    int loops;
+    SDL_AudioStream *stream;    /* stream source, or NULL */
+    float gain;
+    float pan;
+    SDL_bool paused;
+    struct SDL_AudioVoice *next;
+};
+
+static SDL_bool
+IsVoiceFormat(SDL_AudioFormat format)
+{
+    switch (format) {
+    case AUDIO_U8:
+    case AUDIO_S8:
+    case AUDIO_S16SYS:
+    case AUDIO_S32SYS:
+    case AUDIO_F32SYS:
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
+}
+
+/* Layout of device->voice_buffer: the bus, a float copy of one voice's
+   chunk, and room for a chunk as read from a stream. */
+#define VOICE_BUS(device)       ((float *) (device)->voice_buffer)
+#define VOICE_SCRATCH(device)   (VOICE_BUS(device) + (device)->callbackspec.samples * (device)->callbackspec.channels)
+#define VOICE_RAW(device)       ((Uint8 *) (VOICE_SCRATCH(device) + (device)->callbackspec.samples * 2))
+#define VOICE_BUFFER_SIZE(device) \
+    ((device)->callbackspec.samples * ((device)->callbackspec.channels + 2) * sizeof (float) + (device)->callbackspec.samples * 2 * 4)
+
+static void
+S16ToFloat(float *dst, const Sint16 *src, int n)
+{
+    int i = 0;
+
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        const __m128 scale = _mm_set1_ps(DIVBY32768);
+        for (; i + 8 <= n; i += 8) {
+            const __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+            const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+            const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+            _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+            _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+        }
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        const float32x4_t scale = vdupq_n_f32(DIVBY32768);
+        for (; i + 8 <= n; i += 8) {
+            const int16x8_t s = vld1q_s16(src + i);
+            vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s))), scale));
+            vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(s))), scale));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] = (float) src[i] * DIVBY32768;
+    }
+}
+
+/* Clamping happens here, once per period, however many voices were added */
+static void
+FloatToS16(Sint16 *dst, const float *src, int n)
+{
+    int i = 0;
+
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 minus_one = _mm_set1_ps(-1.0f);
+        const __m128 scale = _mm_set1_ps(32768.0f);
+        for (; i + 8 <= n; i += 8) {
+            const __m128 a = _mm_max_ps(_mm_min_ps(_mm_loadu_ps(src + i), one), minus_one);
+            const __m128 b = _mm_max_ps(_mm_min_ps(_mm_loadu_ps(src + i + 4), one), minus_one);
+            /* 1.0f becomes 32768, which the saturating pack turns into 32767 */
+            const __m128i ia = _mm_cvttps_epi32(_mm_mul_ps(a, scale));
+            const __m128i ib = _mm_cvttps_epi32(_mm_mul_ps(b, scale));
+            _mm_storeu_si128((__m128i *) (dst + i), _mm_packs_epi32(ia, ib));
+        }
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        const float32x4_t scale = vdupq_n_f32(32768.0f);
+        for (; i + 8 <= n; i += 8) {
+            /* float to int conversion saturates, and so does the narrowing */
+            const int32x4_t ia = vcvtq_s32_f32(vmulq_f32(vld1q_f32(src + i), scale));
+            const int32x4_t ib = vcvtq_s32_f32(vmulq_f32(vld1q_f32(src + i + 4), scale));
+            vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(ia), vqmovn_s32(ib)));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        const float f = src[i];
+        if (f >= 1.0f) {
+            dst[i] = SDL_MAX_SINT16;
+        } else if (f <= -1.0f) {
+            dst[i] = SDL_MIN_SINT16;
+        } else {
+            dst[i] = (Sint16) (f * 32768.0f);
+        }
+    }
+}
+
+static void
+ClampFloat(float *buf, int n)
+{
+    int i = 0;
+
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 minus_one = _mm_set1_ps(-1.0f);
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_ps(buf + i, _mm_max_ps(_mm_min_ps(_mm_loadu_ps(buf + i), one), minus_one));
+        }
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        const float32x4_t minus_one = vdupq_n_f32(-1.0f);
+        for (; i + 4 <= n; i += 4) {
+            vst1q_f32(buf + i, vmaxq_f32(vminq_f32(vld1q_f32(buf + i), one), minus_one));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (buf[i] > 1.0f) {
+            buf[i] = 1.0f;
+        } else if (buf[i] < -1.0f) {
+            buf[i] = -1.0f;
+        }
+    }
+}
+
+/* Returns the samples as floats, converted into dst unless they already are */
+static const float *
+SamplesToFloat(const Uint8 *src, SDL_AudioFormat format, float *dst, int n)
+{
+    int i;
+
+    switch (format) {
+    case AUDIO_F32SYS:
+        return (const float *) src;
+    case AUDIO_S16SYS:
+        S16ToFloat(dst, (const Sint16 *) src, n);
+        break;
+    case AUDIO_U8:
+        for (i = 0; i < n; ++i) {
+            dst[i] = (float) (src[i] - 128) * DIVBY128;
+        }
+        break;
+    case AUDIO_S8:
+        for (i = 0; i < n; ++i) {
+            dst[i] = (float) ((const Sint8 *) src)[i] * DIVBY128;
+        }
+        break;
+    case AUDIO_S32SYS:
+        for (i = 0; i < n; ++i) {
+            dst[i] = (float) (((const Sint32 *) src)[i] >> 8) * DIVBY8388608;
+        }
+        break;
+    default:
+        SDL_assert(!"unsupported voice format");
+        break;
+    }
+    return dst;
+}
+
+static void
+FloatToSamples(Uint8 *dst, SDL_AudioFormat format, float *src, int n)
+{
+    int i;
+
+    switch (format) {
+    case AUDIO_F32SYS:
+        ClampFloat(src, n);
+        if ((Uint8 *) src != dst) {
+            SDL_memcpy(dst, src, n * sizeof (float));
+        }
+        break;
+    case AUDIO_S16SYS:
+        FloatToS16((Sint16 *) dst, src, n);
+        break;
+    case AUDIO_U8:
+    case AUDIO_S8:
+        ClampFloat(src, n);
+        for (i = 0; i < n; ++i) {
+            const int s = (int) (src[i] * 128.0f);
+            const Sint8 s8 = (Sint8) (s > SDL_MAX_SINT8 ? SDL_MAX_SINT8 : s);
+            dst[i] = (format == AUDIO_U8) ? (Uint8) (s8 + 128) : (Uint8) s8;
+        }
+        break;
+    case AUDIO_S32SYS:
+        ClampFloat(src, n);
+        for (i = 0; i < n; ++i) {
+            ((Sint32 *) dst)[i] = (src[i] >= 1.0f) ? SDL_MAX_SINT32 : (Sint32) (src[i] * 2147483648.0f);
+        }
+        break;
+    default:
+        SDL_assert(!"unsupported voice format");
+        break;
+    }
+}
+
+/* Add one voice's chunk to the bus, spreading it to the bus channels.  The
+   samples are floats, or Sint16 converted on the fly so that the most common
+   format is mixed in a single pass. */
+#define SAMPLE(i)   (s16 ? (float) s16src[i] : fsrc[i])
+#if HAVE_SSE2_INTRINSICS
+#define SAMPLES_SSE(i) \
+    (s16 ? _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *) (s16src + (i))), \
+                                                             _mm_loadl_epi64((const __m128i *) (s16src + (i)))), 16)) \
+         : _mm_loadu_ps(fsrc + (i)))
+#endif
+#if HAVE_NEON_INTRINSICS
+#define SAMPLES_NEON(i) \
+    (s16 ? vcvtq_f32_s32(vmovl_s16(vld1_s16(s16src + (i)))) : vld1q_f32(fsrc + (i)))
+#endif
+
+static void
+Accumulate(float *bus, int buschannels, const void *samples, SDL_bool s16, int channels, int frames, const float *gains)
+{
+    const float *fsrc = (const float *) samples;
+    const Sint16 *s16src = (const Sint16 *) samples;
+    const float scale = s16 ? DIVBY32768 : 1.0f;
+    const float g0 = gains[0] * scale;
+    const float g1 = gains[1] * scale;
+    int i = 0;
+
+    if (channels == buschannels && channels <= 2) {
+        /* Same layout, the gains alternate for stereo and are equal for mono */
+        const int n = frames * channels;
+#if HAVE_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            const __m128 g = _mm_setr_ps(g0, g1, g0, g1);
+            for (; i + 8 <= n; i += 8) {
+                _mm_storeu_ps(bus + i, _mm_add_ps(_mm_loadu_ps(bus + i), _mm_mul_ps(SAMPLES_SSE(i), g)));
+                _mm_storeu_ps(bus + i + 4, _mm_add_ps(_mm_loadu_ps(bus + i + 4), _mm_mul_ps(SAMPLES_SSE(i + 4), g)));
+            }
+        }
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            const float32x4_t g = vcombine_f32(vset_lane_f32(g1, vdup_n_f32(g0), 1), vset_lane_f32(g1, vdup_n_f32(g0), 1));
+            for (; i + 8 <= n; i += 8) {
+                vst1q_f32(bus + i, vmlaq_f32(vld1q_f32(bus + i), SAMPLES_NEON(i), g));
+                vst1q_f32(bus + i + 4, vmlaq_f32(vld1q_f32(bus + i + 4), SAMPLES_NEON(i + 4), g));
+            }
+        }
+#endif
+        for (; i < n; ++i) {
+            bus[i] += SAMPLE(i) * ((i & 1) ? g1 : g0);
+        }
+    } else if (channels == 1 && buschannels == 2) {
+        /* Mono onto stereo: each sample goes to both sides */
+#if HAVE_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            const __m128 g = _mm_setr_ps(g0, g1, g0, g1);
+            for (; i + 4 <= frames; i += 4) {
+                const __m128 s = SAMPLES_SSE(i);
+                float *b = bus + i * 2;
+                _mm_storeu_ps(b, _mm_add_ps(_mm_loadu_ps(b), _mm_mul_ps(_mm_unpacklo_ps(s, s), g)));
+                _mm_storeu_ps(b + 4, _mm_add_ps(_mm_loadu_ps(b + 4), _mm_mul_ps(_mm_unpackhi_ps(s, s), g)));
+            }
+        }
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            const float32x4_t g = vcombine_f32(vset_lane_f32(g1, vdup_n_f32(g0), 1), vset_lane_f32(g1, vdup_n_f32(g0), 1));
+            for (; i + 4 <= frames; i += 4) {
+                const float32x4_t s = SAMPLES_NEON(i);
+                const float32x4x2_t ss = vzipq_f32(s, s);
+                float *b = bus + i * 2;
+                vst1q_f32(b, vmlaq_f32(vld1q_f32(b), ss.val[0], g));
+                vst1q_f32(b + 4, vmlaq_f32(vld1q_f32(b + 4), ss.val[1], g));
+            }
+        }
+#endif
+        for (; i < frames; ++i) {
+            const float s = SAMPLE(i);
+            bus[i * 2] += s * g0;
+            bus[i * 2 + 1] += s * g1;
+        }
+    } else if (buschannels == 1) {
+        /* Stereo onto mono */
+        for (; i < frames; ++i) {
+            bus[i] += SAMPLE(i * 2) * g0 + SAMPLE(i * 2 + 1) * g1;
+        }
+    } else {
+        /* Anything onto more than two channels goes to the front pair */
+        for (; i < frames; ++i) {
+            bus[i * buschannels] += SAMPLE(i * channels) * g0;
+            bus[i * buschannels + 1] += SAMPLE(i * channels + channels - 1) * g1;
+        }
+    }
+}
+
+#undef SAMPLE
+#undef SAMPLES_SSE
+#undef SAMPLES_NEON
+
+static void
+GetVoiceGains(const SDL_AudioVoice *voice, int buschannels, float *gains)
+{
+    if (buschannels == 1) {
+        /* no panning, stereo sources are averaged */
+        gains[0] = gains[1] = (voice->channels == 2) ? voice->gain * 0.5f : voice->gain;
+    } else {
+        /* panning only attenuates the opposite side */
+        gains[0] = voice->gain * ((voice->pan > 0.0f) ? 1.0f - voice->pan : 1.0f);
+        gains[1] = voice->gain * ((voice->pan < 0.0f) ? 1.0f + voice->pan : 1.0f);
+    }
+}
+
+static void
+MixVoice(SDL_AudioDevice *device, SDL_AudioVoice *voice, float *bus, int frames)
+{
+    const int buschannels = device->callbackspec.channels;
+    float *scratch = VOICE_SCRATCH(device);
+    float gains[2];
+
+    GetVoiceGains(voice, buschannels, gains);
+
+    while (frames > 0) {
+        const Uint8 *src;
+        int n;
+
+        if (voice->stream) {
+            const int got = SDL_AudioStreamGet(voice->stream, VOICE_RAW(device), frames * voice->frame_size);
+            if (got < voice->frame_size) {
+                return;  /* starved, or the stream failed; play what we have */
+            }
+            src = VOICE_RAW(device);
+            n = got / voice->frame_size;
+        } else if (voice->data && voice->len) {
+            if (voice->pos >= voice->len) {
+                if (voice->loops == 0) {
+                    return;
+                }
+                if (voice->loops > 0) {
+                    --voice->loops;
+                }
+                voice->pos = 0;
+            }
+            n = SDL_min((Uint32) frames, (voice->len - voice->pos) / voice->frame_size);
+            src = voice->data + voice->pos;
+            voice->pos += n * voice->frame_size;
+        } else {
+            return;
+        }
+
+        if (voice->format == AUDIO_S16SYS) {
+            Accumulate(bus, buschannels, src, SDL_TRUE, voice->channels, n, gains);
+        } else {
+            Accumulate(bus, buschannels, SamplesToFloat(src, voice->format, scratch, n * voice->channels),
+                       SDL_FALSE, voice->channels, n, gains);
+        }
+        bus += n * buschannels;
+        frames -= n;
+    }
+}
+
+void
+SDL_MixAudioVoices(SDL_AudioDevice *device, Uint8 *data, int len)
+{
+    const SDL_AudioFormat format = device->callbackspec.format;
+    const int channels = device->callbackspec.channels;
+    const int frames = len / ((SDL_AUDIO_BITSIZE(format) / 8) * channels);
+    /* a float device is mixed in place */
+    float *bus = (format == AUDIO_F32SYS) ? (float *) data : VOICE_BUS(device);
+    SDL_bool mixed = SDL_FALSE;
+    SDL_AudioVoice *voice;
+
+    for (voice = device->voices; voice; voice = voice->next) {
+        if (voice->paused) {
+            continue;
+        }
+        if (!mixed) {
+            if ((const float *) data != bus) {
+                const float *samples = SamplesToFloat(data, format, bus, frames * channels);
+                SDL_assert(samples == bus);
+                (void) samples;
+            }
+            mixed = SDL_TRUE;
+        }
+        MixVoice(device, voice, bus, frames);
+    }
+
+    if (mixed) {
+        FloatToSamples(data, format, bus, frames * channels);
+    }
+}
+
+void
+SDL_FreeAudioVoices(SDL_AudioDevice *device)
+{
+    SDL_AudioVoice *voice = device->voices;
+
+    while (voice) {
+        SDL_AudioVoice *next = voice->next;
+        SDL_free(voice);
+        voice = next;
+    }
+    device->voices = NULL;
+    SDL_free(device->voice_buffer);
+    device->voice_buffer = NULL;
+}
+
+SDL_AudioVoice *
+SDL_CreateAudioVoice(SDL_AudioDeviceID devid)
+{
+    SDL_AudioDevice *device = SDL_GetAudioDeviceFromID(devid);
+    SDL_AudioVoice *voice;
+
+    if (!device) {
+        return NULL;
+    }
+    if (device->iscapture) {
+        SDL_SetError("Audio voices need a playback device");
+        return NULL;
+    }
+    if (!IsVoiceFormat(device->callbackspec.format)) {
+        SDL_SetError("Audio voices don't support the device's format");
+        return NULL;
+    }
+
+    voice = (SDL_AudioVoice *) SDL_calloc(1, sizeof (*voice));
+    if (!voice) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    voice->device = device;
+    voice->gain = 1.0f;
+    voice->paused = SDL_TRUE;
+
+    SDL_LockAudioDevice(devid);
+    if (!device->voice_buffer) {
+        device->voice_buffer = (Uint8 *) SDL_malloc(VOICE_BUFFER_SIZE(device));
+        if (!device->voice_buffer) {
+            SDL_UnlockAudioDevice(devid);
+            SDL_free(voice);
+            SDL_OutOfMemory();
+            return NULL;
+        }
+    }
+    voice->next = device->voices;
+    device->voices = voice;
+    SDL_UnlockAudioDevice(devid);
+
+    return voice;
+}
+
+int
+SDL_SetAudioVoiceData(SDL_AudioVoice *voice, SDL_AudioFormat format, Uint8 channels,
+                      const void *data, Uint32 len, int loops)
+{
+    if (!voice) {
+        return SDL_InvalidParamError("voice");
+    }
+    if (!IsVoiceFormat(format)) {
+        return SDL_SetError("Unsupported audio voice format");
+    }
+    if (channels != 1 && channels != 2) {
+        return SDL_InvalidParamError("channels");
+    }
+    if (!data && len) {
+        return SDL_InvalidParamError("data");
+    }
+
+    SDL_LockAudioDevice(voice->device->id);
+    voice->stream = NULL;
+    voice->format = format;
+    voice->channels = channels;
+    voice->frame_size = (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+    voice->data = (const Uint8 *) data;
+    voice->len = len - (len % voice->frame_size);
+    voice->pos = 0;
+    voice->loops = loops;
+    SDL_UnlockAudioDevice(voice->device->id);
+
+    return 0;
+}
+
+int
+SDL_SetAudioVoiceStream(SDL_AudioVoice *voice, SDL_AudioStream *stream)
+{
+    SDL_AudioFormat format = 0;
+    Uint8 channels = 0;
+    int rate = 0;
+
+    if (!voice) {
+        return SDL_InvalidParamError("voice");
+    }
+    if (stream) {
+        SDL_GetAudioStreamOutputFormat(stream, &format, &channels, &rate);
+        if (!IsVoiceFormat(format)) {
+            return SDL_SetError("Unsupported audio voice format");
+        }
+        if (channels != 1 && channels != 2) {
+            return SDL_SetError("Audio voice streams must output mono or stereo");
+        }
+        if (rate != voice->device->callbackspec.freq) {
+            return SDL_SetError("Audio voice streams must output the device's frequency");
+        }
+    }
+
+    SDL_LockAudioDevice(voice->device->id);
+    voice->data = NULL;
+    voice->len = voice->pos = 0;
+    voice->stream = stream;
+    if (stream) {
+        voice->format = format;
+        voice->channels = channels;
+        voice->frame_size = (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+    }
+    SDL_UnlockAudioDevice(voice->device->id);
+
+    return 0;
+}
+
+int
+SDL_SetAudioVoiceGain(SDL_AudioVoice *voice, float gain, float pan)
+{
+    if (!voice) {
+        return SDL_InvalidParamError("voice");
+    }
+
+    SDL_LockAudioDevice(voice->device->id);
+    voice->gain = SDL_max(gain, 0.0f);
+    voice->pan = SDL_clamp(pan, -1.0f, 1.0f);
+    SDL_UnlockAudioDevice(voice->device->id);
+
+    return 0;
+}
+
+int
+SDL_PauseAudioVoice(SDL_AudioVoice *voice, int pause_on)
+{
+    if (!voice) {
+        return SDL_InvalidParamError("voice");
+    }
+
+    SDL_LockAudioDevice(voice->device->id);
+    voice->paused = pause_on ? SDL_TRUE : SDL_FALSE;
+    SDL_UnlockAudioDevice(voice->device->id);
+
+    return 0;
+}
+
+SDL_AudioStatus
+SDL_GetAudioVoiceStatus(SDL_AudioVoice *voice)
+{
+    SDL_AudioStatus status = SDL_AUDIO_STOPPED;
+
+    if (!voice) {
+        SDL_InvalidParamError("voice");
+        return SDL_AUDIO_STOPPED;
+    }
+
+    SDL_LockAudioDevice(voice->device->id);
+    if (voice->stream) {
+        if (SDL_AudioStreamAvailable(voice->stream) > 0) {
+            status = voice->paused ? SDL_AUDIO_PAUSED : SDL_AUDIO_PLAYING;
+        }
+    } else if (voice->data && voice->len && (voice->pos < voice->len || voice->loops != 0)) {
+        status = voice->paused ? SDL_AUDIO_PAUSED : SDL_AUDIO_PLAYING;
+    }
+    SDL_UnlockAudioDevice(voice->device->id);
+
+    return status;
+}
+
+void
+SDL_DestroyAudioVoice(SDL_AudioVoice *voice)
+{
+    SDL_AudioDevice *device;
+    SDL_AudioVoice **prev;
+
+    if (!voice) {
+        return;
+    }
+
+    device = voice->device;
+    SDL_LockAudioDevice(device->id);
+    for (prev = &device->voices; *prev; prev = &(*prev)->next) {
+        if (*prev == voice) {
+            *prev = voice->next;
+            break;
+        }
+    }
+    SDL_UnlockAudioDevice(device->id);
+
+    SDL_free(voice);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -27,6 +27,15 @@
 #include "SDL_audio.h"
 #include "SDL_sysaudio.h"
 
+#if defined(__SSE2__) && !defined(SDL_DISABLE_EMMINTRIN_H)
+#include <emmintrin.h>
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
+#ifdef __ARM_NEON
+#define HAVE_NEON_INTRINSICS 1
+#endif
+
 /* This table is used to add two sound values together and pin
  * the value to avoid overflow.  (used with permission from ARDI)
  */
@@ -85,6 +94,234 @@ static const Uint8 mix8[] = {
 #define ADJUST_VOLUME_U8(s, v)  (s = (((s-128)*v)/SDL_MIX_MAXVOLUME)+128)
 #define ADJUST_VOLUME_U16(s, v)  (s = (((s-32768)*v)/SDL_MIX_MAXVOLUME)+32768)
 
+/* Native-endian S16, S32 and F32 are mixed a block at a time with SSE2 or
+   NEON.  The kernels give exactly what the scalar loops below give: the
+   volume still divides by SDL_MIX_MAXVOLUME rounding toward zero, and the
+   add saturates.  Each kernel first mixes samples one at a time until dst is
+   16-byte aligned, and returns how many samples it did; the scalar loops
+   finish the tail.  Volumes above SDL_MIX_MAXVOLUME stay on the scalar path,
+   so the integer products can't overflow.
+ */
+static SDL_INLINE Sint16
+MixSampleS16(Sint16 src, Sint16 dst, int volume)
+{
+    const int sample = ((src * volume) / SDL_MIX_MAXVOLUME) + dst;
+    return (Sint16) SDL_clamp(sample, SDL_MIN_SINT16, SDL_MAX_SINT16);
+}
+
+static SDL_INLINE Sint32
+MixSampleS32(Sint32 src, Sint32 dst, int volume)
+{
+    const Sint64 sample = (((Sint64) src * volume) / SDL_MIX_MAXVOLUME) + dst;
+    return (Sint32) SDL_clamp(sample, SDL_MIN_SINT32, SDL_MAX_SINT32);
+}
+
+static SDL_INLINE float
+MixSampleF32(float src, float dst, float fvolume)
+{
+    const double sample = ((double) ((src * fvolume) * (1.0f / ((float) SDL_MIX_MAXVOLUME)))) + ((double) dst);
+    return (float) SDL_clamp(sample, -3.402823466e+38F, 3.402823466e+38F);
+}
+
+#define MIX_ALIGN_DST(mix, vol) \
+    for (i = 0; i < num_samples && ((uintptr_t) (dst + i) & 15); ++i) { \
+        dst[i] = mix(src[i], dst[i], vol); \
+    }
+
+#if HAVE_SSE2_INTRINSICS
+static Uint32
+MixAudio_S16_SSE2(Sint16 *dst, const Sint16 *src, Uint32 num_samples, int volume)
+{
+    const __m128i vol = _mm_set1_epi16((Sint16) volume);
+    const __m128i bias = _mm_set1_epi32(SDL_MIX_MAXVOLUME - 1);
+    Uint32 i;
+
+    MIX_ALIGN_DST(MixSampleS16, volume);
+    for (; i + 8 <= num_samples; i += 8) {
+        const __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        const __m128i lo = _mm_mullo_epi16(s, vol);
+        const __m128i hi = _mm_mulhi_epi16(s, vol);
+        __m128i s0 = _mm_unpacklo_epi16(lo, hi);
+        __m128i s1 = _mm_unpackhi_epi16(lo, hi);
+
+        /* divide by 128, biasing negative products so it truncates like C */
+        s0 = _mm_srai_epi32(_mm_add_epi32(s0, _mm_and_si128(_mm_srai_epi32(s0, 31), bias)), 7);
+        s1 = _mm_srai_epi32(_mm_add_epi32(s1, _mm_and_si128(_mm_srai_epi32(s1, 31), bias)), 7);
+        _mm_store_si128((__m128i *) (dst + i),
+                        _mm_adds_epi16(_mm_packs_epi32(s0, s1), _mm_load_si128((const __m128i *) (dst + i))));
+    }
+    return i;
+}
+
+static Uint32
+MixAudio_S32_SSE2(Sint32 *dst, const Sint32 *src, Uint32 num_samples, int volume)
+{
+    const __m128i vol = _mm_set1_epi32(volume);
+    const __m128i low7 = _mm_set1_epi32(SDL_MIX_MAXVOLUME - 1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi32(SDL_MAX_SINT32);
+    Uint32 i;
+
+    MIX_ALIGN_DST(MixSampleS32, volume);
+    for (; i + 4 <= num_samples; i += 4) {
+        const __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        const __m128i d = _mm_load_si128((const __m128i *) (dst + i));
+        const __m128i neg = _mm_srai_epi32(s, 31);
+        /* s * volume / 128 without 64-bit lanes: split s into (s >> 7) * 128
+           + (s & 127).  The high part times volume fits 32 bits, and the low
+           part times volume fits the low 16 bits of each lane. */
+        const __m128i hi = _mm_srai_epi32(s, 7);
+        const __m128i rem = _mm_mullo_epi16(_mm_and_si128(s, low7), vol);
+        const __m128i even = _mm_mul_epu32(hi, vol);
+        const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(hi, 32), vol);
+        __m128i v = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                       _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+        __m128i sum, overflow;
+
+        v = _mm_add_epi32(v, _mm_srai_epi32(rem, 7));
+        /* round toward zero: negative samples with a remainder go up one */
+        v = _mm_sub_epi32(v, _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(rem, low7), zero), neg));
+
+        /* saturating add: overflow only when both signs agree and the sum's differs */
+        sum = _mm_add_epi32(v, d);
+        overflow = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(sum, v), _mm_xor_si128(sum, d)), 31);
+        sum = _mm_or_si128(_mm_andnot_si128(overflow, sum),
+                           _mm_and_si128(overflow, _mm_xor_si128(_mm_srai_epi32(v, 31), max)));
+        _mm_store_si128((__m128i *) (dst + i), sum);
+    }
+    return i;
+}
+
+static Uint32
+MixAudio_F32_SSE2(float *dst, const float *src, Uint32 num_samples, float fvolume)
+{
+    const __m128 vol = _mm_set1_ps(fvolume);
+    const __m128 maxvol = _mm_set1_ps(1.0f / ((float) SDL_MIX_MAXVOLUME));
+    const __m128 max = _mm_set1_ps(3.402823466e+38F);
+    const __m128 min = _mm_set1_ps(-3.402823466e+38F);
+    Uint32 i;
+
+    MIX_ALIGN_DST(MixSampleF32, fvolume);
+    for (; i + 4 <= num_samples; i += 4) {
+        const __m128 s = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(src + i), vol), maxvol);
+        /* A float add rounds the same as adding in double and converting;
+           min/max only catch the overflow to infinity.  NaNs are in the
+           second operand so they pass through, as they do in C. */
+        const __m128 sum = _mm_add_ps(s, _mm_load_ps(dst + i));
+        _mm_store_ps(dst + i, _mm_max_ps(min, _mm_min_ps(max, sum)));
+    }
+    return i;
+}
+#endif
+
+#if HAVE_NEON_INTRINSICS
+static Uint32
+MixAudio_S16_NEON(Sint16 *dst, const Sint16 *src, Uint32 num_samples, int volume)
+{
+    const int32x4_t bias = vdupq_n_s32(SDL_MIX_MAXVOLUME - 1);
+    Uint32 i;
+
+    MIX_ALIGN_DST(MixSampleS16, volume);
+    for (; i + 8 <= num_samples; i += 8) {
+        const int16x8_t s = vld1q_s16(src + i);
+        int32x4_t s0 = vmull_n_s16(vget_low_s16(s), (int16_t) volume);
+        int32x4_t s1 = vmull_n_s16(vget_high_s16(s), (int16_t) volume);
+
+        /* divide by 128, biasing negative products so it truncates like C */
+        s0 = vaddq_s32(s0, vandq_s32(vshrq_n_s32(s0, 31), bias));
+        s1 = vaddq_s32(s1, vandq_s32(vshrq_n_s32(s1, 31), bias));
+        vst1q_s16(dst + i, vqaddq_s16(vcombine_s16(vshrn_n_s32(s0, 7), vshrn_n_s32(s1, 7)), vld1q_s16(dst + i)));
+    }
+    return i;
+}
+
+static Uint32
+MixAudio_S32_NEON(Sint32 *dst, const Sint32 *src, Uint32 num_samples, int volume)
+{
+    const int64x2_t bias = vdupq_n_s64(SDL_MIX_MAXVOLUME - 1);
+    const int32x2_t vol = vdup_n_s32(volume);
+    Uint32 i;
+
+    MIX_ALIGN_DST(MixSampleS32, volume);
+    for (; i + 4 <= num_samples; i += 4) {
+        const int32x4_t s = vld1q_s32(src + i);
+        int64x2_t s0 = vmull_s32(vget_low_s32(s), vol);
+        int64x2_t s1 = vmull_s32(vget_high_s32(s), vol);
+
+        s0 = vaddq_s64(s0, vandq_s64(vshrq_n_s64(s0, 63), bias));
+        s1 = vaddq_s64(s1, vandq_s64(vshrq_n_s64(s1, 63), bias));
+        vst1q_s32(dst + i, vqaddq_s32(vcombine_s32(vshrn_n_s64(s0, 7), vshrn_n_s64(s1, 7)), vld1q_s32(dst + i)));
+    }
+    return i;
+}
+
+static Uint32
+MixAudio_F32_NEON(float *dst, const float *src, Uint32 num_samples, float fvolume)
+{
+    const float32x4_t max = vdupq_n_f32(3.402823466e+38F);
+    const float32x4_t min = vdupq_n_f32(-3.402823466e+38F);
+    Uint32 i;
+
+    /* 32-bit ARM NEON flushes denormals to zero; those are the only inputs
+       where this can differ from the scalar loop. */
+    MIX_ALIGN_DST(MixSampleF32, fvolume);
+    for (; i + 4 <= num_samples; i += 4) {
+        const float32x4_t s = vmulq_n_f32(vmulq_n_f32(vld1q_f32(src + i), fvolume), 1.0f / ((float) SDL_MIX_MAXVOLUME));
+        const float32x4_t sum = vaddq_f32(s, vld1q_f32(dst + i));
+        vst1q_f32(dst + i, vmaxq_f32(vminq_f32(sum, max), min));
+    }
+    return i;
+}
+#endif
+
+static Uint32
+MixAudio_S16_SIMD(Sint16 *dst, const Sint16 *src, Uint32 num_samples, int volume)
+{
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return MixAudio_S16_SSE2(dst, src, num_samples, volume);
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return MixAudio_S16_NEON(dst, src, num_samples, volume);
+    }
+#endif
+    return 0;
+}
+
+static Uint32
+MixAudio_S32_SIMD(Sint32 *dst, const Sint32 *src, Uint32 num_samples, int volume)
+{
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return MixAudio_S32_SSE2(dst, src, num_samples, volume);
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return MixAudio_S32_NEON(dst, src, num_samples, volume);
+    }
+#endif
+    return 0;
+}
+
+static Uint32
+MixAudio_F32_SIMD(float *dst, const float *src, Uint32 num_samples, float fvolume)
+{
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return MixAudio_F32_SSE2(dst, src, num_samples, fvolume);
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return MixAudio_F32_NEON(dst, src, num_samples, fvolume);
+    }
+#endif
+    return 0;
+}
+
 
 void
 SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
@@ -144,6 +381,14 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
             const int min_audioval = SDL_MIN_SINT16;
 
             len /= 2;
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            if (volume <= SDL_MIX_MAXVOLUME) {
+                const Uint32 done = MixAudio_S16_SIMD((Sint16 *) dst, (const Sint16 *) src, len, volume);
+                src += done * 2;
+                dst += done * 2;
+                len -= done;
+            }
+#endif
             while (len--) {
                 src1 = SDL_SwapLE16(*(Sint16 *)src);
                 ADJUST_VOLUME(src1, volume);
@@ -169,6 +414,14 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
             const int min_audioval = SDL_MIN_SINT16;
 
             len /= 2;
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+            if (volume <= SDL_MIX_MAXVOLUME) {
+                const Uint32 done = MixAudio_S16_SIMD((Sint16 *) dst, (const Sint16 *) src, len, volume);
+                src += done * 2;
+                dst += done * 2;
+                len -= done;
+            }
+#endif
             while (len--) {
                 src1 = SDL_SwapBE16(*(Sint16 *)src);
                 ADJUST_VOLUME(src1, volume);
@@ -248,6 +501,14 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
             const Sint64 min_audioval = SDL_MIN_SINT32;
 
             len /= 4;
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            if (volume <= SDL_MIX_MAXVOLUME) {
+                const Uint32 done = MixAudio_S32_SIMD((Sint32 *) dst32, (const Sint32 *) src32, len, volume);
+                src32 += done;
+                dst32 += done;
+                len -= done;
+            }
+#endif
             while (len--) {
                 src1 = (Sint64) ((Sint32) SDL_SwapLE32(*src32));
                 src32++;
@@ -274,6 +535,14 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
             const Sint64 min_audioval = SDL_MIN_SINT32;
 
             len /= 4;
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+            if (volume <= SDL_MIX_MAXVOLUME) {
+                const Uint32 done = MixAudio_S32_SIMD((Sint32 *) dst32, (const Sint32 *) src32, len, volume);
+                src32 += done;
+                dst32 += done;
+                len -= done;
+            }
+#endif
             while (len--) {
                 src1 = (Sint64) ((Sint32) SDL_SwapBE32(*src32));
                 src32++;
@@ -303,6 +572,14 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
             const double min_audioval = -3.402823466e+38F;
 
             len /= 4;
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            {
+                const Uint32 done = MixAudio_F32_SIMD(dst32, src32, len, fvolume);
+                src32 += done;
+                dst32 += done;
+                len -= done;
+            }
+#endif
             while (len--) {
                 src1 = ((SDL_SwapFloatLE(*src32) * fvolume) * fmaxvolume);
                 src2 = SDL_SwapFloatLE(*dst32);
@@ -332,6 +609,14 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
             const double min_audioval = -3.402823466e+38F;
 
             len /= 4;
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+            {
+                const Uint32 done = MixAudio_F32_SIMD(dst32, src32, len, fvolume);
+                src32 += done;
+                dst32 += done;
+                len -= done;
+            }
+#endif
             while (len--) {
                 src1 = ((SDL_SwapFloatBE(*src32) * fvolume) * fmaxvolume);
                 src2 = SDL_SwapFloatBE(*dst32);
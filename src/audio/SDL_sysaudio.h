@@ -25,7 +25,7 @@
 
 #include "SDL_mutex.h"
 #include "SDL_thread.h"
-#include "../SDL_dataqueue.h"
+#include "../SDL_ringbuffer.h"
 #include "./SDL_audio_c.h"
 
 /* !!! FIXME: These are wordy and unlocalized... */
@@ -51,16 +51,13 @@ extern void SDL_RemoveAudioDevice(const SDL_bool iscapture, void *handle);
    as appropriate so SDL's list of devices is accurate. */
 extern void SDL_OpenedAudioDeviceDisconnected(SDL_AudioDevice *device);
 
-/* This is the size of a packet when using SDL_QueueAudio(). We allocate
-   these as necessary and pool them, under the assumption that we'll
-   eventually end up with a handful that keep recycling, meeting whatever
-   the app needs. We keep packing data tightly as more arrives to avoid
-   wasting space, and if we get a giant block of data, we'll split them
-   into multiple packets behind the scenes. My expectation is that most
-   apps will have 2-3 of these in the pool. 8k should cover most needs, but
-   if this is crippling for some embedded system, we can #ifdef this.
-   The system preallocates enough packets for 2 callbacks' worth of data. */
-#define SDL_AUDIOBUFFERQUEUE_PACKETLEN (8 * 1024)
+/* Look up an open device, setting the error if there isn't one. */
+extern SDL_AudioDevice *SDL_GetAudioDeviceFromID(SDL_AudioDeviceID id);
+
+/* Mix the device's playing voices into a period of callback output, and
+   free them when the device is closed.  Both are in SDL_audiovoice.c */
+extern void SDL_MixAudioVoices(SDL_AudioDevice *device, Uint8 *data, int len);
+extern void SDL_FreeAudioVoices(SDL_AudioDevice *device);
 
 typedef struct SDL_AudioDriverImpl
 {
@@ -79,6 +76,10 @@ typedef struct SDL_AudioDriverImpl
     void (*FreeDeviceHandle) (void *handle);  /**< SDL is done with handle from SDL_AddAudioDevice() */
     void (*Deinitialize) (void);
     int (*GetDefaultAudioInfo) (char **name, SDL_AudioSpec *spec, int iscapture);
+    void (*GetDeviceXruns) (_THIS, Uint32 *underruns, Uint32 *overruns);  /**< add any since the last call. Optional. */
+    int (*GetCaptureBacklog) (_THIS);  /**< bytes captured but not read yet. Optional. */
+    int (*GetPlaybackDelay) (_THIS);  /**< bytes written but not played yet. Optional. */
+    void (*PlayDeviceBuffer) (_THIS, const Uint8 *buffer, int buflen);  /**< PlayDevice(), but buflen bytes from buffer; a period may come in two calls. Optional. */
 
     /* !!! FIXME: add pause(), so we can optimize instead of mixing silence. */
 
@@ -126,6 +127,14 @@ typedef struct SDL_AudioDriver
 } SDL_AudioDriver;
 
 
+/* What SDL_QueueAudio() does when the queue is full; see SDL_HINT_AUDIO_QUEUE_OVERFLOW. */
+typedef enum
+{
+    SDL_AUDIOQUEUE_GROW,
+    SDL_AUDIOQUEUE_BLOCK,
+    SDL_AUDIOQUEUE_DROP
+} SDL_AudioQueueOverflow;
+
 /* Define the SDL audio driver structure */
 struct SDL_AudioDevice
 {
@@ -142,11 +151,27 @@ struct SDL_AudioDevice
     /* Stream that converts and resamples. NULL if not needed. */
     SDL_AudioStream *stream;
 
+    /* Playback that only changes format and channels skips the stream and
+       converts the callback's output in place with this, inside the device
+       buffer if convert_in_device_buf, else in work_buffer. */
+    SDL_AudioCVT convert;
+    SDL_bool convert_in_device_buf;
+
     /* Current state flags */
     SDL_atomic_t shutdown; /* true if we are signaling the play thread to end. */
     SDL_atomic_t enabled;  /* true if device is functioning and connected. */
     SDL_atomic_t paused;
     SDL_bool iscapture;
+    SDL_bool low_latency_capture;  /* SDL_HINT_AUDIO_CAPTURE_LOW_LATENCY; set before OpenDevice(). */
+
+    /* Performance counter when the capture callback's first sample frame was captured. */
+    Uint64 capture_timestamp;
+
+    /* Playback position, measured by the audio thread after each period it
+       plays. Only the audio thread writes it, so a spinlock is enough. */
+    SDL_SpinLock clock_lock;
+    SDL_AudioClock clock;
+    Uint64 frames_written;
 
     /* Scratch buffer used in the bridge between SDL and the user callback. */
     Uint8 *work_buffer;
@@ -161,8 +186,44 @@ struct SDL_AudioDevice
     SDL_Thread *thread;
     SDL_threadID threadid;
 
-    /* Queued buffers (if app not using callback). */
-    SDL_DataQueue *buffer_queue;
+    /* Queued buffers (if app not using callback). The audio thread's side of
+       the ring runs under mixer_lock as always; the app's side only takes
+       queue_lock, so neither waits for the other unless the ring must grow. */
+    SDL_RingBuffer *buffer_queue;
+    SDL_mutex *queue_lock;
+    SDL_AudioQueueOverflow queue_overflow;
+    SDL_AudioQueueStats queue_stats;  /* each field has one writer, for each direction. */
+
+    /* Playback queue space, for SDL_WaitAudioQueueSpace(): the waiter stores
+       the bytes it wants in queue_space_wanted, and whoever frees them (or
+       pauses, disconnects or closes the device) takes the request back and
+       posts queue_space_sem. Waiters hold queue_wait_lock, so there's only
+       ever one. queue_pinned has bit 0 set while the audio thread plays
+       straight out of the ring, outside mixer_lock, and bit 1 while growing
+       or clearing the ring waits for it on queue_unpin_sem; it isn't pinned
+       again until that is done. */
+    SDL_mutex *queue_wait_lock;
+    SDL_sem *queue_space_sem;
+    SDL_atomic_t queue_space_wanted;
+    SDL_sem *queue_unpin_sem;
+    SDL_atomic_t queue_pinned;
+
+    /* Audio thread counters, updated under mixer_lock. */
+    SDL_AudioDeviceStats stats;
+
+    /* Timing, if SDL_HINT_AUDIO_TIMING was set. The audio thread gathers a
+       callback run's worth in timing_pending, and adds that to timing under
+       mixer_lock. */
+    SDL_bool timing_enabled;
+    SDL_AudioTimingStats timing;
+    SDL_AudioTimingStats timing_pending;
+    Uint64 timing_last_period;  /* performance counter at the last period's start, or 0. */
+    Uint32 timing_log_interval;  /* milliseconds, 0 to not log. */
+    Uint64 timing_next_log;
+
+    /* Voices mixed on top of the callback's output, and their mixing buffer. */
+    SDL_AudioVoice *voices;
+    Uint8 *voice_buffer;
 
     /* * * */
     /* Data private to this driver */
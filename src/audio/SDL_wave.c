@@ -101,6 +101,39 @@ typedef struct MS_ADPCM_ChannelState
     Sint16 coeff2;
 } MS_ADPCM_ChannelState;
 
+static const Uint16 ms_adpcm_adaptive[16] = {
+    230, 230, 230, 230, 307, 409, 512, 614,
+    768, 614, 512, 409, 307, 230, 230, 230
+};
+
+static const Sint8 ima_adpcm_index_table_4b[16] = {
+    -1, -1, -1, -1,
+    2, 4, 6, 8,
+    -1, -1, -1, -1,
+    2, 4, 6, 8
+};
+
+static const Uint16 ima_adpcm_step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
+    34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130,
+    143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
+    449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282,
+    1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
+    9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350,
+    22385, 24623, 27086, 29794, 32767
+};
+
+/* IMA_ADPCM_ProcessNibble() precomputed for every step index and nibble. The
+ * entry for step index i and nibble n is at i * 16 + n. The next index is
+ * stored premultiplied by 16 and already clamped.
+ */
+typedef struct IMA_ADPCM_DecoderData
+{
+    Sint32 delta[89 * 16];
+    Uint16 next[89 * 16];
+} IMA_ADPCM_DecoderData;
+
 #ifdef SDL_WAVE_DEBUG_LOG_FORMAT
 static void
 WaveDebugLogFormat(WaveFile *file)
@@ -496,10 +529,6 @@ MS_ADPCM_ProcessNibble(MS_ADPCM_ChannelState *cstate, Sint32 sample1, Sint32 sam
     const Sint32 max_audioval = 32767;
     const Sint32 min_audioval = -32768;
     const Uint16 max_deltaval = 65535;
-    const Uint16 adaptive[] = {
-        230, 230, 230, 230, 307, 409, 512, 614,
-        768, 614, 512, 409, 307, 230, 230, 230
-    };
     Sint32 new_sample;
     Sint32 errordelta;
     Uint32 delta = cstate->delta;
@@ -513,7 +542,7 @@ MS_ADPCM_ProcessNibble(MS_ADPCM_ChannelState *cstate, Sint32 sample1, Sint32 sam
     } else if (new_sample > max_audioval) {
         new_sample = max_audioval;
     }
-    delta = (delta * adaptive[nybble]) / 256;
+    delta = (delta * ms_adpcm_adaptive[nybble]) / 256;
     if (delta < 16) {
         delta = 16;
     } else if (delta > max_deltaval) {
@@ -607,6 +636,63 @@ MS_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
         blockframesleft = state->framesleft;
     }
 
+    /* Whole bytes of input are decoded with the channel state and the last
+     * two samples kept in locals. The nibbles of a stereo byte belong to the
+     * two channels, so their dependency chains get interleaved. The loop
+     * below takes care of what's left.
+     */
+    if (channels == 2) {
+        MS_ADPCM_ChannelState left = cstate[0];
+        MS_ADPCM_ChannelState right = cstate[1];
+        Sint32 left1 = state->output.data[outpos - 2];
+        Sint32 left2 = state->output.data[outpos - 4];
+        Sint32 right1 = state->output.data[outpos - 1];
+        Sint32 right2 = state->output.data[outpos - 3];
+        size_t frames = (size_t)SDL_min(blockframesleft, (Sint64)(blocksize - blockpos));
+        Sint16 *out = state->output.data + outpos;
+        Sint16 *end = out + frames * 2;
+
+        while (out < end) {
+            const Uint8 byte = state->block.data[blockpos++];
+            const Sint16 newleft = MS_ADPCM_ProcessNibble(&left, left1, left2, byte >> 4);
+            const Sint16 newright = MS_ADPCM_ProcessNibble(&right, right1, right2, byte & 0x0f);
+            left2 = left1;
+            left1 = newleft;
+            right2 = right1;
+            right1 = newright;
+            out[0] = newleft;
+            out[1] = newright;
+            out += 2;
+        }
+
+        cstate[0] = left;
+        cstate[1] = right;
+        outpos += frames * 2;
+        state->framesleft -= frames;
+        blockframesleft -= frames;
+    } else if (channels == 1) {
+        MS_ADPCM_ChannelState mono = cstate[0];
+        Sint32 last = state->output.data[outpos - 1];
+        Sint32 prev = state->output.data[outpos - 2];
+        size_t frames = (size_t)SDL_min(blockframesleft / 2, (Sint64)(blocksize - blockpos)) * 2;
+        Sint16 *out = state->output.data + outpos;
+        Sint16 *end = out + frames;
+
+        while (out < end) {
+            const Uint8 byte = state->block.data[blockpos++];
+            prev = MS_ADPCM_ProcessNibble(&mono, last, prev, byte >> 4);
+            last = MS_ADPCM_ProcessNibble(&mono, prev, last, byte & 0x0f);
+            out[0] = (Sint16)prev;
+            out[1] = (Sint16)last;
+            out += 2;
+        }
+
+        cstate[0] = mono;
+        outpos += frames;
+        state->framesleft -= frames;
+        blockframesleft -= frames;
+    }
+
     while (blockframesleft > 0) {
         for (c = 0; c < channels; c++) {
             if (nybble & 0x4000) {
@@ -799,6 +885,8 @@ IMA_ADPCM_Init(WaveFile *file, size_t datalength)
     const size_t blockdatasize = (size_t)format->blockalign - blockheadersize;
     const size_t blockframebitsize = (size_t)format->bitspersample * format->channels;
     const size_t blockdatasamples = (blockdatasize * 8) / blockframebitsize;
+    IMA_ADPCM_DecoderData *ddata;
+    int index, nybble;
 
     /* Sanity checks. */
 
@@ -853,6 +941,31 @@ IMA_ADPCM_Init(WaveFile *file, size_t datalength)
         return -1;
     }
 
+    ddata = (IMA_ADPCM_DecoderData *)SDL_malloc(sizeof(IMA_ADPCM_DecoderData));
+    file->decoderdata = ddata; /* Freed in cleanup. */
+    if (ddata == NULL) {
+        return SDL_OutOfMemory();
+    }
+
+    /* This is the same calculation as in IMA_ADPCM_ProcessNibble. */
+    for (index = 0; index < 89; index++) {
+        const Sint32 step = ima_adpcm_step_table[index];
+        for (nybble = 0; nybble < 16; nybble++) {
+            Sint32 delta = step >> 3;
+            int next = index + ima_adpcm_index_table_4b[nybble];
+            if (nybble & 0x04)
+                delta += step;
+            if (nybble & 0x02)
+                delta += step >> 1;
+            if (nybble & 0x01)
+                delta += step >> 2;
+            if (nybble & 0x08)
+                delta = -delta;
+            ddata->delta[index * 16 + nybble] = delta;
+            ddata->next[index * 16 + nybble] = (Uint16)(SDL_clamp(next, 0, 88) * 16);
+        }
+    }
+
     return 0;
 }
 
@@ -861,22 +974,6 @@ IMA_ADPCM_ProcessNibble(Sint8 *cindex, Sint16 lastsample, Uint8 nybble)
 {
     const Sint32 max_audioval = 32767;
     const Sint32 min_audioval = -32768;
-    const Sint8 index_table_4b[16] = {
-        -1, -1, -1, -1,
-        2, 4, 6, 8,
-        -1, -1, -1, -1,
-        2, 4, 6, 8
-    };
-    const Uint16 step_table[89] = {
-        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
-        34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130,
-        143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
-        449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282,
-        1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
-        3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
-        9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350,
-        22385, 24623, 27086, 29794, 32767
-    };
     Uint32 step;
     Sint32 sample, delta;
     Sint8 index = *cindex;
@@ -889,10 +986,10 @@ IMA_ADPCM_ProcessNibble(Sint8 *cindex, Sint16 lastsample, Uint8 nybble)
     }
 
     /* explicit cast to avoid gcc warning about using 'char' as array index */
-    step = step_table[(size_t)index];
+    step = ima_adpcm_step_table[(size_t)index];
 
     /* Update index value */
-    *cindex = index + index_table_4b[nybble];
+    *cindex = index + ima_adpcm_index_table_4b[nybble];
 
     /* This calculation uses shifts and additions because multiplications were
      * much slower back then. Sadly, this can't just be replaced with an actual
@@ -986,16 +1083,89 @@ IMA_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
     bytesrequired = (blockframesleft + 7) / 8 * subblockframesize;
     if (blockleft < bytesrequired) {
         /* Data truncated. Calculate how many samples we can get out if it. */
+        const Sint64 framesneeded = blockframesleft;
         const size_t guaranteedframes = blockleft / subblockframesize;
         const size_t remainingbytes = blockleft % subblockframesize;
         blockframesleft = guaranteedframes;
         if (remainingbytes > subblockframesize - 4) {
             blockframesleft += (remainingbytes % 4) * 2;
         }
+        /* The partial sub-block can hold more samples than are needed. */
+        if (blockframesleft > framesneeded) {
+            blockframesleft = framesneeded;
+        }
         /* Signal the truncation. */
         retval = -1;
     }
 
+    /* Whole sub-blocks go through the tables from IMA_ADPCM_Init. The two
+     * channels of a stereo stream are decoded side by side, so their
+     * dependency chains get interleaved.
+     */
+    if (blockframesleft >= 8) {
+        const IMA_ADPCM_DecoderData *ddata = (const IMA_ADPCM_DecoderData *)state->ddata;
+        Sint8 *cindex = (Sint8 *)state->cstate;
+        const Uint8 *in = state->block.data + blockpos;
+        Sint16 *out = state->output.data + outpos;
+        const size_t subblocks = (size_t)(blockframesleft / 8);
+        size_t subblock;
+
+        if (channels == 2) {
+            Sint32 left = out[-2];
+            Sint32 right = out[-1];
+            Uint32 leftindex = SDL_clamp(cindex[0], 0, 88) * 16;
+            Uint32 rightindex = SDL_clamp(cindex[1], 0, 88) * 16;
+
+            for (subblock = 0; subblock < subblocks; subblock++) {
+                Uint32 leftnibbles = in[0] | ((Uint32)in[1] << 8) | ((Uint32)in[2] << 16) | ((Uint32)in[3] << 24);
+                Uint32 rightnibbles = in[4] | ((Uint32)in[5] << 8) | ((Uint32)in[6] << 16) | ((Uint32)in[7] << 24);
+                in += 8;
+
+                for (i = 0; i < 8; i++) {
+                    const Uint32 l = leftindex + (leftnibbles & 0x0f);
+                    const Uint32 r = rightindex + (rightnibbles & 0x0f);
+                    leftnibbles >>= 4;
+                    rightnibbles >>= 4;
+                    left = SDL_clamp(left + ddata->delta[l], -32768, 32767);
+                    right = SDL_clamp(right + ddata->delta[r], -32768, 32767);
+                    leftindex = ddata->next[l];
+                    rightindex = ddata->next[r];
+                    out[0] = (Sint16)left;
+                    out[1] = (Sint16)right;
+                    out += 2;
+                }
+            }
+
+            cindex[0] = (Sint8)(leftindex / 16);
+            cindex[1] = (Sint8)(rightindex / 16);
+        } else {
+            for (subblock = 0; subblock < subblocks; subblock++) {
+                for (c = 0; c < channels; c++) {
+                    Sint32 sample = out[(Sint32)c - (Sint32)channels];
+                    Uint32 index = SDL_clamp(cindex[c], 0, 88) * 16;
+                    Uint32 nibbles = in[0] | ((Uint32)in[1] << 8) | ((Uint32)in[2] << 16) | ((Uint32)in[3] << 24);
+                    in += 4;
+
+                    for (i = 0; i < 8; i++) {
+                        const Uint32 n = index + (nibbles & 0x0f);
+                        nibbles >>= 4;
+                        sample = SDL_clamp(sample + ddata->delta[n], -32768, 32767);
+                        index = ddata->next[n];
+                        out[c + i * channels] = (Sint16)sample;
+                    }
+
+                    cindex[c] = (Sint8)(index / 16);
+                }
+                out += channels * 8;
+            }
+        }
+
+        blockpos += subblocks * subblockframesize;
+        outpos += subblocks * 8 * channels;
+        state->framesleft -= subblocks * 8;
+        blockframesleft -= subblocks * 8;
+    }
+
     /* Each channel has their nibbles packed into 32-bit blocks. These blocks
      * are interleaved and make up the data part of the ADPCM block. This loop
      * decodes the samples as they come from the input data and puts them at
@@ -1089,6 +1259,7 @@ IMA_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
         return SDL_OutOfMemory();
     }
     state.cstate = cstate;
+    state.ddata = file->decoderdata;
 
     /* Decode block by block. A truncated block will stop the decoding. */
     bytesleft = state.input.size - state.input.pos;
@@ -1128,6 +1299,13 @@ IMA_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
         bytesleft = state.input.size - state.input.pos;
     }
 
+    /* A truncated block that ends inside its header counts one sample frame
+     * that never gets decoded. Don't return it.
+     */
+    if (outputsize > state.output.pos * sizeof(Sint16)) {
+        outputsize = state.output.pos * sizeof(Sint16);
+    }
+
     *audio_buf = (Uint8 *)state.output.data;
     *audio_len = (Uint32)outputsize;
 
@@ -1165,51 +1343,110 @@ LAW_Init(WaveFile *file, size_t datalength)
     return 0;
 }
 
+#ifdef SDL_WAVE_LAW_LUT
+static const Sint16 alaw_lut[256] = {
+    -5504, -5248, -6016, -5760, -4480, -4224, -4992, -4736, -7552, -7296, -8064, -7808, -6528, -6272, -7040, -6784, -2752,
+    -2624, -3008, -2880, -2240, -2112, -2496, -2368, -3776, -3648, -4032, -3904, -3264, -3136, -3520, -3392, -22016,
+    -20992, -24064, -23040, -17920, -16896, -19968, -18944, -30208, -29184, -32256, -31232, -26112, -25088, -28160, -27136, -11008,
+    -10496, -12032, -11520, -8960, -8448, -9984, -9472, -15104, -14592, -16128, -15616, -13056, -12544, -14080, -13568, -344,
+    -328, -376, -360, -280, -264, -312, -296, -472, -456, -504, -488, -408, -392, -440, -424, -88,
+    -72, -120, -104, -24, -8, -56, -40, -216, -200, -248, -232, -152, -136, -184, -168, -1376,
+    -1312, -1504, -1440, -1120, -1056, -1248, -1184, -1888, -1824, -2016, -1952, -1632, -1568, -1760, -1696, -688,
+    -656, -752, -720, -560, -528, -624, -592, -944, -912, -1008, -976, -816, -784, -880, -848, 5504,
+    5248, 6016, 5760, 4480, 4224, 4992, 4736, 7552, 7296, 8064, 7808, 6528, 6272, 7040, 6784, 2752,
+    2624, 3008, 2880, 2240, 2112, 2496, 2368, 3776, 3648, 4032, 3904, 3264, 3136, 3520, 3392, 22016,
+    20992, 24064, 23040, 17920, 16896, 19968, 18944, 30208, 29184, 32256, 31232, 26112, 25088, 28160, 27136, 11008,
+    10496, 12032, 11520, 8960, 8448, 9984, 9472, 15104, 14592, 16128, 15616, 13056, 12544, 14080, 13568, 344,
+    328, 376, 360, 280, 264, 312, 296, 472, 456, 504, 488, 408, 392, 440, 424, 88,
+    72, 120, 104, 24, 8, 56, 40, 216, 200, 248, 232, 152, 136, 184, 168, 1376,
+    1312, 1504, 1440, 1120, 1056, 1248, 1184, 1888, 1824, 2016, 1952, 1632, 1568, 1760, 1696, 688,
+    656, 752, 720, 560, 528, 624, 592, 944, 912, 1008, 976, 816, 784, 880, 848
+};
+static const Sint16 mulaw_lut[256] = {
+    -32124, -31100, -30076, -29052, -28028, -27004, -25980, -24956, -23932, -22908, -21884, -20860, -19836, -18812, -17788, -16764, -15996,
+    -15484, -14972, -14460, -13948, -13436, -12924, -12412, -11900, -11388, -10876, -10364, -9852, -9340, -8828, -8316, -7932,
+    -7676, -7420, -7164, -6908, -6652, -6396, -6140, -5884, -5628, -5372, -5116, -4860, -4604, -4348, -4092, -3900,
+    -3772, -3644, -3516, -3388, -3260, -3132, -3004, -2876, -2748, -2620, -2492, -2364, -2236, -2108, -1980, -1884,
+    -1820, -1756, -1692, -1628, -1564, -1500, -1436, -1372, -1308, -1244, -1180, -1116, -1052, -988, -924, -876,
+    -844, -812, -780, -748, -716, -684, -652, -620, -588, -556, -524, -492, -460, -428, -396, -372,
+    -356, -340, -324, -308, -292, -276, -260, -244, -228, -212, -196, -180, -164, -148, -132, -120,
+    -112, -104, -96, -88, -80, -72, -64, -56, -48, -40, -32, -24, -16, -8, 0, 32124,
+    31100, 30076, 29052, 28028, 27004, 25980, 24956, 23932, 22908, 21884, 20860, 19836, 18812, 17788, 16764, 15996,
+    15484, 14972, 14460, 13948, 13436, 12924, 12412, 11900, 11388, 10876, 10364, 9852, 9340, 8828, 8316, 7932,
+    7676, 7420, 7164, 6908, 6652, 6396, 6140, 5884, 5628, 5372, 5116, 4860, 4604, 4348, 4092, 3900,
+    3772, 3644, 3516, 3388, 3260, 3132, 3004, 2876, 2748, 2620, 2492, 2364, 2236, 2108, 1980, 1884,
+    1820, 1756, 1692, 1628, 1564, 1500, 1436, 1372, 1308, 1244, 1180, 1116, 1052, 988, 924, 876,
+    844, 812, 780, 748, 716, 684, 652, 620, 588, 556, 524, 492, 460, 428, 396, 372,
+    356, 340, 324, 308, 292, 276, 260, 244, 228, 212, 196, 180, 164, 148, 132, 120,
+    112, 104, 96, 88, 80, 72, 64, 56, 48, 40, 32, 24, 16, 8, 0
+};
+#endif
+
+/* Expands companded samples to 16 bits. Works backwards, so dst may start at
+ * the same address as src.
+ */
 static int
-LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+LAW_Expand(Uint16 encoding, const Uint8 *src, Sint16 *dst, size_t sample_count)
 {
+    size_t i = sample_count;
+
+    switch (encoding) {
 #ifdef SDL_WAVE_LAW_LUT
-    const Sint16 alaw_lut[256] = {
-        -5504, -5248, -6016, -5760, -4480, -4224, -4992, -4736, -7552, -7296, -8064, -7808, -6528, -6272, -7040, -6784, -2752,
-        -2624, -3008, -2880, -2240, -2112, -2496, -2368, -3776, -3648, -4032, -3904, -3264, -3136, -3520, -3392, -22016,
-        -20992, -24064, -23040, -17920, -16896, -19968, -18944, -30208, -29184, -32256, -31232, -26112, -25088, -28160, -27136, -11008,
-        -10496, -12032, -11520, -8960, -8448, -9984, -9472, -15104, -14592, -16128, -15616, -13056, -12544, -14080, -13568, -344,
-        -328, -376, -360, -280, -264, -312, -296, -472, -456, -504, -488, -408, -392, -440, -424, -88,
-        -72, -120, -104, -24, -8, -56, -40, -216, -200, -248, -232, -152, -136, -184, -168, -1376,
-        -1312, -1504, -1440, -1120, -1056, -1248, -1184, -1888, -1824, -2016, -1952, -1632, -1568, -1760, -1696, -688,
-        -656, -752, -720, -560, -528, -624, -592, -944, -912, -1008, -976, -816, -784, -880, -848, 5504,
-        5248, 6016, 5760, 4480, 4224, 4992, 4736, 7552, 7296, 8064, 7808, 6528, 6272, 7040, 6784, 2752,
-        2624, 3008, 2880, 2240, 2112, 2496, 2368, 3776, 3648, 4032, 3904, 3264, 3136, 3520, 3392, 22016,
-        20992, 24064, 23040, 17920, 16896, 19968, 18944, 30208, 29184, 32256, 31232, 26112, 25088, 28160, 27136, 11008,
-        10496, 12032, 11520, 8960, 8448, 9984, 9472, 15104, 14592, 16128, 15616, 13056, 12544, 14080, 13568, 344,
-        328, 376, 360, 280, 264, 312, 296, 472, 456, 504, 488, 408, 392, 440, 424, 88,
-        72, 120, 104, 24, 8, 56, 40, 216, 200, 248, 232, 152, 136, 184, 168, 1376,
-        1312, 1504, 1440, 1120, 1056, 1248, 1184, 1888, 1824, 2016, 1952, 1632, 1568, 1760, 1696, 688,
-        656, 752, 720, 560, 528, 624, 592, 944, 912, 1008, 976, 816, 784, 880, 848
-    };
-    const Sint16 mulaw_lut[256] = {
-        -32124, -31100, -30076, -29052, -28028, -27004, -25980, -24956, -23932, -22908, -21884, -20860, -19836, -18812, -17788, -16764, -15996,
-        -15484, -14972, -14460, -13948, -13436, -12924, -12412, -11900, -11388, -10876, -10364, -9852, -9340, -8828, -8316, -7932,
-        -7676, -7420, -7164, -6908, -6652, -6396, -6140, -5884, -5628, -5372, -5116, -4860, -4604, -4348, -4092, -3900,
-        -3772, -3644, -3516, -3388, -3260, -3132, -3004, -2876, -2748, -2620, -2492, -2364, -2236, -2108, -1980, -1884,
-        -1820, -1756, -1692, -1628, -1564, -1500, -1436, -1372, -1308, -1244, -1180, -1116, -1052, -988, -924, -876,
-        -844, -812, -780, -748, -716, -684, -652, -620, -588, -556, -524, -492, -460, -428, -396, -372,
-        -356, -340, -324, -308, -292, -276, -260, -244, -228, -212, -196, -180, -164, -148, -132, -120,
-        -112, -104, -96, -88, -80, -72, -64, -56, -48, -40, -32, -24, -16, -8, 0, 32124,
-        31100, 30076, 29052, 28028, 27004, 25980, 24956, 23932, 22908, 21884, 20860, 19836, 18812, 17788, 16764, 15996,
-        15484, 14972, 14460, 13948, 13436, 12924, 12412, 11900, 11388, 10876, 10364, 9852, 9340, 8828, 8316, 7932,
-        7676, 7420, 7164, 6908, 6652, 6396, 6140, 5884, 5628, 5372, 5116, 4860, 4604, 4348, 4092, 3900,
-        3772, 3644, 3516, 3388, 3260, 3132, 3004, 2876, 2748, 2620, 2492, 2364, 2236, 2108, 1980, 1884,
-        1820, 1756, 1692, 1628, 1564, 1500, 1436, 1372, 1308, 1244, 1180, 1116, 1052, 988, 924, 876,
-        844, 812, 780, 748, 716, 684, 652, 620, 588, 556, 524, 492, 460, 428, 396, 372,
-        356, 340, 324, 308, 292, 276, 260, 244, 228, 212, 196, 180, 164, 148, 132, 120,
-        112, 104, 96, 88, 80, 72, 64, 56, 48, 40, 32, 24, 16, 8, 0
-    };
+    case ALAW_CODE:
+        while (i--) {
+            dst[i] = alaw_lut[src[i]];
+        }
+        break;
+    case MULAW_CODE:
+        while (i--) {
+            dst[i] = mulaw_lut[src[i]];
+        }
+        break;
+#else
+    case ALAW_CODE:
+        while (i--) {
+            Uint8 nibble = src[i];
+            Uint8 exponent = (nibble & 0x7f) ^ 0x55;
+            Sint16 mantissa = exponent & 0xf;
+
+            exponent >>= 4;
+            if (exponent > 0) {
+                mantissa |= 0x10;
+            }
+            mantissa = (mantissa << 4) | 0x8;
+            if (exponent > 1) {
+                mantissa <<= exponent - 1;
+            }
+
+            dst[i] = nibble & 0x80 ? mantissa : -mantissa;
+        }
+        break;
+    case MULAW_CODE:
+        while (i--) {
+            Uint8 nibble = ~src[i];
+            Sint16 mantissa = nibble & 0xf;
+            Uint8 exponent = (nibble >> 4) & 0x7;
+            Sint16 step = 4 << (exponent + 1);
+
+            mantissa = (0x80 << exponent) + step * mantissa + step / 2 - 132;
+
+            dst[i] = nibble & 0x80 ? -mantissa : mantissa;
+        }
+        break;
 #endif
+    default:
+        return SDL_SetError("Unknown companded encoding");
+    }
+
+    return 0;
+}
 
+static int
+LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+{
     WaveFormat *format = &file->format;
     WaveChunk *chunk = &file->chunk;
-    size_t i, sample_count, expanded_len;
+    size_t sample_count, expanded_len;
     Uint8 *src;
     Sint16 *dst;
 
@@ -1252,54 +1489,9 @@ LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
     /* Work backwards, since we're expanding in-place. SDL_AudioSpec.format will
      * inform the caller about the byte order.
      */
-    i = sample_count;
-    switch (file->format.encoding) {
-#ifdef SDL_WAVE_LAW_LUT
-    case ALAW_CODE:
-        while (i--) {
-            dst[i] = alaw_lut[src[i]];
-        }
-        break;
-    case MULAW_CODE:
-        while (i--) {
-            dst[i] = mulaw_lut[src[i]];
-        }
-        break;
-#else
-    case ALAW_CODE:
-        while (i--) {
-            Uint8 nibble = src[i];
-            Uint8 exponent = (nibble & 0x7f) ^ 0x55;
-            Sint16 mantissa = exponent & 0xf;
-
-            exponent >>= 4;
-            if (exponent > 0) {
-                mantissa |= 0x10;
-            }
-            mantissa = (mantissa << 4) | 0x8;
-            if (exponent > 1) {
-                mantissa <<= exponent - 1;
-            }
-
-            dst[i] = nibble & 0x80 ? mantissa : -mantissa;
-        }
-        break;
-    case MULAW_CODE:
-        while (i--) {
-            Uint8 nibble = ~src[i];
-            Sint16 mantissa = nibble & 0xf;
-            Uint8 exponent = (nibble >> 4) & 0x7;
-            Sint16 step = 4 << (exponent + 1);
-
-            mantissa = (0x80 << exponent) + step * mantissa + step / 2 - 132;
-
-            dst[i] = nibble & 0x80 ? -mantissa : mantissa;
-        }
-        break;
-#endif
-    default:
+    if (LAW_Expand(format->encoding, src, dst, sample_count) < 0) {
         SDL_free(src);
-        return SDL_SetError("Unknown companded encoding");
+        return -1;
     }
 
     *audio_buf = src;
@@ -1352,12 +1544,34 @@ PCM_Init(WaveFile *file, size_t datalength)
     return 0;
 }
 
+/* Shifts 24-bit samples to 32 bits. Works backwards, in place. */
+static void
+PCM_ExpandSint24(Uint8 *ptr, size_t sample_count)
+{
+    size_t i;
+
+    for (i = sample_count; i > 0; i--) {
+        const size_t o = i - 1;
+        uint8_t b[4];
+
+        b[0] = 0;
+        b[1] = ptr[o * 3];
+        b[2] = ptr[o * 3 + 1];
+        b[3] = ptr[o * 3 + 2];
+
+        ptr[o * 4 + 0] = b[0];
+        ptr[o * 4 + 1] = b[1];
+        ptr[o * 4 + 2] = b[2];
+        ptr[o * 4 + 3] = b[3];
+    }
+}
+
 static int
 PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 {
     WaveFormat *format = &file->format;
     WaveChunk *chunk = &file->chunk;
-    size_t i, expanded_len, sample_count;
+    size_t expanded_len, sample_count;
     Uint8 *ptr;
 
     sample_count = (size_t)file->sampleframes;
@@ -1386,20 +1600,7 @@ PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
     *audio_len = (Uint32)expanded_len;
 
     /* work from end to start, since we're expanding in-place. */
-    for (i = sample_count; i > 0; i--) {
-        const size_t o = i - 1;
-        uint8_t b[4];
-
-        b[0] = 0;
-        b[1] = ptr[o * 3];
-        b[2] = ptr[o * 3 + 1];
-        b[3] = ptr[o * 3 + 2];
-
-        ptr[o * 4 + 0] = b[0];
-        ptr[o * 4 + 1] = b[1];
-        ptr[o * 4 + 2] = b[2];
-        ptr[o * 4 + 3] = b[3];
-    }
+    PCM_ExpandSint24(ptr, sample_count);
 
     return 0;
 }
@@ -1783,8 +1984,12 @@ WaveCheckFormat(WaveFile *file, size_t datalength)
     return 0;
 }
 
+/* Reads the RIFF structure and the fmt chunk. On success, the chunk of the
+ * WaveFile describes the data chunk, which has not been read yet, and the end
+ * of the WAVE file is stored in endposition.
+ */
 static int
-WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+WaveParse(SDL_RWops *src, WaveFile *file, Sint64 *endposition)
 {
     int result;
     Uint32 chunkcount = 0;
@@ -1792,7 +1997,6 @@ WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf,
     char *envchunkcountlimit;
     Sint64 RIFFstart, RIFFend, lastchunkpos;
     SDL_bool RIFFlengthknown = SDL_FALSE;
-    WaveFormat *format = &file->format;
     WaveChunk *chunk = &file->chunk;
     WaveChunk RIFFchunk;
     WaveChunk fmtchunk;
@@ -1997,9 +2201,79 @@ WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf,
 
     WaveFreeChunkData(chunk);
 
-    /* Process data chunk. */
+    /* The data chunk is processed by the caller. */
     *chunk = datachunk;
 
+    if (RIFFlengthknown) {
+        *endposition = RIFFend;
+    } else {
+        *endposition = lastchunkpos;
+    }
+
+    return 0;
+}
+
+/* Sets up the SDL_AudioSpec for the decoded data. All unsupported formats were
+ * filtered out by the checks in WaveParse.
+ */
+static int
+WaveSetSpec(WaveFile *file, SDL_AudioSpec *spec)
+{
+    WaveFormat *format = &file->format;
+
+    SDL_zerop(spec);
+    spec->freq = format->frequency;
+    spec->channels = (Uint8)format->channels;
+    spec->samples = 4096;       /* Good default buffer size */
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+    case ALAW_CODE:
+    case MULAW_CODE:
+        /* These can be easily stored in the byte order of the system. */
+        spec->format = AUDIO_S16SYS;
+        break;
+    case IEEE_FLOAT_CODE:
+        spec->format = AUDIO_F32LSB;
+        break;
+    case PCM_CODE:
+        switch (format->bitspersample) {
+        case 8:
+            spec->format = AUDIO_U8;
+            break;
+        case 16:
+            spec->format = AUDIO_S16LSB;
+            break;
+        case 24: /* Has been shifted to 32 bits. */
+        case 32:
+            spec->format = AUDIO_S32LSB;
+            break;
+        default:
+            /* Just in case something unexpected happened in the checks. */
+            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
+        }
+        break;
+    }
+
+    spec->silence = SDL_SilenceValueForFormat(spec->format);
+
+    return 0;
+}
+
+static int
+WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    int result;
+    Sint64 endposition;
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+
+    if (WaveParse(src, file, &endposition) < 0) {
+        return -1;
+    }
+
+    /* Process data chunk. */
     if (chunk->length > 0) {
         result = WaveReadChunkData(src, chunk);
         if (result == -1) {
@@ -2043,52 +2317,12 @@ WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf,
         break;
     }
 
-    /* Setting up the SDL_AudioSpec. All unsupported formats were filtered out
-     * by checks earlier in this function.
-     */
-    SDL_zerop(spec);
-    spec->freq = format->frequency;
-    spec->channels = (Uint8)format->channels;
-    spec->samples = 4096;       /* Good default buffer size */
-
-    switch (format->encoding) {
-    case MS_ADPCM_CODE:
-    case IMA_ADPCM_CODE:
-    case ALAW_CODE:
-    case MULAW_CODE:
-        /* These can be easily stored in the byte order of the system. */
-        spec->format = AUDIO_S16SYS;
-        break;
-    case IEEE_FLOAT_CODE:
-        spec->format = AUDIO_F32LSB;
-        break;
-    case PCM_CODE:
-        switch (format->bitspersample) {
-        case 8:
-            spec->format = AUDIO_U8;
-            break;
-        case 16:
-            spec->format = AUDIO_S16LSB;
-            break;
-        case 24: /* Has been shifted to 32 bits. */
-        case 32:
-            spec->format = AUDIO_S32LSB;
-            break;
-        default:
-            /* Just in case something unexpected happened in the checks. */
-            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
-        }
-        break;
+    if (WaveSetSpec(file, spec) < 0) {
+        return -1;
     }
 
-    spec->silence = SDL_SilenceValueForFormat(spec->format);
-
     /* Report the end position back to the cleanup code. */
-    if (RIFFlengthknown) {
-        chunk->position = RIFFend;
-    } else {
-        chunk->position = lastchunkpos;
-    }
+    chunk->position = endposition;
 
     return 0;
 }
@@ -2152,4 +2386,372 @@ SDL_FreeWAV(Uint8 *audio_buf)
     SDL_free(audio_buf);
 }
 
+/* Incremental decoding. The stream is read as the samples are requested, one
+ * block at a time for ADPCM, so the decoded data never has to be in memory all
+ * at once.
+ */
+struct SDL_WAVDecoder
+{
+    SDL_RWops *src;
+    int freesrc;
+    WaveFile file;
+    Sint64 endposition;     /* Position after the WAVE file in the stream, or -1. */
+    Sint64 dataposition;    /* Position of the data chunk in the stream. */
+    size_t datasize;        /* Bytes of the data chunk present in the stream. */
+    size_t inframesize;     /* Size of a sample frame in the stream (PCM and companded). */
+    size_t outframesize;    /* Size of a decoded sample frame. */
+    Sint64 frame;           /* Next sample frame to be returned. */
+    SDL_bool seeked;        /* The stream has to be repositioned before the next read. */
+
+    /* ADPCM decoding. */
+    SDL_bool adpcm;
+    ADPCM_DecoderState state;
+    MS_ADPCM_ChannelState mscstate[2];
+    Sint8 *imacstate;
+    size_t nextblock;       /* Index of the next block to be read. */
+    size_t blockframes;     /* Number of sample frames in the decoded block. */
+    size_t blockframe;      /* Next sample frame of the decoded block to be returned. */
+};
+
+/* Reads and decodes the next ADPCM block into the output buffer of the state.
+ * Leaves blockframes at zero at the end of the data.
+ */
+static int
+WaveDecodeNextBlock(SDL_WAVDecoder *decoder)
+{
+    ADPCM_DecoderState *state = &decoder->state;
+    WaveFile *file = &decoder->file;
+    const Sint64 blockstart = (Sint64)decoder->nextblock * state->samplesperblock;
+    const size_t offset = decoder->nextblock * state->blocksize;
+    size_t blocksize;
+    Sint64 position;
+    int result;
+
+    decoder->blockframes = 0;
+    decoder->blockframe = 0;
+
+    if (blockstart >= file->sampleframes || offset >= decoder->datasize ||
+        decoder->datasize - offset < state->blockheadersize) {
+        return 0;
+    }
+    blocksize = SDL_min(state->blocksize, decoder->datasize - offset);
+
+    if (decoder->seeked) {
+        position = decoder->dataposition + (Sint64)offset;
+        if (SDL_RWseek(decoder->src, position, RW_SEEK_SET) != position) {
+            return SDL_SetError("Could not seek in WAVE data chunk");
+        }
+        decoder->seeked = SDL_FALSE;
+    }
+    state->block.size = SDL_RWread(decoder->src, state->block.data, 1, blocksize);
+    if (state->block.size != blocksize) {
+        /* The stream ended early, this is the last block. */
+        decoder->datasize = offset + state->block.size;
+        decoder->seeked = SDL_TRUE;
+        if (state->block.size < state->blockheadersize) {
+            return 0;
+        }
+    }
+    state->block.pos = 0;
+    state->output.pos = 0;
+    state->framesleft = file->sampleframes - blockstart;
+    decoder->nextblock++;
+
+    if (file->format.encoding == MS_ADPCM_CODE) {
+        if (MS_ADPCM_DecodeBlockHeader(state) < 0) {
+            return -1;
+        }
+        result = MS_ADPCM_DecodeBlockData(state);
+    } else {
+        result = IMA_ADPCM_DecodeBlockHeader(state);
+        if (result == 0) {
+            result = IMA_ADPCM_DecodeBlockData(state);
+        }
+    }
+
+    if (result == -1) {
+        /* Unexpected end. Same rules as for the whole file. */
+        if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
+            return SDL_SetError("Truncated data chunk");
+        } else if (file->trunchint != TruncDropFrame) {
+            state->output.pos -= state->output.pos % (state->samplesperblock * state->channels);
+        }
+    }
+
+    decoder->blockframes = state->output.pos / state->channels;
+    if ((Sint64)decoder->blockframes > file->sampleframes - blockstart) {
+        decoder->blockframes = (size_t)(file->sampleframes - blockstart);
+    } else if (result == -1) {
+        /* Now the actual length is known. */
+        file->sampleframes = blockstart + decoder->blockframes;
+    }
+
+    return 0;
+}
+
+SDL_WAVDecoder *
+SDL_NewWAVDecoder(SDL_RWops *src, int freesrc, SDL_AudioSpec *spec)
+{
+    SDL_WAVDecoder *decoder;
+    WaveFile *file;
+    WaveFormat *format;
+    ADPCM_DecoderState *state;
+    Sint64 streamsize;
+    size_t datasize, outputsize;
+
+    /* Make sure we are passed a valid data source */
+    if (src == NULL) {
+        /* Error may come from RWops. */
+        return NULL;
+    } else if (spec == NULL) {
+        SDL_InvalidParamError("spec");
+        if (freesrc) {
+            SDL_RWclose(src);
+        }
+        return NULL;
+    }
+
+    decoder = (SDL_WAVDecoder *)SDL_calloc(1, sizeof(*decoder));
+    if (decoder == NULL) {
+        SDL_OutOfMemory();
+        if (freesrc) {
+            SDL_RWclose(src);
+        }
+        return NULL;
+    }
+    decoder->src = src;
+    decoder->freesrc = freesrc;
+    decoder->endposition = -1;
+
+    file = &decoder->file;
+    format = &file->format;
+    state = &decoder->state;
+    file->riffhint = WaveGetRiffSizeHint();
+    file->trunchint = WaveGetTruncationHint();
+    file->facthint = WaveGetFactChunkHint();
+
+    if (WaveParse(src, file, &decoder->endposition) < 0 || WaveSetSpec(file, spec) < 0) {
+        decoder->endposition = -1;
+        goto failed;
+    }
+
+    /* Find out how much of the data chunk is actually in the stream. */
+    decoder->dataposition = file->chunk.position;
+    datasize = file->chunk.length;
+    streamsize = SDL_RWsize(src);
+    if (streamsize >= 0 && (streamsize <= decoder->dataposition || (Uint64)(streamsize - decoder->dataposition) < datasize)) {
+        datasize = streamsize > decoder->dataposition ? (size_t)(streamsize - decoder->dataposition) : 0;
+    }
+    if (datasize != file->chunk.length) {
+        /* I/O issues or corrupt file. */
+        if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
+            SDL_SetError("Could not read data of WAVE data chunk");
+            goto failed;
+        }
+    }
+    decoder->datasize = datasize;
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+        if (datasize != file->chunk.length) {
+            /* Could not read everything. Recalculate number of sample frames. */
+            int result;
+            if (format->encoding == MS_ADPCM_CODE) {
+                result = MS_ADPCM_CalculateSampleFrames(file, datasize);
+            } else {
+                result = IMA_ADPCM_CalculateSampleFrames(file, datasize);
+            }
+            if (result < 0) {
+                goto failed;
+            }
+        }
+
+        decoder->adpcm = SDL_TRUE;
+        state->channels = format->channels;
+        state->blocksize = format->blockalign;
+        state->samplesperblock = format->samplesperblock;
+        state->framesize = state->channels * sizeof(Sint16);
+        state->framestotal = file->sampleframes;
+        state->ddata = file->decoderdata;
+        if (format->encoding == MS_ADPCM_CODE) {
+            state->blockheadersize = (size_t)state->channels * 7;
+            state->cstate = decoder->mscstate;
+        } else {
+            state->blockheadersize = (size_t)state->channels * 4;
+            decoder->imacstate = (Sint8 *)SDL_calloc(state->channels, sizeof(Sint8));
+            if (decoder->imacstate == NULL) {
+                SDL_OutOfMemory();
+                goto failed;
+            }
+            state->cstate = decoder->imacstate;
+        }
+
+        /* Room for one encoded and one decoded block. */
+        outputsize = state->samplesperblock;
+        if (SafeMult(&outputsize, state->framesize)) {
+            SDL_OutOfMemory();
+            goto failed;
+        }
+        state->block.data = (Uint8 *)SDL_malloc(state->blocksize);
+        state->output.size = outputsize / sizeof(Sint16);
+        state->output.data = (Sint16 *)SDL_calloc(1, outputsize);
+        if (state->block.data == NULL || state->output.data == NULL) {
+            SDL_OutOfMemory();
+            goto failed;
+        }
+        decoder->outframesize = state->framesize;
+        break;
+    default:
+        if (datasize != file->chunk.length) {
+            file->sampleframes = WaveAdjustToFactValue(file, datasize / format->blockalign);
+            if (file->sampleframes < 0) {
+                goto failed;
+            }
+        }
+
+        decoder->inframesize = format->blockalign;
+        if (format->encoding == ALAW_CODE || format->encoding == MULAW_CODE) {
+            decoder->outframesize = (size_t)format->channels * sizeof(Sint16);
+        } else if (format->encoding == PCM_CODE && format->bitspersample == 24) {
+            decoder->outframesize = (size_t)format->channels * sizeof(Sint32);
+        } else {
+            decoder->outframesize = format->blockalign;
+        }
+        break;
+    }
+
+    decoder->seeked = SDL_TRUE;
+
+    return decoder;
+
+failed:
+    SDL_FreeWAVDecoder(decoder);
+    return NULL;
+}
+
+int
+SDL_WAVDecoderGet(SDL_WAVDecoder *decoder, void *buf, int len)
+{
+    Uint8 *dst = (Uint8 *)buf;
+    Sint64 frames;
+    size_t count;
+
+    if (decoder == NULL) {
+        return SDL_InvalidParamError("decoder");
+    } else if (buf == NULL) {
+        return SDL_InvalidParamError("buf");
+    } else if (len < 0) {
+        return SDL_InvalidParamError("len");
+    }
+
+    frames = SDL_min((Sint64)((size_t)len / decoder->outframesize), decoder->file.sampleframes - decoder->frame);
+
+    if (decoder->adpcm) {
+        const Uint32 channels = decoder->state.channels;
+
+        while (frames > 0) {
+            if (decoder->blockframe == decoder->blockframes) {
+                if (WaveDecodeNextBlock(decoder) < 0) {
+                    return -1;
+                } else if (decoder->blockframes == 0) {
+                    break;
+                }
+            }
+            count = (size_t)SDL_min((Sint64)(decoder->blockframes - decoder->blockframe), frames);
+            SDL_memcpy(dst, decoder->state.output.data + decoder->blockframe * channels, count * decoder->outframesize);
+            dst += count * decoder->outframesize;
+            decoder->blockframe += count;
+            decoder->frame += count;
+            frames -= count;
+        }
+    } else if (frames > 0) {
+        WaveFormat *format = &decoder->file.format;
+
+        if (decoder->seeked) {
+            Sint64 position = decoder->dataposition + decoder->frame * (Sint64)decoder->inframesize;
+            if (SDL_RWseek(decoder->src, position, RW_SEEK_SET) != position) {
+                return SDL_SetError("Could not seek in WAVE data chunk");
+            }
+            decoder->seeked = SDL_FALSE;
+        }
+
+        /* The decoded samples are never smaller, so they are expanded in place. */
+        count = SDL_RWread(decoder->src, dst, decoder->inframesize, (size_t)frames);
+        if (count != (size_t)frames) {
+            /* The stream ended early. */
+            decoder->file.sampleframes = decoder->frame + count;
+            decoder->seeked = SDL_TRUE;
+        }
+        if (format->encoding == ALAW_CODE || format->encoding == MULAW_CODE) {
+            if (LAW_Expand(format->encoding, dst, (Sint16 *)dst, count * format->channels) < 0) {
+                return -1;
+            }
+        } else if (format->encoding == PCM_CODE && format->bitspersample == 24) {
+            PCM_ExpandSint24(dst, count * format->channels);
+        }
+        dst += count * decoder->outframesize;
+        decoder->frame += count;
+    }
+
+    return (int)(dst - (Uint8 *)buf);
+}
+
+int
+SDL_WAVDecoderSeek(SDL_WAVDecoder *decoder, Sint64 frame)
+{
+    if (decoder == NULL) {
+        return SDL_InvalidParamError("decoder");
+    } else if (frame < 0 || frame > decoder->file.sampleframes) {
+        return SDL_SetError("Seek position out of range");
+    }
+
+    if (decoder->adpcm) {
+        /* Decode the block the frame is in, unless it's the current one. */
+        const size_t block = (size_t)(frame / decoder->state.samplesperblock);
+        if (block + 1 != decoder->nextblock || decoder->blockframes == 0) {
+            decoder->nextblock = block;
+            decoder->seeked = SDL_TRUE;
+            if (WaveDecodeNextBlock(decoder) < 0) {
+                return -1;
+            }
+        }
+        decoder->blockframe = SDL_min((size_t)(frame - (Sint64)block * decoder->state.samplesperblock), decoder->blockframes);
+    } else {
+        decoder->seeked = SDL_TRUE;
+    }
+    decoder->frame = frame;
+
+    return 0;
+}
+
+Sint64
+SDL_WAVDecoderLength(SDL_WAVDecoder *decoder)
+{
+    if (decoder == NULL) {
+        return SDL_InvalidParamError("decoder");
+    }
+    return decoder->file.sampleframes;
+}
+
+void
+SDL_FreeWAVDecoder(SDL_WAVDecoder *decoder)
+{
+    if (decoder == NULL) {
+        return;
+    }
+
+    if (decoder->freesrc) {
+        SDL_RWclose(decoder->src);
+    } else if (decoder->endposition >= 0) {
+        SDL_RWseek(decoder->src, decoder->endposition, RW_SEEK_SET);
+    }
+    WaveFreeChunkData(&decoder->file.chunk);
+    SDL_free(decoder->file.decoderdata);
+    SDL_free(decoder->state.block.data);
+    SDL_free(decoder->state.output.data);
+    SDL_free(decoder->imacstate);
+    SDL_free(decoder);
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
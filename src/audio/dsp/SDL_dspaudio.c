@@ -33,6 +33,7 @@
 #include <sys/time.h>
 #include <sys/ioctl.h>
 #include <sys/stat.h>
+#include <poll.h>
 
 #include <sys/soundcard.h>
 
@@ -61,6 +62,30 @@ DSP_CloseDevice(_THIS)
 }
 
 
+static int
+DSP_AllocateMixBuffer(_THIS)
+{
+    if (!this->iscapture) {
+        this->hidden->mixlen = this->spec.size;
+        this->hidden->mixbuf = (Uint8 *) SDL_malloc(this->hidden->mixlen);
+        if (this->hidden->mixbuf == NULL) {
+            return SDL_OutOfMemory();
+        }
+        SDL_memset(this->hidden->mixbuf, this->spec.silence, this->spec.size);
+    }
+    return 0;
+}
+
+/* A pipe or plain file standing in for the device, to test against: it
+   takes raw audio in whatever format the app asked for. */
+static int
+DSP_OpenRawDevice(_THIS)
+{
+    this->hidden->raw = SDL_TRUE;
+    SDL_CalculateAudioSpec(&this->spec);
+    return DSP_AllocateMixBuffer(this);
+}
+
 static int
 DSP_OpenDevice(_THIS, const char *devname)
 {
@@ -113,8 +138,21 @@ DSP_OpenDevice(_THIS, const char *devname)
         }
     }
 
+    /* Low latency capture polls instead of blocking in read(). */
+    if (iscapture && this->low_latency_capture) {
+        this->hidden->poll_timeout = (int) (((this->spec.samples * 1000) / this->spec.freq) * 2) + 1;
+        if (fcntl(this->hidden->audio_fd, F_SETFL, fcntl(this->hidden->audio_fd, F_GETFL) | O_NONBLOCK) < 0) {
+            return SDL_SetError("Couldn't set audio non-blocking mode");
+        }
+    }
+
     /* Get a list of supported hardware formats */
     if (ioctl(this->hidden->audio_fd, SNDCTL_DSP_GETFMTS, &value) < 0) {
+        struct stat sb;
+        if ((errno == ENOTTY) && (fstat(this->hidden->audio_fd, &sb) == 0) &&
+            (S_ISFIFO(sb.st_mode) || S_ISREG(sb.st_mode))) {
+            return DSP_OpenRawDevice(this);
+        }
         perror("SNDCTL_DSP_GETFMTS");
         return SDL_SetError("Couldn't get audio format list");
     }
@@ -208,7 +246,13 @@ DSP_OpenDevice(_THIS, const char *devname)
     if ((0x01U << frag_spec) != this->spec.size) {
         return SDL_SetError("Fragment size must be a power of two");
     }
-    frag_spec |= 0x00020000;    /* two fragments, for low latency */
+    if (iscapture && this->low_latency_capture && (frag_spec > 8)) {
+        /* Eighth-period fragments, so data can be read in soon after
+           it's captured; 32 of them, so a slow app doesn't lose any. */
+        frag_spec = (frag_spec - 3) | 0x00200000;
+    } else {
+        frag_spec |= 0x00020000;    /* two fragments, for low latency */
+    }
 
     /* Set the audio buffering parameters */
 #ifdef DEBUG_AUDIO
@@ -230,13 +274,8 @@ DSP_OpenDevice(_THIS, const char *devname)
 #endif
 
     /* Allocate mixing buffer */
-    if (!iscapture) {
-        this->hidden->mixlen = this->spec.size;
-        this->hidden->mixbuf = (Uint8 *) SDL_malloc(this->hidden->mixlen);
-        if (this->hidden->mixbuf == NULL) {
-            return SDL_OutOfMemory();
-        }
-        SDL_memset(this->hidden->mixbuf, this->spec.silence, this->spec.size);
+    if (DSP_AllocateMixBuffer(this) < 0) {
+        return -1;
     }
 
     /* We're ready to rock and roll. :-) */
@@ -245,18 +284,24 @@ DSP_OpenDevice(_THIS, const char *devname)
 
 
 static void
-DSP_PlayDevice(_THIS)
+DSP_PlayDeviceBuffer(_THIS, const Uint8 *buffer, int buflen)
 {
     struct SDL_PrivateAudioData *h = this->hidden;
-    if (write(h->audio_fd, h->mixbuf, h->mixlen) == -1) {
+    if (write(h->audio_fd, buffer, buflen) == -1) {
         perror("Audio write");
         SDL_OpenedAudioDeviceDisconnected(this);
     }
 #ifdef DEBUG_AUDIO
-    fprintf(stderr, "Wrote %d bytes of audio data\n", h->mixlen);
+    fprintf(stderr, "Wrote %d bytes of audio data\n", buflen);
 #endif
 }
 
+static void
+DSP_PlayDevice(_THIS)
+{
+    DSP_PlayDeviceBuffer(this, this->hidden->mixbuf, this->hidden->mixlen);
+}
+
 static Uint8 *
 DSP_GetDeviceBuf(_THIS)
 {
@@ -266,25 +311,114 @@ DSP_GetDeviceBuf(_THIS)
 static int
 DSP_CaptureFromDevice(_THIS, void *buffer, int buflen)
 {
-    return (int) read(this->hidden->audio_fd, buffer, buflen);
+    struct SDL_PrivateAudioData *h = this->hidden;
+    struct pollfd pfd;
+
+    if (!h->poll_timeout) {
+        return (int) read(h->audio_fd, buffer, buflen);
+    }
+
+    /* Take whatever has arrived as soon as it does, but look up now and
+       then in case we're being shut down while the device is stalled. */
+    pfd.fd = h->audio_fd;
+    pfd.events = POLLIN;
+    while (!SDL_AtomicGet(&this->shutdown)) {
+        const int rc = poll(&pfd, 1, h->poll_timeout);
+        if (rc > 0) {
+            const ssize_t br = read(h->audio_fd, buffer, buflen);
+            if (br > 0) {
+                return (int) br;
+            } else if ((br == 0) || ((errno != EAGAIN) && (errno != EINTR))) {
+                return -1;  /* end of file, or the device is gone. */
+            }
+        } else if ((rc < 0) && (errno != EINTR)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int
+DSP_GetCaptureBacklog(_THIS)
+{
+    struct SDL_PrivateAudioData *h = this->hidden;
+    audio_buf_info info;
+    int bytes = 0;
+
+    SDL_zero(info);
+    if (!h->raw) {
+        if (ioctl(h->audio_fd, SNDCTL_DSP_GETISPACE, &info) == 0) {
+            bytes = info.bytes;
+        }
+    } else if (ioctl(h->audio_fd, FIONREAD, &bytes) < 0) {
+        bytes = 0;  /* a plain file has no backlog, it's all there already. */
+    }
+    return bytes;
+}
+
+static int
+DSP_GetPlaybackDelay(_THIS)
+{
+    struct SDL_PrivateAudioData *h = this->hidden;
+    int bytes = 0;
+
+    if (!h->raw) {
+        if (ioctl(h->audio_fd, SNDCTL_DSP_GETODELAY, &bytes) < 0) {
+            bytes = 0;
+        }
+    } else if (ioctl(h->audio_fd, FIONREAD, &bytes) < 0) {
+        bytes = 0;  /* a plain file takes it all at once. */
+    }
+    return bytes;
 }
 
 static void
 DSP_FlushCapture(_THIS)
 {
     struct SDL_PrivateAudioData *h = this->hidden;
+    int bytes = h->raw ? 0 : DSP_GetCaptureBacklog(this);
+
+    while (bytes > 0) {
+        char buf[4096];
+        const ssize_t br = read(h->audio_fd, buf, SDL_min(sizeof (buf), (size_t) bytes));
+        if (br <= 0) {
+            break;
+        }
+        bytes -= (int) br;
+    }
+}
+
+static void
+DSP_GetDeviceXruns(_THIS, Uint32 *underruns, Uint32 *overruns)
+{
+    struct SDL_PrivateAudioData *h = this->hidden;
+#ifdef SNDCTL_DSP_GETERROR
+    audio_errinfo info;
+    if (h->raw) {
+        return;
+    }
+    SDL_zero(info);
+    if (ioctl(h->audio_fd, SNDCTL_DSP_GETERROR, &info) == 0) {
+        *underruns += info.play_underruns;  /* these reset on every call. */
+        *overruns += info.rec_overruns;
+    }
+#else
+    /* No error counters (Linux's OSS emulation), so catch the buffer
+       having run empty (or, capturing, full) since we last looked. */
     audio_buf_info info;
-    if (ioctl(h->audio_fd, SNDCTL_DSP_GETISPACE, &info) == 0) {
-        while (info.bytes > 0) {
-            char buf[512];
-            const size_t len = SDL_min(sizeof (buf), info.bytes);
-            const ssize_t br = read(h->audio_fd, buf, len);
-            if (br <= 0) {
-                break;
-            }
-            info.bytes -= br;
+    SDL_zero(info);
+    if (h->raw || (ioctl(h->audio_fd, this->iscapture ? SNDCTL_DSP_GETISPACE : SNDCTL_DSP_GETOSPACE, &info) < 0)) {
+        return;
+    }
+    if ((info.fragstotal > 0) && (info.fragments >= info.fragstotal)) {
+        if (this->iscapture) {
+            *overruns += 1;
+        } else if (h->xruns_primed) {
+            *underruns += 1;
         }
     }
+    h->xruns_primed = SDL_TRUE;  /* playback starts out empty; that's no underrun. */
+#endif
 }
 
 static SDL_bool InitTimeDevicesExist = SDL_FALSE;
@@ -314,6 +448,10 @@ DSP_Init(SDL_AudioDriverImpl * impl)
     impl->CloseDevice = DSP_CloseDevice;
     impl->CaptureFromDevice = DSP_CaptureFromDevice;
     impl->FlushCapture = DSP_FlushCapture;
+    impl->GetDeviceXruns = DSP_GetDeviceXruns;
+    impl->GetCaptureBacklog = DSP_GetCaptureBacklog;
+    impl->GetPlaybackDelay = DSP_GetPlaybackDelay;
+    impl->PlayDeviceBuffer = DSP_PlayDeviceBuffer;
 
     impl->AllowsArbitraryDeviceNames = SDL_TRUE;
     impl->HasCaptureSupport = SDL_TRUE;
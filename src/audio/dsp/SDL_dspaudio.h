@@ -36,6 +36,15 @@ struct SDL_PrivateAudioData
     /* Raw mixing buffer */
     Uint8 *mixbuf;
     int mixlen;
+
+    /* Whether DSP_GetDeviceXruns() has looked at the buffer yet. */
+    SDL_bool xruns_primed;
+
+    /* A pipe or file instead of a sound device, without any ioctls. */
+    SDL_bool raw;
+
+    /* Low latency capture polls this many milliseconds at a time; 0 reads blocking. */
+    int poll_timeout;
 };
 #define FUDGE_TICKS 10      /* The scheduler overhead ticks per frame */
 
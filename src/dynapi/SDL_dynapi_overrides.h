@@ -893,3 +893,48 @@
 #define SDL_SensorGetDataWithTimestamp SDL_SensorGetDataWithTimestamp_REAL
 #define SDL_ResetHints SDL_ResetHints_REAL
 #define SDL_strcasestr SDL_strcasestr_REAL
+#define SDL_DelayUntil SDL_DelayUntil_REAL
+#define SDL_DelayPeriodic SDL_DelayPeriodic_REAL
+#define SDL_GetMemoryClassStats SDL_GetMemoryClassStats_REAL
+#define SDL_CreateJob SDL_CreateJob_REAL
+#define SDL_AddJobDependency SDL_AddJobDependency_REAL
+#define SDL_SubmitJob SDL_SubmitJob_REAL
+#define SDL_WaitJob SDL_WaitJob_REAL
+#define SDL_DetachJob SDL_DetachJob_REAL
+#define SDL_ParallelFor SDL_ParallelFor_REAL
+#define SDL_GetJobWorkerCount SDL_GetJobWorkerCount_REAL
+#define SDL_RWFromMappedFile SDL_RWFromMappedFile_REAL
+#define SDL_LoadFileAsync SDL_LoadFileAsync_REAL
+#define SDL_LoadBMPAsync SDL_LoadBMPAsync_REAL
+#define SDL_LoadWAVAsync SDL_LoadWAVAsync_REAL
+#define SDL_GetAsyncLoadStatus SDL_GetAsyncLoadStatus_REAL
+#define SDL_WaitAsyncLoad SDL_WaitAsyncLoad_REAL
+#define SDL_CancelAsyncLoad SDL_CancelAsyncLoad_REAL
+#define SDL_GetAsyncLoadData SDL_GetAsyncLoadData_REAL
+#define SDL_GetAsyncLoadSurface SDL_GetAsyncLoadSurface_REAL
+#define SDL_GetAsyncLoadWAV SDL_GetAsyncLoadWAV_REAL
+#define SDL_GetAsyncLoadError SDL_GetAsyncLoadError_REAL
+#define SDL_FreeAsyncLoad SDL_FreeAsyncLoad_REAL
+#define SDL_LoadBMPFormat_RW SDL_LoadBMPFormat_RW_REAL
+#define SDL_NewWAVDecoder SDL_NewWAVDecoder_REAL
+#define SDL_WAVDecoderGet SDL_WAVDecoderGet_REAL
+#define SDL_WAVDecoderSeek SDL_WAVDecoderSeek_REAL
+#define SDL_WAVDecoderLength SDL_WAVDecoderLength_REAL
+#define SDL_FreeWAVDecoder SDL_FreeWAVDecoder_REAL
+#define SDL_GetTextureRLEStats SDL_GetTextureRLEStats_REAL
+#define SDL_MapColors SDL_MapColors_REAL
+#define SDL_CreateAudioVoice SDL_CreateAudioVoice_REAL
+#define SDL_SetAudioVoiceData SDL_SetAudioVoiceData_REAL
+#define SDL_SetAudioVoiceStream SDL_SetAudioVoiceStream_REAL
+#define SDL_SetAudioVoiceGain SDL_SetAudioVoiceGain_REAL
+#define SDL_PauseAudioVoice SDL_PauseAudioVoice_REAL
+#define SDL_GetAudioVoiceStatus SDL_GetAudioVoiceStatus_REAL
+#define SDL_DestroyAudioVoice SDL_DestroyAudioVoice_REAL
+#define SDL_GetAudioQueueStats SDL_GetAudioQueueStats_REAL
+#define SDL_GetAudioDeviceStats SDL_GetAudioDeviceStats_REAL
+#define SDL_GetAudioDeviceTiming SDL_GetAudioDeviceTiming_REAL
+#define SDL_GetAudioCaptureTimestamp SDL_GetAudioCaptureTimestamp_REAL
+#define SDL_GetAudioDeviceClock SDL_GetAudioDeviceClock_REAL
+#define SDL_AcquireAudioQueueBuffer SDL_AcquireAudioQueueBuffer_REAL
+#define SDL_CommitAudioQueueBuffer SDL_CommitAudioQueueBuffer_REAL
+#define SDL_WaitAudioQueueSpace SDL_WaitAudioQueueSpace_REAL
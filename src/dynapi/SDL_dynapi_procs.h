@@ -887,3 +887,48 @@ SDL_DYNAPI_PROC(int,SDL_GameControllerGetSensorDataWithTimestamp,(SDL_GameContro
 SDL_DYNAPI_PROC(int,SDL_SensorGetDataWithTimestamp,(SDL_Sensor *a, Uint64 *b, float *c, int d),(a,b,c,d),return)
 SDL_DYNAPI_PROC(void,SDL_ResetHints,(void),(),)
 SDL_DYNAPI_PROC(char*,SDL_strcasestr,(const char *a, const char *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_DelayUntil,(Uint64 a),(a),)
+SDL_DYNAPI_PROC(Uint64,SDL_DelayPeriodic,(Uint64 *a, Uint64 b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetMemoryClassStats,(SDL_MemoryClassStats *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_Job*,SDL_CreateJob,(SDL_JobFunction a, void *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_AddJobDependency,(SDL_Job *a, SDL_Job *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_SubmitJob,(SDL_Job *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_WaitJob,(SDL_Job *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_DetachJob,(SDL_Job *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_ParallelFor,(int a, int b, int c, SDL_ParallelForFunction d, void *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_GetJobWorkerCount,(void),(),return)
+SDL_DYNAPI_PROC(SDL_RWops*,SDL_RWFromMappedFile,(const char *a),(a),return)
+SDL_DYNAPI_PROC(SDL_AsyncLoad*,SDL_LoadFileAsync,(const char *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_AsyncLoad*,SDL_LoadBMPAsync,(const char *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_AsyncLoad*,SDL_LoadWAVAsync,(const char *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_AsyncLoadStatus,SDL_GetAsyncLoadStatus,(SDL_AsyncLoad *a),(a),return)
+SDL_DYNAPI_PROC(SDL_AsyncLoadStatus,SDL_WaitAsyncLoad,(SDL_AsyncLoad *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_CancelAsyncLoad,(SDL_AsyncLoad *a),(a),)
+SDL_DYNAPI_PROC(void*,SDL_GetAsyncLoadData,(SDL_AsyncLoad *a, size_t *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_GetAsyncLoadSurface,(SDL_AsyncLoad *a),(a),return)
+SDL_DYNAPI_PROC(Uint8*,SDL_GetAsyncLoadWAV,(SDL_AsyncLoad *a, SDL_AudioSpec *b, Uint32 *c),(a,b,c),return)
+SDL_DYNAPI_PROC(const char*,SDL_GetAsyncLoadError,(SDL_AsyncLoad *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_FreeAsyncLoad,(SDL_AsyncLoad *a),(a),)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_LoadBMPFormat_RW,(SDL_RWops *a, int b, Uint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_WAVDecoder*,SDL_NewWAVDecoder,(SDL_RWops *a, int b, SDL_AudioSpec *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_WAVDecoderGet,(SDL_WAVDecoder *a, void *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_WAVDecoderSeek,(SDL_WAVDecoder *a, Sint64 b),(a,b),return)
+SDL_DYNAPI_PROC(Sint64,SDL_WAVDecoderLength,(SDL_WAVDecoder *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_FreeWAVDecoder,(SDL_WAVDecoder *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_GetTextureRLEStats,(SDL_Texture *a, SDL_TextureRLEStats *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_MapColors,(const SDL_PixelFormat *a, const SDL_Color *b, Uint32 *c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_AudioVoice*,SDL_CreateAudioVoice,(SDL_AudioDeviceID a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioVoiceData,(SDL_AudioVoice *a, SDL_AudioFormat b, Uint8 c, const void *d, Uint32 e, int f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioVoiceStream,(SDL_AudioVoice *a, SDL_AudioStream *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioVoiceGain,(SDL_AudioVoice *a, float b, float c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_PauseAudioVoice,(SDL_AudioVoice *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_AudioStatus,SDL_GetAudioVoiceStatus,(SDL_AudioVoice *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyAudioVoice,(SDL_AudioVoice *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_GetAudioQueueStats,(SDL_AudioDeviceID a, SDL_AudioQueueStats *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetAudioDeviceStats,(SDL_AudioDeviceID a, SDL_AudioDeviceStats *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetAudioDeviceTiming,(SDL_AudioDeviceID a, SDL_AudioTimingStats *b),(a,b),return)
+SDL_DYNAPI_PROC(Uint64,SDL_GetAudioCaptureTimestamp,(SDL_AudioDeviceID a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetAudioDeviceClock,(SDL_AudioDeviceID a, SDL_AudioClock *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_AcquireAudioQueueBuffer,(SDL_AudioDeviceID a, void **b, Uint32 *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_CommitAudioQueueBuffer,(SDL_AudioDeviceID a, Uint32 b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_WaitAudioQueueSpace,(SDL_AudioDeviceID a, Uint32 b, Uint32 c),(a,b,c),return)
@@ -219,6 +219,11 @@ SDL_LogEvent(const SDL_Event *event)
         SDL_EVENT_CASE(SDL_RENDER_TARGETS_RESET) break;
         SDL_EVENT_CASE(SDL_RENDER_DEVICE_RESET) break;
 
+        SDL_EVENT_CASE(SDL_ASYNCLOADCOMPLETE)
+            SDL_snprintf(details, sizeof (details), " (timestamp=%u load=%p status=%d)",
+                (uint) event->user.timestamp, event->user.data1, (int) event->user.code);
+            break;
+
         SDL_EVENT_CASE(SDL_DISPLAYEVENT) {
             char name2[64];
             switch (event->display.event) {
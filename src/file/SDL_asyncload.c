@@ -0,0 +1,496 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* Background loading of files, images and sounds */
+
+#include "SDL.h"
+#include "SDL_asyncload_c.h"
+#include "../thread/SDL_systhread.h"
+
+typedef enum
+{
+    SDL_ASYNCLOAD_TYPE_FILE,
+    SDL_ASYNCLOAD_TYPE_BMP,
+    SDL_ASYNCLOAD_TYPE_WAV
+} SDL_AsyncLoadType;
+
+struct SDL_AsyncLoad
+{
+    SDL_AsyncLoadType type;
+    char *file;
+    int priority;
+    SDL_atomic_t status;    /* SDL_AsyncLoadStatus */
+    SDL_atomic_t canceled;  /* the result is to be thrown away */
+    SDL_bool queued;        /* waiting in the read queue */
+    SDL_bool released;      /* freed by the application while we were working on it */
+    SDL_AsyncLoad *next;
+
+    void *data;
+    size_t datasize;
+    SDL_Surface *surface;
+    SDL_AudioSpec spec;
+    Uint8 *audio_buf;
+    Uint32 audio_len;
+    char *error;
+};
+
+static SDL_SpinLock SDL_asyncload_init_lock;
+static SDL_mutex *SDL_asyncload_lock;
+static SDL_cond *SDL_asyncload_cond;
+static SDL_Thread *SDL_asyncload_thread;
+static SDL_AsyncLoad *SDL_asyncload_queue;
+static int SDL_asyncload_in_flight;
+static SDL_bool SDL_asyncload_quit;
+
+
+static void
+SDL_FreeAsyncLoadResults(SDL_AsyncLoad *load)
+{
+    SDL_free(load->data);
+    load->data = NULL;
+    SDL_FreeSurface(load->surface);
+    load->surface = NULL;
+    SDL_FreeWAV(load->audio_buf);
+    load->audio_buf = NULL;
+}
+
+static void
+SDL_DestroyAsyncLoad(SDL_AsyncLoad *load)
+{
+    SDL_FreeAsyncLoadResults(load);
+    SDL_free(load->error);
+    SDL_free(load->file);
+    SDL_free(load);
+}
+
+/* These are called with the lock held */
+static void
+SDL_QueueAsyncLoad(SDL_AsyncLoad *load)
+{
+    SDL_AsyncLoad **prev = &SDL_asyncload_queue;
+
+    while (*prev && (*prev)->priority >= load->priority) {
+        prev = &(*prev)->next;
+    }
+    load->next = *prev;
+    *prev = load;
+    load->queued = SDL_TRUE;
+}
+
+static void
+SDL_UnqueueAsyncLoad(SDL_AsyncLoad *load)
+{
+    SDL_AsyncLoad **prev = &SDL_asyncload_queue;
+
+    while (*prev != load) {
+        prev = &(*prev)->next;
+    }
+    *prev = load->next;
+    load->next = NULL;
+    load->queued = SDL_FALSE;
+}
+
+static void
+SDL_PostAsyncLoadEvent(SDL_AsyncLoad *load, SDL_AsyncLoadStatus status)
+{
+    if (SDL_WasInit(SDL_INIT_EVENTS) && SDL_GetEventState(SDL_ASYNCLOADCOMPLETE) == SDL_ENABLE) {
+        SDL_Event event;
+
+        SDL_zero(event);
+        event.type = SDL_ASYNCLOADCOMPLETE;
+        event.user.code = (Sint32) status;
+        event.user.data1 = load;
+        SDL_PushEvent(&event);
+    }
+}
+
+/* The event is pushed with the lock held, so the application can't free the
+   handle between publishing the status and queueing the event. */
+static void
+SDL_FinishAsyncLoad(SDL_AsyncLoad *load, SDL_bool success)
+{
+    SDL_AsyncLoadStatus status = SDL_ASYNCLOAD_CANCELED;
+
+    if (!success) {
+        load->error = SDL_strdup(SDL_GetError());
+    }
+
+    SDL_LockMutex(SDL_asyncload_lock);
+    --SDL_asyncload_in_flight;
+    if (load->released) {
+        SDL_DestroyAsyncLoad(load);
+    } else {
+        if (SDL_AtomicGet(&load->canceled)) {
+            SDL_FreeAsyncLoadResults(load);
+        } else {
+            status = success ? SDL_ASYNCLOAD_COMPLETE : SDL_ASYNCLOAD_FAILED;
+        }
+        SDL_AtomicSet(&load->status, status);
+        SDL_PostAsyncLoadEvent(load, status);
+    }
+    SDL_CondBroadcast(SDL_asyncload_cond);
+    SDL_UnlockMutex(SDL_asyncload_lock);
+}
+
+static void SDLCALL
+SDL_DecodeAsyncLoad(void *data)
+{
+    SDL_AsyncLoad *load = (SDL_AsyncLoad *)data;
+    SDL_bool success = SDL_TRUE;
+
+    if (!SDL_AtomicGet(&load->canceled)) {
+        SDL_RWops *src = NULL;
+
+        if (load->datasize > SDL_MAX_SINT32) {
+            SDL_SetError("%s is too large", load->file);
+        } else {
+            src = SDL_RWFromConstMem(load->data, (int)load->datasize);
+        }
+
+        if (!src) {
+            success = SDL_FALSE;
+        } else if (load->type == SDL_ASYNCLOAD_TYPE_BMP) {
+            load->surface = SDL_LoadBMP_RW(src, 1);
+            success = (load->surface != NULL);
+        } else {
+            success = (SDL_LoadWAV_RW(src, 1, &load->spec, &load->audio_buf, &load->audio_len) != NULL);
+        }
+    }
+    SDL_free(load->data);
+    load->data = NULL;
+
+    SDL_FinishAsyncLoad(load, success);
+}
+
+static int SDLCALL
+SDL_AsyncLoadThread(void *unused)
+{
+    SDL_AsyncLoad *load;
+    SDL_RWops *src;
+    SDL_Job *job;
+
+    SDL_LockMutex(SDL_asyncload_lock);
+    for (;;) {
+        while (!SDL_asyncload_queue && !SDL_asyncload_quit) {
+            SDL_CondWait(SDL_asyncload_cond, SDL_asyncload_lock);
+        }
+        if (SDL_asyncload_quit) {
+            break;
+        }
+
+        load = SDL_asyncload_queue;
+        SDL_UnqueueAsyncLoad(load);
+        ++SDL_asyncload_in_flight;
+        SDL_UnlockMutex(SDL_asyncload_lock);
+
+        /* Not SDL_LoadFile(), which would replace the reason the open failed */
+        src = SDL_RWFromFile(load->file, "rb");
+        if (src) {
+            load->data = SDL_LoadFile_RW(src, &load->datasize, 1);
+        }
+        if (!load->data) {
+            SDL_FinishAsyncLoad(load, SDL_FALSE);
+        } else if (load->type == SDL_ASYNCLOAD_TYPE_FILE) {
+            SDL_FinishAsyncLoad(load, SDL_TRUE);
+        } else {
+            /* Decode elsewhere, so the next read can start right away */
+            job = SDL_CreateJob(SDL_DecodeAsyncLoad, load);
+            if (job) {
+                SDL_SubmitJob(job);
+                SDL_DetachJob(job);
+            } else {
+                SDL_DecodeAsyncLoad(load);
+            }
+        }
+
+        SDL_LockMutex(SDL_asyncload_lock);
+    }
+    SDL_UnlockMutex(SDL_asyncload_lock);
+
+    return 0;
+}
+
+static int
+SDL_StartAsyncLoad(void)
+{
+    int retval = 0;
+
+    SDL_AtomicLock(&SDL_asyncload_init_lock);
+    if (!SDL_asyncload_thread) {
+        SDL_asyncload_lock = SDL_CreateMutex();
+        SDL_asyncload_cond = SDL_CreateCond();
+        if (SDL_asyncload_lock && SDL_asyncload_cond) {
+            SDL_asyncload_thread = SDL_CreateThreadInternal(SDL_AsyncLoadThread, "SDLAsyncLoad", 0, NULL);
+        }
+        if (!SDL_asyncload_thread) {
+            SDL_DestroyCond(SDL_asyncload_cond);
+            SDL_asyncload_cond = NULL;
+            SDL_DestroyMutex(SDL_asyncload_lock);
+            SDL_asyncload_lock = NULL;
+            retval = -1;
+        }
+    }
+    SDL_AtomicUnlock(&SDL_asyncload_init_lock);
+
+    return retval;
+}
+
+void
+SDL_QuitAsyncLoad(void)
+{
+    SDL_AsyncLoad *load;
+
+    SDL_AtomicLock(&SDL_asyncload_init_lock);
+    if (SDL_asyncload_thread) {
+        SDL_LockMutex(SDL_asyncload_lock);
+        SDL_asyncload_quit = SDL_TRUE;
+        while (SDL_asyncload_queue) {
+            load = SDL_asyncload_queue;
+            SDL_UnqueueAsyncLoad(load);
+            SDL_AtomicSet(&load->status, SDL_ASYNCLOAD_CANCELED);
+        }
+        SDL_CondBroadcast(SDL_asyncload_cond);
+        SDL_UnlockMutex(SDL_asyncload_lock);
+
+        SDL_WaitThread(SDL_asyncload_thread, NULL);
+        SDL_asyncload_thread = NULL;
+
+        /* Decoding may still be going on in the job system */
+        SDL_LockMutex(SDL_asyncload_lock);
+        while (SDL_asyncload_in_flight > 0) {
+            SDL_CondWait(SDL_asyncload_cond, SDL_asyncload_lock);
+        }
+        SDL_UnlockMutex(SDL_asyncload_lock);
+
+        SDL_DestroyCond(SDL_asyncload_cond);
+        SDL_asyncload_cond = NULL;
+        SDL_DestroyMutex(SDL_asyncload_lock);
+        SDL_asyncload_lock = NULL;
+        SDL_asyncload_quit = SDL_FALSE;
+    }
+    SDL_AtomicUnlock(&SDL_asyncload_init_lock);
+}
+
+static SDL_AsyncLoad *
+SDL_CreateAsyncLoad(const char *file, int priority, SDL_AsyncLoadType type)
+{
+    SDL_AsyncLoad *load;
+
+    if (!file || !*file) {
+        SDL_InvalidParamError("file");
+        return NULL;
+    }
+    if (SDL_StartAsyncLoad() < 0) {
+        return NULL;
+    }
+
+    load = (SDL_AsyncLoad *)SDL_calloc(1, sizeof(*load));
+    if (load) {
+        load->file = SDL_strdup(file);
+    }
+    if (!load || !load->file) {
+        SDL_free(load);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    load->type = type;
+    load->priority = priority;
+    SDL_AtomicSet(&load->status, SDL_ASYNCLOAD_PENDING);
+
+    SDL_LockMutex(SDL_asyncload_lock);
+    SDL_QueueAsyncLoad(load);
+    SDL_CondBroadcast(SDL_asyncload_cond);
+    SDL_UnlockMutex(SDL_asyncload_lock);
+
+    return load;
+}
+
+SDL_AsyncLoad *
+SDL_LoadFileAsync(const char *file, int priority)
+{
+    return SDL_CreateAsyncLoad(file, priority, SDL_ASYNCLOAD_TYPE_FILE);
+}
+
+SDL_AsyncLoad *
+SDL_LoadBMPAsync(const char *file, int priority)
+{
+    return SDL_CreateAsyncLoad(file, priority, SDL_ASYNCLOAD_TYPE_BMP);
+}
+
+SDL_AsyncLoad *
+SDL_LoadWAVAsync(const char *file, int priority)
+{
+    return SDL_CreateAsyncLoad(file, priority, SDL_ASYNCLOAD_TYPE_WAV);
+}
+
+SDL_AsyncLoadStatus
+SDL_GetAsyncLoadStatus(SDL_AsyncLoad *load)
+{
+    if (!load) {
+        SDL_InvalidParamError("load");
+        return SDL_ASYNCLOAD_FAILED;
+    }
+    return (SDL_AsyncLoadStatus)SDL_AtomicGet(&load->status);
+}
+
+SDL_AsyncLoadStatus
+SDL_WaitAsyncLoad(SDL_AsyncLoad *load)
+{
+    if (!load) {
+        SDL_InvalidParamError("load");
+        return SDL_ASYNCLOAD_FAILED;
+    }
+
+    SDL_LockMutex(SDL_asyncload_lock);
+    if (load->queued) {
+        /* Someone is blocked on this one, so it goes next */
+        SDL_UnqueueAsyncLoad(load);
+        load->next = SDL_asyncload_queue;
+        SDL_asyncload_queue = load;
+        load->queued = SDL_TRUE;
+    }
+    while (SDL_AtomicGet(&load->status) == SDL_ASYNCLOAD_PENDING) {
+        SDL_CondWait(SDL_asyncload_cond, SDL_asyncload_lock);
+    }
+    SDL_UnlockMutex(SDL_asyncload_lock);
+
+    return (SDL_AsyncLoadStatus)SDL_AtomicGet(&load->status);
+}
+
+void
+SDL_CancelAsyncLoad(SDL_AsyncLoad *load)
+{
+    if (!load) {
+        SDL_InvalidParamError("load");
+        return;
+    }
+
+    SDL_LockMutex(SDL_asyncload_lock);
+    if (load->queued) {
+        SDL_UnqueueAsyncLoad(load);
+        SDL_AtomicSet(&load->status, SDL_ASYNCLOAD_CANCELED);
+        SDL_CondBroadcast(SDL_asyncload_cond);
+        SDL_PostAsyncLoadEvent(load, SDL_ASYNCLOAD_CANCELED);
+    } else if (SDL_AtomicGet(&load->status) == SDL_ASYNCLOAD_PENDING) {
+        SDL_AtomicSet(&load->canceled, 1);
+    }
+    SDL_UnlockMutex(SDL_asyncload_lock);
+}
+
+void *
+SDL_GetAsyncLoadData(SDL_AsyncLoad *load, size_t *datasize)
+{
+    void *data = NULL;
+
+    if (!load) {
+        SDL_InvalidParamError("load");
+        return NULL;
+    }
+
+    if (SDL_AtomicGet(&load->status) == SDL_ASYNCLOAD_COMPLETE && load->type == SDL_ASYNCLOAD_TYPE_FILE) {
+        data = load->data;
+        load->data = NULL;
+        if (data && datasize) {
+            *datasize = load->datasize;
+        }
+    }
+    return data;
+}
+
+SDL_Surface *
+SDL_GetAsyncLoadSurface(SDL_AsyncLoad *load)
+{
+    SDL_Surface *surface = NULL;
+
+    if (!load) {
+        SDL_InvalidParamError("load");
+        return NULL;
+    }
+
+    if (SDL_AtomicGet(&load->status) == SDL_ASYNCLOAD_COMPLETE) {
+        surface = load->surface;
+        load->surface = NULL;
+    }
+    return surface;
+}
+
+Uint8 *
+SDL_GetAsyncLoadWAV(SDL_AsyncLoad *load, SDL_AudioSpec *spec, Uint32 *audio_len)
+{
+    Uint8 *audio_buf = NULL;
+
+    if (!load) {
+        SDL_InvalidParamError("load");
+        return NULL;
+    }
+    if (!spec) {
+        SDL_InvalidParamError("spec");
+        return NULL;
+    }
+
+    if (SDL_AtomicGet(&load->status) == SDL_ASYNCLOAD_COMPLETE && load->audio_buf) {
+        audio_buf = load->audio_buf;
+        load->audio_buf = NULL;
+        *spec = load->spec;
+        if (audio_len) {
+            *audio_len = load->audio_len;
+        }
+    }
+    return audio_buf;
+}
+
+const char *
+SDL_GetAsyncLoadError(SDL_AsyncLoad *load)
+{
+    if (!load) {
+        SDL_InvalidParamError("load");
+        return "";
+    }
+
+    if (SDL_AtomicGet(&load->status) == SDL_ASYNCLOAD_FAILED && load->error) {
+        return load->error;
+    }
+    return "";
+}
+
+void
+SDL_FreeAsyncLoad(SDL_AsyncLoad *load)
+{
+    if (!load) {
+        return;
+    }
+
+    SDL_LockMutex(SDL_asyncload_lock);
+    if (load->queued) {
+        SDL_UnqueueAsyncLoad(load);
+        SDL_DestroyAsyncLoad(load);
+    } else if (SDL_AtomicGet(&load->status) == SDL_ASYNCLOAD_PENDING) {
+        /* Whoever is working on it cleans up when they're done */
+        SDL_AtomicSet(&load->canceled, 1);
+        load->released = SDL_TRUE;
+    } else {
+        SDL_DestroyAsyncLoad(load);
+    }
+    SDL_UnlockMutex(SDL_asyncload_lock);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
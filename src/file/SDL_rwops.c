@@ -38,11 +38,19 @@
 #include <limits.h>
 #endif
 
+#ifdef HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 /* This file provides a general interface for SDL to read and write
    data sources.  It can easily be extended to files, memory, etc.
 */
 
 #include "SDL_endian.h"
+#include "SDL_hints.h"
 #include "SDL_rwops.h"
 
 #ifdef HAVE_STDIO_H
@@ -261,6 +269,84 @@ mem_close(SDL_RWops * context)
     return 0;
 }
 
+#ifdef HAVE_MMAP
+/* Functions to read memory-mapped files, through the memory functions */
+
+/* Files smaller than this aren't worth a mapping when SDL_RWFromFile() has the choice */
+#define MMAP_MIN_FILE_SIZE  (64 * 1024)
+
+static int SDLCALL
+mmap_close(SDL_RWops * context)
+{
+    if (context) {
+        if (context->hidden.mem.base) {
+            munmap(context->hidden.mem.base, (size_t)(context->hidden.mem.stop - context->hidden.mem.base));
+        }
+        SDL_FreeRW(context);
+    }
+    return 0;
+}
+
+static SDL_RWops *
+mmap_open(const char *file, Sint64 min_size)
+{
+    SDL_RWops *rwops = NULL;
+    struct stat st;
+    void *base = NULL;
+    int fd;
+
+    fd = open(file, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        if (min_size == 0) {
+            SDL_SetError("Couldn't open %s", file);
+        }
+        return NULL;
+    }
+
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode) ||
+        st.st_size < min_size || (Uint64)st.st_size > (SDL_SIZE_MAX >> 1)) {
+        if (min_size == 0) {
+            SDL_SetError("Couldn't map %s", file);
+        }
+        close(fd);
+        return NULL;
+    }
+
+    if (st.st_size > 0) {
+        base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (base == MAP_FAILED) {
+            if (min_size == 0) {
+                SDL_SetError("Couldn't map %s", file);
+            }
+            close(fd);
+            return NULL;
+        }
+#ifdef HAVE_MADVISE
+        madvise(base, (size_t)st.st_size, MADV_SEQUENTIAL);
+        madvise(base, (size_t)st.st_size, MADV_WILLNEED);
+#endif
+    }
+    /* The mapping keeps the file alive */
+    close(fd);
+
+    rwops = SDL_AllocRW();
+    if (rwops != NULL) {
+        rwops->size = mem_size;
+        rwops->seek = mem_seek;
+        rwops->read = mem_read;
+        rwops->write = mem_writeconst;
+        rwops->close = mmap_close;
+        rwops->hidden.mem.base = (Uint8 *) base;
+        rwops->hidden.mem.here = rwops->hidden.mem.base;
+        rwops->hidden.mem.stop = rwops->hidden.mem.base + (size_t)st.st_size;
+        rwops->type = SDL_RWOPS_MAPPED;
+    } else if (base) {
+        munmap(base, (size_t)st.st_size);
+    }
+    return rwops;
+}
+#endif /* HAVE_MMAP */
+
 
 /* Functions to create SDL_RWops structures from various data sources */
 
@@ -272,6 +358,15 @@ SDL_RWFromFile(const char *file, const char *mode)
         SDL_SetError("SDL_RWFromFile(): No file or no mode specified");
         return NULL;
     }
+#ifdef HAVE_MMAP
+    if ((SDL_strcmp(mode, "r") == 0 || SDL_strcmp(mode, "rb") == 0) &&
+        SDL_GetHintBoolean(SDL_HINT_RWOPS_MMAP, SDL_FALSE)) {
+        rwops = mmap_open(file, MMAP_MIN_FILE_SIZE);
+        if (rwops) {
+            return rwops;
+        }
+    }
+#endif
 #if   HAVE_STDIO_H
     {
         FILE *fp = fopen(file, mode);
@@ -372,6 +467,21 @@ SDL_RWFromConstMem(const void *mem, int size)
     return rwops;
 }
 
+SDL_RWops *
+SDL_RWFromMappedFile(const char *file)
+{
+    if (!file || !*file) {
+        SDL_InvalidParamError("file");
+        return NULL;
+    }
+#ifdef HAVE_MMAP
+    return mmap_open(file, 0);
+#else
+    SDL_Unsupported();
+    return NULL;
+#endif
+}
+
 SDL_RWops *
 SDL_AllocRW(void)
 {
@@ -410,12 +520,36 @@ SDL_LoadFile_RW(SDL_RWops * src, size_t *datasize, int freesrc)
     if (size < 0) {
         size = FILE_CHUNK_SIZE;
     }
+    if ((Uint64)size >= SDL_SIZE_MAX) {
+        SDL_OutOfMemory();
+        goto done;
+    }
     data = SDL_malloc((size_t)(size + 1));
+    if (!data) {
+        SDL_OutOfMemory();
+        goto done;
+    }
 
     size_total = 0;
     for (;;) {
-        if ((((Sint64)size_total) + FILE_CHUNK_SIZE) > size) {
-            size = (size_total + FILE_CHUNK_SIZE);
+        if (((Sint64)size_total) == size) {
+            /* The buffer is full, which usually means the size was known up
+               front and we're done: check before growing it. */
+            char extra;
+
+            if (SDL_RWread(src, &extra, 1, 1) == 0) {
+                break;
+            }
+
+            /* Grow geometrically, so streams of unknown size are read in
+               linear time rather than being copied over and over */
+            size = SDL_max(size * 2, FILE_CHUNK_SIZE);
+            if ((Uint64)size >= SDL_SIZE_MAX) {
+                SDL_free(data);
+                data = NULL;
+                SDL_OutOfMemory();
+                goto done;
+            }
             newdata = SDL_realloc(data, (size_t)(size + 1));
             if (!newdata) {
                 SDL_free(data);
@@ -424,6 +558,7 @@ SDL_LoadFile_RW(SDL_RWops * src, size_t *datasize, int freesrc)
                 goto done;
             }
             data = newdata;
+            ((char *)data)[size_total++] = extra;
         }
 
         size_read = SDL_RWread(src, (char *)data+size_total, 1, (size_t)(size-size_total));
@@ -28,6 +28,7 @@
 #include "SDL_sysrender.h"
 #include "software/SDL_render_sw_c.h"
 #include "../video/SDL_pixels_c.h"
+#include "../video/SDL_blit.h"
 
 /* as a courtesy to iOS apps, we don't try to draw when in the background, as
 that will crash the app. However, these apps _should_ have used
@@ -197,6 +198,58 @@ DebugLogRenderCommands(const SDL_RenderCommand *cmd)
 #endif
 }
 
+struct SDL_RenderScratchBlock
+{
+    SDL_RenderScratchBlock *next;
+    size_t size;
+    size_t used;
+};
+
+#define SDL_RENDER_SCRATCH_MIN_BLOCK (64 * 1024)
+
+static void
+ResetRenderScratch(SDL_Renderer *renderer)
+{
+    SDL_RenderScratchBlock *block = renderer->scratch;
+
+    if (renderer->scratch_used > renderer->scratch_high_water) {
+        renderer->scratch_high_water = renderer->scratch_used;
+        SDL_LogDebug(SDL_LOG_CATEGORY_RENDER, "Render scratch high water mark: %u bytes",
+                     (unsigned int) renderer->scratch_high_water);
+    }
+    renderer->scratch_used = 0;
+
+    if (block && block->next) {
+        /* The pass didn't fit in one block, replace the chain with a single
+           block that holds all of it next time. */
+        size_t total = 0;
+        while (block) {
+            SDL_RenderScratchBlock *next = block->next;
+            total += block->size;
+            SDL_free(block);
+            block = next;
+        }
+        renderer->scratch = NULL;
+        renderer->scratch_reserve = total;
+    } else if (block) {
+        block->used = 0;
+    }
+}
+
+static void
+FreeRenderScratch(SDL_Renderer *renderer)
+{
+    SDL_RenderScratchBlock *block = renderer->scratch;
+
+    while (block) {
+        SDL_RenderScratchBlock *next = block->next;
+        SDL_free(block);
+        block = next;
+    }
+    renderer->scratch = NULL;
+    renderer->scratch_used = 0;
+}
+
 static int
 FlushRenderCommands(SDL_Renderer *renderer)
 {
@@ -213,6 +266,9 @@ FlushRenderCommands(SDL_Renderer *renderer)
 
     retval = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
 
+    /* Nothing allocated from the scratch arena outlives the pass */
+    ResetRenderScratch(renderer);
+
     /* Move the whole render command queue to the unused pool so we can reuse them next time. */
     if (renderer->render_commands_tail != NULL) {
         renderer->render_commands_tail->next = renderer->render_commands_pool;
@@ -287,6 +343,174 @@ SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes, const
     return ((Uint8 *) renderer->vertex_data) + aligned;
 }
 
+void *
+SDL_AllocateRenderScratch(SDL_Renderer *renderer, const size_t numbytes, const size_t alignment)
+{
+    SDL_RenderScratchBlock *block = renderer->scratch;
+    Uint8 *base;
+    size_t aligner, size;
+
+    SDL_assert(alignment && (alignment & (alignment - 1)) == 0);
+
+    if (block) {
+        base = (Uint8 *) (block + 1) + block->used;
+        aligner = (size_t) (-(uintptr_t) base & (alignment - 1));
+        if (numbytes <= block->size - block->used && aligner <= block->size - block->used - numbytes) {
+            block->used += aligner + numbytes;
+            renderer->scratch_used += aligner + numbytes;
+            return base + aligner;
+        }
+    }
+
+    /* Start a new block, at least twice as big as the last one */
+    if (numbytes > SDL_SIZE_MAX - sizeof(*block) - alignment) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    size = SDL_max(renderer->scratch_reserve, SDL_RENDER_SCRATCH_MIN_BLOCK);
+    if (block) {
+        size = SDL_max(size, block->size * 2);
+    }
+    size = SDL_max(size, numbytes + alignment);
+
+    block = (SDL_RenderScratchBlock *) SDL_malloc(sizeof(*block) + size);
+    if (block == NULL) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    block->next = renderer->scratch;
+    block->size = size;
+    block->used = 0;
+    renderer->scratch = block;
+    renderer->scratch_reserve = 0;
+
+    base = (Uint8 *) (block + 1);
+    aligner = (size_t) (-(uintptr_t) base & (alignment - 1));
+    block->used = aligner + numbytes;
+    renderer->scratch_used += aligner + numbytes;
+    return base + aligner;
+}
+
+/* Everything SDL_CreateRGBSurfaceWithFormatFrom() would allocate, in one piece */
+typedef struct SDL_RenderScratchSurface
+{
+    SDL_Surface surface;
+    SDL_PixelFormat format;
+    SDL_BlitMap map;
+    SDL_Palette palette;
+} SDL_RenderScratchSurface;
+
+SDL_Surface *
+SDL_CreateRenderScratchSurface(SDL_Renderer *renderer, int width, int height, Uint32 format)
+{
+    SDL_RenderScratchSurface *scratch;
+    SDL_Surface *surface;
+    size_t pitch, size;
+    void *pixels;
+
+    if (width < 0) {
+        SDL_InvalidParamError("width");
+        return NULL;
+    }
+    if (height < 0) {
+        SDL_InvalidParamError("height");
+        return NULL;
+    }
+    if (SDL_ISPIXELFORMAT_FOURCC(format)) {
+        SDL_Unsupported();
+        return NULL;
+    }
+
+    /* Same pitch as SDL_CreateRGBSurfaceWithFormat(); formats like RGB888
+       have fewer bits per pixel than they take up. */
+    if (SDL_BITSPERPIXEL(format) >= 8) {
+        if (SDL_size_mul_overflow((size_t) width, SDL_BYTESPERPIXEL(format), &pitch)) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+    } else if (SDL_size_mul_overflow((size_t) width, SDL_BITSPERPIXEL(format), &pitch)) {
+        SDL_OutOfMemory();
+        return NULL;
+    } else {
+        pitch = (pitch + 7) / 8;
+    }
+    pitch = (pitch + 3) & ~3;
+    if (pitch > SDL_MAX_SINT32 || SDL_size_mul_overflow(pitch, (size_t) height, &size)) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    scratch = (SDL_RenderScratchSurface *) SDL_AllocateRenderScratch(renderer, sizeof(*scratch), sizeof(void *));
+    if (scratch == NULL) {
+        return NULL;
+    }
+    if (SDL_InitFormat(&scratch->format, format) < 0) {
+        return NULL;
+    }
+    if (SDL_ISPIXELFORMAT_INDEXED(format)) {
+        const int ncolors = 1 << SDL_BITSPERPIXEL(format);
+        SDL_Color *colors = (SDL_Color *) SDL_AllocateRenderScratch(renderer, ncolors * sizeof(SDL_Color), sizeof(void *));
+        if (colors == NULL) {
+            return NULL;
+        }
+        SDL_memset(colors, 0xFF, ncolors * sizeof(SDL_Color));  /* as SDL_AllocPalette() */
+        if (ncolors == 2) {
+            colors[1].r = colors[1].g = colors[1].b = 0x00;  /* black and white, as SDL_CreateRGBSurfaceWithFormat() */
+        }
+        scratch->palette.ncolors = ncolors;
+        scratch->palette.colors = colors;
+        scratch->palette.version = 1;
+        scratch->palette.refcount = 1;
+        scratch->format.palette = &scratch->palette;
+    }
+
+    pixels = SDL_AllocateRenderScratch(renderer, size, 16);
+    if (pixels == NULL) {
+        return NULL;
+    }
+    SDL_memset(pixels, 0, size);
+
+    /* Same as SDL_CreateSurfaceOnStack(), plus the clip rect blits need */
+    SDL_zero(scratch->map);
+    scratch->map.info.r = 0xFF;
+    scratch->map.info.g = 0xFF;
+    scratch->map.info.b = 0xFF;
+    scratch->map.info.a = 0xFF;
+
+    surface = &scratch->surface;
+    SDL_zerop(surface);
+    surface->flags = SDL_PREALLOC | SDL_DONTFREE;
+    surface->format = &scratch->format;
+    surface->pixels = pixels;
+    surface->w = width;
+    surface->h = height;
+    surface->pitch = (int) pitch;
+    surface->map = &scratch->map;
+    surface->refcount = 1;
+    SDL_SetClipRect(surface, NULL);
+    if (scratch->format.Amask) {
+        SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_BLEND);
+    }
+    return surface;
+}
+
+void
+SDL_FreeRenderScratchSurface(SDL_Surface *surface)
+{
+    if (surface == NULL) {
+        return;
+    }
+    if ((surface->flags & (SDL_PREALLOC | SDL_DONTFREE)) != (SDL_PREALLOC | SDL_DONTFREE)) {
+        SDL_FreeSurface(surface);
+        return;
+    }
+
+    /* The memory goes back with the arena; just drop the blit mappings
+       to and from it, so no other surface keeps a stale one. */
+    SDL_InvalidateMap(surface->map);
+    SDL_InvalidateAllBlitMap(surface);
+}
+
 static SDL_RenderCommand *
 AllocateRenderCommand(SDL_Renderer *renderer)
 {
@@ -1299,7 +1523,7 @@ SDL_CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int
         renderer->textures = texture;
 
         if (SDL_ISPIXELFORMAT_FOURCC(texture->format)) {
-            SDL_SetError("SDL not built with YUV support");
+            texture->yuv = SDL_SW_CreateYUVTexture(format, w, h);
             if (!texture->yuv) {
                 SDL_DestroyTexture(texture);
                 return NULL;
@@ -1622,6 +1846,63 @@ SDL_GetTextureUserData(SDL_Texture * texture)
     return texture->userdata;
 }
 
+int
+SDL_GetTextureRLEStats(SDL_Texture * texture, SDL_TextureRLEStats *stats)
+{
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+    if (!(texture->renderer->info.flags & SDL_RENDERER_SOFTWARE)) {
+        return SDL_Unsupported();
+    }
+    if (texture->native) {
+        texture = texture->native;
+    }
+    *stats = texture->rle_stats;
+    return 0;
+}
+
+/* Convert the whole YUV data of a texture into its native texture */
+static int
+SDL_UpdateTextureFromYUV(SDL_Texture * texture)
+{
+    SDL_Texture *native = texture->native;
+    SDL_Rect full_rect;
+
+    full_rect.x = 0;
+    full_rect.y = 0;
+    full_rect.w = texture->w;
+    full_rect.h = texture->h;
+
+    if (texture->access == SDL_TEXTUREACCESS_STREAMING) {
+        /* We can lock the texture and copy to it */
+        void *native_pixels = NULL;
+        int native_pitch = 0;
+
+        if (SDL_LockTexture(native, &full_rect, &native_pixels, &native_pitch) < 0) {
+            return -1;
+        }
+        SDL_SW_CopyYUVToRGB(texture->yuv, &full_rect, native->format,
+                            full_rect.w, full_rect.h, native_pixels, native_pitch);
+        SDL_UnlockTexture(native);
+    } else {
+        /* Use a temporary buffer for updating */
+        const int temp_pitch = (((full_rect.w * SDL_BYTESPERPIXEL(native->format)) + 3) & ~3);
+        const size_t alloclen = (size_t) full_rect.h * temp_pitch;
+        void *temp_pixels = SDL_malloc(alloclen);
+        if (!temp_pixels) {
+            return SDL_OutOfMemory();
+        }
+        SDL_SW_CopyYUVToRGB(texture->yuv, &full_rect, native->format,
+                            full_rect.w, full_rect.h, temp_pixels, temp_pitch);
+        SDL_UpdateTexture(native, &full_rect, temp_pixels, temp_pitch);
+        SDL_free(temp_pixels);
+    }
+    return 0;
+}
+
 static int
 SDL_UpdateTextureNative(SDL_Texture * texture, const SDL_Rect * rect,
                         const void *pixels, int pitch)
@@ -1663,6 +1944,16 @@ SDL_UpdateTextureNative(SDL_Texture * texture, const SDL_Rect * rect,
     return 0;
 }
 
+static int
+SDL_UpdateTextureYUV(SDL_Texture * texture, const SDL_Rect * rect,
+                     const void *pixels, int pitch)
+{
+    if (SDL_SW_UpdateYUVTexture(texture->yuv, rect, pixels, pitch) < 0) {
+        return -1;
+    }
+    return SDL_UpdateTextureFromYUV(texture);
+}
+
 int
 SDL_UpdateTexture(SDL_Texture * texture, const SDL_Rect * rect,
                   const void *pixels, int pitch)
@@ -1690,6 +1981,8 @@ SDL_UpdateTexture(SDL_Texture * texture, const SDL_Rect * rect,
 
     if (real_rect.w == 0 || real_rect.h == 0) {
         return 0;  /* nothing to do. */
+    } else if (texture->native && texture->yuv) {
+        return SDL_UpdateTextureYUV(texture, &real_rect, pixels, pitch);
     } else if (texture->native) {
         return SDL_UpdateTextureNative(texture, &real_rect, pixels, pitch);
     } else {
@@ -1706,17 +1999,119 @@ int SDL_UpdateYUVTexture(SDL_Texture * texture, const SDL_Rect * rect,
                          const Uint8 *Uplane, int Upitch,
                          const Uint8 *Vplane, int Vpitch)
 {
-    return -1;
+    SDL_Renderer *renderer;
+    SDL_Rect real_rect;
+
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (!Yplane) {
+        return SDL_InvalidParamError("Yplane");
+    }
+    if (!Ypitch) {
+        return SDL_InvalidParamError("Ypitch");
+    }
+    if (!Uplane) {
+        return SDL_InvalidParamError("Uplane");
+    }
+    if (!Upitch) {
+        return SDL_InvalidParamError("Upitch");
+    }
+    if (!Vplane) {
+        return SDL_InvalidParamError("Vplane");
+    }
+    if (!Vpitch) {
+        return SDL_InvalidParamError("Vpitch");
+    }
+
+    if (texture->format != SDL_PIXELFORMAT_YV12 &&
+        texture->format != SDL_PIXELFORMAT_IYUV) {
+        return SDL_SetError("Texture format must by YV12 or IYUV");
+    }
+
+    real_rect.x = 0;
+    real_rect.y = 0;
+    real_rect.w = texture->w;
+    real_rect.h = texture->h;
+    if (rect) {
+        SDL_IntersectRect(rect, &real_rect, &real_rect);
+    }
+
+    if (real_rect.w == 0 || real_rect.h == 0) {
+        return 0;  /* nothing to do. */
+    }
+
+    if (texture->native) {
+        if (SDL_SW_UpdateYUVTexturePlanar(texture->yuv, &real_rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch) < 0) {
+            return -1;
+        }
+        return SDL_UpdateTextureFromYUV(texture);
+    }
+
+    renderer = texture->renderer;
+    if (!renderer->UpdateTextureYUV) {
+        return SDL_Unsupported();
+    }
+    if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
+        return -1;
+    }
+    return renderer->UpdateTextureYUV(renderer, texture, &real_rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
 }
 
 int SDL_UpdateNVTexture(SDL_Texture * texture, const SDL_Rect * rect,
                          const Uint8 *Yplane, int Ypitch,
                          const Uint8 *UVplane, int UVpitch)
 {
-    return -1;
-}
+    SDL_Renderer *renderer;
+    SDL_Rect real_rect;
+
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (!Yplane) {
+        return SDL_InvalidParamError("Yplane");
+    }
+    if (!Ypitch) {
+        return SDL_InvalidParamError("Ypitch");
+    }
+    if (!UVplane) {
+        return SDL_InvalidParamError("UVplane");
+    }
+    if (!UVpitch) {
+        return SDL_InvalidParamError("UVpitch");
+    }
+
+    if (texture->format != SDL_PIXELFORMAT_NV12 &&
+        texture->format != SDL_PIXELFORMAT_NV21) {
+        return SDL_SetError("Texture format must by NV12 or NV21");
+    }
+
+    real_rect.x = 0;
+    real_rect.y = 0;
+    real_rect.w = texture->w;
+    real_rect.h = texture->h;
+    if (rect) {
+        SDL_IntersectRect(rect, &real_rect, &real_rect);
+    }
+
+    if (real_rect.w == 0 || real_rect.h == 0) {
+        return 0;  /* nothing to do. */
+    }
 
+    if (texture->native) {
+        if (SDL_SW_UpdateNVTexturePlanar(texture->yuv, &real_rect, Yplane, Ypitch, UVplane, UVpitch) < 0) {
+            return -1;
+        }
+        return SDL_UpdateTextureFromYUV(texture);
+    }
 
+    renderer = texture->renderer;
+    if (!renderer->UpdateTextureNV) {
+        return SDL_Unsupported();
+    }
+    if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
+        return -1;
+    }
+    return renderer->UpdateTextureNV(renderer, texture, &real_rect, Yplane, Ypitch, UVplane, UVpitch);
+}
 
 static int
 SDL_LockTextureNative(SDL_Texture * texture, const SDL_Rect * rect,
@@ -1750,7 +2145,10 @@ SDL_LockTexture(SDL_Texture * texture, const SDL_Rect * rect,
         rect = &full_rect;
     }
 
-    if (texture->native) {
+    if (texture->native && texture->yuv) {
+        /* The native texture is refreshed on unlock */
+        return SDL_SW_LockYUVTexture(texture->yuv, rect, pixels, pitch);
+    } else if (texture->native) {
         /* Calls a real SDL_LockTexture/SDL_UnlockTexture on unlock, flushing then. */
         return SDL_LockTextureNative(texture, rect, pixels, pitch);
     } else {
@@ -1827,7 +2225,10 @@ SDL_UnlockTexture(SDL_Texture * texture)
     if (texture->access != SDL_TEXTUREACCESS_STREAMING) {
         return;
     }
-    if (texture->native) {
+    if (texture->native && texture->yuv) {
+        SDL_SW_UnlockYUVTexture(texture->yuv);
+        SDL_UpdateTextureFromYUV(texture);
+    } else if (texture->native) {
         SDL_UnlockTextureNative(texture);
     } else {
         SDL_Renderer *renderer = texture->renderer;
@@ -3986,6 +4387,8 @@ SDL_DestroyTexture(SDL_Texture * texture)
 
     renderer->DestroyTexture(renderer, texture);
 
+    SDL_SW_DestroyYUVTexture(texture->yuv);
+
     SDL_FreeSurface(texture->locked_surface);
     texture->locked_surface = NULL;
 
@@ -4019,6 +4422,7 @@ SDL_DestroyRenderer(SDL_Renderer * renderer)
     }
 
     SDL_free(renderer->vertex_data);
+    FreeRenderScratch(renderer);
 
     /* Free existing textures for this renderer */
     while (renderer->textures) {
@@ -66,7 +66,7 @@ struct SDL_Texture
 
     /* Support for formats not supported directly by the renderer */
     SDL_Texture *native;
-    SDL_SW_YUVTexture *yuv;
+    SDL_SW_YUVTexture *yuv;     /**< Also set by back-ends handling YUV in system memory, freed by SDL_DestroyTexture() */
     void *pixels;
     int pitch;
     SDL_Rect locked_rect;
@@ -74,6 +74,9 @@ struct SDL_Texture
 
     Uint32 last_command_generation; /* last command queue generation this texture was in. */
 
+    SDL_TextureRLEStats rle_stats;  /**< Measured by back-ends drawing through RLE */
+    int rle_trial;              /**< Back-end state for choosing between RLE and plain copies */
+
     void *driverdata;           /**< Driver specific texture representation */
     void *userdata;
 
@@ -139,6 +142,8 @@ typedef enum
 } SDL_RenderLineMethod;
 
 
+typedef struct SDL_RenderScratchBlock SDL_RenderScratchBlock;
+
 /* Define the SDL renderer structure */
 struct SDL_Renderer
 {
@@ -170,6 +175,15 @@ struct SDL_Renderer
     int (*UpdateTexture) (SDL_Renderer * renderer, SDL_Texture * texture,
                           const SDL_Rect * rect, const void *pixels,
                           int pitch);
+    int (*UpdateTextureYUV) (SDL_Renderer * renderer, SDL_Texture * texture,
+                             const SDL_Rect * rect,
+                             const Uint8 *Yplane, int Ypitch,
+                             const Uint8 *Uplane, int Upitch,
+                             const Uint8 *Vplane, int Vpitch);
+    int (*UpdateTextureNV) (SDL_Renderer * renderer, SDL_Texture * texture,
+                            const SDL_Rect * rect,
+                            const Uint8 *Yplane, int Ypitch,
+                            const Uint8 *UVplane, int UVpitch);
     int (*LockTexture) (SDL_Renderer * renderer, SDL_Texture * texture,
                         const SDL_Rect * rect, void **pixels, int *pitch);
     void (*UnlockTexture) (SDL_Renderer * renderer, SDL_Texture * texture);
@@ -270,6 +284,12 @@ struct SDL_Renderer
     size_t vertex_data_used;
     size_t vertex_data_allocation;
 
+    /* Scratch memory for temporaries of a single RunCommandQueue() pass */
+    SDL_RenderScratchBlock *scratch;
+    size_t scratch_used;
+    size_t scratch_reserve;
+    size_t scratch_high_water;
+
     void *driverdata;
 };
 
@@ -309,6 +329,23 @@ extern SDL_BlendOperation SDL_GetBlendModeAlphaOperation(SDL_BlendMode blendMode
    the next call, because it might be in an array that gets realloc()'d. */
 extern void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes, const size_t alignment, size_t *offset);
 
+/* drivers call this during RunCommandQueue() for temporary memory that is only needed until
+   it returns. The memory comes from an arena owned by the renderer that is reset after every
+   pass, so once it has grown to fit a frame no heap allocation happens. Pointers returned here
+   stay valid until RunCommandQueue() returns. `alignment` must be a power of two. */
+extern void *SDL_AllocateRenderScratch(SDL_Renderer *renderer, const size_t numbytes, const size_t alignment);
+
+/* Same as SDL_CreateRGBSurfaceWithFormat(), but the surface, its format, blit map and
+   palette come from SDL_AllocateRenderScratch() with the zero-filled pixels. The surface
+   must be released with SDL_FreeRenderScratchSurface() before RunCommandQueue() returns;
+   SDL_FreeSurface() ignores it. Blitting to or from it can still allocate the small list
+   node SDL_MapSurface() uses to track the mapping. */
+extern SDL_Surface *SDL_CreateRenderScratchSurface(SDL_Renderer *renderer, int width, int height, Uint32 format);
+
+/* Release a surface from SDL_CreateRenderScratchSurface(); any other surface is passed
+   on to SDL_FreeSurface(), so code holding either kind can call this. */
+extern void SDL_FreeRenderScratchSurface(SDL_Surface *surface);
+
 extern int SDL_PrivateLowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect, SDL_Surface * dst, SDL_Rect * dstrect, SDL_ScaleMode scaleMode);
 extern int SDL_PrivateUpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect, SDL_Surface * dst, SDL_Rect * dstrect, SDL_ScaleMode scaleMode);
 
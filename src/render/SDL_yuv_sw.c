@@ -22,4 +22,289 @@
 
 /* This is the software implementation of the YUV texture support */
 
+#include "SDL_cpuinfo.h"
+#include "SDL_yuv_sw_c.h"
+#include "../video/SDL_yuv_c.h"
+
+
+SDL_SW_YUVTexture *
+SDL_SW_CreateYUVTexture(Uint32 format, int w, int h)
+{
+    SDL_SW_YUVTexture *swdata;
+    size_t size;
+
+    switch (format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        break;
+    default:
+        SDL_SetError("Unsupported YUV format");
+        return NULL;
+    }
+
+    if (SDL_CalculateYUVSize(format, w, h, &size, NULL) < 0) {
+        return NULL;
+    }
+
+    swdata = (SDL_SW_YUVTexture *) SDL_calloc(1, sizeof(*swdata));
+    if (!swdata) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    swdata->format = format;
+    swdata->w = w;
+    swdata->h = h;
+    swdata->pixels = (Uint8 *) SDL_SIMDAlloc(size);
+    if (!swdata->pixels) {
+        SDL_SW_DestroyYUVTexture(swdata);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    /* Find the pitch and offset values for the texture, planes are in memory order */
+    switch (format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+        swdata->pitches[0] = w;
+        swdata->pitches[1] = (swdata->pitches[0] + 1) / 2;
+        swdata->pitches[2] = (swdata->pitches[0] + 1) / 2;
+        swdata->planes[0] = swdata->pixels;
+        swdata->planes[1] = swdata->planes[0] + (size_t) swdata->pitches[0] * h;
+        swdata->planes[2] = swdata->planes[1] + (size_t) swdata->pitches[1] * ((h + 1) / 2);
+        break;
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+        swdata->pitches[0] = ((w + 1) / 2) * 4;
+        swdata->planes[0] = swdata->pixels;
+        break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        swdata->pitches[0] = w;
+        swdata->pitches[1] = 2 * ((swdata->pitches[0] + 1) / 2);
+        swdata->planes[0] = swdata->pixels;
+        swdata->planes[1] = swdata->planes[0] + (size_t) swdata->pitches[0] * h;
+        break;
+    default:
+        SDL_assert(0 && "We should never get here (caught above)");
+        break;
+    }
+
+    /* Black, rather than whatever the allocator left there */
+    SDL_memset(swdata->pixels, 0, size);
+    if (swdata->planes[1]) {
+        SDL_memset(swdata->planes[1], 0x80, size - (size_t) (swdata->planes[1] - swdata->pixels));
+    } else {
+        int i;
+        const int offset = (format == SDL_PIXELFORMAT_UYVY) ? 0 : 1;
+        for (i = offset; i < (int) size; i += 2) {
+            swdata->pixels[i] = 0x80;
+        }
+    }
+    swdata->dirty = SDL_TRUE;
+
+    /* We're all done.. */
+    return swdata;
+}
+
+int
+SDL_SW_QueryYUVTexturePixels(SDL_SW_YUVTexture * swdata, void **pixels,
+                             int *pitch)
+{
+    *pixels = swdata->planes[0];
+    *pitch = swdata->pitches[0];
+    return 0;
+}
+
+static void
+CopyRows(const Uint8 *src, int src_pitch, Uint8 *dst, int dst_pitch, size_t length, int rows)
+{
+    int row;
+
+    for (row = 0; row < rows; ++row) {
+        SDL_memcpy(dst, src, length);
+        src += src_pitch;
+        dst += dst_pitch;
+    }
+}
+
+int
+SDL_SW_UpdateYUVTexture(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
+                        const void *pixels, int pitch)
+{
+    const Uint8 *src = (const Uint8 *) pixels;
+    const SDL_bool full = (rect->x == 0 && rect->y == 0 &&
+                           rect->w == swdata->w && rect->h == swdata->h &&
+                           pitch == swdata->pitches[0]);
+
+    switch (swdata->format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+        if (full) {
+            SDL_memcpy(swdata->pixels, src,
+                       (size_t) swdata->pitches[0] * swdata->h +
+                       2 * (size_t) swdata->pitches[1] * ((swdata->h + 1) / 2));
+        } else {
+            const int src_uv_pitch = (pitch + 1) / 2;
+            const size_t uv_length = (rect->w + 1) / 2;
+            const int uv_rows = (rect->h + 1) / 2;
+            const size_t uv_offset = (size_t) (rect->y / 2) * swdata->pitches[1] + rect->x / 2;
+
+            /* Copy the Y plane */
+            CopyRows(src, pitch, swdata->planes[0] + (size_t) rect->y * swdata->pitches[0] + rect->x,
+                     swdata->pitches[0], rect->w, rect->h);
+            src += (size_t) rect->h * pitch;
+
+            /* Copy the next plane */
+            CopyRows(src, src_uv_pitch, swdata->planes[1] + uv_offset,
+                     swdata->pitches[1], uv_length, uv_rows);
+            src += (size_t) uv_rows * src_uv_pitch;
+
+            /* Copy the next plane */
+            CopyRows(src, src_uv_pitch, swdata->planes[2] + uv_offset,
+                     swdata->pitches[2], uv_length, uv_rows);
+        }
+        break;
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+        CopyRows(src, pitch, swdata->planes[0] + (size_t) rect->y * swdata->pitches[0] + (rect->x / 2) * 4,
+                 swdata->pitches[0], 4 * (((size_t) rect->w + 1) / 2), rect->h);
+        break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        if (full) {
+            SDL_memcpy(swdata->pixels, src,
+                       (size_t) swdata->pitches[0] * swdata->h +
+                       (size_t) swdata->pitches[1] * ((swdata->h + 1) / 2));
+        } else {
+            /* Copy the Y plane */
+            CopyRows(src, pitch, swdata->planes[0] + (size_t) rect->y * swdata->pitches[0] + rect->x,
+                     swdata->pitches[0], rect->w, rect->h);
+            src += (size_t) rect->h * pitch;
+
+            /* Copy the UV or VU plane */
+            CopyRows(src, 2 * ((pitch + 1) / 2),
+                     swdata->planes[1] + (size_t) (rect->y / 2) * swdata->pitches[1] + 2 * (rect->x / 2),
+                     swdata->pitches[1], 2 * (((size_t) rect->w + 1) / 2), (rect->h + 1) / 2);
+        }
+        break;
+    default:
+        return SDL_SetError("Unsupported YUV format");
+    }
+    swdata->dirty = SDL_TRUE;
+    return 0;
+}
+
+int
+SDL_SW_UpdateYUVTexturePlanar(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
+                              const Uint8 *Yplane, int Ypitch,
+                              const Uint8 *Uplane, int Upitch,
+                              const Uint8 *Vplane, int Vpitch)
+{
+    const size_t uv_offset = (size_t) (rect->y / 2) * swdata->pitches[1] + rect->x / 2;
+    Uint8 *udst, *vdst;
+
+    if (swdata->format == SDL_PIXELFORMAT_YV12) {
+        vdst = swdata->planes[1];
+        udst = swdata->planes[2];
+    } else {
+        udst = swdata->planes[1];
+        vdst = swdata->planes[2];
+    }
+
+    /* Copy the Y plane */
+    CopyRows(Yplane, Ypitch, swdata->planes[0] + (size_t) rect->y * swdata->pitches[0] + rect->x,
+             swdata->pitches[0], rect->w, rect->h);
+
+    /* Copy the U plane */
+    CopyRows(Uplane, Upitch, udst + uv_offset, swdata->pitches[1], (rect->w + 1) / 2, (rect->h + 1) / 2);
+
+    /* Copy the V plane */
+    CopyRows(Vplane, Vpitch, vdst + uv_offset, swdata->pitches[2], (rect->w + 1) / 2, (rect->h + 1) / 2);
+
+    swdata->dirty = SDL_TRUE;
+    return 0;
+}
+
+int
+SDL_SW_UpdateNVTexturePlanar(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
+                             const Uint8 *Yplane, int Ypitch,
+                             const Uint8 *UVplane, int UVpitch)
+{
+    /* Copy the Y plane */
+    CopyRows(Yplane, Ypitch, swdata->planes[0] + (size_t) rect->y * swdata->pitches[0] + rect->x,
+             swdata->pitches[0], rect->w, rect->h);
+
+    /* Copy the UV or VU plane */
+    CopyRows(UVplane, UVpitch,
+             swdata->planes[1] + (size_t) (rect->y / 2) * swdata->pitches[1] + 2 * (rect->x / 2),
+             swdata->pitches[1], 2 * (((size_t) rect->w + 1) / 2), (rect->h + 1) / 2);
+
+    swdata->dirty = SDL_TRUE;
+    return 0;
+}
+
+int
+SDL_SW_LockYUVTexture(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
+                      void **pixels, int *pitch)
+{
+    switch (swdata->format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        if (rect
+            && (rect->x != 0 || rect->y != 0 || rect->w != swdata->w
+                || rect->h != swdata->h)) {
+            return SDL_SetError
+                ("YV12, IYUV, NV12, NV21 textures only support full surface locks");
+        }
+        break;
+    default:
+        break;
+    }
+
+    if (rect) {
+        *pixels = swdata->planes[0] + (size_t) rect->y * swdata->pitches[0] + (rect->x / 2) * 4;
+    } else {
+        *pixels = swdata->planes[0];
+    }
+    *pitch = swdata->pitches[0];
+
+    /* The caller may write anywhere in the locked area */
+    swdata->dirty = SDL_TRUE;
+    return 0;
+}
+
+void
+SDL_SW_UnlockYUVTexture(SDL_SW_YUVTexture * swdata)
+{
+}
+
+int
+SDL_SW_CopyYUVToRGB(SDL_SW_YUVTexture * swdata, const SDL_Rect * srcrect,
+                    Uint32 target_format, int w, int h, void *pixels,
+                    int pitch)
+{
+    return SDL_ConvertPixels_YUV_to_RGB_Scaled(swdata->w, swdata->h, swdata->format,
+                                               swdata->planes[0], swdata->pitches[0],
+                                               srcrect, w, h, target_format, pixels, pitch);
+}
+
+void
+SDL_SW_DestroyYUVTexture(SDL_SW_YUVTexture * swdata)
+{
+    if (swdata) {
+        SDL_SIMDFree(swdata->pixels);
+        SDL_free(swdata);
+    }
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
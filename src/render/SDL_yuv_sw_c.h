@@ -31,17 +31,15 @@
 struct SDL_SW_YUVTexture
 {
     Uint32 format;
-    Uint32 target_format;
     int w, h;
     Uint8 *pixels;
 
     /* These are just so we don't have to allocate them separately */
-    Uint16 pitches[3];
+    int pitches[3];
     Uint8 *planes[3];
 
-    /* This is a temporary surface in case we have to stretch copy */
-    SDL_Surface *stretch;
-    SDL_Surface *display;
+    /* Set whenever the pixels change, for users keeping a converted copy */
+    SDL_bool dirty;
 };
 
 typedef struct SDL_SW_YUVTexture SDL_SW_YUVTexture;
@@ -61,6 +59,8 @@ int SDL_SW_UpdateNVTexturePlanar(SDL_SW_YUVTexture * swdata, const SDL_Rect * re
 int SDL_SW_LockYUVTexture(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
                           void **pixels, int *pitch);
 void SDL_SW_UnlockYUVTexture(SDL_SW_YUVTexture * swdata);
+/* Convert the srcrect part of the texture to w x h pixels of target_format,
+   scaling in the same pass if the sizes differ */
 int SDL_SW_CopyYUVToRGB(SDL_SW_YUVTexture * swdata, const SDL_Rect * srcrect,
                         Uint32 target_format, int w, int h, void *pixels,
                         int pitch);
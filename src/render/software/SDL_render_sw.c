@@ -25,6 +25,7 @@
 #include "../SDL_sysrender.h"
 #include "SDL_render_sw_c.h"
 #include "SDL_hints.h"
+#include "SDL_timer.h"
 
 #include "SDL_draw.h"
 #include "SDL_blendfillrect.h"
@@ -34,6 +35,7 @@
 #include "SDL_drawpoint.h"
 #include "SDL_rotate.h"
 #include "SDL_triangle.h"
+#include "../../video/SDL_pixels_c.h"
 
 /* SDL surface based renderer implementation */
 
@@ -108,6 +110,15 @@ SW_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
     int bpp;
     Uint32 Rmask, Gmask, Bmask, Amask;
 
+    /* YUV textures are converted when they are drawn, see SW_RenderCopyYUV() */
+    if (SDL_ISPIXELFORMAT_FOURCC(texture->format)) {
+        texture->yuv = SDL_SW_CreateYUVTexture(texture->format, texture->w, texture->h);
+        if (!texture->yuv) {
+            return -1;
+        }
+        return 0;
+    }
+
     if (!SDL_PixelFormatEnumToMasks
         (texture->format, &bpp, &Rmask, &Gmask, &Bmask, &Amask)) {
         return SDL_SetError("Unknown texture format");
@@ -120,16 +131,27 @@ SW_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
     SDL_SetSurfaceAlphaMod(texture->driverdata, texture->color.a);
     SDL_SetSurfaceBlendMode(texture->driverdata, texture->blendMode);
 
-    /* Only RLE encode textures without an alpha channel since the RLE coder
-     * discards the color values of pixels with an alpha value of zero.
-     */
-    if (texture->access == SDL_TEXTUREACCESS_STATIC && !Amask) {
-        SDL_SetSurfaceRLE(texture->driverdata, 1);
-    }
-
     if (!texture->driverdata) {
         return -1;
     }
+
+    /* Static textures without an alpha channel are RLE encoded by their
+     * first blit that can use it. Alpha textures are not: RLE blends
+     * 16-bit targets with 5-bit alpha, so their output would depend on
+     * which way SW_CopyTexture() is drawing them at the time.
+     * The original pixels are kept, so updates don't have to decode them.
+     * SW_CopyTexture() turns RLE off again for the textures it doesn't
+     * speed up, which drops their encoding; the ones that stay RLE hold
+     * both copies of their pixels.
+     */
+    if (texture->access == SDL_TEXTUREACCESS_STATIC && !Amask) {
+#if SDL_HAVE_RLE
+        SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
+        surface->map->info.flags |= SDL_COPY_RLE_KEEP;
+        SDL_SetSurfaceRLE(surface, 1);
+        texture->rle_stats.rle = SDL_TRUE;
+#endif
+    }
     return 0;
 }
 
@@ -142,6 +164,10 @@ SW_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
     int row;
     size_t length;
 
+    if (texture->yuv) {
+        return SDL_SW_UpdateYUVTexture(texture->yuv, rect, pixels, pitch);
+    }
+
     if(SDL_MUSTLOCK(surface))
         SDL_LockSurface(surface);
     src = (Uint8 *) pixels;
@@ -159,12 +185,37 @@ SW_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
     return 0;
 }
 
+static int
+SW_UpdateTextureYUV(SDL_Renderer * renderer, SDL_Texture * texture,
+                    const SDL_Rect * rect,
+                    const Uint8 *Yplane, int Ypitch,
+                    const Uint8 *Uplane, int Upitch,
+                    const Uint8 *Vplane, int Vpitch)
+{
+    return SDL_SW_UpdateYUVTexturePlanar(texture->yuv, rect, Yplane, Ypitch,
+                                         Uplane, Upitch, Vplane, Vpitch);
+}
+
+static int
+SW_UpdateTextureNV(SDL_Renderer * renderer, SDL_Texture * texture,
+                   const SDL_Rect * rect,
+                   const Uint8 *Yplane, int Ypitch,
+                   const Uint8 *UVplane, int UVpitch)
+{
+    return SDL_SW_UpdateNVTexturePlanar(texture->yuv, rect, Yplane, Ypitch,
+                                        UVplane, UVpitch);
+}
+
 static int
 SW_LockTexture(SDL_Renderer * renderer, SDL_Texture * texture,
                const SDL_Rect * rect, void **pixels, int *pitch)
 {
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
 
+    if (texture->yuv) {
+        return SDL_SW_LockYUVTexture(texture->yuv, rect, pixels, pitch);
+    }
+
     *pixels =
         (void *) ((Uint8 *) surface->pixels + rect->y * surface->pitch +
                   rect->x * surface->format->BytesPerPixel);
@@ -175,6 +226,9 @@ SW_LockTexture(SDL_Renderer * renderer, SDL_Texture * texture,
 static void
 SW_UnlockTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
+    if (texture->yuv) {
+        SDL_SW_UnlockYUVTexture(texture->yuv);
+    }
 }
 
 static void
@@ -404,8 +458,7 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
      * to clear the pixels in the destination surface. The other steps are explained below.
      */
     if (blendmode == SDL_BLENDMODE_NONE && !isOpaque) {
-        mask = SDL_CreateRGBSurface(0, final_rect->w, final_rect->h, 32,
-                                    0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+        mask = SDL_CreateRenderScratchSurface(renderer, final_rect->w, final_rect->h, SDL_PIXELFORMAT_ARGB8888);
         if (mask == NULL) {
             retval = -1;
         } else {
@@ -418,8 +471,7 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
      */
     if (!retval && (blitRequired || applyModulation)) {
         SDL_Rect scale_rect = tmp_rect;
-        src_scaled = SDL_CreateRGBSurface(0, final_rect->w, final_rect->h, 32,
-                                          0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+        src_scaled = SDL_CreateRenderScratchSurface(renderer, final_rect->w, final_rect->h, SDL_PIXELFORMAT_ARGB8888);
         if (src_scaled == NULL) {
             retval = -1;
         } else {
@@ -440,7 +492,7 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
 
         SDLgfx_rotozoomSurfaceSizeTrig(tmp_rect.w, tmp_rect.h, angle, center,
                 &rect_dest, &cangle, &sangle);
-        src_rotated = SDLgfx_rotateSurface(src_clone, angle,
+        src_rotated = SDLgfx_rotateSurface(renderer, src_clone, angle,
                 (texture->scaleMode == SDL_ScaleModeNearest) ? 0 : 1, flip & SDL_FLIP_HORIZONTAL, flip & SDL_FLIP_VERTICAL,
                 &rect_dest, cangle, sangle, center);
         if (src_rotated == NULL) {
@@ -448,7 +500,7 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
         }
         if (!retval && mask != NULL) {
             /* The mask needed for the NONE blend mode gets rotated with the same parameters. */
-            mask_rotated = SDLgfx_rotateSurface(mask, angle,
+            mask_rotated = SDLgfx_rotateSurface(renderer, mask, angle,
                     SDL_FALSE, 0, 0,
                     &rect_dest, cangle, sangle, center);
             if (mask_rotated == NULL) {
@@ -513,10 +565,10 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
                         }
                     }
                 }
-                SDL_FreeSurface(mask_rotated);
+                SDL_FreeRenderScratchSurface(mask_rotated);
             }
             if (src_rotated != NULL) {
-                SDL_FreeSurface(src_rotated);
+                SDL_FreeRenderScratchSurface(src_rotated);
             }
         }
     }
@@ -525,10 +577,10 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
         SDL_UnlockSurface(src);
     }
     if (mask != NULL) {
-        SDL_FreeSurface(mask);
+        SDL_FreeRenderScratchSurface(mask);
     }
     if (src_clone != NULL) {
-        SDL_FreeSurface(src_clone);
+        SDL_FreeRenderScratchSurface(src_clone);
     }
     return retval;
 }
@@ -631,6 +683,82 @@ SW_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL_Texture *te
     return 0;
 }
 
+/* Get the RGB surface of a YUV texture, for the draws that can't convert
+   straight into the target. It is created on first use in the format of
+   the target, and converted again only after the YUV data changed. */
+static SDL_Surface *
+SW_GetYUVTextureSurface(SDL_Texture * texture, SDL_Surface *target)
+{
+    SDL_SW_YUVTexture *swdata = texture->yuv;
+    SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
+    SDL_Rect rect;
+
+    if (!surface) {
+        Uint32 format = target->format->format;
+        if (SDL_ISPIXELFORMAT_INDEXED(format) || SDL_ISPIXELFORMAT_FOURCC(format)) {
+            format = SDL_PIXELFORMAT_RGB888;
+        }
+        surface = SDL_CreateRGBSurfaceWithFormat(0, texture->w, texture->h, 0, format);
+        if (!surface) {
+            return NULL;
+        }
+        texture->driverdata = surface;
+        swdata->dirty = SDL_TRUE;
+    }
+
+    if (swdata->dirty) {
+        rect.x = 0;
+        rect.y = 0;
+        rect.w = texture->w;
+        rect.h = texture->h;
+        if (SDL_SW_CopyYUVToRGB(swdata, &rect, surface->format->format,
+                                rect.w, rect.h, surface->pixels, surface->pitch) < 0) {
+            return NULL;
+        }
+        swdata->dirty = SDL_FALSE;
+    }
+    return surface;
+}
+
+/* Convert a YUV texture straight into the target, scaling in the same pass.
+   Returns SDL_FALSE if the copy has to go through SW_GetYUVTextureSurface(). */
+static SDL_bool
+SW_RenderCopyYUV(SDL_Surface *surface, const SDL_RenderCommand *cmd,
+                 const SDL_Rect *srcrect, const SDL_Rect *dstrect)
+{
+    SDL_Texture *texture = cmd->data.draw.texture;
+    const SDL_Rect *clip = &surface->clip_rect;
+    const SDL_BlendMode blend = cmd->data.draw.blend;
+    Uint8 *pixels;
+
+    /* YUV is opaque, so blending is only a copy */
+    if ((cmd->data.draw.r & cmd->data.draw.g & cmd->data.draw.b & cmd->data.draw.a) != 0xFF ||
+        (blend != SDL_BLENDMODE_NONE && blend != SDL_BLENDMODE_BLEND)) {
+        return SDL_FALSE;
+    }
+    if (texture->scaleMode != SDL_ScaleModeNearest &&
+        (srcrect->w != dstrect->w || srcrect->h != dstrect->h)) {
+        return SDL_FALSE;
+    }
+    if (SDL_MUSTLOCK(surface) || SDL_ISPIXELFORMAT_INDEXED(surface->format->format)) {
+        return SDL_FALSE;
+    }
+    if (dstrect->w <= 0 || dstrect->h <= 0) {
+        return SDL_TRUE;  /* nothing to draw */
+    }
+    /* Clipping a scaled copy would need the source cut in proportion */
+    if (dstrect->x < clip->x || dstrect->y < clip->y ||
+        dstrect->x + dstrect->w > clip->x + clip->w ||
+        dstrect->y + dstrect->h > clip->y + clip->h) {
+        return SDL_FALSE;
+    }
+
+    pixels = (Uint8 *) surface->pixels + dstrect->y * surface->pitch +
+             dstrect->x * surface->format->BytesPerPixel;
+    return (SDL_SW_CopyYUVToRGB(texture->yuv, srcrect, surface->format->format,
+                                dstrect->w, dstrect->h, pixels, surface->pitch) == 0);
+}
+
 static void
 PrepTextureForCopy(const SDL_RenderCommand *cmd)
 {
@@ -641,20 +769,95 @@ PrepTextureForCopy(const SDL_RenderCommand *cmd)
     const SDL_BlendMode blend = cmd->data.draw.blend;
     SDL_Texture *texture = cmd->data.draw.texture;
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
-    const SDL_bool colormod = ((r & g & b) != 0xFF);
-    const SDL_bool alphamod = (a != 0xFF);
-    const SDL_bool blending = ((blend == SDL_BLENDMODE_ADD) || (blend == SDL_BLENDMODE_MOD) || (blend == SDL_BLENDMODE_MUL));
-
-    if (colormod || alphamod || blending) {
-        SDL_SetSurfaceRLE(surface, 0);
-    }
 
+    /* Modes RLE doesn't support make the next blit skip the encoding, which
+     * is cheap to redo since the pixels are kept, see SW_CreateTexture().
+     */
     /* !!! FIXME: we can probably avoid some of these calls. */
     SDL_SetSurfaceColorMod(surface, r, g, b);
     SDL_SetSurfaceAlphaMod(surface, a);
     SDL_SetSurfaceBlendMode(surface, blend);
 }
 
+/* Number of copies of a texture measured with and without RLE before
+   SW_CopyTexture() settles on the cheaper one */
+#define SW_RLE_TRIAL_COPIES 16
+
+/* Turn RLE on or off for a texture, keeping its statistics up to date */
+static void
+SW_SetTextureRLE(SDL_Texture *texture, SDL_bool rle)
+{
+    SDL_SetSurfaceRLE((SDL_Surface *) texture->driverdata, rle);
+    texture->rle_stats.rle = rle;
+}
+
+/* Draw an unscaled copy of a texture, measuring what it costs. Textures
+ * that may use RLE are first drawn with it until SW_RLE_TRIAL_COPIES copies
+ * went through RLE, whether they drew an existing encoding or had to make a
+ * new one. If most had to encode (the texture keeps changing targets, mods
+ * or gets scaled in between), RLE is turned off right away. Otherwise the
+ * texture is drawn without it for as many copies, and RLE stays on only if
+ * that was cheaper per pixel, counting the time spent encoding.
+ */
+static void
+SW_CopyTexture(SDL_Texture *texture, const SDL_Rect *srcrect,
+               SDL_Surface *surface, SDL_Rect *dstrect)
+{
+    SDL_TextureRLEStats *stats = &texture->rle_stats;
+    SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+    const SDL_bool encoded = ((src->flags & SDL_RLEACCEL) && src->map->dst == surface);
+    Uint64 start, ticks, pixels;
+
+    start = SDL_GetPerformanceCounter();
+    if (SDL_BlitSurface(src, srcrect, surface, dstrect) < 0) {
+        return;
+    }
+    ticks = SDL_GetPerformanceCounter() - start;
+
+    /* The destination rectangle was clipped to what was drawn */
+    pixels = (Uint64) dstrect->w * dstrect->h;
+    if (!pixels) {
+        return;
+    }
+
+    if (!(src->flags & SDL_RLEACCEL)) {
+        ++stats->plain_copies;
+        stats->plain_pixels += pixels;
+        stats->plain_ticks += ticks;
+    } else if (!encoded) {
+        ++stats->encodes;
+        stats->encode_ticks += ticks;
+    } else {
+        ++stats->rle_copies;
+        stats->rle_pixels += pixels;
+        stats->rle_ticks += ticks;
+    }
+
+    if (texture->rle_trial < 0 || (texture->rle_trial == 0 && !stats->rle)) {
+        return;  /* Already decided, or RLE was never possible */
+    }
+    if (texture->rle_trial == 0) {
+        /* Still measuring with RLE. Copies in modes RLE can't do count as
+           plain, and give up on it if they are all there is. */
+        if ((stats->rle_copies + stats->encodes) >= SW_RLE_TRIAL_COPIES ||
+            stats->plain_copies >= (SW_RLE_TRIAL_COPIES * 4)) {
+            if (stats->encodes >= stats->rle_copies) {
+                texture->rle_trial = -1;
+            } else {
+                texture->rle_trial = stats->plain_copies + SW_RLE_TRIAL_COPIES;
+            }
+            SW_SetTextureRLE(texture, SDL_FALSE);
+        }
+    } else if ((int) stats->plain_copies >= texture->rle_trial) {
+        const double rle_cost = (double) (stats->rle_ticks + stats->encode_ticks) / stats->rle_pixels;
+        const double plain_cost = (double) stats->plain_ticks / stats->plain_pixels;
+        texture->rle_trial = -1;
+        if (rle_cost < plain_cost) {
+            SW_SetTextureRLE(texture, SDL_TRUE);
+        }
+    }
+}
+
 static void
 SetDrawState(SDL_Surface *surface, SW_DrawStateCache *drawstate)
 {
@@ -717,7 +920,7 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 const Uint8 a = cmd->data.color.a;
                 /* By definition the clear ignores the clip rect */
                 SDL_SetClipRect(surface, NULL);
-                SDL_FillRect(surface, NULL, SDL_MapRGBA(surface->format, r, g, b, a));
+                SDL_FillRect(surface, NULL, SDL_InlineMapRGBA(surface->format, r, g, b, a));
                 drawstate.surface_cliprect_dirty = SDL_TRUE;
                 break;
             }
@@ -742,7 +945,7 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 }
 
                 if (blend == SDL_BLENDMODE_NONE) {
-                    SDL_DrawPoints(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+                    SDL_DrawPoints(surface, verts, count, SDL_InlineMapRGBA(surface->format, r, g, b, a));
                 } else {
                     SDL_BlendPoints(surface, verts, count, blend, r, g, b, a);
                 }
@@ -769,7 +972,7 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 }
 
                 if (blend == SDL_BLENDMODE_NONE) {
-                    SDL_DrawLines(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+                    SDL_DrawLines(surface, verts, count, SDL_InlineMapRGBA(surface->format, r, g, b, a));
                 } else {
                     SDL_BlendLines(surface, verts, count, blend, r, g, b, a);
                 }
@@ -796,7 +999,7 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 }
 
                 if (blend == SDL_BLENDMODE_NONE) {
-                    SDL_FillRects(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+                    SDL_FillRects(surface, verts, count, SDL_InlineMapRGBA(surface->format, r, g, b, a));
                 } else {
                     SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
                 }
@@ -808,29 +1011,34 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 const SDL_Rect *srcrect = verts;
                 SDL_Rect *dstrect = verts + 1;
                 SDL_Texture *texture = cmd->data.draw.texture;
-                SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+                SDL_Surface *src;
 
                 SetDrawState(surface, &drawstate);
 
-                PrepTextureForCopy(cmd);
-
                 /* Apply viewport */
                 if (drawstate.viewport != NULL && (drawstate.viewport->x || drawstate.viewport->y)) {
                     dstrect->x += drawstate.viewport->x;
                     dstrect->y += drawstate.viewport->y;
                 }
 
+                if (texture->yuv) {
+                    if (SW_RenderCopyYUV(surface, cmd, srcrect, dstrect)) {
+                        break;
+                    }
+                    if (!SW_GetYUVTextureSurface(texture, surface)) {
+                        break;
+                    }
+                }
+                src = (SDL_Surface *) texture->driverdata;
+
+                PrepTextureForCopy(cmd);
+
                 if ( srcrect->w == dstrect->w && srcrect->h == dstrect->h ) {
-                    SDL_BlitSurface(src, srcrect, surface, dstrect);
+                    SW_CopyTexture(texture, srcrect, surface, dstrect);
                 } else {
-                    /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
-                     * to avoid potentially frequent RLE encoding/decoding.
-                     */
-                    SDL_SetSurfaceRLE(surface, 0);
-
                     /* Prevent to do scaling + clipping on viewport boundaries as it may lose proportion */
                     if (dstrect->x < 0 || dstrect->y < 0 || dstrect->x + dstrect->w > surface->w || dstrect->y + dstrect->h > surface->h) {
-                        SDL_Surface *tmp = SDL_CreateRGBSurfaceWithFormat(0, dstrect->w, dstrect->h, 0, src->format->format);
+                        SDL_Surface *tmp = SDL_CreateRenderScratchSurface(renderer, dstrect->w, dstrect->h, src->format->format);
                         /* Scale to an intermediate surface, then blit */
                         if (tmp) {
                             SDL_Rect r;
@@ -857,7 +1065,7 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                             SDL_SetSurfaceBlendMode(tmp, blendmode);
 
                             SDL_BlitSurface(tmp, NULL, surface, dstrect);
-                            SDL_FreeSurface(tmp);
+                            SDL_FreeRenderScratchSurface(tmp);
                             /* No need to set back r/g/b/a/blendmode to 'src' since it's done in PrepTextureForCopy() */
                         }
                     } else{
@@ -870,6 +1078,9 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
             case SDL_RENDERCMD_COPY_EX: {
                 CopyExData *copydata = (CopyExData *) (((Uint8 *) vertices) + cmd->data.draw.first);
                 SetDrawState(surface, &drawstate);
+                if (cmd->data.draw.texture->yuv && !SW_GetYUVTextureSurface(cmd->data.draw.texture, surface)) {
+                    break;
+                }
                 PrepTextureForCopy(cmd);
 
                 /* Apply viewport */
@@ -894,10 +1105,14 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 SetDrawState(surface, &drawstate);
 
                 if (texture) {
-                    SDL_Surface *src = (SDL_Surface *) texture->driverdata;
-
+                    SDL_Surface *src;
                     GeometryCopyData *ptr = (GeometryCopyData *) verts;
 
+                    if (texture->yuv && !SW_GetYUVTextureSurface(texture, surface)) {
+                        break;
+                    }
+                    src = (SDL_Surface *) texture->driverdata;
+
                     PrepTextureForCopy(cmd);
 
                     /* Apply viewport */
@@ -936,7 +1151,7 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                     }
 
                     for (i = 0; i < count; i += 3, ptr += 3) {
-                        SDL_SW_FillTriangle(surface, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color);
+                        SDL_SW_FillTriangle(renderer, surface, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color);
                     }
                 }
                 break;
@@ -1041,6 +1256,8 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     renderer->GetOutputSize = SW_GetOutputSize;
     renderer->CreateTexture = SW_CreateTexture;
     renderer->UpdateTexture = SW_UpdateTexture;
+    renderer->UpdateTextureYUV = SW_UpdateTextureYUV;
+    renderer->UpdateTextureNV = SW_UpdateTextureNV;
     renderer->LockTexture = SW_LockTexture;
     renderer->UnlockTexture = SW_UnlockTexture;
     renderer->SetTextureScaleMode = SW_SetTextureScaleMode;
@@ -1103,7 +1320,7 @@ SDL_RenderDriver SW_RenderDriver = {
     {
      "software",
      SDL_RENDERER_SOFTWARE | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE,
-     8,
+     15,
      {
       SDL_PIXELFORMAT_ARGB8888,
       SDL_PIXELFORMAT_ABGR8888,
@@ -1112,7 +1329,14 @@ SDL_RenderDriver SW_RenderDriver = {
       SDL_PIXELFORMAT_RGB888,
       SDL_PIXELFORMAT_BGR888,
       SDL_PIXELFORMAT_RGB565,
-      SDL_PIXELFORMAT_RGB555
+      SDL_PIXELFORMAT_RGB555,
+      SDL_PIXELFORMAT_YV12,
+      SDL_PIXELFORMAT_IYUV,
+      SDL_PIXELFORMAT_NV12,
+      SDL_PIXELFORMAT_NV21,
+      SDL_PIXELFORMAT_YUY2,
+      SDL_PIXELFORMAT_UYVY,
+      SDL_PIXELFORMAT_YVYU
      },
      0,
      0}
@@ -38,6 +38,8 @@ Andreas Schiffler -- aschiffler at ferzkopp dot net
 #include "SDL.h"
 #include "SDL_rotate.h"
 
+#include "../SDL_sysrender.h"
+
 /* ---- Internally used structures */
 
 /* !
@@ -447,7 +449,7 @@ When using the NONE and MOD modes, color and alpha modulation must be applied be
 */
 
 SDL_Surface *
-SDLgfx_rotateSurface(SDL_Surface * src, double angle, int smooth, int flipx, int flipy,
+SDLgfx_rotateSurface(SDL_Renderer *renderer, SDL_Surface * src, double angle, int smooth, int flipx, int flipy,
         const SDL_Rect *rect_dest, double cangle, double sangle, const SDL_FPoint *center)
 {
     SDL_Surface *rz_dst;
@@ -480,7 +482,7 @@ SDLgfx_rotateSurface(SDL_Surface * src, double angle, int smooth, int flipx, int
     rz_dst = NULL;
     if (is8bit) {
         /* Target surface is 8 bit */
-        rz_dst = SDL_CreateRGBSurfaceWithFormat(0, rect_dest->w, rect_dest->h + GUARD_ROWS, 8, src->format->format);
+        rz_dst = SDL_CreateRenderScratchSurface(renderer, rect_dest->w, rect_dest->h + GUARD_ROWS, src->format->format);
         if (rz_dst != NULL) {
             if (src->format->palette) {
                 for (i = 0; i < src->format->palette->ncolors; i++) {
@@ -491,9 +493,8 @@ SDLgfx_rotateSurface(SDL_Surface * src, double angle, int smooth, int flipx, int
         }
     } else {
         /* Target surface is 32 bit with source RGBA ordering */
-        rz_dst = SDL_CreateRGBSurface(0, rect_dest->w, rect_dest->h + GUARD_ROWS, 32,
-                                      src->format->Rmask, src->format->Gmask,
-                                      src->format->Bmask, src->format->Amask);
+        rz_dst = SDL_CreateRenderScratchSurface(renderer, rect_dest->w, rect_dest->h + GUARD_ROWS,
+                                                src->format->format);
     }
 
     /* Check target */
@@ -26,6 +26,7 @@
 #include "SDL_triangle.h"
 
 #include "../../video/SDL_blit.h"
+#include "../../video/SDL_pixels_c.h"
 
 /* fixed points bits precision
  * Set to 1, so that it can start rendering wth middle of a pixel precision.
@@ -178,7 +179,7 @@ static void bounding_rect(const SDL_Point *a, const SDL_Point *b, const SDL_Poin
                     int g = (int)(((Sint64)w0 * c0.g + (Sint64)w1 * c1.g + (Sint64)w2 * c2.g) / area);  \
                     int b = (int)(((Sint64)w0 * c0.b + (Sint64)w1 * c1.b + (Sint64)w2 * c2.b) / area);  \
                     int a = (int)(((Sint64)w0 * c0.a + (Sint64)w1 * c1.a + (Sint64)w2 * c2.a) / area);  \
-                    int color = SDL_MapRGBA(format, r, g, b, a);                                        \
+                    int color = SDL_InlineMapRGBA(format, r, g, b, a);                                  \
 
 #define TRIANGLE_GET_COLOR                                                                              \
                     int r = (int)(((Sint64)w0 * c0.r + (Sint64)w1 * c1.r + (Sint64)w2 * c2.r) / area);  \
@@ -202,7 +203,7 @@ static void bounding_rect(const SDL_Point *a, const SDL_Point *b, const SDL_Poin
         }                                                                                               \
     }                                                                                                   \
 
-int SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Point *d2, SDL_BlendMode blend, SDL_Color c0, SDL_Color c1, SDL_Color c2)
+int SDL_SW_FillTriangle(SDL_Renderer *renderer, SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Point *d2, SDL_BlendMode blend, SDL_Color c0, SDL_Color c1, SDL_Color c2)
 {
     int ret = 0;
     int dst_locked = 0;
@@ -275,7 +276,7 @@ int SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poin
         }
 
         /* Use an intermediate surface */
-        tmp = SDL_CreateRGBSurfaceWithFormat(0, dstrect.w, dstrect.h, 0, format);
+        tmp = SDL_CreateRenderScratchSurface(renderer, dstrect.w, dstrect.h, format);
         if (tmp == NULL) {
             ret = -1;
             goto end;
@@ -422,7 +423,7 @@ int SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poin
 
     if (tmp) {
         SDL_BlitSurface(tmp, NULL, dst, &dstrect);
-        SDL_FreeSurface(tmp);
+        SDL_FreeRenderScratchSurface(tmp);
     }
 
 end:
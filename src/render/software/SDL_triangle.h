@@ -24,7 +24,9 @@
 
 #include "../../SDL_internal.h"
 
-extern int SDL_SW_FillTriangle(SDL_Surface *dst,
+#include "../SDL_sysrender.h"
+
+extern int SDL_SW_FillTriangle(SDL_Renderer *renderer, SDL_Surface *dst,
         SDL_Point *d0, SDL_Point *d1, SDL_Point *d2,
         SDL_BlendMode blend, SDL_Color c0, SDL_Color c1, SDL_Color c2);
 
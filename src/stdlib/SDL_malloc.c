@@ -29,6 +29,7 @@
 #include "SDL_stdinc.h"
 #include "SDL_atomic.h"
 #include "SDL_error.h"
+#include "SDL_malloc_c.h"
 
 #ifndef HAVE_MALLOC
 #define LACKS_SYS_TYPES_H
@@ -5115,6 +5116,560 @@ static void  SDLCALL real_free(void *p) { free(p); }
 #define real_free dlfree
 #endif
 
+#if defined(SDL_MALLOC_CACHE) && !defined(__GNUC__)
+#undef SDL_MALLOC_CACHE  /* the thread caches need __thread storage */
+#endif
+
+#ifdef SDL_MALLOC_CACHE
+/* Thread-caching front end for the allocator above.
+
+   Requests up to the largest size class are rounded up to a class and
+   served from a per-thread free list, so the steady state of a frame
+   never reaches malloc or takes a lock. Thread caches exchange blocks
+   with a shared per-class depot in batches. Larger blocks (surfaces,
+   audio buffers) go to the real allocator, with a few recently freed
+   ones kept around because the same sizes tend to be reallocated every
+   frame. Those are limited to SDL_MALLOC_CACHE_BIG_BUDGET bytes in total
+   and released by SDL_Quit().
+
+   Every block carries a small header recording its class, so free() and
+   realloc() don't need to know where a pointer came from.
+*/
+#define SDL_MALLOC_CACHE_CLASSES    16
+#define SDL_MALLOC_CACHE_LARGE      SDL_MALLOC_CACHE_CLASSES
+#define SDL_MALLOC_CACHE_THREAD_MAX 64      /* blocks per class in a thread cache */
+#define SDL_MALLOC_CACHE_BATCH      16      /* blocks moved to or from the depot at once */
+#define SDL_MALLOC_CACHE_DEPOT_MAX  512     /* blocks per class in the depot */
+#define SDL_MALLOC_CACHE_BIG_SLOTS  4
+#ifndef SDL_MALLOC_CACHE_BIG_BUDGET
+#define SDL_MALLOC_CACHE_BIG_BUDGET (2 * 1024 * 1024)  /* bytes in all big slots */
+#endif
+
+/* The header keeps the alignment malloc would have given the caller */
+typedef union SDL_MallocCacheHeader
+{
+    struct
+    {
+        size_t size;  /* total block size, including this header */
+        int size_class;
+    } info;
+    void *next;       /* free list link while the block is cached */
+    char align[2 * sizeof(void *)];
+} SDL_MallocCacheHeader;
+
+typedef struct SDL_MallocCacheBin
+{
+    SDL_MallocCacheHeader *head;
+    int count;
+} SDL_MallocCacheBin;
+
+typedef struct SDL_MallocThreadCache
+{
+    SDL_MallocCacheBin bins[SDL_MALLOC_CACHE_CLASSES];
+    /* Small class statistics of a linked thread, kept here so the fast
+       path needs no atomic operations */
+    int allocations[SDL_MALLOC_CACHE_CLASSES];
+    int frees[SDL_MALLOC_CACHE_CLASSES];
+    struct SDL_MallocThreadCache *prev;
+    struct SDL_MallocThreadCache *next;
+    SDL_bool linked;      /* in cache_threads, keeping its own statistics */
+} SDL_MallocThreadCache;
+
+typedef struct SDL_MallocCacheDepot
+{
+    SDL_SpinLock lock;
+    SDL_MallocCacheBin bin;
+} SDL_MallocCacheDepot;
+
+typedef struct SDL_MallocCacheBigSlot
+{
+    SDL_MallocCacheHeader *block;
+    size_t size;
+} SDL_MallocCacheBigSlot;
+
+static const size_t cache_class_size[SDL_MALLOC_CACHE_CLASSES] = {
+    16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096
+};
+
+/* Only a pointer lives in thread-local storage, so it can use the
+   initial-exec model, which is a plain load rather than a call into the
+   dynamic linker, without using up the static TLS space that libraries
+   loaded with dlopen() share. The cache itself is allocated on first use. */
+#ifdef __ELF__
+static __thread SDL_MallocThreadCache *cache_thread __attribute__((tls_model("initial-exec")));
+#else
+static __thread SDL_MallocThreadCache *cache_thread;
+#endif
+static SDL_MallocThreadCache cache_thread_exited;  /* cache_thread after SDL_QuitThreadMemoryCache() */
+static SDL_MallocCacheDepot cache_depot[SDL_MALLOC_CACHE_CLASSES];
+
+static SDL_SpinLock cache_big_lock;
+static SDL_MallocCacheBigSlot cache_big[SDL_MALLOC_CACHE_BIG_SLOTS];
+static size_t cache_big_bytes;
+static int cache_big_next;
+
+/* Statistics of the large class and of threads that aren't linked, plus
+   those of linked threads that have exited */
+static struct
+{
+    SDL_atomic_t live;
+    SDL_atomic_t allocations;
+} cache_stats[SDL_MALLOC_CACHE_CLASSES + 1];
+
+static SDL_SpinLock cache_threads_lock;
+static SDL_MallocThreadCache *cache_threads;
+
+#ifdef SDL_THREAD_PTHREAD
+#include <pthread.h>
+
+/* Threads SDL didn't create never reach SDL_QuitThreadMemoryCache() in
+   SDL_RunThread(), so a thread-specific data destructor releases their
+   caches when they exit. */
+static pthread_once_t cache_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t cache_key;
+static SDL_bool cache_key_valid;
+
+static void
+SDL_MallocCacheThreadExit(void *unused)
+{
+    SDL_QuitThreadMemoryCache();
+}
+
+static void
+SDL_MallocCacheCreateKey(void)
+{
+    cache_key_valid = (pthread_key_create(&cache_key, SDL_MallocCacheThreadExit) == 0) ? SDL_TRUE : SDL_FALSE;
+}
+
+/* Only threads with an exit hook can keep their own statistics, since
+   they have to be unlinked before the thread goes away */
+static void
+SDL_MallocCacheRegisterThread(SDL_MallocThreadCache *thread)
+{
+    pthread_once(&cache_key_once, SDL_MallocCacheCreateKey);
+    if (cache_key_valid && pthread_setspecific(cache_key, thread) == 0) {
+        SDL_AtomicLock(&cache_threads_lock);
+        thread->next = cache_threads;
+        if (cache_threads) {
+            cache_threads->prev = thread;
+        }
+        cache_threads = thread;
+        thread->linked = SDL_TRUE;
+        SDL_AtomicUnlock(&cache_threads_lock);
+    }
+}
+#else
+/* Without pthreads, the caches of threads SDL didn't create are lost
+   when they exit, and every thread counts its allocations in the shared
+   statistics. */
+static void
+SDL_MallocCacheRegisterThread(SDL_MallocThreadCache *thread)
+{
+    (void)thread;
+}
+#endif /* SDL_THREAD_PTHREAD */
+
+/* Returns NULL once the thread has quit, or if there's no memory for a
+   cache; blocks then go straight to and from the depot. */
+static SDL_INLINE SDL_MallocThreadCache *
+SDL_MallocCacheGetThread(void)
+{
+    SDL_MallocThreadCache *thread = cache_thread;
+
+    if (!thread) {
+        thread = (SDL_MallocThreadCache *)real_calloc(1, sizeof(*thread));
+        if (!thread) {
+            return NULL;
+        }
+        cache_thread = thread;
+        SDL_MallocCacheRegisterThread(thread);
+    } else if (thread == &cache_thread_exited) {
+        return NULL;
+    }
+    return thread;
+}
+
+static SDL_INLINE int
+SDL_MallocCacheClass(size_t total)
+{
+    int i;
+    for (i = 0; i < SDL_MALLOC_CACHE_CLASSES; ++i) {
+        if (total <= cache_class_size[i]) {
+            return i;
+        }
+    }
+    return SDL_MALLOC_CACHE_LARGE;
+}
+
+/* Move up to `count` blocks from one free list to another */
+static void
+SDL_MallocCacheMove(SDL_MallocCacheBin *dst, SDL_MallocCacheBin *src, int count)
+{
+    while (count-- > 0 && src->head) {
+        SDL_MallocCacheHeader *block = src->head;
+        src->head = (SDL_MallocCacheHeader *)block->next;
+        --src->count;
+        block->next = dst->head;
+        dst->head = block;
+        ++dst->count;
+    }
+}
+
+static SDL_MallocCacheHeader *
+SDL_MallocCacheGetSmall(SDL_MallocThreadCache *thread, int size_class)
+{
+    SDL_MallocCacheBin uncached = { NULL, 0 };
+    SDL_MallocCacheBin *bin = thread ? &thread->bins[size_class] : &uncached;
+    SDL_MallocCacheHeader *block;
+
+    if (!bin->head) {
+        SDL_MallocCacheDepot *depot = &cache_depot[size_class];
+        SDL_AtomicLock(&depot->lock);
+        SDL_MallocCacheMove(bin, &depot->bin, thread ? SDL_MALLOC_CACHE_BATCH : 1);
+        SDL_AtomicUnlock(&depot->lock);
+        if (!bin->head) {
+            return (SDL_MallocCacheHeader *)real_malloc(cache_class_size[size_class]);
+        }
+    }
+
+    block = bin->head;
+    bin->head = (SDL_MallocCacheHeader *)block->next;
+    --bin->count;
+    return block;
+}
+
+static void
+SDL_MallocCachePutSmall(SDL_MallocThreadCache *thread, SDL_MallocCacheHeader *block, int size_class)
+{
+    SDL_MallocCacheBin uncached = { NULL, 0 };
+    SDL_MallocCacheBin *bin = thread ? &thread->bins[size_class] : &uncached;
+
+    block->next = bin->head;
+    bin->head = block;
+    ++bin->count;
+
+    if (bin->count > SDL_MALLOC_CACHE_THREAD_MAX || !thread) {
+        SDL_MallocCacheDepot *depot = &cache_depot[size_class];
+        SDL_MallocCacheBin overflow = { NULL, 0 };
+
+        SDL_AtomicLock(&depot->lock);
+        SDL_MallocCacheMove(&depot->bin, bin, thread ? SDL_MALLOC_CACHE_BATCH : bin->count);
+        if (depot->bin.count > SDL_MALLOC_CACHE_DEPOT_MAX) {
+            SDL_MallocCacheMove(&overflow, &depot->bin, depot->bin.count - SDL_MALLOC_CACHE_DEPOT_MAX);
+        }
+        SDL_AtomicUnlock(&depot->lock);
+
+        while (overflow.head) {
+            block = overflow.head;
+            overflow.head = (SDL_MallocCacheHeader *)block->next;
+            real_free(block);
+        }
+    }
+}
+
+static SDL_MallocCacheHeader *
+SDL_MallocCacheGetLarge(size_t total)
+{
+    SDL_MallocCacheHeader *block = NULL;
+    int i;
+
+    /* Reuse a recently freed block if it doesn't waste more than 1/8 */
+    SDL_AtomicLock(&cache_big_lock);
+    for (i = 0; i < SDL_MALLOC_CACHE_BIG_SLOTS; ++i) {
+        SDL_MallocCacheBigSlot *slot = &cache_big[i];
+        if (slot->block && slot->size >= total && slot->size - total <= total / 8) {
+            block = slot->block;
+            total = slot->size;
+            slot->block = NULL;
+            cache_big_bytes -= total;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&cache_big_lock);
+
+    if (!block) {
+        block = (SDL_MallocCacheHeader *)real_malloc(total);
+    }
+    if (block) {
+        block->info.size = total;
+    }
+    return block;
+}
+
+static void
+SDL_MallocCachePutLarge(SDL_MallocCacheHeader *block)
+{
+    const size_t total = block->info.size;
+    SDL_MallocCacheHeader *evicted[SDL_MALLOC_CACHE_BIG_SLOTS + 1];
+    int num_evicted = 0;
+    int i;
+
+    if (total > SDL_MALLOC_CACHE_BIG_BUDGET) {
+        real_free(block);
+        return;
+    }
+
+    SDL_AtomicLock(&cache_big_lock);
+    for (i = 0; i < SDL_MALLOC_CACHE_BIG_SLOTS; ++i) {
+        if (!cache_big[i].block) {
+            break;
+        }
+    }
+    if (i == SDL_MALLOC_CACHE_BIG_SLOTS) {
+        /* Evict the slots round robin */
+        i = cache_big_next;
+        cache_big_next = (cache_big_next + 1) % SDL_MALLOC_CACHE_BIG_SLOTS;
+        evicted[num_evicted++] = cache_big[i].block;
+        cache_big_bytes -= cache_big[i].size;
+        cache_big[i].block = NULL;
+    }
+
+    /* Then make room for it in the budget, oldest slots first */
+    while (cache_big_bytes + total > SDL_MALLOC_CACHE_BIG_BUDGET) {
+        SDL_MallocCacheBigSlot *slot = &cache_big[cache_big_next];
+        cache_big_next = (cache_big_next + 1) % SDL_MALLOC_CACHE_BIG_SLOTS;
+        if (slot->block) {
+            evicted[num_evicted++] = slot->block;
+            cache_big_bytes -= slot->size;
+            slot->block = NULL;
+        }
+    }
+
+    cache_big[i].block = block;
+    cache_big[i].size = total;
+    cache_big_bytes += total;
+    SDL_AtomicUnlock(&cache_big_lock);
+
+    while (num_evicted > 0) {
+        real_free(evicted[--num_evicted]);
+    }
+}
+
+/* `thread` is NULL for the large class and for threads without a cache */
+static void *
+SDL_MallocCacheHandOut(SDL_MallocThreadCache *thread, SDL_MallocCacheHeader *block, int size_class)
+{
+    block->info.size_class = size_class;
+    if (thread && thread->linked) {
+        ++thread->allocations[size_class];
+    } else {
+        SDL_AtomicIncRef(&cache_stats[size_class].live);
+        SDL_AtomicIncRef(&cache_stats[size_class].allocations);
+    }
+    return block + 1;
+}
+
+static void * SDLCALL
+cache_malloc(size_t size)
+{
+    const size_t total = size + sizeof(SDL_MallocCacheHeader);
+    const int size_class = SDL_MallocCacheClass(total);
+    SDL_MallocThreadCache *thread = NULL;
+    SDL_MallocCacheHeader *block;
+
+    if (total < size) {
+        return NULL;  /* overflow */
+    }
+
+    if (size_class == SDL_MALLOC_CACHE_LARGE) {
+        block = SDL_MallocCacheGetLarge(total);
+    } else {
+        thread = SDL_MallocCacheGetThread();
+        block = SDL_MallocCacheGetSmall(thread, size_class);
+        if (block) {
+            block->info.size = cache_class_size[size_class];
+        }
+    }
+    if (!block) {
+        return NULL;
+    }
+    return SDL_MallocCacheHandOut(thread, block, size_class);
+}
+
+static void SDLCALL
+cache_free(void *ptr)
+{
+    SDL_MallocCacheHeader *block;
+    int size_class;
+
+    if (!ptr) {
+        return;
+    }
+
+    block = (SDL_MallocCacheHeader *)ptr - 1;
+    size_class = block->info.size_class;
+
+    if (size_class == SDL_MALLOC_CACHE_LARGE) {
+        (void)SDL_AtomicDecRef(&cache_stats[size_class].live);
+        SDL_MallocCachePutLarge(block);
+    } else {
+        SDL_MallocThreadCache *thread = SDL_MallocCacheGetThread();
+        SDL_MallocCachePutSmall(thread, block, size_class);
+        if (thread && thread->linked) {
+            ++thread->frees[size_class];
+        } else {
+            (void)SDL_AtomicDecRef(&cache_stats[size_class].live);
+        }
+    }
+}
+
+static void * SDLCALL
+cache_calloc(size_t nmemb, size_t size)
+{
+    size_t total;
+    void *mem;
+
+    if (size && nmemb > SDL_SIZE_MAX / size) {
+        return NULL;  /* overflow */
+    }
+    size *= nmemb;
+    total = size + sizeof(SDL_MallocCacheHeader);
+    if (total < size) {
+        return NULL;  /* overflow */
+    }
+
+    if (SDL_MallocCacheClass(total) == SDL_MALLOC_CACHE_LARGE) {
+        /* Fresh memory from the real allocator may already be zeroed */
+        SDL_MallocCacheHeader *block = (SDL_MallocCacheHeader *)real_calloc(1, total);
+        if (!block) {
+            return NULL;
+        }
+        block->info.size = total;
+        return SDL_MallocCacheHandOut(NULL, block, SDL_MALLOC_CACHE_LARGE);
+    }
+
+    mem = cache_malloc(size);
+    if (mem) {
+        SDL_memset(mem, 0, size);
+    }
+    return mem;
+}
+
+static void * SDLCALL
+cache_realloc(void *ptr, size_t size)
+{
+    SDL_MallocCacheHeader *block;
+    size_t total, usable;
+    void *mem;
+
+    if (!ptr) {
+        return cache_malloc(size);
+    }
+
+    block = (SDL_MallocCacheHeader *)ptr - 1;
+    total = size + sizeof(SDL_MallocCacheHeader);
+    usable = block->info.size - sizeof(SDL_MallocCacheHeader);
+
+    if (block->info.size_class == SDL_MALLOC_CACHE_LARGE) {
+        if (total < size) {
+            return NULL;  /* overflow */
+        }
+        if (SDL_MallocCacheClass(total) == SDL_MALLOC_CACHE_LARGE) {
+            /* Let the real allocator grow or shrink it in place */
+            block = (SDL_MallocCacheHeader *)real_realloc(block, total);
+            if (!block) {
+                return NULL;
+            }
+            block->info.size = total;
+            return block + 1;
+        }
+    } else if (size <= usable && SDL_MallocCacheClass(total) == block->info.size_class) {
+        return ptr;
+    }
+
+    mem = cache_malloc(size);
+    if (mem) {
+        SDL_memcpy(mem, ptr, SDL_min(size, usable));
+        cache_free(ptr);
+    }
+    return mem;
+}
+
+void
+SDL_QuitThreadMemoryCache(void)
+{
+    SDL_MallocThreadCache *thread = cache_thread;
+    int i;
+
+    /* Anything this thread allocates or frees from now on goes straight
+       to the depot */
+    cache_thread = &cache_thread_exited;
+    if (!thread || thread == &cache_thread_exited) {
+        return;
+    }
+
+    if (thread->linked) {
+        SDL_AtomicLock(&cache_threads_lock);
+        if (thread->prev) {
+            thread->prev->next = thread->next;
+        } else {
+            cache_threads = thread->next;
+        }
+        if (thread->next) {
+            thread->next->prev = thread->prev;
+        }
+        for (i = 0; i < SDL_MALLOC_CACHE_CLASSES; ++i) {
+            SDL_AtomicAdd(&cache_stats[i].live, thread->allocations[i] - thread->frees[i]);
+            SDL_AtomicAdd(&cache_stats[i].allocations, thread->allocations[i]);
+        }
+        SDL_AtomicUnlock(&cache_threads_lock);
+    }
+
+    for (i = 0; i < SDL_MALLOC_CACHE_CLASSES; ++i) {
+        SDL_MallocCacheBin *bin = &thread->bins[i];
+        if (bin->head) {
+            SDL_MallocCacheDepot *depot = &cache_depot[i];
+            SDL_AtomicLock(&depot->lock);
+            SDL_MallocCacheMove(&depot->bin, bin, bin->count);
+            SDL_AtomicUnlock(&depot->lock);
+        }
+    }
+    real_free(thread);
+}
+
+void
+SDL_QuitMemoryCache(void)
+{
+    SDL_MallocCacheHeader *released[SDL_MALLOC_CACHE_BIG_SLOTS];
+    int num_released = 0;
+    int i;
+
+    SDL_AtomicLock(&cache_big_lock);
+    for (i = 0; i < SDL_MALLOC_CACHE_BIG_SLOTS; ++i) {
+        if (cache_big[i].block) {
+            released[num_released++] = cache_big[i].block;
+            cache_big[i].block = NULL;
+        }
+    }
+    cache_big_bytes = 0;
+    SDL_AtomicUnlock(&cache_big_lock);
+
+    while (num_released > 0) {
+        real_free(released[--num_released]);
+    }
+}
+
+#define default_malloc cache_malloc
+#define default_calloc cache_calloc
+#define default_realloc cache_realloc
+#define default_free cache_free
+#else
+#define default_malloc real_malloc
+#define default_calloc real_calloc
+#define default_realloc real_realloc
+#define default_free real_free
+
+void
+SDL_QuitThreadMemoryCache(void)
+{
+}
+
+void
+SDL_QuitMemoryCache(void)
+{
+}
+#endif /* SDL_MALLOC_CACHE */
+
 /* Memory functions used by SDL that can be replaced by the application */
 static struct
 {
@@ -5124,7 +5679,7 @@ static struct
     SDL_free_func free_func;
     SDL_atomic_t num_allocations;
 } s_mem = {
-    real_malloc, real_calloc, real_realloc, real_free, { 0 }
+    default_malloc, default_calloc, default_realloc, default_free, { 0 }
 };
 
 void SDL_GetOriginalMemoryFunctions(SDL_malloc_func *malloc_func,
@@ -5133,16 +5688,16 @@ void SDL_GetOriginalMemoryFunctions(SDL_malloc_func *malloc_func,
                                     SDL_free_func *free_func)
 {
     if (malloc_func) {
-        *malloc_func = real_malloc;
+        *malloc_func = default_malloc;
     }
     if (calloc_func) {
-        *calloc_func = real_calloc;
+        *calloc_func = default_calloc;
     }
     if (realloc_func) {
-        *realloc_func = real_realloc;
+        *realloc_func = default_realloc;
     }
     if (free_func) {
-        *free_func = real_free;
+        *free_func = default_free;
     }
 }
 
@@ -5195,6 +5750,55 @@ int SDL_GetNumAllocations(void)
     return SDL_AtomicGet(&s_mem.num_allocations);
 }
 
+int SDL_GetMemoryClassStats(SDL_MemoryClassStats *stats, int maxstats)
+{
+#ifdef SDL_MALLOC_CACHE
+    int i;
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    for (i = 0; i < maxstats && i <= SDL_MALLOC_CACHE_CLASSES; ++i) {
+        SDL_MemoryClassStats *stat = &stats[i];
+        if (i == SDL_MALLOC_CACHE_LARGE) {
+            int j;
+            stat->block_size = 0;
+            stat->cached = 0;
+            SDL_AtomicLock(&cache_big_lock);
+            for (j = 0; j < SDL_MALLOC_CACHE_BIG_SLOTS; ++j) {
+                if (cache_big[j].block) {
+                    ++stat->cached;
+                }
+            }
+            SDL_AtomicUnlock(&cache_big_lock);
+        } else {
+            stat->block_size = cache_class_size[i] - sizeof(SDL_MallocCacheHeader);
+            SDL_AtomicLock(&cache_depot[i].lock);
+            stat->cached = cache_depot[i].bin.count;
+            SDL_AtomicUnlock(&cache_depot[i].lock);
+        }
+        stat->live = SDL_AtomicGet(&cache_stats[i].live);
+        stat->allocations = SDL_AtomicGet(&cache_stats[i].allocations);
+        if (i != SDL_MALLOC_CACHE_LARGE) {
+            /* Counts of threads that are running may be slightly behind */
+            SDL_MallocThreadCache *thread;
+            SDL_AtomicLock(&cache_threads_lock);
+            for (thread = cache_threads; thread; thread = thread->next) {
+                stat->live += thread->allocations[i] - thread->frees[i];
+                stat->allocations += thread->allocations[i];
+            }
+            SDL_AtomicUnlock(&cache_threads_lock);
+        }
+    }
+    return SDL_MALLOC_CACHE_CLASSES + 1;
+#else
+    (void)stats;
+    (void)maxstats;
+    return SDL_Unsupported();
+#endif
+}
+
 void *SDL_malloc(size_t size)
 {
     void *mem;
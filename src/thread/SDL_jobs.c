@@ -0,0 +1,586 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* Work-stealing job scheduler for SDL */
+
+#include "SDL_atomic.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_hints.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+#include "SDL_jobs_c.h"
+#include "SDL_systhread.h"
+
+#ifdef __LINUX__
+#include <sched.h>
+#endif
+
+#define SDL_MAX_JOB_WORKERS 64
+
+struct SDL_Job
+{
+    SDL_JobFunction function;
+    void *userdata;
+    SDL_atomic_t refcount;  /* the caller's reference and the scheduler's */
+    SDL_atomic_t pending;   /* unfinished dependencies, plus one until submitted */
+    SDL_atomic_t done;
+    SDL_atomic_t waited;
+    SDL_SpinLock lock;      /* protects the dependents against completion */
+    SDL_Job **dependents;
+    int num_dependents;
+    int max_dependents;
+};
+
+/* The owner pushes and pops at the tail, other threads steal from the head */
+typedef struct SDL_JobQueue
+{
+    SDL_SpinLock lock;
+    SDL_Job **jobs;
+    int head;
+    int count;
+    int capacity;
+    SDL_Thread *thread;
+} SDL_JobQueue;
+
+static SDL_SpinLock SDL_jobs_init_lock;
+static SDL_atomic_t SDL_jobs_initialized;
+static SDL_atomic_t SDL_jobs_quit;
+static SDL_atomic_t SDL_jobs_queued;
+static SDL_atomic_t SDL_jobs_sleepers;
+static SDL_mutex *SDL_jobs_lock;
+static SDL_cond *SDL_jobs_cond;
+static SDL_TLSID SDL_job_worker_tls;
+static int SDL_num_job_workers;
+/* One queue per worker, and a last one shared by every other thread */
+static int SDL_num_job_queues;
+static SDL_JobQueue *SDL_job_queues;
+
+static void SDL_RunJob(SDL_Job *job);
+
+
+static int
+SDL_GetJobQueueIndex(void)
+{
+    int index = (int)(uintptr_t)SDL_TLSGet(SDL_job_worker_tls);
+    if (index) {
+        return index - 1;
+    }
+    return SDL_num_job_queues - 1;
+}
+
+static SDL_bool
+SDL_PushJob(SDL_JobQueue *queue, SDL_Job *job)
+{
+    SDL_AtomicLock(&queue->lock);
+    if (queue->count == queue->capacity) {
+        int capacity = queue->capacity ? queue->capacity * 2 : 64;
+        SDL_Job **jobs = (SDL_Job **)SDL_malloc(capacity * sizeof(*jobs));
+        int i;
+
+        if (!jobs) {
+            SDL_AtomicUnlock(&queue->lock);
+            return SDL_FALSE;
+        }
+        for (i = 0; i < queue->count; ++i) {
+            jobs[i] = queue->jobs[(queue->head + i) % queue->capacity];
+        }
+        SDL_free(queue->jobs);
+        queue->jobs = jobs;
+        queue->head = 0;
+        queue->capacity = capacity;
+    }
+    queue->jobs[(queue->head + queue->count) % queue->capacity] = job;
+    ++queue->count;
+    SDL_AtomicUnlock(&queue->lock);
+    return SDL_TRUE;
+}
+
+static SDL_Job *
+SDL_PopJob(SDL_JobQueue *queue, SDL_bool tail)
+{
+    SDL_Job *job = NULL;
+
+    SDL_AtomicLock(&queue->lock);
+    if (queue->count > 0) {
+        --queue->count;
+        if (tail) {
+            job = queue->jobs[(queue->head + queue->count) % queue->capacity];
+        } else {
+            job = queue->jobs[queue->head];
+            queue->head = (queue->head + 1) % queue->capacity;
+        }
+    }
+    SDL_AtomicUnlock(&queue->lock);
+    return job;
+}
+
+static void
+SDL_WakeJobThreads(SDL_bool all)
+{
+    SDL_LockMutex(SDL_jobs_lock);
+    if (all) {
+        SDL_CondBroadcast(SDL_jobs_cond);
+    } else {
+        SDL_CondSignal(SDL_jobs_cond);
+    }
+    SDL_UnlockMutex(SDL_jobs_lock);
+}
+
+static void
+SDL_ScheduleJob(SDL_Job *job)
+{
+    if (SDL_num_job_workers == 0 ||
+        !SDL_PushJob(&SDL_job_queues[SDL_GetJobQueueIndex()], job)) {
+        SDL_RunJob(job);
+        return;
+    }
+
+    /* The count goes up after the push and sleepers check it after
+       registering, so either they see the job or we see them. */
+    SDL_AtomicIncRef(&SDL_jobs_queued);
+    if (SDL_AtomicGet(&SDL_jobs_sleepers) > 0) {
+        SDL_WakeJobThreads(SDL_FALSE);
+    }
+}
+
+static void
+SDL_ReleaseJob(SDL_Job *job)
+{
+    if (SDL_AtomicDecRef(&job->refcount)) {
+        SDL_free(job->dependents);
+        SDL_free(job);
+    }
+}
+
+static void
+SDL_RunJob(SDL_Job *job)
+{
+    SDL_Job **dependents;
+    int num_dependents;
+    int i;
+
+    job->function(job->userdata);
+
+    SDL_AtomicLock(&job->lock);
+    SDL_AtomicSet(&job->done, 1);
+    dependents = job->dependents;
+    num_dependents = job->num_dependents;
+    job->dependents = NULL;
+    job->num_dependents = 0;
+    job->max_dependents = 0;
+    SDL_AtomicUnlock(&job->lock);
+
+    for (i = 0; i < num_dependents; ++i) {
+        if (SDL_AtomicDecRef(&dependents[i]->pending)) {
+            SDL_ScheduleJob(dependents[i]);
+        }
+    }
+    SDL_free(dependents);
+
+    if (SDL_AtomicGet(&job->waited)) {
+        SDL_WakeJobThreads(SDL_TRUE);
+    }
+    SDL_ReleaseJob(job);
+}
+
+/* Run one job from our own queue, or steal one from another thread */
+static SDL_bool
+SDL_RunQueuedJob(int index)
+{
+    SDL_Job *job;
+    int i;
+
+    if (SDL_AtomicGet(&SDL_jobs_queued) == 0) {
+        return SDL_FALSE;
+    }
+
+    /* Workers take their newest job, which is most likely still in cache.
+       The shared queue is served in order. */
+    job = SDL_PopJob(&SDL_job_queues[index], (index < SDL_num_job_queues - 1));
+    for (i = 1; !job && i < SDL_num_job_queues; ++i) {
+        job = SDL_PopJob(&SDL_job_queues[(index + i) % SDL_num_job_queues], SDL_FALSE);
+    }
+    if (!job) {
+        return SDL_FALSE;
+    }
+    SDL_AtomicAdd(&SDL_jobs_queued, -1);
+    SDL_RunJob(job);
+    return SDL_TRUE;
+}
+
+static void
+SDL_SetJobWorkerAffinity(int index)
+{
+#ifdef __LINUX__
+    /* Leave the first CPU we may run on to the application's main thread */
+    cpu_set_t allowed, set;
+    int cpu, target;
+
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) < 0 || CPU_COUNT(&allowed) < 2) {
+        return;
+    }
+    target = 1 + index % (CPU_COUNT(&allowed) - 1);
+    for (cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &allowed) && target-- == 0) {
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            sched_setaffinity(0, sizeof(set), &set);
+            break;
+        }
+    }
+#endif /* __LINUX__ */
+}
+
+static int SDLCALL
+SDL_JobWorker(void *data)
+{
+    int index = (int)(uintptr_t)data;
+
+    SDL_TLSSet(SDL_job_worker_tls, (void *)(uintptr_t)(index + 1), NULL);
+    SDL_SetJobWorkerAffinity(index);
+
+    while (!SDL_AtomicGet(&SDL_jobs_quit)) {
+        if (SDL_RunQueuedJob(index)) {
+            continue;
+        }
+
+        SDL_LockMutex(SDL_jobs_lock);
+        SDL_AtomicIncRef(&SDL_jobs_sleepers);
+        if (!SDL_AtomicGet(&SDL_jobs_quit) && SDL_AtomicGet(&SDL_jobs_queued) == 0) {
+            SDL_CondWait(SDL_jobs_cond, SDL_jobs_lock);
+        }
+        SDL_AtomicAdd(&SDL_jobs_sleepers, -1);
+        SDL_UnlockMutex(SDL_jobs_lock);
+    }
+    return 0;
+}
+
+static int
+SDL_InitJobs(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_JOB_WORKERS);
+    int num_workers;
+    int i;
+
+    if (hint && *hint) {
+        num_workers = SDL_atoi(hint);
+    } else {
+        num_workers = SDL_GetCPUCount() - 1;
+    }
+    num_workers = SDL_clamp(num_workers, 0, SDL_MAX_JOB_WORKERS);
+#if SDL_THREADS_DISABLED
+    num_workers = 0;
+#endif
+
+    if (!SDL_job_worker_tls) {
+        SDL_job_worker_tls = SDL_TLSCreate();
+    }
+    SDL_jobs_lock = SDL_CreateMutex();
+    SDL_jobs_cond = SDL_CreateCond();
+    SDL_job_queues = (SDL_JobQueue *)SDL_calloc(num_workers + 1, sizeof(*SDL_job_queues));
+    if (!SDL_jobs_lock || !SDL_jobs_cond || !SDL_job_queues) {
+        SDL_DestroyCond(SDL_jobs_cond);
+        SDL_DestroyMutex(SDL_jobs_lock);
+        SDL_free(SDL_job_queues);
+        SDL_jobs_cond = NULL;
+        SDL_jobs_lock = NULL;
+        SDL_job_queues = NULL;
+        return SDL_OutOfMemory();
+    }
+    SDL_num_job_queues = num_workers + 1;
+
+    /* If a thread can't be created, carry on with the ones we have.
+       Its queue stays empty and is simply skipped over. */
+    for (i = 0; i < num_workers; ++i) {
+        char name[16];
+
+        SDL_snprintf(name, sizeof(name), "SDLJob%d", i);
+        SDL_job_queues[i].thread = SDL_CreateThreadInternal(SDL_JobWorker, name, 0, (void *)(uintptr_t)i);
+        if (!SDL_job_queues[i].thread) {
+            break;
+        }
+        ++SDL_num_job_workers;
+    }
+    return 0;
+}
+
+static int
+SDL_StartJobs(void)
+{
+    int retval = 0;
+
+    if (SDL_AtomicGet(&SDL_jobs_initialized)) {
+        return 0;
+    }
+
+    SDL_AtomicLock(&SDL_jobs_init_lock);
+    if (!SDL_AtomicGet(&SDL_jobs_initialized)) {
+        retval = SDL_InitJobs();
+        if (retval == 0) {
+            SDL_AtomicSet(&SDL_jobs_initialized, 1);
+        }
+    }
+    SDL_AtomicUnlock(&SDL_jobs_init_lock);
+    return retval;
+}
+
+void
+SDL_QuitJobs(void)
+{
+    int i;
+
+    SDL_AtomicLock(&SDL_jobs_init_lock);
+    if (!SDL_AtomicGet(&SDL_jobs_initialized)) {
+        SDL_AtomicUnlock(&SDL_jobs_init_lock);
+        return;
+    }
+
+    SDL_AtomicSet(&SDL_jobs_quit, 1);
+    SDL_WakeJobThreads(SDL_TRUE);
+    for (i = 0; i < SDL_num_job_queues - 1; ++i) {
+        if (SDL_job_queues[i].thread) {
+            SDL_WaitThread(SDL_job_queues[i].thread, NULL);
+        }
+    }
+
+    /* Detached jobs that never got to run still own memory */
+    while (SDL_RunQueuedJob(SDL_num_job_queues - 1)) {
+    }
+
+    for (i = 0; i < SDL_num_job_queues; ++i) {
+        SDL_free(SDL_job_queues[i].jobs);
+    }
+    SDL_free(SDL_job_queues);
+    SDL_job_queues = NULL;
+    SDL_num_job_queues = 0;
+    SDL_num_job_workers = 0;
+    SDL_DestroyCond(SDL_jobs_cond);
+    SDL_jobs_cond = NULL;
+    SDL_DestroyMutex(SDL_jobs_lock);
+    SDL_jobs_lock = NULL;
+
+    SDL_AtomicSet(&SDL_jobs_quit, 0);
+    SDL_AtomicSet(&SDL_jobs_initialized, 0);
+    SDL_AtomicUnlock(&SDL_jobs_init_lock);
+}
+
+SDL_Job *
+SDL_CreateJob(SDL_JobFunction fn, void *userdata)
+{
+    SDL_Job *job;
+
+    if (!fn) {
+        SDL_InvalidParamError("fn");
+        return NULL;
+    }
+    if (SDL_StartJobs() < 0) {
+        return NULL;
+    }
+
+    job = (SDL_Job *)SDL_calloc(1, sizeof(*job));
+    if (!job) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    job->function = fn;
+    job->userdata = userdata;
+    SDL_AtomicSet(&job->refcount, 2);
+    SDL_AtomicSet(&job->pending, 1);
+    return job;
+}
+
+int
+SDL_AddJobDependency(SDL_Job *job, SDL_Job *dependency)
+{
+    int retval = 0;
+
+    if (!job) {
+        return SDL_InvalidParamError("job");
+    }
+    if (!dependency || dependency == job) {
+        return SDL_InvalidParamError("dependency");
+    }
+
+    SDL_AtomicLock(&dependency->lock);
+    if (!SDL_AtomicGet(&dependency->done)) {
+        if (dependency->num_dependents == dependency->max_dependents) {
+            int max_dependents = dependency->max_dependents ? dependency->max_dependents * 2 : 4;
+            SDL_Job **dependents = (SDL_Job **)SDL_realloc(dependency->dependents, max_dependents * sizeof(*dependents));
+            if (dependents) {
+                dependency->dependents = dependents;
+                dependency->max_dependents = max_dependents;
+            }
+        }
+        if (dependency->num_dependents < dependency->max_dependents) {
+            dependency->dependents[dependency->num_dependents++] = job;
+            SDL_AtomicIncRef(&job->pending);
+        } else {
+            retval = SDL_OutOfMemory();
+        }
+    }
+    SDL_AtomicUnlock(&dependency->lock);
+
+    return retval;
+}
+
+int
+SDL_SubmitJob(SDL_Job *job)
+{
+    if (!job) {
+        return SDL_InvalidParamError("job");
+    }
+
+    if (SDL_AtomicDecRef(&job->pending)) {
+        SDL_ScheduleJob(job);
+    }
+    return 0;
+}
+
+void
+SDL_WaitJob(SDL_Job *job)
+{
+    int index;
+
+    if (!job) {
+        return;
+    }
+
+    index = SDL_GetJobQueueIndex();
+    SDL_AtomicSet(&job->waited, 1);
+    while (!SDL_AtomicGet(&job->done)) {
+        if (SDL_RunQueuedJob(index)) {
+            continue;
+        }
+
+        SDL_LockMutex(SDL_jobs_lock);
+        SDL_AtomicIncRef(&SDL_jobs_sleepers);
+        if (!SDL_AtomicGet(&job->done) && SDL_AtomicGet(&SDL_jobs_queued) == 0) {
+            SDL_CondWait(SDL_jobs_cond, SDL_jobs_lock);
+        }
+        SDL_AtomicAdd(&SDL_jobs_sleepers, -1);
+        SDL_UnlockMutex(SDL_jobs_lock);
+    }
+    SDL_ReleaseJob(job);
+}
+
+void
+SDL_DetachJob(SDL_Job *job)
+{
+    if (job) {
+        SDL_ReleaseJob(job);
+    }
+}
+
+typedef struct SDL_ParallelForData
+{
+    SDL_ParallelForFunction function;
+    void *userdata;
+    int start;
+    int count;
+    int grain;
+    SDL_atomic_t next;
+} SDL_ParallelForData;
+
+static void SDLCALL
+SDL_RunParallelFor(void *data)
+{
+    SDL_ParallelForData *work = (SDL_ParallelForData *)data;
+    int offset, length;
+
+    for (;;) {
+        offset = SDL_AtomicGet(&work->next);
+        if (offset >= work->count) {
+            break;
+        }
+        length = SDL_min(work->grain, work->count - offset);
+        if (SDL_AtomicCAS(&work->next, offset, offset + length)) {
+            work->function(work->userdata, work->start + offset, work->start + offset + length);
+        }
+    }
+}
+
+int
+SDL_ParallelFor(int start, int end, int grain, SDL_ParallelForFunction fn, void *userdata)
+{
+    SDL_ParallelForData work;
+    SDL_Job *jobs[SDL_MAX_JOB_WORKERS];
+    int num_jobs;
+    int i;
+
+    if (!fn) {
+        return SDL_InvalidParamError("fn");
+    }
+    if (grain < 0) {
+        return SDL_InvalidParamError("grain");
+    }
+    if (end <= start) {
+        return 0;
+    }
+    if ((Sint64)end - start > SDL_MAX_SINT32) {
+        return SDL_InvalidParamError("end");
+    }
+    if (SDL_StartJobs() < 0) {
+        return -1;
+    }
+
+    work.function = fn;
+    work.userdata = userdata;
+    work.start = start;
+    work.count = end - start;
+    if (grain == 0) {
+        /* A few pieces per thread, so the ones that finish early can pick up the slack */
+        grain = SDL_max(work.count / ((SDL_num_job_workers + 1) * 4), 1);
+    }
+    work.grain = grain;
+    SDL_AtomicSet(&work.next, 0);
+
+    /* Every thread pulls pieces from the shared counter, so one job per
+       worker is enough and a job that couldn't be created only costs us
+       parallelism. */
+    num_jobs = SDL_min((work.count - 1) / grain, SDL_num_job_workers);
+    for (i = 0; i < num_jobs; ++i) {
+        jobs[i] = SDL_CreateJob(SDL_RunParallelFor, &work);
+        if (!jobs[i]) {
+            break;
+        }
+        SDL_SubmitJob(jobs[i]);
+    }
+    num_jobs = i;
+
+    SDL_RunParallelFor(&work);
+
+    for (i = 0; i < num_jobs; ++i) {
+        SDL_WaitJob(jobs[i]);
+    }
+    return 0;
+}
+
+int
+SDL_GetJobWorkerCount(void)
+{
+    if (SDL_StartJobs() < 0) {
+        return 0;
+    }
+    return SDL_num_job_workers;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -27,6 +27,7 @@
 #include "SDL_systhread.h"
 #include "SDL_hints.h"
 #include "../SDL_error_c.h"
+#include "../stdlib/SDL_malloc_c.h"
 
 
 SDL_TLSID
@@ -307,6 +308,9 @@ SDL_RunThread(SDL_Thread *thread)
     /* Clean up thread-local storage */
     SDL_TLSCleanup();
 
+    /* Hand any cached memory blocks back before this thread goes away */
+    SDL_QuitThreadMemoryCache();
+
     /* Mark us as ready to be joined (or detached) */
     if (!SDL_AtomicCAS(&thread->state, SDL_THREAD_STATE_ALIVE, SDL_THREAD_STATE_ZOMBIE)) {
         /* Clean up if something already detached us. */
@@ -0,0 +1,144 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+/* Condition variables built directly on Linux futexes.
+   Waiters sleep on a sequence number that every signal bumps, so a wakeup
+   can't be lost between releasing the mutex and going to sleep. */
+
+#include "SDL_thread.h"
+#include "SDL_sysfutex_c.h"
+#include "SDL_sysmutex_c.h"
+
+struct SDL_cond
+{
+    SDL_atomic_t sequence;
+    SDL_atomic_t waiters;
+};
+
+/* Create a condition variable */
+SDL_cond *
+SDL_CreateCond(void)
+{
+    SDL_cond *cond;
+
+    cond = (SDL_cond *) SDL_calloc(1, sizeof(SDL_cond));
+    if (!cond) {
+        SDL_OutOfMemory();
+    }
+    return (cond);
+}
+
+/* Destroy a condition variable */
+void
+SDL_DestroyCond(SDL_cond * cond)
+{
+    if (cond) {
+        SDL_free(cond);
+    }
+}
+
+/* Restart one of the threads that are waiting on the condition variable */
+int
+SDL_CondSignal(SDL_cond * cond)
+{
+    if (!cond) {
+        return SDL_InvalidParamError("cond");
+    }
+
+    if (SDL_AtomicGet(&cond->waiters) > 0) {
+        SDL_AtomicIncRef(&cond->sequence);
+        SDL_FutexWake(&cond->sequence, 1);
+    }
+    return 0;
+}
+
+/* Restart all threads that are waiting on the condition variable */
+int
+SDL_CondBroadcast(SDL_cond * cond)
+{
+    if (!cond) {
+        return SDL_InvalidParamError("cond");
+    }
+
+    if (SDL_AtomicGet(&cond->waiters) > 0) {
+        SDL_AtomicIncRef(&cond->sequence);
+        SDL_FutexWake(&cond->sequence, INT_MAX);
+    }
+    return 0;
+}
+
+int
+SDL_CondWaitTimeout(SDL_cond * cond, SDL_mutex * mutex, Uint32 ms)
+{
+    SDL_FutexTime deadline;
+    int sequence, recursive, result;
+    int retval = 0;
+
+    if (!cond) {
+        return SDL_InvalidParamError("cond");
+    }
+    if (!mutex) {
+        return SDL_InvalidParamError("mutex");
+    }
+    if (mutex->owner != SDL_ThreadID()) {
+        return SDL_SetError("mutex not owned by this thread");
+    }
+
+    if (ms != SDL_MUTEX_MAXWAIT) {
+        SDL_FutexDeadline(ms, &deadline);
+    }
+
+    /* Register before letting go of the mutex, so a signal sent by the
+       next holder sees us and moves the sequence past the one we sleep on */
+    SDL_AtomicIncRef(&cond->waiters);
+    sequence = SDL_AtomicGet(&cond->sequence);
+
+    /* Release the mutex fully even if it was locked recursively */
+    recursive = mutex->recursive;
+    mutex->recursive = 0;
+    SDL_UnlockMutex(mutex);
+
+    do {
+        result = SDL_FutexWait(&cond->sequence, sequence, (ms != SDL_MUTEX_MAXWAIT) ? &deadline : NULL);
+    } while (result == EINTR);
+
+    SDL_AtomicAdd(&cond->waiters, -1);
+
+    SDL_LockMutex(mutex);
+    mutex->recursive = recursive;
+
+    if (result == ETIMEDOUT) {
+        retval = SDL_MUTEX_TIMEDOUT;
+    }
+    return retval;
+}
+
+/* Wait on the condition variable, unlocking the provided mutex.
+   The mutex must be locked before entering this function!
+ */
+int
+SDL_CondWait(SDL_cond * cond, SDL_mutex * mutex)
+{
+    return SDL_CondWaitTimeout(cond, mutex, SDL_MUTEX_MAXWAIT);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
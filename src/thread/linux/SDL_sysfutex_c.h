@@ -0,0 +1,87 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#ifndef SDL_sysfutex_c_h_
+#define SDL_sysfutex_c_h_
+
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "SDL_atomic.h"
+
+/* How many times to poll a contended word before going to sleep on it.
+   Spinning only pays off when the holder can run at the same time. */
+#define SDL_FUTEX_MAX_SPINS 200
+
+/* The layout SYS_futex expects, which is not struct timespec on 32-bit
+   systems built with a 64-bit time_t */
+typedef struct SDL_FutexTime
+{
+    long tv_sec;
+    long tv_nsec;
+} SDL_FutexTime;
+
+/* Get the CLOCK_MONOTONIC time `ms` milliseconds from now */
+static SDL_INLINE void
+SDL_FutexDeadline(Uint32 ms, SDL_FutexTime *deadline)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    deadline->tv_sec = (long)now.tv_sec + (long)(ms / 1000);
+    deadline->tv_nsec = now.tv_nsec + (long)(ms % 1000) * 1000000;
+    if (deadline->tv_nsec >= 1000000000) {
+        deadline->tv_sec += 1;
+        deadline->tv_nsec -= 1000000000;
+    }
+}
+
+/* Sleep while `word` holds `value`, until woken or the absolute
+   CLOCK_MONOTONIC `deadline` passes (NULL waits forever).
+   Returns 0, or an errno value: EAGAIN, EINTR or ETIMEDOUT. */
+static SDL_INLINE int
+SDL_FutexWait(SDL_atomic_t *word, int value, const SDL_FutexTime *deadline)
+{
+    if (syscall(SYS_futex, &word->value, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG,
+                value, deadline, NULL, FUTEX_BITSET_MATCH_ANY) < 0) {
+        return errno;
+    }
+    return 0;
+}
+
+/* Wake up to `count` threads sleeping on `word` */
+static SDL_INLINE void
+SDL_FutexWake(SDL_atomic_t *word, int count)
+{
+    syscall(SYS_futex, &word->value, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, count, NULL, NULL, 0);
+}
+
+/* The spin budget for this system, 0 on a single CPU */
+extern int SDL_GetFutexSpinLimit(void);
+
+#endif /* SDL_sysfutex_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
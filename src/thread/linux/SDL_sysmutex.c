@@ -0,0 +1,164 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+/* Mutexes built directly on Linux futexes */
+
+#include "SDL_thread.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_sysfutex_c.h"
+#include "SDL_sysmutex_c.h"
+
+int
+SDL_GetFutexSpinLimit(void)
+{
+    static int spin_limit = -1;
+
+    if (spin_limit < 0) {
+        spin_limit = (SDL_GetCPUCount() > 1) ? SDL_FUTEX_MAX_SPINS : 0;
+    }
+    return spin_limit;
+}
+
+SDL_mutex *
+SDL_CreateMutex(void)
+{
+    SDL_mutex *mutex;
+
+    /* Allocate the structure */
+    mutex = (SDL_mutex *) SDL_calloc(1, sizeof(*mutex));
+    if (!mutex) {
+        SDL_OutOfMemory();
+    }
+    return (mutex);
+}
+
+void
+SDL_DestroyMutex(SDL_mutex * mutex)
+{
+    if (mutex) {
+        SDL_free(mutex);
+    }
+}
+
+/* Lock the mutex */
+int
+SDL_LockMutex(SDL_mutex * mutex)
+{
+    SDL_threadID this_thread;
+    int max_spins, spins;
+
+    if (mutex == NULL) {
+        return SDL_InvalidParamError("mutex");
+    }
+
+    this_thread = SDL_ThreadID();
+    if (mutex->owner == this_thread) {
+        ++mutex->recursive;
+        return 0;
+    }
+
+    if (!SDL_AtomicCAS(&mutex->state, 0, 1)) {
+        /* Poll for a while, in case the holder is about to let go.
+           The budget follows how long that took in the past. Polling
+           that fails counts as zero, so a lock that is held for long
+           stretches quickly stops burning CPU. */
+        max_spins = SDL_min(SDL_GetFutexSpinLimit(), mutex->spins * 2 + 10);
+        for (spins = 0; spins < max_spins; ++spins) {
+            SDL_CPUPauseInstruction();
+            if (SDL_AtomicGet(&mutex->state) == 0 && SDL_AtomicCAS(&mutex->state, 0, 1)) {
+                break;
+            }
+        }
+        if (max_spins > 0) {
+            mutex->spins += (((spins < max_spins) ? spins : 0) - mutex->spins) / 8;
+        }
+
+        if (spins == max_spins) {
+            /* Mark the lock contended so the holder wakes us up */
+            while (SDL_AtomicSet(&mutex->state, 2) != 0) {
+                SDL_FutexWait(&mutex->state, 2, NULL);
+            }
+        }
+    }
+
+    /* The order of operations is important.
+       We set the locking thread id after we obtain the lock
+       so unlocks from other threads will fail.
+     */
+    mutex->owner = this_thread;
+    mutex->recursive = 0;
+    return 0;
+}
+
+int
+SDL_TryLockMutex(SDL_mutex * mutex)
+{
+    SDL_threadID this_thread;
+
+    if (mutex == NULL) {
+        return SDL_InvalidParamError("mutex");
+    }
+
+    this_thread = SDL_ThreadID();
+    if (mutex->owner == this_thread) {
+        ++mutex->recursive;
+        return 0;
+    }
+    if (!SDL_AtomicCAS(&mutex->state, 0, 1)) {
+        return SDL_MUTEX_TIMEDOUT;
+    }
+    mutex->owner = this_thread;
+    mutex->recursive = 0;
+    return 0;
+}
+
+int
+SDL_UnlockMutex(SDL_mutex * mutex)
+{
+    if (mutex == NULL) {
+        return SDL_InvalidParamError("mutex");
+    }
+
+    /* We can only unlock the mutex if we own it */
+    if (mutex->owner != SDL_ThreadID()) {
+        return SDL_SetError("mutex not owned by this thread");
+    }
+
+    if (mutex->recursive) {
+        --mutex->recursive;
+    } else {
+        /* The order of operations is important.
+           First reset the owner so another thread doesn't lock
+           the mutex and set the ownership before we reset it,
+           then release the lock. SDL_AtomicSet() is only an acquire
+           barrier, so fence the critical section's stores first.
+         */
+        mutex->owner = 0;
+        SDL_MemoryBarrierRelease();
+        if (SDL_AtomicSet(&mutex->state, 0) == 2) {
+            SDL_FutexWake(&mutex->state, 1);
+        }
+    }
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
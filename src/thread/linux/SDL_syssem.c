@@ -0,0 +1,165 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+/* Semaphores built directly on Linux futexes.
+   Timeouts are measured on CLOCK_MONOTONIC, so changes to the wall clock
+   don't shorten or stretch them. */
+
+#include "SDL_thread.h"
+#include "SDL_sysfutex_c.h"
+
+struct SDL_semaphore
+{
+    SDL_atomic_t count;
+    SDL_atomic_t waiters;
+};
+
+/* Create a semaphore, initialized with value */
+SDL_sem *
+SDL_CreateSemaphore(Uint32 initial_value)
+{
+    SDL_sem *sem;
+
+    if (initial_value > INT_MAX) {
+        SDL_InvalidParamError("initial_value");
+        return NULL;
+    }
+
+    sem = (SDL_sem *) SDL_calloc(1, sizeof(SDL_sem));
+    if (sem) {
+        SDL_AtomicSet(&sem->count, (int) initial_value);
+    } else {
+        SDL_OutOfMemory();
+    }
+    return sem;
+}
+
+void
+SDL_DestroySemaphore(SDL_sem * sem)
+{
+    if (sem) {
+        SDL_free(sem);
+    }
+}
+
+static SDL_bool
+SDL_SemTryDecrement(SDL_sem * sem)
+{
+    int value;
+
+    while ((value = SDL_AtomicGet(&sem->count)) > 0) {
+        if (SDL_AtomicCAS(&sem->count, value, value - 1)) {
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+int
+SDL_SemTryWait(SDL_sem * sem)
+{
+    if (!sem) {
+        return SDL_InvalidParamError("sem");
+    }
+    return SDL_SemTryDecrement(sem) ? 0 : SDL_MUTEX_TIMEDOUT;
+}
+
+int
+SDL_SemWaitTimeout(SDL_sem * sem, Uint32 timeout)
+{
+    SDL_FutexTime deadline;
+    int max_spins, spins;
+    int retval = 0;
+
+    if (!sem) {
+        return SDL_InvalidParamError("sem");
+    }
+
+    /* Try the easy cases first */
+    if (SDL_SemTryDecrement(sem)) {
+        return 0;
+    }
+    if (timeout == 0) {
+        return SDL_MUTEX_TIMEDOUT;
+    }
+
+    /* A post that is already on its way is cheaper to wait for than a sleep */
+    max_spins = SDL_GetFutexSpinLimit();
+    for (spins = 0; spins < max_spins; ++spins) {
+        SDL_CPUPauseInstruction();
+        if (SDL_AtomicGet(&sem->count) > 0 && SDL_SemTryDecrement(sem)) {
+            return 0;
+        }
+    }
+
+    if (timeout != SDL_MUTEX_MAXWAIT) {
+        SDL_FutexDeadline(timeout, &deadline);
+    }
+
+    /* Posters check for waiters after raising the count, so once we are
+       counted either we see their post or they wake us. */
+    SDL_AtomicIncRef(&sem->waiters);
+    while (!SDL_SemTryDecrement(sem)) {
+        if (SDL_FutexWait(&sem->count, 0, (timeout != SDL_MUTEX_MAXWAIT) ? &deadline : NULL) == ETIMEDOUT) {
+            retval = SDL_SemTryDecrement(sem) ? 0 : SDL_MUTEX_TIMEDOUT;
+            break;
+        }
+    }
+    SDL_AtomicAdd(&sem->waiters, -1);
+
+    return retval;
+}
+
+int
+SDL_SemWait(SDL_sem * sem)
+{
+    return SDL_SemWaitTimeout(sem, SDL_MUTEX_MAXWAIT);
+}
+
+Uint32
+SDL_SemValue(SDL_sem * sem)
+{
+    int ret = 0;
+    if (sem) {
+        ret = SDL_AtomicGet(&sem->count);
+        if (ret < 0) {
+            ret = 0;
+        }
+    }
+    return (Uint32) ret;
+}
+
+int
+SDL_SemPost(SDL_sem * sem)
+{
+    if (!sem) {
+        return SDL_InvalidParamError("sem");
+    }
+
+    SDL_AtomicIncRef(&sem->count);
+    if (SDL_AtomicGet(&sem->waiters) > 0) {
+        SDL_FutexWake(&sem->count, 1);
+    }
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
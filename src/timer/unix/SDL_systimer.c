@@ -29,6 +29,7 @@
 
 #include "SDL_timer.h"
 #include "SDL_hints.h"
+#include "SDL_atomic.h"
 #include "../SDL_timer_c.h"
 
 /* The clock_gettime provides monotonous time, so we should use it if
@@ -201,6 +202,92 @@ SDL_Delay(Uint32 ms)
     } while (was_error && (errno == EINTR));
 }
 
+/* Sleep for a number of performance counter ticks, relative to now.
+   The caller re-checks the counter afterwards, so a short or interrupted
+   sleep is harmless. */
+static void
+SDL_SleepCounterTicks(Uint64 ticks)
+{
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    Uint64 ns;
+    struct timespec ts;
+
+    /* Both counter frequencies divide a second evenly */
+    ns = ticks * (1000000000 / freq);
+
+#if HAVE_CLOCK_GETTIME && defined(TIMER_ABSTIME)
+    /* The performance counter may run on CLOCK_MONOTONIC_RAW, which
+       clock_nanosleep() does not accept, so rebase the deadline onto
+       CLOCK_MONOTONIC. The two only differ by NTP slew, which the caller's
+       re-check absorbs. */
+    if (has_monotonic_time && clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+        ns += ts.tv_nsec;
+        ts.tv_sec += (time_t)(ns / 1000000000);
+        ts.tv_nsec = (long)(ns % 1000000000);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+        }
+        return;
+    }
+#endif
+
+#if HAVE_NANOSLEEP
+    ts.tv_sec = (time_t)(ns / 1000000000);
+    ts.tv_nsec = (long)(ns % 1000000000);
+    nanosleep(&ts, NULL);
+#else
+    SDL_Delay((Uint32)(ns / 1000000));
+#endif
+}
+
+void
+SDL_DelayUntil(Uint64 deadline)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_TIMER_SPIN_THRESHOLD);
+    Uint64 spin = 0;
+    Uint64 now;
+
+    if (hint && *hint) {
+        /* Convert the spin threshold from microseconds to counter ticks */
+        spin = (Uint64)SDL_max(SDL_atoi(hint), 0);
+        spin = (spin * SDL_GetPerformanceFrequency()) / 1000000;
+    }
+
+    now = SDL_GetPerformanceCounter();
+    while (now < deadline && (deadline - now) > spin) {
+        SDL_SleepCounterTicks(deadline - now - spin);
+        now = SDL_GetPerformanceCounter();
+    }
+    while (now < deadline) {
+        SDL_CPUPauseInstruction();
+        now = SDL_GetPerformanceCounter();
+    }
+}
+
+Uint64
+SDL_DelayPeriodic(Uint64 *deadline, Uint64 period)
+{
+    Uint64 now;
+
+    if (!deadline) {
+        SDL_InvalidParamError("deadline");
+        return SDL_GetPerformanceCounter();
+    }
+
+    if (*deadline == 0) {
+        *deadline = SDL_GetPerformanceCounter() + period;
+    }
+
+    SDL_DelayUntil(*deadline);
+
+    now = SDL_GetPerformanceCounter();
+    *deadline += period;
+    if (*deadline <= now) {
+        /* We missed at least a whole period, restart from here */
+        *deadline = now + period;
+    }
+    return now;
+}
+
 #endif /* SDL_TIMER_UNIX */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -85,13 +85,28 @@
  *
  *   The end of the sequence is marked by a zero <skip>,<run> pair at the
  *   beginning of an opaque line.
+ *
+ * Normally the encoder frees the original pixels, and locking the surface
+ * decodes them again. Surfaces with SDL_COPY_RLE_KEEP set in their blit map
+ * keep the original pixels next to the encoding instead, so that a lock only
+ * drops the encoding and the next blit encodes the new contents.
  */
 
 #include "SDL_video.h"
 #include "SDL_sysvideo.h"
+#include "SDL_cpuinfo.h"
 #include "SDL_blit.h"
 #include "SDL_RLEaccel_c.h"
 
+#if defined(__SSE2__) && !defined(SDL_DISABLE_EMMINTRIN_H)
+#include <emmintrin.h>
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
+#if defined(__ARM_NEON) && SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define HAVE_NEON_INTRINSICS 1
+#endif
+
 #define PIXEL_COPY(to, from, len, bpp)          \
     SDL_memcpy(to, from, (size_t)(len) * (bpp))
 
@@ -132,40 +147,172 @@
  * in the high 16 bits of a 32 bit word, and process all three RGB
  * components at the same time. Since the smallest gap is here just
  * 5 bits, we have to scale alpha down to 5 bits as well.
+ *
+ * The run blenders below do this for both per-surface alpha and the
+ * translucent pixels of the per-pixel alpha encoding, with mask selecting
+ * the 565 or 555 layout. With NEON or SSE2 they blend 8 pixels at a time,
+ * giving the same results as the scalar code.
+ */
+#define MASK_565 0x07e0f81fU
+#define MASK_555 0x03e07c1fU
+
+#if HAVE_NEON_INTRINSICS
+/* Blend four spread out source pixels onto four 16bpp pixels */
+static SDL_INLINE uint16x4_t
+Blend16NEON(uint32x4_t s, uint16x4_t dst, uint32x4_t alpha, uint32x4_t mask)
+{
+    uint32x4_t d = vmovl_u16(dst);
+    d = vandq_u32(vorrq_u32(d, vshlq_n_u32(d, 16)), mask);
+    d = vaddq_u32(d, vshrq_n_u32(vmulq_u32(vsubq_u32(s, d), alpha), 5));
+    d = vandq_u32(d, mask);
+    return vmovn_u32(vorrq_u32(d, vshrq_n_u32(d, 16)));
+}
+
+static SDL_INLINE uint32x4_t
+Spread16NEON(uint16x4_t pixels, uint32x4_t mask)
+{
+    uint32x4_t p = vmovl_u16(pixels);
+    return vandq_u32(vorrq_u32(p, vshlq_n_u32(p, 16)), mask);
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
+#if HAVE_SSE2_INTRINSICS
+/*
+ * Blend four spread out source pixels onto four 16bpp pixels held in the
+ * low halves of d. alpha has the alpha value in both 16-bit halves of each
+ * lane, so the 32-bit product can be put together from 16-bit multiplies.
+ * The result is sign extended from 16 bits, ready for _mm_packs_epi32().
+ */
+static SDL_INLINE __m128i
+Blend16SSE2(__m128i s, __m128i d, __m128i alpha, __m128i mask)
+{
+    __m128i diff, prod;
+
+    d = _mm_and_si128(_mm_or_si128(d, _mm_slli_epi32(d, 16)), mask);
+    diff = _mm_sub_epi32(s, d);
+    prod = _mm_add_epi32(_mm_mullo_epi16(diff, alpha),
+                         _mm_slli_epi32(_mm_mulhi_epu16(diff, alpha), 16));
+    d = _mm_and_si128(_mm_add_epi32(d, _mm_srli_epi32(prod, 5)), mask);
+    d = _mm_or_si128(d, _mm_srli_epi32(d, 16));
+    return _mm_srai_epi32(_mm_slli_epi32(d, 16), 16);
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+/* Blend n 16bpp pixels with a per-surface alpha of 0-31 */
+static void
+BlendRun16(Uint16 *dst, const Uint16 *src, int n, Uint32 alpha, Uint32 mask)
+{
+    int i = 0;
+
+#if HAVE_NEON_INTRINSICS
+    if (n >= 8 && SDL_HasNEON()) {
+        const uint32x4_t vmask = vdupq_n_u32(mask);
+        const uint32x4_t valpha = vdupq_n_u32(alpha);
+        for (; i + 8 <= n; i += 8) {
+            const uint16x8_t s = vld1q_u16(src + i);
+            const uint16x8_t d = vld1q_u16(dst + i);
+            const uint16x4_t lo = Blend16NEON(Spread16NEON(vget_low_u16(s), vmask),
+                                              vget_low_u16(d), valpha, vmask);
+            const uint16x4_t hi = Blend16NEON(Spread16NEON(vget_high_u16(s), vmask),
+                                              vget_high_u16(d), valpha, vmask);
+            vst1q_u16(dst + i, vcombine_u16(lo, hi));
+        }
+    }
+#endif
+#if HAVE_SSE2_INTRINSICS
+    if (n >= 8 && SDL_HasSSE2()) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i vmask = _mm_set1_epi32((int)mask);
+        const __m128i valpha = _mm_set1_epi16((short)alpha);
+        for (; i + 8 <= n; i += 8) {
+            const __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+            const __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+            __m128i s0 = _mm_unpacklo_epi16(s, zero);
+            __m128i s1 = _mm_unpackhi_epi16(s, zero);
+            s0 = _mm_and_si128(_mm_or_si128(s0, _mm_slli_epi32(s0, 16)), vmask);
+            s1 = _mm_and_si128(_mm_or_si128(s1, _mm_slli_epi32(s1, 16)), vmask);
+            _mm_storeu_si128((__m128i *)(dst + i),
+                             _mm_packs_epi32(Blend16SSE2(s0, _mm_unpacklo_epi16(d, zero), valpha, vmask),
+                                             Blend16SSE2(s1, _mm_unpackhi_epi16(d, zero), valpha, vmask)));
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        Uint32 s = src[i];
+        Uint32 d = dst[i];
+        s = (s | s << 16) & mask;
+        d = (d | d << 16) & mask;
+        d += (s - d) * alpha >> 5;
+        d &= mask;
+        dst[i] = (Uint16)(d | d >> 16);
+    }
+}
+
+/*
+ * Blend n translucent pixels of the per-pixel alpha encoding for 16bpp
+ * targets, which are already spread out and have their alpha in bits 5-10.
  */
+static void
+BlendTranslRun16(Uint16 *dst, const Uint32 *src, int n, Uint32 mask)
+{
+    int i = 0;
+
+#if HAVE_NEON_INTRINSICS
+    if (n >= 8 && SDL_HasNEON()) {
+        const uint32x4_t vmask = vdupq_n_u32(mask);
+        const uint32x4_t mask_1f = vdupq_n_u32(0x1f);
+        for (; i + 8 <= n; i += 8) {
+            const uint32x4_t s0 = vld1q_u32(src + i);
+            const uint32x4_t s1 = vld1q_u32(src + i + 4);
+            const uint16x8_t d = vld1q_u16(dst + i);
+            const uint16x4_t lo = Blend16NEON(vandq_u32(s0, vmask), vget_low_u16(d),
+                                              vandq_u32(vshrq_n_u32(s0, 5), mask_1f), vmask);
+            const uint16x4_t hi = Blend16NEON(vandq_u32(s1, vmask), vget_high_u16(d),
+                                              vandq_u32(vshrq_n_u32(s1, 5), mask_1f), vmask);
+            vst1q_u16(dst + i, vcombine_u16(lo, hi));
+        }
+    }
+#endif
+#if HAVE_SSE2_INTRINSICS
+    if (n >= 8 && SDL_HasSSE2()) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i vmask = _mm_set1_epi32((int)mask);
+        const __m128i mask_1f = _mm_set1_epi32(0x1f);
+        for (; i + 8 <= n; i += 8) {
+            const __m128i s0 = _mm_loadu_si128((const __m128i *)(src + i));
+            const __m128i s1 = _mm_loadu_si128((const __m128i *)(src + i + 4));
+            const __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+            __m128i a0 = _mm_and_si128(_mm_srli_epi32(s0, 5), mask_1f);
+            __m128i a1 = _mm_and_si128(_mm_srli_epi32(s1, 5), mask_1f);
+            a0 = _mm_or_si128(a0, _mm_slli_epi32(a0, 16));
+            a1 = _mm_or_si128(a1, _mm_slli_epi32(a1, 16));
+            _mm_storeu_si128((__m128i *)(dst + i),
+                             _mm_packs_epi32(Blend16SSE2(_mm_and_si128(s0, vmask), _mm_unpacklo_epi16(d, zero), a0, vmask),
+                                             Blend16SSE2(_mm_and_si128(s1, vmask), _mm_unpackhi_epi16(d, zero), a1, vmask)));
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        Uint32 s = src[i];
+        Uint32 d = dst[i];
+        Uint32 alpha = (s & 0x3e0) >> 5;
+        s &= mask;
+        d = (d | d << 16) & mask;
+        d += (s - d) * alpha >> 5;
+        d &= mask;
+        dst[i] = (Uint16)(d | d >> 16);
+    }
+}
+
 #define ALPHA_BLIT16_565(to, from, length, bpp, alpha)  \
-    do {                                                \
-        int i;                                          \
-        Uint16 *src = (Uint16 *)(from);                 \
-        Uint16 *dst = (Uint16 *)(to);                   \
-        Uint32 ALPHA = alpha >> 3;                      \
-        for(i = 0; i < (int)(length); i++) {            \
-            Uint32 s = *src++;                          \
-            Uint32 d = *dst;                            \
-            s = (s | s << 16) & 0x07e0f81f;             \
-            d = (d | d << 16) & 0x07e0f81f;             \
-            d += (s - d) * ALPHA >> 5;                  \
-            d &= 0x07e0f81f;                            \
-            *dst++ = (Uint16)(d | d >> 16);             \
-        }                                               \
-    } while(0)
+    BlendRun16((Uint16 *)(to), (const Uint16 *)(from), (int)(length), \
+               (alpha) >> 3, MASK_565)
 
 #define ALPHA_BLIT16_555(to, from, length, bpp, alpha)  \
-    do {                                                \
-        int i;                                          \
-        Uint16 *src = (Uint16 *)(from);                 \
-        Uint16 *dst = (Uint16 *)(to);                   \
-        Uint32 ALPHA = alpha >> 3;                      \
-        for(i = 0; i < (int)(length); i++) {            \
-            Uint32 s = *src++;                          \
-            Uint32 d = *dst;                            \
-            s = (s | s << 16) & 0x03e07c1f;             \
-            d = (d | d << 16) & 0x03e07c1f;             \
-            d += (s - d) * ALPHA >> 5;                  \
-            d &= 0x03e07c1f;                            \
-            *dst++ = (Uint16)(d | d >> 16);             \
-        }                                               \
-    } while(0)
+    BlendRun16((Uint16 *)(to), (const Uint16 *)(from), (int)(length), \
+               (alpha) >> 3, MASK_555)
 
 /*
  * The general slow catch-all function, for remaining depths and formats
@@ -584,28 +731,17 @@ SDL_RLEBlit(SDL_Surface * surf_src, SDL_Rect * srcrect,
  * For 16bpp pixels, we have stored the 5 most significant alpha bits in
  * bits 5-10. As before, we can process all 3 RGB components at the same time.
  */
-#define BLIT_TRANSL_565(src, dst)       \
-    do {                    \
-    Uint32 s = src;             \
-    Uint32 d = dst;             \
-    unsigned alpha = (s & 0x3e0) >> 5;  \
-    s &= 0x07e0f81f;            \
-    d = (d | d << 16) & 0x07e0f81f;     \
-    d += (s - d) * alpha >> 5;      \
-    d &= 0x07e0f81f;            \
-    dst = (Uint16)(d | d >> 16);            \
-    } while(0)
+#define BLIT_TRANSL_RUN_565(src, dst, n)        \
+    BlendTranslRun16(dst, src, n, MASK_565)
 
-#define BLIT_TRANSL_555(src, dst)       \
-    do {                    \
-    Uint32 s = src;             \
-    Uint32 d = dst;             \
-    unsigned alpha = (s & 0x3e0) >> 5;  \
-    s &= 0x03e07c1f;            \
-    d = (d | d << 16) & 0x03e07c1f;     \
-    d += (s - d) * alpha >> 5;      \
-    d &= 0x03e07c1f;            \
-    dst = (Uint16)(d | d >> 16);            \
+#define BLIT_TRANSL_RUN_555(src, dst, n)        \
+    BlendTranslRun16(dst, src, n, MASK_555)
+
+#define BLIT_TRANSL_RUN_888(src, dst, n)        \
+    do {                                        \
+        int i;                                  \
+        for (i = 0; i < (n); i++)               \
+            BLIT_TRANSL_888((src)[i], (dst)[i]); \
     } while(0)
 
 /* used to save the destination format in the encoding. Designed to be
@@ -637,7 +773,7 @@ RLEAlphaClipBlit(int w, Uint8 * srcbuf, SDL_Surface * surf_dst,
     /*
      * clipped blitter: Ptype is the destination pixel type,
      * Ctype the translucent count type, and do_blend the macro
-     * to blend one pixel.
+     * to blend a run of pixels.
      */
 #define RLEALPHACLIPBLIT(Ptype, Ctype, do_blend)              \
     do {                                  \
@@ -692,13 +828,9 @@ RLEAlphaClipBlit(int w, Uint8 * srcbuf, SDL_Surface * surf_dst,
             }                             \
             if(crun > right - cofs)               \
             crun = right - cofs;                  \
-            if(crun > 0) {                    \
-            Ptype *dst = (Ptype *)dstbuf + cofs;          \
-            Uint32 *src = (Uint32 *)srcbuf + (cofs - ofs);    \
-            int i;                        \
-            for(i = 0; i < crun; i++)             \
-                do_blend(src[i], dst[i]);             \
-            }                             \
+            if(crun > 0)                      \
+            do_blend((Uint32 *)srcbuf + (cofs - ofs),     \
+                 (Ptype *)dstbuf + cofs, crun);       \
             srcbuf += run * 4;                    \
             ofs += run;                       \
         }                             \
@@ -710,12 +842,12 @@ RLEAlphaClipBlit(int w, Uint8 * srcbuf, SDL_Surface * surf_dst,
     switch (df->BytesPerPixel) {
     case 2:
         if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0)
-            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_565);
+            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_RUN_565);
         else
-            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_555);
+            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_RUN_555);
         break;
     case 4:
-        RLEALPHACLIPBLIT(Uint32, Uint16, BLIT_TRANSL_888);
+        RLEALPHACLIPBLIT(Uint32, Uint16, BLIT_TRANSL_RUN_888);
         break;
     }
 }
@@ -806,7 +938,7 @@ SDL_RLEAlphaBlit(SDL_Surface * surf_src, SDL_Rect * srcrect,
         /*
          * non-clipped blitter. Ptype is the destination pixel type,
          * Ctype the translucent count type, and do_blend the
-         * macro to blend one pixel.
+         * macro to blend a run of pixels.
          */
 #define RLEALPHABLIT(Ptype, Ctype, do_blend)                 \
     do {                                 \
@@ -838,14 +970,9 @@ SDL_RLEAlphaBlit(SDL_Surface * surf_src, SDL_Rect * srcrect,
             run = ((Uint16 *)srcbuf)[1];             \
             srcbuf += 4;                     \
             if(run) {                        \
-            Ptype *dst = (Ptype *)dstbuf + ofs;      \
-            unsigned i;                  \
-            for(i = 0; i < run; i++) {           \
-                Uint32 src = *(Uint32 *)srcbuf;      \
-                do_blend(src, *dst);             \
-                srcbuf += 4;                 \
-                dst++;                   \
-            }                        \
+            do_blend((Uint32 *)srcbuf, (Ptype *)dstbuf + ofs, \
+                 (int)run);                  \
+            srcbuf += run * 4;               \
             ofs += run;                  \
             }                            \
         } while(ofs < w);                    \
@@ -857,12 +984,12 @@ SDL_RLEAlphaBlit(SDL_Surface * surf_src, SDL_Rect * srcrect,
         case 2:
             if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0
                 || df->Bmask == 0x07e0)
-                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_565);
+                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_RUN_565);
             else
-                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_555);
+                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_RUN_555);
             break;
         case 4:
-            RLEALPHABLIT(Uint32, Uint16, BLIT_TRANSL_888);
+            RLEALPHABLIT(Uint32, Uint16, BLIT_TRANSL_RUN_888);
             break;
         }
     }
@@ -1217,7 +1344,8 @@ RLEAlphaSurface(SDL_Surface * surface)
 #undef ADD_TRANSL_COUNTS
 
     /* Now that we have it encoded, release the original pixels */
-    if (!(surface->flags & SDL_PREALLOC)) {
+    if (!(surface->flags & SDL_PREALLOC) &&
+        !(surface->map->info.flags & SDL_COPY_RLE_KEEP)) {
         if (surface->flags & SDL_SIMD_ALIGNED) {
             SDL_SIMDFree(surface->pixels);
             surface->flags &= ~SDL_SIMD_ALIGNED;
@@ -1385,7 +1513,8 @@ RLEColorkeySurface(SDL_Surface * surface)
 #undef ADD_COUNTS
 
     /* Now that we have it encoded, release the original pixels */
-    if (!(surface->flags & SDL_PREALLOC)) {
+    if (!(surface->flags & SDL_PREALLOC) &&
+        !(surface->map->info.flags & SDL_COPY_RLE_KEEP)) {
         if (surface->flags & SDL_SIMD_ALIGNED) {
             SDL_SIMDFree(surface->pixels);
             surface->flags &= ~SDL_SIMD_ALIGNED;
@@ -1557,7 +1686,8 @@ SDL_UnRLESurface(SDL_Surface * surface, int recode)
     if (surface->flags & SDL_RLEACCEL) {
         surface->flags &= ~SDL_RLEACCEL;
 
-        if (recode && !(surface->flags & SDL_PREALLOC)) {
+        if (recode && !(surface->flags & SDL_PREALLOC) &&
+            !(surface->map->info.flags & SDL_COPY_RLE_KEEP)) {
             if (surface->map->info.flags & SDL_COPY_RLE_COLORKEY) {
                 SDL_Rect full;
 
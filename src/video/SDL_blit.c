@@ -210,7 +210,7 @@ SDL_CalculateBlit(SDL_Surface * surface)
 #endif
 
     /* Choose a standard blit function */
-    if (map->identity && !(map->info.flags & ~SDL_COPY_RLE_DESIRED)) {
+    if (map->identity && !(map->info.flags & ~SDL_COPY_RLE_MASK)) {
         blit = SDL_BlitCopy;
     } else if (surface->format->Rloss > 8 || dst->format->Rloss > 8) {
         blit = SDL_Blit_Slow;
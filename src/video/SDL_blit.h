@@ -44,7 +44,8 @@ extern Uint8* SDL_expand_byte[9];
 #define SDL_COPY_RLE_DESIRED        0x00001000
 #define SDL_COPY_RLE_COLORKEY       0x00002000
 #define SDL_COPY_RLE_ALPHAKEY       0x00004000
-#define SDL_COPY_RLE_MASK           (SDL_COPY_RLE_DESIRED|SDL_COPY_RLE_COLORKEY|SDL_COPY_RLE_ALPHAKEY)
+#define SDL_COPY_RLE_KEEP           0x00008000  /* Keep the original pixels while RLE encoded */
+#define SDL_COPY_RLE_MASK           (SDL_COPY_RLE_DESIRED|SDL_COPY_RLE_COLORKEY|SDL_COPY_RLE_ALPHAKEY|SDL_COPY_RLE_KEEP)
 
 /* SDL blit CPU flags */
 #define SDL_CPU_ANY                 0x00000000
@@ -110,6 +111,9 @@ extern SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface * surface);
 extern SDL_BlitFunc SDL_CalculateBlitN(SDL_Surface * surface);
 extern SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface * surface);
 
+/* A blitter between two formats that needs no surfaces or blit map, or NULL */
+extern SDL_BlitFunc SDL_CalculateConvertBlitN(Uint32 src_format, Uint32 dst_format);
+
 /*
  * Useful macros for blitting routines
  */
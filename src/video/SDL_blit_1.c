@@ -72,21 +72,26 @@ Blit1to1(SDL_BlitInfo * info)
 }
 
 /* This is now endian dependent */
-#ifndef USE_DUFFS_LOOP
-# if ( SDL_BYTEORDER == SDL_LIL_ENDIAN )
-#  define HI    1
-#  define LO    0
-# else /* ( SDL_BYTEORDER == SDL_BIG_ENDIAN ) */
-#  define HI    0
-#  define LO    1
-# endif
+#if ( SDL_BYTEORDER == SDL_LIL_ENDIAN )
+# define HI    1
+# define LO    0
+#else /* ( SDL_BYTEORDER == SDL_BIG_ENDIAN ) */
+# define HI    0
+# define LO    1
 #endif
+/* Two mapped pixels as one 32-bit value, to be stored at an aligned address */
+#define MAP_PAIR(map, src)  ((Uint32)map[(src)[HI]] << 16 | map[(src)[LO]])
+
+/* This is the 8-bit indexed to RGB565 path used by emulators and the like.
+   The 512 byte table stays in the L1 cache, so the loop is bound by the
+   lookups; it keeps eight in flight and pairs up the stores.  A 64K entry
+   table mapping two pixels at a time would be 256 KB, which doesn't fit in
+   the L1 or comfortably in the L2 on the devices that need this, and would
+   have to be rebuilt on every palette change.
+ */
 static void
 Blit1to2(SDL_BlitInfo * info)
 {
-#ifndef USE_DUFFS_LOOP
-    int c;
-#endif
     int width, height;
     Uint8 *src, *dst;
     Uint16 *map;
@@ -101,91 +106,42 @@ Blit1to2(SDL_BlitInfo * info)
     dstskip = info->dst_skip;
     map = (Uint16 *) info->table;
 
-#ifdef USE_DUFFS_LOOP
     while (height--) {
-        /* *INDENT-OFF* */ /* clang-format off */
-        DUFFS_LOOP(
-        {
-            *(Uint16 *)dst = map[*src++];
-            dst += 2;
-        },
-        width);
-        /* *INDENT-ON* */ /* clang-format on */
-        src += srcskip;
-        dst += dstskip;
-    }
-#else
-    /* Memory align at 4-byte boundary, if necessary */
-    if ((long) dst & 0x03) {
-        /* Don't do anything if width is 0 */
-        if (width == 0) {
-            return;
-        }
-        --width;
+        int n = width;
 
-        while (height--) {
-            /* Perform copy alignment */
+        /* Memory align at 4-byte boundary, if necessary */
+        if (((uintptr_t) dst & 2) && n) {
             *(Uint16 *) dst = map[*src++];
             dst += 2;
+            --n;
+        }
 
-            /* Copy in 4 pixel chunks */
-            for (c = width / 4; c; --c) {
-                *(Uint32 *) dst = (map[src[HI]] << 16) | (map[src[LO]]);
-                src += 2;
-                dst += 4;
-                *(Uint32 *) dst = (map[src[HI]] << 16) | (map[src[LO]]);
-                src += 2;
-                dst += 4;
-            }
-            /* Get any leftovers */
-            switch (width & 3) {
-            case 3:
-                *(Uint16 *) dst = map[*src++];
-                dst += 2;
-            case 2:
-                *(Uint32 *) dst = (map[src[HI]] << 16) | (map[src[LO]]);
-                src += 2;
-                dst += 4;
-                break;
-            case 1:
-                *(Uint16 *) dst = map[*src++];
-                dst += 2;
-                break;
-            }
-            src += srcskip;
-            dst += dstskip;
+        /* Copy in 8 pixel chunks */
+        while (n >= 8) {
+            Uint32 *d = (Uint32 *) dst;
+            d[0] = MAP_PAIR(map, src);
+            d[1] = MAP_PAIR(map, src + 2);
+            d[2] = MAP_PAIR(map, src + 4);
+            d[3] = MAP_PAIR(map, src + 6);
+            src += 8;
+            dst += 16;
+            n -= 8;
         }
-    } else {
-        while (height--) {
-            /* Copy in 4 pixel chunks */
-            for (c = width / 4; c; --c) {
-                *(Uint32 *) dst = (map[src[HI]] << 16) | (map[src[LO]]);
-                src += 2;
-                dst += 4;
-                *(Uint32 *) dst = (map[src[HI]] << 16) | (map[src[LO]]);
-                src += 2;
-                dst += 4;
-            }
-            /* Get any leftovers */
-            switch (width & 3) {
-            case 3:
-                *(Uint16 *) dst = map[*src++];
-                dst += 2;
-            case 2:
-                *(Uint32 *) dst = (map[src[HI]] << 16) | (map[src[LO]]);
-                src += 2;
-                dst += 4;
-                break;
-            case 1:
-                *(Uint16 *) dst = map[*src++];
-                dst += 2;
-                break;
-            }
-            src += srcskip;
-            dst += dstskip;
+
+        /* Get any leftovers */
+        while (n >= 2) {
+            *(Uint32 *) dst = MAP_PAIR(map, src);
+            src += 2;
+            dst += 4;
+            n -= 2;
         }
+        if (n) {
+            *(Uint16 *) dst = map[*src++];
+            dst += 2;
+        }
+        src += srcskip;
+        dst += dstskip;
     }
-#endif /* USE_DUFFS_LOOP */
 }
 
 static void
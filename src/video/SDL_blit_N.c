@@ -28,6 +28,14 @@
 #include "SDL_blit.h"
 #include "SDL_blit_copy.h"
 
+#if defined(__SSE2__) && !defined(SDL_DISABLE_EMMINTRIN_H)
+#include <emmintrin.h>
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
+#if defined(__ARM_NEON) && SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define HAVE_NEON_INTRINSICS 1
+#endif
 
 /* General optimized routines that write char by char */
 #define HAVE_FAST_WRITE_INT8 1
@@ -45,7 +53,9 @@ enum blit_features {
     BLIT_FEATURE_HAS_MMX = 1,
     BLIT_FEATURE_HAS_ALTIVEC = 2,
     BLIT_FEATURE_ALTIVEC_DONT_USE_PREFETCH = 4,
-    BLIT_FEATURE_HAS_ARM_SIMD = 8
+    BLIT_FEATURE_HAS_ARM_SIMD = 8,
+    BLIT_FEATURE_HAS_NEON = 16,
+    BLIT_FEATURE_HAS_SSE2 = 32
 };
 
 #if SDL_ALTIVEC_BLITTERS
@@ -907,7 +917,8 @@ GetBlitFeatures(void)
 #endif
 #else
 /* Feature 1 is has-MMX */
-#define GetBlitFeatures() ((SDL_HasMMX() ? BLIT_FEATURE_HAS_MMX : 0) | (SDL_HasARMSIMD() ? BLIT_FEATURE_HAS_ARM_SIMD : 0))
+#define GetBlitFeatures() ((SDL_HasMMX() ? BLIT_FEATURE_HAS_MMX : 0) | (SDL_HasARMSIMD() ? BLIT_FEATURE_HAS_ARM_SIMD : 0) | \
+                           (SDL_HasNEON() ? BLIT_FEATURE_HAS_NEON : 0) | (SDL_HasSSE2() ? BLIT_FEATURE_HAS_SSE2 : 0))
 #endif
 
 #if SDL_ARM_SIMD_BLITTERS
@@ -942,6 +953,368 @@ Blit_RGB444_RGB888ARMSIMD(SDL_BlitInfo * info)
 }
 #endif
 
+/* Converters for the RGB565, 8888 and ARGB4444 formats that streamed
+   textures and SDL_ConvertPixels() go through most.  Each works on a single
+   row; the NEON and SSE2 versions produce exactly the same pixels as the
+   scalar ones, which also handle their leftovers.
+ */
+typedef void (*BlitRowFunc)(const Uint8 *src, Uint8 *dst, int width);
+
+static void
+BlitRows(SDL_BlitInfo * info, int srcbpp, int dstbpp, BlitRowFunc row)
+{
+    const Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const int width = info->dst_w;
+    const int srcpitch = width * srcbpp + info->src_skip;
+    const int dstpitch = width * dstbpp + info->dst_skip;
+    int height = info->dst_h;
+
+    while (height--) {
+        row(src, dst, width);
+        src += srcpitch;
+        dst += dstpitch;
+    }
+}
+
+#define DEFINE_BLIT_ROWS(name, srcbpp, dstbpp, row) \
+static void name(SDL_BlitInfo * info) \
+{ \
+    BlitRows(info, srcbpp, dstbpp, row); \
+}
+
+/* The 5 and 6 bit channels are widened like SDL_expand_byte[] does, which
+   the vector versions compute as (v * 1053) >> 7 and (v * 259 + 3) >> 6. */
+static SDL_INLINE Uint32
+Convert_RGB565_8888(Uint32 p, int rshift, int bshift)
+{
+    const Uint32 r = SDL_expand_byte[3][p >> 11];
+    const Uint32 g = SDL_expand_byte[2][(p >> 5) & 0x3F];
+    const Uint32 b = SDL_expand_byte[3][p & 0x1F];
+    return 0xFF000000 | (r << rshift) | (g << 8) | (b << bshift);
+}
+
+static SDL_INLINE Uint16
+Convert_8888_RGB565(Uint32 p, int rshift, int bshift)
+{
+    return (Uint16)((((p >> rshift) & 0xF8) << 8) |
+                    ((p >> 5) & 0x07E0) |
+                    (((p >> bshift) & 0xF8) >> 3));
+}
+
+static SDL_INLINE Uint32
+Convert_ARGB4444_ARGB8888(Uint32 p)
+{
+    return (((p >> 12) & 0x0F) * 0x11) << 24 |
+           (((p >> 8) & 0x0F) * 0x11) << 16 |
+           (((p >> 4) & 0x0F) * 0x11) << 8 |
+           ((p & 0x0F) * 0x11);
+}
+
+static SDL_INLINE Uint16
+Convert_ARGB8888_ARGB4444(Uint32 p)
+{
+    return (Uint16)(((p >> 16) & 0xF000) | ((p >> 12) & 0x0F00) |
+                    ((p >> 8) & 0x00F0) | ((p >> 4) & 0x000F));
+}
+
+#define DEFINE_SCALAR_ROW(name, srctype, dsttype, convert) \
+static void name(const Uint8 *srcp, Uint8 *dstp, int width) \
+{ \
+    const srctype *src = (const srctype *)srcp; \
+    dsttype *dst = (dsttype *)dstp; \
+    while (width--) { \
+        const Uint32 p = *src++; \
+        *dst++ = convert; \
+    } \
+}
+
+DEFINE_SCALAR_ROW(RGB565_ARGB8888_Row, Uint16, Uint32, Convert_RGB565_8888(p, 16, 0))
+DEFINE_SCALAR_ROW(RGB565_ABGR8888_Row, Uint16, Uint32, Convert_RGB565_8888(p, 0, 16))
+#if HAVE_NEON_INTRINSICS || HAVE_SSE2_INTRINSICS
+DEFINE_SCALAR_ROW(ARGB8888_RGB565_Row, Uint32, Uint16, Convert_8888_RGB565(p, 16, 0))
+#endif
+DEFINE_SCALAR_ROW(ABGR8888_RGB565_Row, Uint32, Uint16, Convert_8888_RGB565(p, 0, 16))
+DEFINE_SCALAR_ROW(ARGB4444_ARGB8888_Row, Uint16, Uint32, Convert_ARGB4444_ARGB8888(p))
+DEFINE_SCALAR_ROW(ARGB8888_ARGB4444_Row, Uint32, Uint16, Convert_ARGB8888_ARGB4444(p))
+
+DEFINE_BLIT_ROWS(Blit_RGB565_ARGB8888Rows, 2, 4, RGB565_ARGB8888_Row)
+DEFINE_BLIT_ROWS(Blit_RGB565_ABGR8888Rows, 2, 4, RGB565_ABGR8888_Row)
+DEFINE_BLIT_ROWS(Blit_ABGR8888_RGB565, 4, 2, ABGR8888_RGB565_Row)
+DEFINE_BLIT_ROWS(Blit_ARGB4444_ARGB8888, 2, 4, ARGB4444_ARGB8888_Row)
+DEFINE_BLIT_ROWS(Blit_ARGB8888_ARGB4444, 4, 2, ARGB8888_ARGB4444_Row)
+
+#if HAVE_NEON_INTRINSICS
+static SDL_INLINE void
+RGB565_8888_RowNEON(const Uint8 *src, Uint8 *dst, int width, SDL_bool bgr)
+{
+    const uint16x8_t mask_3f = vdupq_n_u16(0x3F);
+    const uint16x8_t mask_1f = vdupq_n_u16(0x1F);
+    const uint16x8_t three = vdupq_n_u16(3);
+    const uint8x8_t alpha = vdup_n_u8(0xFF);
+
+    for (; width >= 8; width -= 8) {
+        const uint16x8_t p = vld1q_u16((const uint16_t *)src);
+        const uint8x8_t r = vshrn_n_u16(vmulq_n_u16(vshrq_n_u16(p, 11), 1053), 7);
+        const uint8x8_t g = vshrn_n_u16(vmlaq_n_u16(three, vandq_u16(vshrq_n_u16(p, 5), mask_3f), 259), 6);
+        const uint8x8_t b = vshrn_n_u16(vmulq_n_u16(vandq_u16(p, mask_1f), 1053), 7);
+        uint8x8x4_t v;
+
+        v.val[0] = bgr ? r : b;
+        v.val[1] = g;
+        v.val[2] = bgr ? b : r;
+        v.val[3] = alpha;
+        vst4_u8(dst, v);
+        src += 16;
+        dst += 32;
+    }
+    if (bgr) {
+        RGB565_ABGR8888_Row(src, dst, width);
+    } else {
+        RGB565_ARGB8888_Row(src, dst, width);
+    }
+}
+
+static SDL_INLINE void
+RGB8888_565_RowNEON(const Uint8 *src, Uint8 *dst, int width, SDL_bool bgr)
+{
+    for (; width >= 8; width -= 8) {
+        const uint8x8x4_t v = vld4_u8(src);
+        uint16x8_t p = vshll_n_u8(bgr ? v.val[0] : v.val[2], 8);
+
+        p = vsriq_n_u16(p, vshll_n_u8(v.val[1], 8), 5);
+        p = vsriq_n_u16(p, vshll_n_u8(bgr ? v.val[2] : v.val[0], 8), 11);
+        vst1q_u16((uint16_t *)dst, p);
+        src += 32;
+        dst += 16;
+    }
+    if (bgr) {
+        ABGR8888_RGB565_Row(src, dst, width);
+    } else {
+        ARGB8888_RGB565_Row(src, dst, width);
+    }
+}
+
+static void
+RGB565_ARGB8888_RowNEON(const Uint8 *src, Uint8 *dst, int width)
+{
+    RGB565_8888_RowNEON(src, dst, width, SDL_FALSE);
+}
+
+static void
+RGB565_ABGR8888_RowNEON(const Uint8 *src, Uint8 *dst, int width)
+{
+    RGB565_8888_RowNEON(src, dst, width, SDL_TRUE);
+}
+
+static void
+ARGB8888_RGB565_RowNEON(const Uint8 *src, Uint8 *dst, int width)
+{
+    RGB8888_565_RowNEON(src, dst, width, SDL_FALSE);
+}
+
+static void
+ABGR8888_RGB565_RowNEON(const Uint8 *src, Uint8 *dst, int width)
+{
+    RGB8888_565_RowNEON(src, dst, width, SDL_TRUE);
+}
+
+static void
+ARGB4444_ARGB8888_RowNEON(const Uint8 *src, Uint8 *dst, int width)
+{
+    for (; width >= 8; width -= 8) {
+        const uint16x8_t p = vld1q_u16((const uint16_t *)src);
+        const uint8x8_t ar = vshrn_n_u16(p, 8);
+        const uint8x8_t gb = vmovn_u16(p);
+        const uint8x8_t r = vshl_n_u8(ar, 4);
+        const uint8x8_t b = vshl_n_u8(gb, 4);
+        uint8x8x4_t v;
+
+        v.val[0] = vsri_n_u8(b, b, 4);
+        v.val[1] = vsri_n_u8(gb, gb, 4);
+        v.val[2] = vsri_n_u8(r, r, 4);
+        v.val[3] = vsri_n_u8(ar, ar, 4);
+        vst4_u8(dst, v);
+        src += 16;
+        dst += 32;
+    }
+    ARGB4444_ARGB8888_Row(src, dst, width);
+}
+
+static void
+ARGB8888_ARGB4444_RowNEON(const Uint8 *src, Uint8 *dst, int width)
+{
+    for (; width >= 8; width -= 8) {
+        const uint8x8x4_t v = vld4_u8(src);
+        uint8x8x2_t p;
+
+        p.val[0] = vsri_n_u8(v.val[1], v.val[0], 4);
+        p.val[1] = vsri_n_u8(v.val[3], v.val[2], 4);
+        vst2_u8(dst, p);
+        src += 32;
+        dst += 16;
+    }
+    ARGB8888_ARGB4444_Row(src, dst, width);
+}
+
+DEFINE_BLIT_ROWS(Blit_RGB565_ARGB8888NEON, 2, 4, RGB565_ARGB8888_RowNEON)
+DEFINE_BLIT_ROWS(Blit_RGB565_ABGR8888NEON, 2, 4, RGB565_ABGR8888_RowNEON)
+DEFINE_BLIT_ROWS(Blit_ARGB8888_RGB565NEON, 4, 2, ARGB8888_RGB565_RowNEON)
+DEFINE_BLIT_ROWS(Blit_ABGR8888_RGB565NEON, 4, 2, ABGR8888_RGB565_RowNEON)
+DEFINE_BLIT_ROWS(Blit_ARGB4444_ARGB8888NEON, 2, 4, ARGB4444_ARGB8888_RowNEON)
+DEFINE_BLIT_ROWS(Blit_ARGB8888_ARGB4444NEON, 4, 2, ARGB8888_ARGB4444_RowNEON)
+#endif /* HAVE_NEON_INTRINSICS */
+
+#if HAVE_SSE2_INTRINSICS
+/* Pack the low 16 bits of each 32-bit lane of two vectors */
+static SDL_INLINE __m128i
+Pack32to16SSE2(__m128i lo, __m128i hi)
+{
+    lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+    hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+    return _mm_packs_epi32(lo, hi);
+}
+
+static SDL_INLINE void
+RGB565_8888_RowSSE2(const Uint8 *src, Uint8 *dst, int width, SDL_bool bgr)
+{
+    const __m128i mask_3f = _mm_set1_epi16(0x3F);
+    const __m128i mask_1f = _mm_set1_epi16(0x1F);
+    const __m128i mul_5 = _mm_set1_epi16(1053);
+    const __m128i mul_6 = _mm_set1_epi16(259);
+    const __m128i three = _mm_set1_epi16(3);
+    const __m128i alpha = _mm_set1_epi16((short)0xFF00);
+
+    for (; width >= 8; width -= 8) {
+        const __m128i p = _mm_loadu_si128((const __m128i *)src);
+        const __m128i r = _mm_srli_epi16(_mm_mullo_epi16(_mm_srli_epi16(p, 11), mul_5), 7);
+        const __m128i g = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(p, 5), mask_3f), mul_6), three), 6);
+        const __m128i b = _mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(p, mask_1f), mul_5), 7);
+        const __m128i lo = _mm_or_si128(bgr ? r : b, _mm_slli_epi16(g, 8));
+        const __m128i hi = _mm_or_si128(bgr ? b : r, alpha);
+
+        _mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi16(lo, hi));
+        _mm_storeu_si128((__m128i *)(dst + 16), _mm_unpackhi_epi16(lo, hi));
+        src += 16;
+        dst += 32;
+    }
+    if (bgr) {
+        RGB565_ABGR8888_Row(src, dst, width);
+    } else {
+        RGB565_ARGB8888_Row(src, dst, width);
+    }
+}
+
+static SDL_INLINE __m128i
+ARGB8888_RGB565_SSE2(__m128i p)
+{
+    return _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 8), _mm_set1_epi32(0xF800)),
+                                     _mm_and_si128(_mm_srli_epi32(p, 5), _mm_set1_epi32(0x07E0))),
+                        _mm_and_si128(_mm_srli_epi32(p, 3), _mm_set1_epi32(0x001F)));
+}
+
+static SDL_INLINE __m128i
+ABGR8888_RGB565_SSE2(__m128i p)
+{
+    return _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_slli_epi32(p, 8), _mm_set1_epi32(0xF800)),
+                                     _mm_and_si128(_mm_srli_epi32(p, 5), _mm_set1_epi32(0x07E0))),
+                        _mm_and_si128(_mm_srli_epi32(p, 19), _mm_set1_epi32(0x001F)));
+}
+
+static void
+RGB565_ARGB8888_RowSSE2(const Uint8 *src, Uint8 *dst, int width)
+{
+    RGB565_8888_RowSSE2(src, dst, width, SDL_FALSE);
+}
+
+static void
+RGB565_ABGR8888_RowSSE2(const Uint8 *src, Uint8 *dst, int width)
+{
+    RGB565_8888_RowSSE2(src, dst, width, SDL_TRUE);
+}
+
+static void
+ARGB8888_RGB565_RowSSE2(const Uint8 *src, Uint8 *dst, int width)
+{
+    for (; width >= 8; width -= 8) {
+        const __m128i p0 = _mm_loadu_si128((const __m128i *)src);
+        const __m128i p1 = _mm_loadu_si128((const __m128i *)(src + 16));
+
+        _mm_storeu_si128((__m128i *)dst, Pack32to16SSE2(ARGB8888_RGB565_SSE2(p0), ARGB8888_RGB565_SSE2(p1)));
+        src += 32;
+        dst += 16;
+    }
+    ARGB8888_RGB565_Row(src, dst, width);
+}
+
+static void
+ABGR8888_RGB565_RowSSE2(const Uint8 *src, Uint8 *dst, int width)
+{
+    for (; width >= 8; width -= 8) {
+        const __m128i p0 = _mm_loadu_si128((const __m128i *)src);
+        const __m128i p1 = _mm_loadu_si128((const __m128i *)(src + 16));
+
+        _mm_storeu_si128((__m128i *)dst, Pack32to16SSE2(ABGR8888_RGB565_SSE2(p0), ABGR8888_RGB565_SSE2(p1)));
+        src += 32;
+        dst += 16;
+    }
+    ABGR8888_RGB565_Row(src, dst, width);
+}
+
+static void
+ARGB4444_ARGB8888_RowSSE2(const Uint8 *src, Uint8 *dst, int width)
+{
+    const __m128i mask_0f = _mm_set1_epi16(0x0F);
+    const __m128i x11 = _mm_set1_epi16(0x11);
+
+    for (; width >= 8; width -= 8) {
+        const __m128i p = _mm_loadu_si128((const __m128i *)src);
+        const __m128i a = _mm_mullo_epi16(_mm_srli_epi16(p, 12), x11);
+        const __m128i r = _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(p, 8), mask_0f), x11);
+        const __m128i g = _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(p, 4), mask_0f), x11);
+        const __m128i b = _mm_mullo_epi16(_mm_and_si128(p, mask_0f), x11);
+        const __m128i lo = _mm_or_si128(b, _mm_slli_epi16(g, 8));
+        const __m128i hi = _mm_or_si128(r, _mm_slli_epi16(a, 8));
+
+        _mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi16(lo, hi));
+        _mm_storeu_si128((__m128i *)(dst + 16), _mm_unpackhi_epi16(lo, hi));
+        src += 16;
+        dst += 32;
+    }
+    ARGB4444_ARGB8888_Row(src, dst, width);
+}
+
+static SDL_INLINE __m128i
+ARGB8888_ARGB4444_SSE2(__m128i p)
+{
+    return _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 16), _mm_set1_epi32(0xF000)),
+                                     _mm_and_si128(_mm_srli_epi32(p, 12), _mm_set1_epi32(0x0F00))),
+                        _mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 8), _mm_set1_epi32(0x00F0)),
+                                     _mm_and_si128(_mm_srli_epi32(p, 4), _mm_set1_epi32(0x000F))));
+}
+
+static void
+ARGB8888_ARGB4444_RowSSE2(const Uint8 *src, Uint8 *dst, int width)
+{
+    for (; width >= 8; width -= 8) {
+        const __m128i p0 = _mm_loadu_si128((const __m128i *)src);
+        const __m128i p1 = _mm_loadu_si128((const __m128i *)(src + 16));
+
+        _mm_storeu_si128((__m128i *)dst, Pack32to16SSE2(ARGB8888_ARGB4444_SSE2(p0), ARGB8888_ARGB4444_SSE2(p1)));
+        src += 32;
+        dst += 16;
+    }
+    ARGB8888_ARGB4444_Row(src, dst, width);
+}
+
+DEFINE_BLIT_ROWS(Blit_RGB565_ARGB8888SSE2, 2, 4, RGB565_ARGB8888_RowSSE2)
+DEFINE_BLIT_ROWS(Blit_RGB565_ABGR8888SSE2, 2, 4, RGB565_ABGR8888_RowSSE2)
+DEFINE_BLIT_ROWS(Blit_ARGB8888_RGB565SSE2, 4, 2, ARGB8888_RGB565_RowSSE2)
+DEFINE_BLIT_ROWS(Blit_ABGR8888_RGB565SSE2, 4, 2, ABGR8888_RGB565_RowSSE2)
+DEFINE_BLIT_ROWS(Blit_ARGB4444_ARGB8888SSE2, 2, 4, ARGB4444_ARGB8888_RowSSE2)
+DEFINE_BLIT_ROWS(Blit_ARGB8888_ARGB4444SSE2, 4, 2, ARGB8888_ARGB4444_RowSSE2)
+#endif /* HAVE_SSE2_INTRINSICS */
+
 /* This is now endian dependent */
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
 #define HI  1
@@ -1492,282 +1865,6 @@ Blit_RGB565_32(SDL_BlitInfo * info, const Uint32 * map)
 #endif /* USE_DUFFS_LOOP */
 }
 
-/* Special optimized blit for RGB 5-6-5 --> ARGB 8-8-8-8 */
-static const Uint32 RGB565_ARGB8888_LUT[512] = {
-    0x00000000, 0xff000000, 0x00000008, 0xff002000,
-    0x00000010, 0xff004000, 0x00000018, 0xff006100,
-    0x00000020, 0xff008100, 0x00000029, 0xff00a100,
-    0x00000031, 0xff00c200, 0x00000039, 0xff00e200,
-    0x00000041, 0xff080000, 0x0000004a, 0xff082000,
-    0x00000052, 0xff084000, 0x0000005a, 0xff086100,
-    0x00000062, 0xff088100, 0x0000006a, 0xff08a100,
-    0x00000073, 0xff08c200, 0x0000007b, 0xff08e200,
-    0x00000083, 0xff100000, 0x0000008b, 0xff102000,
-    0x00000094, 0xff104000, 0x0000009c, 0xff106100,
-    0x000000a4, 0xff108100, 0x000000ac, 0xff10a100,
-    0x000000b4, 0xff10c200, 0x000000bd, 0xff10e200,
-    0x000000c5, 0xff180000, 0x000000cd, 0xff182000,
-    0x000000d5, 0xff184000, 0x000000de, 0xff186100,
-    0x000000e6, 0xff188100, 0x000000ee, 0xff18a100,
-    0x000000f6, 0xff18c200, 0x000000ff, 0xff18e200,
-    0x00000400, 0xff200000, 0x00000408, 0xff202000,
-    0x00000410, 0xff204000, 0x00000418, 0xff206100,
-    0x00000420, 0xff208100, 0x00000429, 0xff20a100,
-    0x00000431, 0xff20c200, 0x00000439, 0xff20e200,
-    0x00000441, 0xff290000, 0x0000044a, 0xff292000,
-    0x00000452, 0xff294000, 0x0000045a, 0xff296100,
-    0x00000462, 0xff298100, 0x0000046a, 0xff29a100,
-    0x00000473, 0xff29c200, 0x0000047b, 0xff29e200,
-    0x00000483, 0xff310000, 0x0000048b, 0xff312000,
-    0x00000494, 0xff314000, 0x0000049c, 0xff316100,
-    0x000004a4, 0xff318100, 0x000004ac, 0xff31a100,
-    0x000004b4, 0xff31c200, 0x000004bd, 0xff31e200,
-    0x000004c5, 0xff390000, 0x000004cd, 0xff392000,
-    0x000004d5, 0xff394000, 0x000004de, 0xff396100,
-    0x000004e6, 0xff398100, 0x000004ee, 0xff39a100,
-    0x000004f6, 0xff39c200, 0x000004ff, 0xff39e200,
-    0x00000800, 0xff410000, 0x00000808, 0xff412000,
-    0x00000810, 0xff414000, 0x00000818, 0xff416100,
-    0x00000820, 0xff418100, 0x00000829, 0xff41a100,
-    0x00000831, 0xff41c200, 0x00000839, 0xff41e200,
-    0x00000841, 0xff4a0000, 0x0000084a, 0xff4a2000,
-    0x00000852, 0xff4a4000, 0x0000085a, 0xff4a6100,
-    0x00000862, 0xff4a8100, 0x0000086a, 0xff4aa100,
-    0x00000873, 0xff4ac200, 0x0000087b, 0xff4ae200,
-    0x00000883, 0xff520000, 0x0000088b, 0xff522000,
-    0x00000894, 0xff524000, 0x0000089c, 0xff526100,
-    0x000008a4, 0xff528100, 0x000008ac, 0xff52a100,
-    0x000008b4, 0xff52c200, 0x000008bd, 0xff52e200,
-    0x000008c5, 0xff5a0000, 0x000008cd, 0xff5a2000,
-    0x000008d5, 0xff5a4000, 0x000008de, 0xff5a6100,
-    0x000008e6, 0xff5a8100, 0x000008ee, 0xff5aa100,
-    0x000008f6, 0xff5ac200, 0x000008ff, 0xff5ae200,
-    0x00000c00, 0xff620000, 0x00000c08, 0xff622000,
-    0x00000c10, 0xff624000, 0x00000c18, 0xff626100,
-    0x00000c20, 0xff628100, 0x00000c29, 0xff62a100,
-    0x00000c31, 0xff62c200, 0x00000c39, 0xff62e200,
-    0x00000c41, 0xff6a0000, 0x00000c4a, 0xff6a2000,
-    0x00000c52, 0xff6a4000, 0x00000c5a, 0xff6a6100,
-    0x00000c62, 0xff6a8100, 0x00000c6a, 0xff6aa100,
-    0x00000c73, 0xff6ac200, 0x00000c7b, 0xff6ae200,
-    0x00000c83, 0xff730000, 0x00000c8b, 0xff732000,
-    0x00000c94, 0xff734000, 0x00000c9c, 0xff736100,
-    0x00000ca4, 0xff738100, 0x00000cac, 0xff73a100,
-    0x00000cb4, 0xff73c200, 0x00000cbd, 0xff73e200,
-    0x00000cc5, 0xff7b0000, 0x00000ccd, 0xff7b2000,
-    0x00000cd5, 0xff7b4000, 0x00000cde, 0xff7b6100,
-    0x00000ce6, 0xff7b8100, 0x00000cee, 0xff7ba100,
-    0x00000cf6, 0xff7bc200, 0x00000cff, 0xff7be200,
-    0x00001000, 0xff830000, 0x00001008, 0xff832000,
-    0x00001010, 0xff834000, 0x00001018, 0xff836100,
-    0x00001020, 0xff838100, 0x00001029, 0xff83a100,
-    0x00001031, 0xff83c200, 0x00001039, 0xff83e200,
-    0x00001041, 0xff8b0000, 0x0000104a, 0xff8b2000,
-    0x00001052, 0xff8b4000, 0x0000105a, 0xff8b6100,
-    0x00001062, 0xff8b8100, 0x0000106a, 0xff8ba100,
-    0x00001073, 0xff8bc200, 0x0000107b, 0xff8be200,
-    0x00001083, 0xff940000, 0x0000108b, 0xff942000,
-    0x00001094, 0xff944000, 0x0000109c, 0xff946100,
-    0x000010a4, 0xff948100, 0x000010ac, 0xff94a100,
-    0x000010b4, 0xff94c200, 0x000010bd, 0xff94e200,
-    0x000010c5, 0xff9c0000, 0x000010cd, 0xff9c2000,
-    0x000010d5, 0xff9c4000, 0x000010de, 0xff9c6100,
-    0x000010e6, 0xff9c8100, 0x000010ee, 0xff9ca100,
-    0x000010f6, 0xff9cc200, 0x000010ff, 0xff9ce200,
-    0x00001400, 0xffa40000, 0x00001408, 0xffa42000,
-    0x00001410, 0xffa44000, 0x00001418, 0xffa46100,
-    0x00001420, 0xffa48100, 0x00001429, 0xffa4a100,
-    0x00001431, 0xffa4c200, 0x00001439, 0xffa4e200,
-    0x00001441, 0xffac0000, 0x0000144a, 0xffac2000,
-    0x00001452, 0xffac4000, 0x0000145a, 0xffac6100,
-    0x00001462, 0xffac8100, 0x0000146a, 0xffaca100,
-    0x00001473, 0xffacc200, 0x0000147b, 0xfface200,
-    0x00001483, 0xffb40000, 0x0000148b, 0xffb42000,
-    0x00001494, 0xffb44000, 0x0000149c, 0xffb46100,
-    0x000014a4, 0xffb48100, 0x000014ac, 0xffb4a100,
-    0x000014b4, 0xffb4c200, 0x000014bd, 0xffb4e200,
-    0x000014c5, 0xffbd0000, 0x000014cd, 0xffbd2000,
-    0x000014d5, 0xffbd4000, 0x000014de, 0xffbd6100,
-    0x000014e6, 0xffbd8100, 0x000014ee, 0xffbda100,
-    0x000014f6, 0xffbdc200, 0x000014ff, 0xffbde200,
-    0x00001800, 0xffc50000, 0x00001808, 0xffc52000,
-    0x00001810, 0xffc54000, 0x00001818, 0xffc56100,
-    0x00001820, 0xffc58100, 0x00001829, 0xffc5a100,
-    0x00001831, 0xffc5c200, 0x00001839, 0xffc5e200,
-    0x00001841, 0xffcd0000, 0x0000184a, 0xffcd2000,
-    0x00001852, 0xffcd4000, 0x0000185a, 0xffcd6100,
-    0x00001862, 0xffcd8100, 0x0000186a, 0xffcda100,
-    0x00001873, 0xffcdc200, 0x0000187b, 0xffcde200,
-    0x00001883, 0xffd50000, 0x0000188b, 0xffd52000,
-    0x00001894, 0xffd54000, 0x0000189c, 0xffd56100,
-    0x000018a4, 0xffd58100, 0x000018ac, 0xffd5a100,
-    0x000018b4, 0xffd5c200, 0x000018bd, 0xffd5e200,
-    0x000018c5, 0xffde0000, 0x000018cd, 0xffde2000,
-    0x000018d5, 0xffde4000, 0x000018de, 0xffde6100,
-    0x000018e6, 0xffde8100, 0x000018ee, 0xffdea100,
-    0x000018f6, 0xffdec200, 0x000018ff, 0xffdee200,
-    0x00001c00, 0xffe60000, 0x00001c08, 0xffe62000,
-    0x00001c10, 0xffe64000, 0x00001c18, 0xffe66100,
-    0x00001c20, 0xffe68100, 0x00001c29, 0xffe6a100,
-    0x00001c31, 0xffe6c200, 0x00001c39, 0xffe6e200,
-    0x00001c41, 0xffee0000, 0x00001c4a, 0xffee2000,
-    0x00001c52, 0xffee4000, 0x00001c5a, 0xffee6100,
-    0x00001c62, 0xffee8100, 0x00001c6a, 0xffeea100,
-    0x00001c73, 0xffeec200, 0x00001c7b, 0xffeee200,
-    0x00001c83, 0xfff60000, 0x00001c8b, 0xfff62000,
-    0x00001c94, 0xfff64000, 0x00001c9c, 0xfff66100,
-    0x00001ca4, 0xfff68100, 0x00001cac, 0xfff6a100,
-    0x00001cb4, 0xfff6c200, 0x00001cbd, 0xfff6e200,
-    0x00001cc5, 0xffff0000, 0x00001ccd, 0xffff2000,
-    0x00001cd5, 0xffff4000, 0x00001cde, 0xffff6100,
-    0x00001ce6, 0xffff8100, 0x00001cee, 0xffffa100,
-    0x00001cf6, 0xffffc200, 0x00001cff, 0xffffe200
-};
-
-static void
-Blit_RGB565_ARGB8888(SDL_BlitInfo * info)
-{
-    Blit_RGB565_32(info, RGB565_ARGB8888_LUT);
-}
-
-/* Special optimized blit for RGB 5-6-5 --> ABGR 8-8-8-8 */
-static const Uint32 RGB565_ABGR8888_LUT[512] = {
-    0xff000000, 0x00000000, 0xff080000, 0x00002000,
-    0xff100000, 0x00004000, 0xff180000, 0x00006100,
-    0xff200000, 0x00008100, 0xff290000, 0x0000a100,
-    0xff310000, 0x0000c200, 0xff390000, 0x0000e200,
-    0xff410000, 0x00000008, 0xff4a0000, 0x00002008,
-    0xff520000, 0x00004008, 0xff5a0000, 0x00006108,
-    0xff620000, 0x00008108, 0xff6a0000, 0x0000a108,
-    0xff730000, 0x0000c208, 0xff7b0000, 0x0000e208,
-    0xff830000, 0x00000010, 0xff8b0000, 0x00002010,
-    0xff940000, 0x00004010, 0xff9c0000, 0x00006110,
-    0xffa40000, 0x00008110, 0xffac0000, 0x0000a110,
-    0xffb40000, 0x0000c210, 0xffbd0000, 0x0000e210,
-    0xffc50000, 0x00000018, 0xffcd0000, 0x00002018,
-    0xffd50000, 0x00004018, 0xffde0000, 0x00006118,
-    0xffe60000, 0x00008118, 0xffee0000, 0x0000a118,
-    0xfff60000, 0x0000c218, 0xffff0000, 0x0000e218,
-    0xff000400, 0x00000020, 0xff080400, 0x00002020,
-    0xff100400, 0x00004020, 0xff180400, 0x00006120,
-    0xff200400, 0x00008120, 0xff290400, 0x0000a120,
-    0xff310400, 0x0000c220, 0xff390400, 0x0000e220,
-    0xff410400, 0x00000029, 0xff4a0400, 0x00002029,
-    0xff520400, 0x00004029, 0xff5a0400, 0x00006129,
-    0xff620400, 0x00008129, 0xff6a0400, 0x0000a129,
-    0xff730400, 0x0000c229, 0xff7b0400, 0x0000e229,
-    0xff830400, 0x00000031, 0xff8b0400, 0x00002031,
-    0xff940400, 0x00004031, 0xff9c0400, 0x00006131,
-    0xffa40400, 0x00008131, 0xffac0400, 0x0000a131,
-    0xffb40400, 0x0000c231, 0xffbd0400, 0x0000e231,
-    0xffc50400, 0x00000039, 0xffcd0400, 0x00002039,
-    0xffd50400, 0x00004039, 0xffde0400, 0x00006139,
-    0xffe60400, 0x00008139, 0xffee0400, 0x0000a139,
-    0xfff60400, 0x0000c239, 0xffff0400, 0x0000e239,
-    0xff000800, 0x00000041, 0xff080800, 0x00002041,
-    0xff100800, 0x00004041, 0xff180800, 0x00006141,
-    0xff200800, 0x00008141, 0xff290800, 0x0000a141,
-    0xff310800, 0x0000c241, 0xff390800, 0x0000e241,
-    0xff410800, 0x0000004a, 0xff4a0800, 0x0000204a,
-    0xff520800, 0x0000404a, 0xff5a0800, 0x0000614a,
-    0xff620800, 0x0000814a, 0xff6a0800, 0x0000a14a,
-    0xff730800, 0x0000c24a, 0xff7b0800, 0x0000e24a,
-    0xff830800, 0x00000052, 0xff8b0800, 0x00002052,
-    0xff940800, 0x00004052, 0xff9c0800, 0x00006152,
-    0xffa40800, 0x00008152, 0xffac0800, 0x0000a152,
-    0xffb40800, 0x0000c252, 0xffbd0800, 0x0000e252,
-    0xffc50800, 0x0000005a, 0xffcd0800, 0x0000205a,
-    0xffd50800, 0x0000405a, 0xffde0800, 0x0000615a,
-    0xffe60800, 0x0000815a, 0xffee0800, 0x0000a15a,
-    0xfff60800, 0x0000c25a, 0xffff0800, 0x0000e25a,
-    0xff000c00, 0x00000062, 0xff080c00, 0x00002062,
-    0xff100c00, 0x00004062, 0xff180c00, 0x00006162,
-    0xff200c00, 0x00008162, 0xff290c00, 0x0000a162,
-    0xff310c00, 0x0000c262, 0xff390c00, 0x0000e262,
-    0xff410c00, 0x0000006a, 0xff4a0c00, 0x0000206a,
-    0xff520c00, 0x0000406a, 0xff5a0c00, 0x0000616a,
-    0xff620c00, 0x0000816a, 0xff6a0c00, 0x0000a16a,
-    0xff730c00, 0x0000c26a, 0xff7b0c00, 0x0000e26a,
-    0xff830c00, 0x00000073, 0xff8b0c00, 0x00002073,
-    0xff940c00, 0x00004073, 0xff9c0c00, 0x00006173,
-    0xffa40c00, 0x00008173, 0xffac0c00, 0x0000a173,
-    0xffb40c00, 0x0000c273, 0xffbd0c00, 0x0000e273,
-    0xffc50c00, 0x0000007b, 0xffcd0c00, 0x0000207b,
-    0xffd50c00, 0x0000407b, 0xffde0c00, 0x0000617b,
-    0xffe60c00, 0x0000817b, 0xffee0c00, 0x0000a17b,
-    0xfff60c00, 0x0000c27b, 0xffff0c00, 0x0000e27b,
-    0xff001000, 0x00000083, 0xff081000, 0x00002083,
-    0xff101000, 0x00004083, 0xff181000, 0x00006183,
-    0xff201000, 0x00008183, 0xff291000, 0x0000a183,
-    0xff311000, 0x0000c283, 0xff391000, 0x0000e283,
-    0xff411000, 0x0000008b, 0xff4a1000, 0x0000208b,
-    0xff521000, 0x0000408b, 0xff5a1000, 0x0000618b,
-    0xff621000, 0x0000818b, 0xff6a1000, 0x0000a18b,
-    0xff731000, 0x0000c28b, 0xff7b1000, 0x0000e28b,
-    0xff831000, 0x00000094, 0xff8b1000, 0x00002094,
-    0xff941000, 0x00004094, 0xff9c1000, 0x00006194,
-    0xffa41000, 0x00008194, 0xffac1000, 0x0000a194,
-    0xffb41000, 0x0000c294, 0xffbd1000, 0x0000e294,
-    0xffc51000, 0x0000009c, 0xffcd1000, 0x0000209c,
-    0xffd51000, 0x0000409c, 0xffde1000, 0x0000619c,
-    0xffe61000, 0x0000819c, 0xffee1000, 0x0000a19c,
-    0xfff61000, 0x0000c29c, 0xffff1000, 0x0000e29c,
-    0xff001400, 0x000000a4, 0xff081400, 0x000020a4,
-    0xff101400, 0x000040a4, 0xff181400, 0x000061a4,
-    0xff201400, 0x000081a4, 0xff291400, 0x0000a1a4,
-    0xff311400, 0x0000c2a4, 0xff391400, 0x0000e2a4,
-    0xff411400, 0x000000ac, 0xff4a1400, 0x000020ac,
-    0xff521400, 0x000040ac, 0xff5a1400, 0x000061ac,
-    0xff621400, 0x000081ac, 0xff6a1400, 0x0000a1ac,
-    0xff731400, 0x0000c2ac, 0xff7b1400, 0x0000e2ac,
-    0xff831400, 0x000000b4, 0xff8b1400, 0x000020b4,
-    0xff941400, 0x000040b4, 0xff9c1400, 0x000061b4,
-    0xffa41400, 0x000081b4, 0xffac1400, 0x0000a1b4,
-    0xffb41400, 0x0000c2b4, 0xffbd1400, 0x0000e2b4,
-    0xffc51400, 0x000000bd, 0xffcd1400, 0x000020bd,
-    0xffd51400, 0x000040bd, 0xffde1400, 0x000061bd,
-    0xffe61400, 0x000081bd, 0xffee1400, 0x0000a1bd,
-    0xfff61400, 0x0000c2bd, 0xffff1400, 0x0000e2bd,
-    0xff001800, 0x000000c5, 0xff081800, 0x000020c5,
-    0xff101800, 0x000040c5, 0xff181800, 0x000061c5,
-    0xff201800, 0x000081c5, 0xff291800, 0x0000a1c5,
-    0xff311800, 0x0000c2c5, 0xff391800, 0x0000e2c5,
-    0xff411800, 0x000000cd, 0xff4a1800, 0x000020cd,
-    0xff521800, 0x000040cd, 0xff5a1800, 0x000061cd,
-    0xff621800, 0x000081cd, 0xff6a1800, 0x0000a1cd,
-    0xff731800, 0x0000c2cd, 0xff7b1800, 0x0000e2cd,
-    0xff831800, 0x000000d5, 0xff8b1800, 0x000020d5,
-    0xff941800, 0x000040d5, 0xff9c1800, 0x000061d5,
-    0xffa41800, 0x000081d5, 0xffac1800, 0x0000a1d5,
-    0xffb41800, 0x0000c2d5, 0xffbd1800, 0x0000e2d5,
-    0xffc51800, 0x000000de, 0xffcd1800, 0x000020de,
-    0xffd51800, 0x000040de, 0xffde1800, 0x000061de,
-    0xffe61800, 0x000081de, 0xffee1800, 0x0000a1de,
-    0xfff61800, 0x0000c2de, 0xffff1800, 0x0000e2de,
-    0xff001c00, 0x000000e6, 0xff081c00, 0x000020e6,
-    0xff101c00, 0x000040e6, 0xff181c00, 0x000061e6,
-    0xff201c00, 0x000081e6, 0xff291c00, 0x0000a1e6,
-    0xff311c00, 0x0000c2e6, 0xff391c00, 0x0000e2e6,
-    0xff411c00, 0x000000ee, 0xff4a1c00, 0x000020ee,
-    0xff521c00, 0x000040ee, 0xff5a1c00, 0x000061ee,
-    0xff621c00, 0x000081ee, 0xff6a1c00, 0x0000a1ee,
-    0xff731c00, 0x0000c2ee, 0xff7b1c00, 0x0000e2ee,
-    0xff831c00, 0x000000f6, 0xff8b1c00, 0x000020f6,
-    0xff941c00, 0x000040f6, 0xff9c1c00, 0x000061f6,
-    0xffa41c00, 0x000081f6, 0xffac1c00, 0x0000a1f6,
-    0xffb41c00, 0x0000c2f6, 0xffbd1c00, 0x0000e2f6,
-    0xffc51c00, 0x000000ff, 0xffcd1c00, 0x000020ff,
-    0xffd51c00, 0x000040ff, 0xffde1c00, 0x000061ff,
-    0xffe61c00, 0x000081ff, 0xffee1c00, 0x0000a1ff,
-    0xfff61c00, 0x0000c2ff, 0xffff1c00, 0x0000e2ff
-};
-
-static void
-Blit_RGB565_ABGR8888(SDL_BlitInfo * info)
-{
-    Blit_RGB565_32(info, RGB565_ABGR8888_LUT);
-}
-
 /* Special optimized blit for RGB 5-6-5 --> RGBA 8-8-8-8 */
 static const Uint32 RGB565_RGBA8888_LUT[512] = {
     0x000000ff, 0x00000000, 0x000008ff, 0x00200000,
@@ -3220,20 +3317,38 @@ static const struct blit_table normal_blit_2[] = {
     {0x00007C00, 0x000003E0, 0x0000001F, 4, 0x00000000, 0x00000000, 0x00000000,
      BLIT_FEATURE_HAS_ALTIVEC, Blit_RGB555_32Altivec, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
 #endif
+#if HAVE_NEON_INTRINSICS
+    {0x0000F800, 0x000007E0, 0x0000001F, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     BLIT_FEATURE_HAS_NEON, Blit_RGB565_ARGB8888NEON, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+    {0x0000F800, 0x000007E0, 0x0000001F, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
+     BLIT_FEATURE_HAS_NEON, Blit_RGB565_ABGR8888NEON, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+    {0x00000F00, 0x000000F0, 0x0000000F, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     BLIT_FEATURE_HAS_NEON, Blit_ARGB4444_ARGB8888NEON, COPY_ALPHA},
+#endif
+#if HAVE_SSE2_INTRINSICS
+    {0x0000F800, 0x000007E0, 0x0000001F, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     BLIT_FEATURE_HAS_SSE2, Blit_RGB565_ARGB8888SSE2, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+    {0x0000F800, 0x000007E0, 0x0000001F, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
+     BLIT_FEATURE_HAS_SSE2, Blit_RGB565_ABGR8888SSE2, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+    {0x00000F00, 0x000000F0, 0x0000000F, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     BLIT_FEATURE_HAS_SSE2, Blit_ARGB4444_ARGB8888SSE2, COPY_ALPHA},
+#endif
 #if SDL_ARM_SIMD_BLITTERS
     {0x00000F00, 0x000000F0, 0x0000000F, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
      BLIT_FEATURE_HAS_ARM_SIMD, Blit_RGB444_RGB888ARMSIMD, NO_ALPHA | COPY_ALPHA},
 #endif
-#if SDL_HAVE_BLIT_N_RGB565
     {0x0000F800, 0x000007E0, 0x0000001F, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
-     0, Blit_RGB565_ARGB8888, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+     0, Blit_RGB565_ARGB8888Rows, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
     {0x0000F800, 0x000007E0, 0x0000001F, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
-     0, Blit_RGB565_ABGR8888, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+     0, Blit_RGB565_ABGR8888Rows, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+#if SDL_HAVE_BLIT_N_RGB565
     {0x0000F800, 0x000007E0, 0x0000001F, 4, 0xFF000000, 0x00FF0000, 0x0000FF00,
      0, Blit_RGB565_RGBA8888, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
     {0x0000F800, 0x000007E0, 0x0000001F, 4, 0x0000FF00, 0x00FF0000, 0xFF000000,
      0, Blit_RGB565_BGRA8888, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
 #endif
+    {0x00000F00, 0x000000F0, 0x0000000F, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     0, Blit_ARGB4444_ARGB8888, COPY_ALPHA},
     {0x00007C00, 0x000003E0, 0x0000001F, 2, 0x00007C00, 0x000003E0, 0x0000001F,
      0, Blit_RGB555_ARGB1555, SET_ALPHA},
     {0x0000001F, 0x000003E0, 0x00007C00, 2, 0x0000001F, 0x000003E0, 0x00007C00,
@@ -3291,6 +3406,22 @@ static const struct blit_table normal_blit_4[] = {
     {0x00000000, 0x00000000, 0x00000000, 2, 0x0000F800, 0x000007E0, 0x0000001F,
      BLIT_FEATURE_HAS_ALTIVEC, Blit_RGB888_RGB565Altivec, NO_ALPHA},
 #endif
+#if HAVE_NEON_INTRINSICS
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 2, 0x0000F800, 0x000007E0, 0x0000001F,
+     BLIT_FEATURE_HAS_NEON, Blit_ARGB8888_RGB565NEON, NO_ALPHA},
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 2, 0x0000F800, 0x000007E0, 0x0000001F,
+     BLIT_FEATURE_HAS_NEON, Blit_ABGR8888_RGB565NEON, NO_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 2, 0x00000F00, 0x000000F0, 0x0000000F,
+     BLIT_FEATURE_HAS_NEON, Blit_ARGB8888_ARGB4444NEON, COPY_ALPHA},
+#endif
+#if HAVE_SSE2_INTRINSICS
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 2, 0x0000F800, 0x000007E0, 0x0000001F,
+     BLIT_FEATURE_HAS_SSE2, Blit_ARGB8888_RGB565SSE2, NO_ALPHA},
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 2, 0x0000F800, 0x000007E0, 0x0000001F,
+     BLIT_FEATURE_HAS_SSE2, Blit_ABGR8888_RGB565SSE2, NO_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 2, 0x00000F00, 0x000000F0, 0x0000000F,
+     BLIT_FEATURE_HAS_SSE2, Blit_ARGB8888_ARGB4444SSE2, COPY_ALPHA},
+#endif
 #if SDL_ARM_SIMD_BLITTERS
     {0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
      BLIT_FEATURE_HAS_ARM_SIMD, Blit_BGR888_RGB888ARMSIMD, NO_ALPHA | COPY_ALPHA },
@@ -3321,6 +3452,10 @@ static const struct blit_table normal_blit_4[] = {
     /* RGB 888 and RGB 565 */
     {0x00FF0000, 0x0000FF00, 0x000000FF, 2, 0x0000F800, 0x000007E0, 0x0000001F,
      0, Blit_RGB888_RGB565, NO_ALPHA},
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 2, 0x0000F800, 0x000007E0, 0x0000001F,
+     0, Blit_ABGR8888_RGB565, NO_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 2, 0x00000F00, 0x000000F0, 0x0000000F,
+     0, Blit_ARGB8888_ARGB4444, COPY_ALPHA},
     {0x00FF0000, 0x0000FF00, 0x000000FF, 2, 0x00007C00, 0x000003E0, 0x0000001F,
      0, Blit_RGB888_RGB555, NO_ALPHA},
     /* Default for 32-bit RGB source, used if no other blitter matches */
@@ -3331,6 +3466,73 @@ static const struct blit_table *const normal_blit[] = {
     normal_blit_1, normal_blit_2, normal_blit_3, normal_blit_4
 };
 
+/* Blitters for SDL_ConvertPixels() to call directly, without setting up
+   surfaces.  They only use the pixel pointers, skips and size of the blit. */
+struct convert_blit_table
+{
+    Uint32 src_format;
+    Uint32 dst_format;
+    enum blit_features blit_features;
+    SDL_BlitFunc blitfunc;
+};
+
+#define CONVERT_BLITS(features, suffix) \
+    {SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB8888, features, Blit_RGB565_ARGB8888##suffix}, \
+    {SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB888, features, Blit_RGB565_ARGB8888##suffix}, \
+    {SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ABGR8888, features, Blit_RGB565_ABGR8888##suffix}, \
+    {SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_BGR888, features, Blit_RGB565_ABGR8888##suffix}, \
+    {SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565, features, Blit_ARGB8888_RGB565##suffix}, \
+    {SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB565, features, Blit_ARGB8888_RGB565##suffix}, \
+    {SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB565, features, Blit_ABGR8888_RGB565##suffix}, \
+    {SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB565, features, Blit_ABGR8888_RGB565##suffix}, \
+    {SDL_PIXELFORMAT_ARGB4444, SDL_PIXELFORMAT_ARGB8888, features, Blit_ARGB4444_ARGB8888##suffix}, \
+    {SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB4444, features, Blit_ARGB8888_ARGB4444##suffix},
+
+static const struct convert_blit_table convert_blit[] = {
+#if HAVE_NEON_INTRINSICS
+    CONVERT_BLITS(BLIT_FEATURE_HAS_NEON, NEON)
+#endif
+#if HAVE_SSE2_INTRINSICS
+    CONVERT_BLITS(BLIT_FEATURE_HAS_SSE2, SSE2)
+#endif
+    {SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB8888, 0, Blit_RGB565_ARGB8888Rows},
+    {SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB888, 0, Blit_RGB565_ARGB8888Rows},
+    {SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ABGR8888, 0, Blit_RGB565_ABGR8888Rows},
+    {SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_BGR888, 0, Blit_RGB565_ABGR8888Rows},
+    {SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565, 0, Blit_RGB888_RGB565},
+    {SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB565, 0, Blit_RGB888_RGB565},
+    {SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB565, 0, Blit_ABGR8888_RGB565},
+    {SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB565, 0, Blit_ABGR8888_RGB565},
+    {SDL_PIXELFORMAT_ARGB4444, SDL_PIXELFORMAT_ARGB8888, 0, Blit_ARGB4444_ARGB8888},
+    {SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB4444, 0, Blit_ARGB8888_ARGB4444},
+    {SDL_PIXELFORMAT_UNKNOWN, SDL_PIXELFORMAT_UNKNOWN, 0, NULL}
+};
+
+#undef CONVERT_BLITS
+
+SDL_BlitFunc
+SDL_CalculateConvertBlitN(Uint32 src_format, Uint32 dst_format)
+{
+    const struct convert_blit_table *entry;
+    int features = -1;
+
+    for (entry = convert_blit; entry->blitfunc; ++entry) {
+        if (entry->src_format != src_format || entry->dst_format != dst_format) {
+            continue;
+        }
+        if (entry->blit_features) {
+            if (features < 0) {
+                features = GetBlitFeatures();
+            }
+            if ((entry->blit_features & features) != entry->blit_features) {
+                continue;
+            }
+        }
+        return entry->blitfunc;
+    }
+    return NULL;
+}
+
 /* Mask matches table, or table entry is zero */
 #define MASKOK(x, y) (((x) == (y)) || ((y) == 0x00000000))
 
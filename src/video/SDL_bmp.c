@@ -39,6 +39,9 @@
 
 #define SAVE_32BIT_BMP
 
+/* Uncompressed pixel rows are read from the stream in chunks of about this size */
+#define BMP_READ_CHUNK  (64 * 1024)
+
 /* Compression encodings for BMP files */
 #ifndef BI_RGB
 #define BI_RGB      0
@@ -168,21 +171,84 @@ static void CorrectAlphaChannel(SDL_Surface *surface)
     }
 }
 
+/* Unpack one row of the file into a row of the surface, returns SDL_FALSE on error */
+static SDL_bool DecodeBMPRow(Uint8 *bits, const Uint8 *row, int width, int rowBytes,
+                             int ExpandBMP, int biBitCount, Uint32 biClrUsed)
+{
+    int i;
+
+    if (ExpandBMP) {
+        Uint8 pixel = 0;
+        int shift = (8 - ExpandBMP);
+        for (i = 0; i < width; ++i) {
+            if (i % (8 / ExpandBMP) == 0) {
+                pixel = *row++;
+            }
+            bits[i] = (pixel >> shift);
+            pixel <<= ExpandBMP;
+        }
+    } else {
+        SDL_memcpy(bits, row, rowBytes);
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+        /* Byte-swap the pixels if needed. Note that the 24bpp
+           case has already been taken care of above. */
+        switch (biBitCount) {
+        case 15:
+        case 16:{
+                Uint16 *pix = (Uint16 *) bits;
+                for (i = 0; i < width; i++)
+                    pix[i] = SDL_Swap16(pix[i]);
+                break;
+            }
+
+        case 32:{
+                Uint32 *pix = (Uint32 *) bits;
+                for (i = 0; i < width; i++)
+                    pix[i] = SDL_Swap32(pix[i]);
+                break;
+            }
+        }
+#endif
+    }
+
+    /* biClrUsed is zero unless the image has a palette */
+    if (biBitCount == 8 && biClrUsed < 256) {
+        for (i = 0; i < width; ++i) {
+            if (bits[i] >= biClrUsed) {
+                SDL_SetError("A BMP image contains a pixel with a color out of the palette");
+                return SDL_FALSE;
+            }
+        }
+    }
+    return SDL_TRUE;
+}
+
 SDL_Surface *
 SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
+{
+    return SDL_LoadBMPFormat_RW(src, freesrc, SDL_PIXELFORMAT_UNKNOWN);
+}
+
+SDL_Surface *
+SDL_LoadBMPFormat_RW(SDL_RWops * src, int freesrc, Uint32 format)
 {
     SDL_bool was_error;
     Sint64 fp_offset = 0;
     int bmpPitch;
-    int i, pad;
+    int i, rowBytes;
+    int stripRows, fileRow, rows, y;
+    size_t got;
     SDL_Surface *surface;
+    SDL_Surface *result = NULL;
+    SDL_Rect srcrect, dstrect;
+    Uint8 *rowbuf = NULL;
+    Uint8 colors[256 * 4];
     Uint32 Rmask = 0;
     Uint32 Gmask = 0;
     Uint32 Bmask = 0;
     Uint32 Amask = 0;
     SDL_Palette *palette;
     Uint8 *bits;
-    Uint8 *top, *end;
     SDL_bool topDown;
     int ExpandBMP;
     SDL_bool haveRGBMasks = SDL_FALSE;
@@ -394,18 +460,50 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
         break;
     }
 
+    /* Decide how the pixels get into the result. Converting strip by strip
+       needs each row to be final once read, which rules out RLE images and
+       alpha that may have to be corrected after the last row. Indexed
+       targets go through SDL_ConvertSurfaceFormat() for its palette rules. */
+    if (format == SDL_PIXELFORMAT_UNKNOWN ||
+        format == SDL_MasksToPixelFormatEnum(biBitCount, Rmask, Gmask, Bmask, Amask)) {
+        format = SDL_PIXELFORMAT_UNKNOWN;
+        stripRows = biHeight;
+    } else if (biCompression == BI_RLE4 || biCompression == BI_RLE8 ||
+               (correctAlpha && SDL_ISPIXELFORMAT_ALPHA(format)) ||
+               SDL_ISPIXELFORMAT_INDEXED(format) || SDL_ISPIXELFORMAT_FOURCC(format)) {
+        stripRows = biHeight;
+    } else {
+        /* The strip holds about the same number of bytes as a read chunk */
+        stripRows = BMP_READ_CHUNK / ((biBitCount + 7) / 8) / biWidth;
+        stripRows = SDL_clamp(stripRows, 1, biHeight);
+        result = SDL_CreateRGBSurfaceWithFormat(0, biWidth, biHeight, 0, format);
+        if (result == NULL) {
+            was_error = SDL_TRUE;
+            goto done;
+        }
+    }
+
     /* Create a compatible surface, note that the colors are RGB ordered */
     surface =
-        SDL_CreateRGBSurface(0, biWidth, biHeight, biBitCount, Rmask, Gmask,
+        SDL_CreateRGBSurface(0, biWidth, stripRows, biBitCount, Rmask, Gmask,
                              Bmask, Amask);
     if (surface == NULL) {
         was_error = SDL_TRUE;
         goto done;
     }
 
+    if (result) {
+        /* The strip is copied into the result as is, alpha included, and the
+           result blends the way SDL_ConvertSurface() would have set it up */
+        SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+        SDL_SetSurfaceBlendMode(result, (Amask && result->format->Amask) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+    }
+
     /* Load the palette, if any */
     palette = (surface->format)->palette;
     if (palette) {
+        int colorSize = (biSize == 12) ? 3 : 4;
+
         if (SDL_RWseek(src, fp_offset+14+biSize, RW_SEEK_SET) < 0) {
             SDL_Error(SDL_EFSEEK);
             was_error = SDL_TRUE;
@@ -431,28 +529,23 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
             }
         }
 
-       if (biSize == 12) {
-            for (i = 0; i < (int) biClrUsed; ++i) {
-                SDL_RWread(src, &palette->colors[i].b, 1, 1);
-                SDL_RWread(src, &palette->colors[i].g, 1, 1);
-                SDL_RWread(src, &palette->colors[i].r, 1, 1);
-                palette->colors[i].a = SDL_ALPHA_OPAQUE;
-            }
-        } else {
-            for (i = 0; i < (int) biClrUsed; ++i) {
-                SDL_RWread(src, &palette->colors[i].b, 1, 1);
-                SDL_RWread(src, &palette->colors[i].g, 1, 1);
-                SDL_RWread(src, &palette->colors[i].r, 1, 1);
-                SDL_RWread(src, &palette->colors[i].a, 1, 1);
-
-                /* According to Microsoft documentation, the fourth element
-                   is reserved and must be zero, so we shouldn't treat it as
-                   alpha.
-                */
-                palette->colors[i].a = SDL_ALPHA_OPAQUE;
-            }
+        /* Short reads leave the remaining entries black, as they always have */
+        SDL_zeroa(colors);
+        SDL_RWread(src, colors, colorSize, biClrUsed);
+        for (i = 0; i < (int) biClrUsed; ++i) {
+            palette->colors[i].b = colors[i * colorSize + 0];
+            palette->colors[i].g = colors[i * colorSize + 1];
+            palette->colors[i].r = colors[i * colorSize + 2];
+
+            /* According to Microsoft documentation, the fourth element
+               is reserved and must be zero, so we shouldn't treat it as
+               alpha.
+            */
+            palette->colors[i].a = SDL_ALPHA_OPAQUE;
         }
         palette->ncolors = biClrUsed;
+    } else {
+        biClrUsed = 0;
     }
 
     /* Read the surface pixels.  Note that the bmp image is upside down */
@@ -464,123 +557,101 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
     if ((biCompression == BI_RLE4) || (biCompression == BI_RLE8)) {
         was_error = readRlePixels(surface, src, biCompression == BI_RLE8);
         if (was_error) SDL_Error(SDL_EFREAD);
-        goto done;
+        goto convert;
     }
-    top = (Uint8 *)surface->pixels;
-    end = (Uint8 *)surface->pixels+(surface->h*surface->pitch);
-    switch (ExpandBMP) {
-    case 1:
-        bmpPitch = (biWidth + 7) >> 3;
-        pad = (((bmpPitch) % 4) ? (4 - ((bmpPitch) % 4)) : 0);
-        break;
-    case 2:
-        bmpPitch = (biWidth + 3) >> 2;
-        pad = (((bmpPitch) % 4) ? (4 - ((bmpPitch) % 4)) : 0);
-        break;
-    case 4:
-        bmpPitch = (biWidth + 1) >> 1;
-        pad = (((bmpPitch) % 4) ? (4 - ((bmpPitch) % 4)) : 0);
-        break;
-    default:
-        pad = ((surface->pitch % 4) ? (4 - (surface->pitch % 4)) : 0);
-        break;
-    }
-    if (topDown) {
-        bits = top;
+    if (ExpandBMP) {
+        rowBytes = (biWidth * ExpandBMP + 7) >> 3;
     } else {
-        bits = end - surface->pitch;
-    }
-    while (bits >= top && bits < end) {
-        switch (ExpandBMP) {
-        case 1:
-        case 2:
-        case 4:{
-                Uint8 pixel = 0;
-                int shift = (8 - ExpandBMP);
-                for (i = 0; i < surface->w; ++i) {
-                    if (i % (8 / ExpandBMP) == 0) {
-                        if (!SDL_RWread(src, &pixel, 1, 1)) {
-                            SDL_Error(SDL_EFREAD);
-                            was_error = SDL_TRUE;
-                            goto done;
-                        }
-                    }
-                    bits[i] = (pixel >> shift);
-                    if (bits[i] >= biClrUsed) {
-                        SDL_SetError("A BMP image contains a pixel with a color out of the palette");
-                        was_error = SDL_TRUE;
-                        goto done;
-                    }
-                    pixel <<= ExpandBMP;
-                }
-            }
-            break;
+        rowBytes = biWidth * surface->format->BytesPerPixel;
+    }
+    /* Rows are padded to a multiple of 4 bytes in the file */
+    bmpPitch = (rowBytes + 3) & ~3;
 
-        default:
-            if (SDL_RWread(src, bits, 1, surface->pitch) != surface->pitch) {
-                SDL_Error(SDL_EFREAD);
+    rowbuf = (Uint8 *)SDL_malloc((size_t)SDL_max(BMP_READ_CHUNK / bmpPitch, 1) * bmpPitch);
+    if (rowbuf == NULL) {
+        SDL_OutOfMemory();
+        was_error = SDL_TRUE;
+        goto done;
+    }
+
+    /* Read a chunk of rows at a time, in file order, unpacking each row where
+       it belongs in the strip. Bottom-up images fill the strip from the
+       bottom. Once a strip is full it is converted into the result with the
+       blitter. Without a conversion the strip is the whole image. */
+    fileRow = 0;
+    while (fileRow < biHeight) {
+        const Uint8 *row;
+
+        rows = SDL_max(BMP_READ_CHUNK / bmpPitch, 1);
+        rows = SDL_min(rows, biHeight - fileRow);
+        rows = SDL_min(rows, stripRows - (fileRow % stripRows));
+
+        got = SDL_RWread(src, rowbuf, 1, (size_t)rows * bmpPitch);
+        /* The padding of the last row is allowed to be missing */
+        if (got < (size_t)(rows - 1) * bmpPitch + rowBytes) {
+            SDL_Error(SDL_EFREAD);
+            was_error = SDL_TRUE;
+            goto done;
+        }
+
+        row = rowbuf;
+        for (i = 0; i < rows; ++i, ++fileRow, row += bmpPitch) {
+            y = fileRow % stripRows;
+            if (!topDown) {
+                y = stripRows - 1 - y;
+            }
+            bits = (Uint8 *)surface->pixels + y * surface->pitch;
+            if (!DecodeBMPRow(bits, row, biWidth, rowBytes, ExpandBMP, biBitCount, biClrUsed)) {
                 was_error = SDL_TRUE;
                 goto done;
             }
-            if (biBitCount == 8 && palette && biClrUsed < (1u << biBitCount)) {
-                for (i = 0; i < surface->w; ++i) {
-                    if (bits[i] >= biClrUsed) {
-                        SDL_SetError("A BMP image contains a pixel with a color out of the palette");
-                        was_error = SDL_TRUE;
-                        goto done;
-                    }
-                }
-            }
-#if SDL_BYTEORDER == SDL_BIG_ENDIAN
-            /* Byte-swap the pixels if needed. Note that the 24bpp
-               case has already been taken care of above. */
-            switch (biBitCount) {
-            case 15:
-            case 16:{
-                    Uint16 *pix = (Uint16 *) bits;
-                    for (i = 0; i < surface->w; i++)
-                        pix[i] = SDL_Swap16(pix[i]);
-                    break;
-                }
+        }
 
-            case 32:{
-                    Uint32 *pix = (Uint32 *) bits;
-                    for (i = 0; i < surface->w; i++)
-                        pix[i] = SDL_Swap32(pix[i]);
-                    break;
-                }
+        if (result && (fileRow == biHeight || (fileRow % stripRows) == 0)) {
+            int count = (fileRow - 1) % stripRows + 1;
+            if (topDown) {
+                srcrect.y = 0;
+                dstrect.y = fileRow - count;
+            } else {
+                srcrect.y = stripRows - count;
+                dstrect.y = biHeight - fileRow;
             }
-#endif
-            break;
-        }
-        /* Skip padding bytes, ugh */
-        if (pad) {
-            Uint8 padbyte;
-            for (i = 0; i < pad; ++i) {
-                SDL_RWread(src, &padbyte, 1, 1);
+            srcrect.x = dstrect.x = 0;
+            srcrect.w = dstrect.w = biWidth;
+            srcrect.h = dstrect.h = count;
+            if (SDL_LowerBlit(surface, &srcrect, result, &dstrect) < 0) {
+                was_error = SDL_TRUE;
+                goto done;
             }
         }
-        if (topDown) {
-            bits += surface->pitch;
-        } else {
-            bits -= surface->pitch;
-        }
     }
-    if (correctAlpha) {
+    if (correctAlpha && !result) {
         CorrectAlphaChannel(surface);
     }
+  convert:
+    if (!was_error && !result) {
+        if (format == SDL_PIXELFORMAT_UNKNOWN) {
+            result = surface;
+            surface = NULL;
+        } else {
+            result = SDL_ConvertSurfaceFormat(surface, format, 0);
+            was_error = (result == NULL);
+        }
+    }
   done:
+    SDL_free(rowbuf);
+    SDL_FreeSurface(surface);
     if (was_error) {
         if (src) {
             SDL_RWseek(src, fp_offset, RW_SEEK_SET);
         }
-        SDL_FreeSurface(surface);
-        surface = NULL;
+        SDL_FreeSurface(result);
+        result = NULL;
     }
     if (freesrc && src) {
         SDL_RWclose(src);
     }
-    return (surface);
+    return (result);
 }
 
 int
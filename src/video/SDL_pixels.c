@@ -499,7 +499,72 @@ SDL_MasksToPixelFormatEnum(int bpp, Uint32 Rmask, Uint32 Gmask, Uint32 Bmask,
     return SDL_PIXELFORMAT_UNKNOWN;
 }
 
-static SDL_PixelFormat *formats;
+/* Every non-indexed format is described once, at compile time, so looking one
+   up needs neither an allocation nor a lock.  The entries are sorted by format
+   value and never freed; a palette can't be attached to them.
+ */
+#define STATIC_FORMAT(format, bpp, Rm, Gm, Bm, Am, Rl, Gl, Bl, Al, Rs, Gs, Bs, As) \
+    { format, NULL, bpp, ((bpp) + 7) / 8, { 0, 0 }, Rm, Gm, Bm, Am, Rl, Gl, Bl, Al, Rs, Gs, Bs, As, 1, NULL }
+
+static SDL_PixelFormat static_formats[] = {
+    STATIC_FORMAT(SDL_PIXELFORMAT_RGB332, 8, 0xE0, 0x1C, 0x03, 0, 5, 5, 6, 8, 5, 2, 0, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_XRGB4444, 12, 0x0F00, 0x00F0, 0x000F, 0, 4, 4, 4, 8, 8, 4, 0, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_XRGB1555, 15, 0x7C00, 0x03E0, 0x001F, 0, 3, 3, 3, 8, 10, 5, 0, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_RGB565, 16, 0xF800, 0x07E0, 0x001F, 0, 3, 2, 3, 8, 11, 5, 0, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_ARGB4444, 16, 0x0F00, 0x00F0, 0x000F, 0xF000, 4, 4, 4, 4, 8, 4, 0, 12),
+    STATIC_FORMAT(SDL_PIXELFORMAT_ARGB1555, 16, 0x7C00, 0x03E0, 0x001F, 0x8000, 3, 3, 3, 7, 10, 5, 0, 15),
+    STATIC_FORMAT(SDL_PIXELFORMAT_RGBA4444, 16, 0xF000, 0x0F00, 0x00F0, 0x000F, 4, 4, 4, 4, 12, 8, 4, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_RGBA5551, 16, 0xF800, 0x07C0, 0x003E, 0x0001, 3, 3, 3, 7, 11, 6, 1, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_XBGR4444, 12, 0x000F, 0x00F0, 0x0F00, 0, 4, 4, 4, 8, 0, 4, 8, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_XBGR1555, 15, 0x001F, 0x03E0, 0x7C00, 0, 3, 3, 3, 8, 0, 5, 10, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_BGR565, 16, 0x001F, 0x07E0, 0xF800, 0, 3, 2, 3, 8, 0, 5, 11, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_ABGR4444, 16, 0x000F, 0x00F0, 0x0F00, 0xF000, 4, 4, 4, 4, 0, 4, 8, 12),
+    STATIC_FORMAT(SDL_PIXELFORMAT_ABGR1555, 16, 0x001F, 0x03E0, 0x7C00, 0x8000, 3, 3, 3, 7, 0, 5, 10, 15),
+    STATIC_FORMAT(SDL_PIXELFORMAT_BGRA4444, 16, 0x00F0, 0x0F00, 0xF000, 0x000F, 4, 4, 4, 4, 4, 8, 12, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_BGRA5551, 16, 0x003E, 0x07C0, 0xF800, 0x0001, 3, 3, 3, 7, 1, 6, 11, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_XRGB8888, 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0, 0, 0, 0, 8, 16, 8, 0, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_RGBX8888, 32, 0xFF000000, 0x00FF0000, 0x0000FF00, 0, 0, 0, 0, 8, 24, 16, 8, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_ARGB8888, 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000, 0, 0, 0, 0, 16, 8, 0, 24),
+    STATIC_FORMAT(SDL_PIXELFORMAT_ARGB2101010, 32, 0x3FF00000, 0x000FFC00, 0x000003FF, 0xC0000000, (Uint8)(8 - 10), (Uint8)(8 - 10), (Uint8)(8 - 10), 6, 20, 10, 0, 30),
+    STATIC_FORMAT(SDL_PIXELFORMAT_RGBA8888, 32, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF, 0, 0, 0, 0, 24, 16, 8, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_XBGR8888, 32, 0x000000FF, 0x0000FF00, 0x00FF0000, 0, 0, 0, 0, 8, 0, 8, 16, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_BGRX8888, 32, 0x0000FF00, 0x00FF0000, 0xFF000000, 0, 0, 0, 0, 8, 8, 16, 24, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_ABGR8888, 32, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000, 0, 0, 0, 0, 0, 8, 16, 24),
+    STATIC_FORMAT(SDL_PIXELFORMAT_BGRA8888, 32, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF, 0, 0, 0, 0, 8, 16, 24, 0),
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+    STATIC_FORMAT(SDL_PIXELFORMAT_RGB24, 24, 0xFF0000, 0x00FF00, 0x0000FF, 0, 0, 0, 0, 8, 16, 8, 0, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_BGR24, 24, 0x0000FF, 0x00FF00, 0xFF0000, 0, 0, 0, 0, 8, 0, 8, 16, 0),
+#else
+    STATIC_FORMAT(SDL_PIXELFORMAT_RGB24, 24, 0x0000FF, 0x00FF00, 0xFF0000, 0, 0, 0, 0, 8, 0, 8, 16, 0),
+    STATIC_FORMAT(SDL_PIXELFORMAT_BGR24, 24, 0xFF0000, 0x00FF00, 0x0000FF, 0, 0, 0, 0, 8, 16, 8, 0, 0),
+#endif
+};
+
+#undef STATIC_FORMAT
+
+static SDL_PixelFormat *
+SDL_GetStaticFormat(Uint32 pixel_format)
+{
+    int lo = 0;
+    int hi = SDL_arraysize(static_formats) - 1;
+
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        Uint32 format = static_formats[mid].format;
+        if (format == pixel_format) {
+            return &static_formats[mid];
+        } else if (format < pixel_format) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return NULL;
+}
+
+#define SDL_IsStaticFormat(format) \
+    ((format) >= &static_formats[0] && (format) < &static_formats[SDL_arraysize(static_formats)])
+
 static SDL_SpinLock formats_lock = 0;
 
 SDL_PixelFormat *
@@ -507,39 +572,24 @@ SDL_AllocFormat(Uint32 pixel_format)
 {
     SDL_PixelFormat *format;
 
-    SDL_AtomicLock(&formats_lock);
-
-    /* Look it up in our list of previously allocated formats */
-    for (format = formats; format; format = format->next) {
-        if (pixel_format == format->format) {
-            ++format->refcount;
-            SDL_AtomicUnlock(&formats_lock);
-            return format;
-        }
+    /* RGB formats are shared, immutable and never freed */
+    format = SDL_GetStaticFormat(pixel_format);
+    if (format) {
+        return format;
     }
 
     /* Allocate an empty pixel format structure, and initialize it */
     format = SDL_malloc(sizeof(*format));
     if (format == NULL) {
-        SDL_AtomicUnlock(&formats_lock);
         SDL_OutOfMemory();
         return NULL;
     }
     if (SDL_InitFormat(format, pixel_format) < 0) {
-        SDL_AtomicUnlock(&formats_lock);
         SDL_free(format);
         SDL_InvalidParamError("format");
         return NULL;
     }
 
-    if (!SDL_ISPIXELFORMAT_INDEXED(pixel_format)) {
-        /* Cache the RGB formats */
-        format->next = formats;
-        formats = format;
-    }
-
-    SDL_AtomicUnlock(&formats_lock);
-
     return format;
 }
 
@@ -611,13 +661,15 @@ SDL_InitFormat(SDL_PixelFormat * format, Uint32 pixel_format)
 void
 SDL_FreeFormat(SDL_PixelFormat *format)
 {
-    SDL_PixelFormat *prev;
-
     if (!format) {
         SDL_InvalidParamError("format");
         return;
     }
 
+    if (SDL_IsStaticFormat(format)) {
+        return;
+    }
+
     SDL_AtomicLock(&formats_lock);
 
     if (--format->refcount > 0) {
@@ -625,18 +677,6 @@ SDL_FreeFormat(SDL_PixelFormat *format)
         return;
     }
 
-    /* Remove this format from our list */
-    if (format == formats) {
-        formats = format->next;
-    } else if (formats) {
-        for (prev = formats; prev->next; prev = prev->next) {
-            if (prev->next == format) {
-                prev->next = format->next;
-                break;
-            }
-        }
-    }
-
     SDL_AtomicUnlock(&formats_lock);
 
     if (format->palette) {
@@ -687,6 +727,10 @@ SDL_SetPixelFormatPalette(SDL_PixelFormat * format, SDL_Palette *palette)
         return SDL_SetError("SDL_SetPixelFormatPalette() passed a palette that doesn't match the format");
     }
 
+    if (palette && SDL_IsStaticFormat(format)) {
+        return SDL_SetError("SDL_SetPixelFormatPalette() passed a shared RGB format");
+    }
+
     if (format->palette == palette) {
         return 0;
     }
@@ -880,6 +924,50 @@ SDL_MapRGBA(const SDL_PixelFormat * format, Uint8 r, Uint8 g, Uint8 b,
     }
 }
 
+/* Map a run of colors, looking at the format once */
+int
+SDL_MapColors(const SDL_PixelFormat * format, const SDL_Color * colors,
+              Uint32 * pixels, int count)
+{
+    int i;
+
+    if (!format) {
+        return SDL_InvalidParamError("format");
+    }
+    if (count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+    if (count > 0 && (!colors || !pixels)) {
+        return SDL_InvalidParamError(!colors ? "colors" : "pixels");
+    }
+
+    if (format->palette == NULL) {
+        const Uint8 Rloss = format->Rloss, Rshift = format->Rshift;
+        const Uint8 Gloss = format->Gloss, Gshift = format->Gshift;
+        const Uint8 Bloss = format->Bloss, Bshift = format->Bshift;
+        const Uint8 Aloss = format->Aloss, Ashift = format->Ashift;
+        const Uint32 Amask = format->Amask;
+
+        for (i = 0; i < count; ++i) {
+            pixels[i] = (colors[i].r >> Rloss) << Rshift
+                | (colors[i].g >> Gloss) << Gshift
+                | (colors[i].b >> Bloss) << Bshift
+                | ((Uint32)(colors[i].a >> Aloss) << Ashift & Amask);
+        }
+    } else {
+        for (i = 0; i < count; ++i) {
+            /* Runs of one color are common, skip the palette search for them */
+            if (i > 0 && colors[i].r == colors[i - 1].r && colors[i].g == colors[i - 1].g &&
+                colors[i].b == colors[i - 1].b && colors[i].a == colors[i - 1].a) {
+                pixels[i] = pixels[i - 1];
+            } else {
+                pixels[i] = SDL_FindColor(format->palette, colors[i].r, colors[i].g, colors[i].b, colors[i].a);
+            }
+        }
+    }
+    return 0;
+}
+
 void
 SDL_GetRGB(Uint32 pixel, const SDL_PixelFormat * format, Uint8 * r, Uint8 * g,
            Uint8 * b)
@@ -963,31 +1051,57 @@ Map1to1(SDL_Palette * src, SDL_Palette * dst, int *identical)
     return (map);
 }
 
+/* A Map1toN() table is followed by a copy of the palette colors it was built
+   from, so that palette animation only has to redo the entries that changed.
+ */
+#define MAP1TON_BPP(dst)            ((dst)->BytesPerPixel == 3 ? 4 : (dst)->BytesPerPixel)
+#define MAP1TON_COLORS(map, bpp)    ((SDL_Color *)((map) + 256 * (bpp)))
+
+/* Update the entries of a Palette to BitField map whose color changed */
+static void
+Map1toNUpdate(Uint8 * map, SDL_Palette * pal, Uint8 Rmod, Uint8 Gmod, Uint8 Bmod, Uint8 Amod,
+              SDL_PixelFormat * dst)
+{
+    int i;
+    int bpp = MAP1TON_BPP(dst);
+    SDL_Color *colors = MAP1TON_COLORS(map, bpp);
+    int ncolors = SDL_min(pal->ncolors, 256);
+
+    /* We memory copy to the pixel map so the endianness is preserved */
+    for (i = 0; i < ncolors; ++i) {
+        const SDL_Color *color = &pal->colors[i];
+        Uint8 R, G, B, A;
+
+        if (color->r == colors[i].r && color->g == colors[i].g &&
+            color->b == colors[i].b && color->a == colors[i].a) {
+            continue;
+        }
+        colors[i] = *color;
+
+        R = (Uint8) ((color->r * Rmod) / 255);
+        G = (Uint8) ((color->g * Gmod) / 255);
+        B = (Uint8) ((color->b * Bmod) / 255);
+        A = (Uint8) ((color->a * Amod) / 255);
+        ASSEMBLE_RGBA(&map[i * bpp], dst->BytesPerPixel, dst, (Uint32)R, (Uint32)G, (Uint32)B, (Uint32)A);
+    }
+}
+
 /* Map from Palette to BitField */
 static Uint8 *
 Map1toN(SDL_PixelFormat * src, Uint8 Rmod, Uint8 Gmod, Uint8 Bmod, Uint8 Amod,
         SDL_PixelFormat * dst)
 {
     Uint8 *map;
-    int i;
     int bpp;
-    SDL_Palette *pal = src->palette;
 
-    bpp = ((dst->BytesPerPixel == 3) ? 4 : dst->BytesPerPixel);
-    map = (Uint8 *) SDL_calloc(256, bpp);
+    /* A zeroed entry matches a zeroed color, so those are already right */
+    bpp = MAP1TON_BPP(dst);
+    map = (Uint8 *) SDL_calloc(256, bpp + sizeof(SDL_Color));
     if (map == NULL) {
         SDL_OutOfMemory();
         return (NULL);
     }
-
-    /* We memory copy to the pixel map so the endianness is preserved */
-    for (i = 0; i < pal->ncolors; ++i) {
-        Uint8 R = (Uint8) ((pal->colors[i].r * Rmod) / 255);
-        Uint8 G = (Uint8) ((pal->colors[i].g * Gmod) / 255);
-        Uint8 B = (Uint8) ((pal->colors[i].b * Bmod) / 255);
-        Uint8 A = (Uint8) ((pal->colors[i].a * Amod) / 255);
-        ASSEMBLE_RGBA(&map[i * bpp], dst->BytesPerPixel, dst, (Uint32)R, (Uint32)G, (Uint32)B, (Uint32)A);
-    }
+    Map1toNUpdate(map, src->palette, Rmod, Gmod, Bmod, Amod, dst);
     return (map);
 }
 
@@ -1141,6 +1255,29 @@ SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst)
     return (SDL_CalculateBlit(src));
 }
 
+SDL_bool
+SDL_RefreshMapPalette(SDL_Surface * src)
+{
+    SDL_BlitMap *map = src->map;
+    SDL_PixelFormat *srcfmt = src->format;
+
+    /* Only a Palette --> BitField table can be patched in place */
+    if (!map->dst || !map->info.table || !srcfmt->palette ||
+        SDL_ISPIXELFORMAT_INDEXED(map->dst->format->format)) {
+        return SDL_FALSE;
+    }
+#if SDL_HAVE_RLE
+    if ((src->flags & SDL_RLEACCEL) == SDL_RLEACCEL) {
+        return SDL_FALSE;
+    }
+#endif
+
+    Map1toNUpdate(map->info.table, srcfmt->palette, map->info.r, map->info.g,
+                  map->info.b, map->info.a, map->dst->format);
+    map->src_palette_version = srcfmt->palette->version;
+    return SDL_TRUE;
+}
+
 void
 SDL_FreeBlitMap(SDL_BlitMap * map)
 {
@@ -35,6 +35,7 @@ extern int SDL_InitFormat(SDL_PixelFormat * format, Uint32 pixel_format);
 extern SDL_BlitMap *SDL_AllocBlitMap(void);
 extern void SDL_InvalidateMap(SDL_BlitMap * map);
 extern int SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst);
+extern SDL_bool SDL_RefreshMapPalette(SDL_Surface * src);
 extern void SDL_FreeBlitMap(SDL_BlitMap * map);
 
 extern void SDL_InvalidateAllBlitMap(SDL_Surface *surface);
@@ -44,6 +45,19 @@ extern void SDL_DitherColors(SDL_Color * colors, int bpp);
 extern Uint8 SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
 extern void SDL_DetectPalette(SDL_Palette *pal, SDL_bool *is_opaque, SDL_bool *has_alpha_channel);
 
+/* SDL_MapRGBA() without the call, for per-pixel use in inner loops */
+SDL_FORCE_INLINE Uint32
+SDL_InlineMapRGBA(const SDL_PixelFormat * format, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    if (format->palette == NULL) {
+        return (r >> format->Rloss) << format->Rshift
+            | (g >> format->Gloss) << format->Gshift
+            | (b >> format->Bloss) << format->Bshift
+            | ((Uint32)(a >> format->Aloss) << format->Ashift & format->Amask);
+    }
+    return SDL_FindColor(format->palette, r, g, b, a);
+}
+
 #endif /* SDL_pixels_c_h_ */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -25,8 +25,17 @@
 #include "SDL_blit.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
+#include "SDL_yuv_c.h"
 #include "../render/SDL_sysrender.h"
 
+#if defined(__SSE2__) && !defined(SDL_DISABLE_EMMINTRIN_H)
+#include <emmintrin.h>
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
+#if defined(__ARM_NEON) && SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define HAVE_NEON_INTRINSICS 1
+#endif
 
 /* Check to make sure we can safely check multiplication of surface w and pitch and it won't overflow size_t */
 SDL_COMPILE_TIME_ASSERT(surface_size_assumptions,
@@ -696,7 +705,8 @@ SDL_LowerBlit(SDL_Surface * src, SDL_Rect * srcrect,
         (dst->format->palette &&
          src->map->dst_palette_version != dst->format->palette->version) ||
         (src->format->palette &&
-         src->map->src_palette_version != src->format->palette->version)) {
+         src->map->src_palette_version != src->format->palette->version &&
+         !SDL_RefreshMapPalette(src))) {
         if (SDL_MapSurface(src, dst) < 0) {
             return (-1);
         }
@@ -1135,7 +1145,12 @@ SDL_UnlockSurface(SDL_Surface * surface)
     /* Update RLE encoded surface with new data */
     if ((surface->flags & SDL_RLEACCEL) == SDL_RLEACCEL) {
         surface->flags &= ~SDL_RLEACCEL;        /* stop lying */
-        SDL_RLESurface(surface);
+        if (surface->map->info.flags & SDL_COPY_RLE_KEEP) {
+            /* Leave the encoding to the next blit */
+            SDL_InvalidateMap(surface->map);
+        } else {
+            SDL_RLESurface(surface);
+        }
     }
 #endif
 }
@@ -1218,7 +1233,7 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
     surface->map->info.g = 0xFF;
     surface->map->info.b = 0xFF;
     surface->map->info.a = 0xFF;
-    surface->map->info.flags = (copy_flags & (SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY));
+    surface->map->info.flags = (copy_flags & (SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY | SDL_COPY_RLE_KEEP));
     SDL_InvalidateMap(surface->map);
 
     /* Copy over the image data */
@@ -1289,9 +1304,7 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
     convert->map->info.a = copy_color.a;
     convert->map->info.flags =
         (copy_flags &
-         ~(SDL_COPY_COLORKEY | SDL_COPY_BLEND
-           | SDL_COPY_RLE_DESIRED | SDL_COPY_RLE_COLORKEY |
-           SDL_COPY_RLE_ALPHAKEY));
+         ~(SDL_COPY_COLORKEY | SDL_COPY_BLEND | SDL_COPY_RLE_MASK));
     surface->map->info.r = copy_color.r;
     surface->map->info.g = copy_color.g;
     surface->map->info.b = copy_color.b;
@@ -1453,6 +1466,9 @@ int SDL_ConvertPixels(int width, int height,
     SDL_Rect rect;
     void *nonconst_src = (void *) src;
     int ret;
+#if SDL_HAVE_BLIT_N
+    SDL_BlitFunc blit;
+#endif
 
     if (!src) {
         return SDL_InvalidParamError("src");
@@ -1466,8 +1482,12 @@ int SDL_ConvertPixels(int width, int height,
     if (!dst_pitch) {
         return SDL_InvalidParamError("dst_pitch");
     }
-    if (SDL_ISPIXELFORMAT_FOURCC(src_format) || SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
-        return SDL_SetError("SDL not built with YUV support");
+    if (SDL_ISPIXELFORMAT_FOURCC(src_format) && SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
+        return SDL_ConvertPixels_YUV_to_YUV(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch);
+    } else if (SDL_ISPIXELFORMAT_FOURCC(src_format)) {
+        return SDL_ConvertPixels_YUV_to_RGB(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch);
+    } else if (SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
+        return SDL_SetError("Unsupported conversion to YUV format %s", SDL_GetPixelFormatName(dst_format));
     }
 
     /* Fast path for same format copy */
@@ -1483,6 +1503,26 @@ int SDL_ConvertPixels(int width, int height,
         return 0;
     }
 
+#if SDL_HAVE_BLIT_N
+    /* Fast path for the conversions that have a dedicated blitter */
+    blit = SDL_CalculateConvertBlitN(src_format, dst_format);
+    if (blit && width > 0 && height > 0) {
+        SDL_BlitInfo info;
+
+        SDL_zero(info);
+        info.src = (Uint8 *) nonconst_src;
+        info.src_w = info.dst_w = width;
+        info.src_h = info.dst_h = height;
+        info.src_pitch = src_pitch;
+        info.src_skip = src_pitch - width * SDL_BYTESPERPIXEL(src_format);
+        info.dst = (Uint8 *) dst;
+        info.dst_pitch = dst_pitch;
+        info.dst_skip = dst_pitch - width * SDL_BYTESPERPIXEL(dst_format);
+        blit(&info);
+        return 0;
+    }
+#endif
+
     if (!SDL_CreateSurfaceOnStack(width, height, src_format, nonconst_src,
                                   src_pitch,
                                   &src_surface, &src_fmt, &src_blitmap)) {
@@ -1493,6 +1533,15 @@ int SDL_ConvertPixels(int width, int height,
         return -1;
     }
 
+    /* Both formats are non-indexed, so there is no table to build, and the
+       stack surfaces go away with us: pick the blitter directly instead of
+       going through SDL_MapSurface(), which allocates a list node on the
+       destination to track the mapping. */
+    src_blitmap.dst = &dst_surface;
+    if (SDL_CalculateBlit(&src_surface) < 0) {
+        return -1;
+    }
+
     /* Set up the rect and go! */
     rect.x = 0;
     rect.y = 0;
@@ -1509,21 +1558,96 @@ int SDL_ConvertPixels(int width, int height,
 /*
  * Premultiply the alpha on a block of pixels
  *
- * This is currently only implemented for SDL_PIXELFORMAT_ARGB8888
- *
- * Here are some ideas for optimization:
- * https://github.com/Wizermil/premultiply_alpha/tree/master/premultiply_alpha
- * https://developer.arm.com/documentation/101964/0201/Pre-multiplied-alpha-channel-data
+ * This is implemented for the 8888 formats with alpha, converting to the
+ * same format.  The NEON and SSE2 versions divide by 255 exactly, like the
+ * scalar one: for t = c * a, t / 255 == (t + 1 + ((t + 1) >> 8)) >> 8.
  */
+static void
+PremultiplyAlphaRow(const Uint32 *src, Uint32 *dst, int width, int ashift)
+{
+    /* The color channels are the three bytes other than alpha */
+    const int shift = (ashift == 0) ? 8 : 0;
+
+    while (width--) {
+        const Uint32 pixel = *src++;
+        const Uint32 a = (pixel >> ashift) & 0xFF;
+        const Uint32 c0 = (((pixel >> shift) & 0xFF) * a) / 255;
+        const Uint32 c1 = (((pixel >> (shift + 8)) & 0xFF) * a) / 255;
+        const Uint32 c2 = (((pixel >> (shift + 16)) & 0xFF) * a) / 255;
+
+        *dst++ = (a << ashift) | (c0 << shift) | (c1 << (shift + 8)) | (c2 << (shift + 16));
+    }
+}
+
+#if HAVE_NEON_INTRINSICS
+static void
+PremultiplyAlphaRowNEON(const Uint32 *src, Uint32 *dst, int width, int ashift)
+{
+    const int alpha = ashift / 8;
+    const uint16x8_t one = vdupq_n_u16(1);
+    int i;
+
+    for (; width >= 8; width -= 8) {
+        uint8x8x4_t v = vld4_u8((const uint8_t *)src);
+        const uint8x8_t a = v.val[alpha];
+
+        for (i = 0; i < 4; ++i) {
+            if (i != alpha) {
+                const uint16x8_t t = vaddq_u16(vmull_u8(v.val[i], a), one);
+                v.val[i] = vaddhn_u16(t, vshrq_n_u16(t, 8));
+            }
+        }
+        vst4_u8((uint8_t *)dst, v);
+        src += 8;
+        dst += 8;
+    }
+    PremultiplyAlphaRow(src, dst, width, ashift);
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
+#if HAVE_SSE2_INTRINSICS
+static SDL_INLINE __m128i
+PremultiplyAlphaSSE2(__m128i c, __m128i a)
+{
+    const __m128i t = _mm_add_epi16(_mm_mullo_epi16(c, a), _mm_set1_epi16(1));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+static void
+PremultiplyAlphaRowSSE2(const Uint32 *src, Uint32 *dst, int width, int ashift)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i amask = _mm_set1_epi32((int)(0xFFu << ashift));
+
+    for (; width >= 4; width -= 4) {
+        const __m128i p = _mm_loadu_si128((const __m128i *)src);
+        const __m128i lo = _mm_unpacklo_epi8(p, zero);
+        const __m128i hi = _mm_unpackhi_epi8(p, zero);
+        __m128i alo, ahi, c;
+
+        if (ashift) {
+            alo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0xFF), 0xFF);
+            ahi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0xFF), 0xFF);
+        } else {
+            alo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0x00), 0x00);
+            ahi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0x00), 0x00);
+        }
+        c = _mm_packus_epi16(PremultiplyAlphaSSE2(lo, alo), PremultiplyAlphaSSE2(hi, ahi));
+        c = _mm_or_si128(_mm_andnot_si128(amask, c), _mm_and_si128(amask, p));
+        _mm_storeu_si128((__m128i *)dst, c);
+        src += 4;
+        dst += 4;
+    }
+    PremultiplyAlphaRow(src, dst, width, ashift);
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
 int SDL_PremultiplyAlpha(int width, int height,
                          Uint32 src_format, const void * src, int src_pitch,
                          Uint32 dst_format, void * dst, int dst_pitch)
 {
-    int c;
-    Uint32 srcpixel;
-    Uint32 srcR, srcG, srcB, srcA;
-    Uint32 dstpixel;
-    Uint32 dstR, dstG, dstB, dstA;
+    void (*row)(const Uint32 *src, Uint32 *dst, int width, int ashift) = PremultiplyAlphaRow;
+    int ashift;
 
     if (!src) {
         return SDL_InvalidParamError("src");
@@ -1537,31 +1661,35 @@ int SDL_PremultiplyAlpha(int width, int height,
     if (!dst_pitch) {
         return SDL_InvalidParamError("dst_pitch");
     }
-    if (src_format != SDL_PIXELFORMAT_ARGB8888) {
+    switch (src_format) {
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_ABGR8888:
+        ashift = 24;
+        break;
+    case SDL_PIXELFORMAT_RGBA8888:
+    case SDL_PIXELFORMAT_BGRA8888:
+        ashift = 0;
+        break;
+    default:
         return SDL_InvalidParamError("src_format");
     }
-    if (dst_format != SDL_PIXELFORMAT_ARGB8888) {
+    if (dst_format != src_format) {
         return SDL_InvalidParamError("dst_format");
     }
 
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        row = PremultiplyAlphaRowNEON;
+    }
+#endif
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        row = PremultiplyAlphaRowSSE2;
+    }
+#endif
+
     while (height--) {
-        const Uint32 *src_px = (const Uint32 *)src;
-        Uint32 *dst_px = (Uint32 *)dst;
-        for (c = width; c; --c) {
-            /* Component bytes extraction. */
-            srcpixel = *src_px++;
-            RGBA_FROM_ARGB8888(srcpixel, srcR, srcG, srcB, srcA);
-
-            /* Alpha pre-multiplication of each component. */
-            dstA = srcA;
-            dstR = (srcA * srcR) / 255;
-            dstG = (srcA * srcG) / 255;
-            dstB = (srcA * srcB) / 255;
-
-            /* ARGB8888 pixel recomposition. */
-            ARGB8888_FROM_RGBA(dstpixel, dstR, dstG, dstB, dstA);
-            *dst_px++ = dstpixel;
-        }
+        row((const Uint32 *)src, (Uint32 *)dst, width, ashift);
         src = (const Uint8 *)src + src_pitch;
         dst = (Uint8 *)dst + dst_pitch;
     }
@@ -0,0 +1,905 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_cpuinfo.h"
+#include "SDL_surface.h"
+#include "SDL_yuv_c.h"
+
+#if defined(__SSE2__) && !defined(SDL_DISABLE_EMMINTRIN_H)
+#include <emmintrin.h>
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
+#ifdef __ARM_NEON
+#define HAVE_NEON_INTRINSICS 1
+#endif
+
+/* The maximum image height at which SDL_YUV_CONVERSION_AUTOMATIC picks BT.601 */
+#define SDL_YUV_SD_THRESHOLD   576
+
+static SDL_YUV_CONVERSION_MODE SDL_YUV_ConversionMode = SDL_YUV_CONVERSION_BT601;
+
+
+void
+SDL_SetYUVConversionMode(SDL_YUV_CONVERSION_MODE mode)
+{
+    SDL_YUV_ConversionMode = mode;
+}
+
+SDL_YUV_CONVERSION_MODE
+SDL_GetYUVConversionMode(void)
+{
+    return SDL_YUV_ConversionMode;
+}
+
+SDL_YUV_CONVERSION_MODE
+SDL_GetYUVConversionModeForResolution(int width, int height)
+{
+    SDL_YUV_CONVERSION_MODE mode = SDL_GetYUVConversionMode();
+    if (mode == SDL_YUV_CONVERSION_AUTOMATIC) {
+        if (height <= SDL_YUV_SD_THRESHOLD) {
+            mode = SDL_YUV_CONVERSION_BT601;
+        } else {
+            mode = SDL_YUV_CONVERSION_BT709;
+        }
+    }
+    return mode;
+}
+
+int
+SDL_CalculateYUVSize(Uint32 format, int w, int h, size_t *size, int *pitch)
+{
+    size_t sz_plane, sz_plane_chroma, sz_plane_packed;
+    size_t dst_size;
+    int dst_pitch;
+
+    if (w <= 0 || h <= 0) {
+        return SDL_SetError("Invalid YUV image size %dx%d", w, h);
+    }
+    if (w > SDL_MAX_SINT32 / 4 || (size_t) w > (SDL_SIZE_MAX / 4) / (size_t) h) {
+        return SDL_SetError("YUV image is too large");
+    }
+
+    sz_plane = (size_t) w * h;
+    sz_plane_chroma = (size_t) ((w + 1) / 2) * ((h + 1) / 2);
+    sz_plane_packed = (size_t) ((w + 1) / 2) * h;
+
+    switch (format) {
+    case SDL_PIXELFORMAT_YV12:  /**< Planar mode: Y + V + U  (3 planes) */
+    case SDL_PIXELFORMAT_IYUV:  /**< Planar mode: Y + U + V  (3 planes) */
+    case SDL_PIXELFORMAT_NV12:  /**< Planar mode: Y + U/V interleaved  (2 planes) */
+    case SDL_PIXELFORMAT_NV21:  /**< Planar mode: Y + V/U interleaved  (2 planes) */
+        dst_size = sz_plane + sz_plane_chroma + sz_plane_chroma;
+        dst_pitch = w;
+        break;
+
+    case SDL_PIXELFORMAT_YUY2:  /**< Packed mode: Y0+U0+Y1+V0 (1 plane) */
+    case SDL_PIXELFORMAT_UYVY:  /**< Packed mode: U0+Y0+V0+Y1 (1 plane) */
+    case SDL_PIXELFORMAT_YVYU:  /**< Packed mode: Y0+V0+Y1+U0 (1 plane) */
+        dst_size = 4 * sz_plane_packed;
+        dst_pitch = 4 * ((w + 1) / 2);
+        break;
+
+    default:
+        return SDL_SetError("Unsupported YUV format: %s", SDL_GetPixelFormatName(format));
+    }
+
+    if (size) {
+        *size = dst_size;
+    }
+    if (pitch) {
+        *pitch = dst_pitch;
+    }
+    return 0;
+}
+
+
+/* Where the samples of a YUV image are. Packed and semi-planar formats are
+   described as strided planes, so one set of loops walks all of them. */
+typedef struct
+{
+    const Uint8 *y;
+    const Uint8 *u;
+    const Uint8 *v;
+    int y_pitch;
+    int uv_pitch;
+    int y_step;     /* bytes between two luma samples of a row */
+    int uv_step;    /* bytes between two chroma samples of a row */
+    int uv_shift;   /* chroma row of luma row n is n >> uv_shift */
+} YUVPlanes;
+
+static int
+GetYUVPlanes(int height, Uint32 format, const void *pixels, int pitch, YUVPlanes *planes)
+{
+    const Uint8 *p = (const Uint8 *) pixels;
+    const Uint8 *chroma = p + (size_t) height * pitch;
+
+    switch (format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+    {
+        const Uint8 *second;
+
+        planes->y = p;
+        planes->y_pitch = pitch;
+        planes->uv_pitch = (pitch + 1) / 2;
+        planes->y_step = 1;
+        planes->uv_step = 1;
+        planes->uv_shift = 1;
+        second = chroma + (size_t) ((height + 1) / 2) * planes->uv_pitch;
+        if (format == SDL_PIXELFORMAT_YV12) {
+            planes->v = chroma;
+            planes->u = second;
+        } else {
+            planes->u = chroma;
+            planes->v = second;
+        }
+        break;
+    }
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        planes->y = p;
+        planes->y_pitch = pitch;
+        planes->uv_pitch = 2 * ((pitch + 1) / 2);
+        planes->y_step = 1;
+        planes->uv_step = 2;
+        planes->uv_shift = 1;
+        if (format == SDL_PIXELFORMAT_NV12) {
+            planes->u = chroma;
+            planes->v = chroma + 1;
+        } else {
+            planes->v = chroma;
+            planes->u = chroma + 1;
+        }
+        break;
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+        planes->y_pitch = pitch;
+        planes->uv_pitch = pitch;
+        planes->y_step = 2;
+        planes->uv_step = 4;
+        planes->uv_shift = 0;
+        if (format == SDL_PIXELFORMAT_YUY2) {
+            planes->y = p;
+            planes->u = p + 1;
+            planes->v = p + 3;
+        } else if (format == SDL_PIXELFORMAT_UYVY) {
+            planes->u = p;
+            planes->y = p + 1;
+            planes->v = p + 2;
+        } else {
+            planes->y = p;
+            planes->v = p + 1;
+            planes->u = p + 3;
+        }
+        break;
+    default:
+        return SDL_SetError("Unsupported YUV format: %s", SDL_GetPixelFormatName(format));
+    }
+    return 0;
+}
+
+
+/* Fixed point YUV to RGB coefficients.
+
+   The luma factor is 7.7 fixed point and applied to the unsigned sample, and
+   then halved, so the scaled luma fits a signed 16-bit lane; y_bias is the
+   black level in the resulting 10.6 fixed point. The chroma factors are 10.6
+   fixed point. Every path computes exactly the same result, so a frame looks
+   the same whichever kernel the CPU gets. */
+typedef struct
+{
+    int y_factor;
+    int y_bias;
+    int v_r;
+    int u_g;
+    int v_g;
+    int u_b;
+} YUVCoefficients;
+
+static const YUVCoefficients YUV_JPEG = { 128, 0, 90, 22, 46, 113 };
+static const YUVCoefficients YUV_BT601 = { 149, 1192, 102, 25, 52, 129 };
+static const YUVCoefficients YUV_BT709 = { 149, 1192, 115, 14, 34, 135 };
+
+static const YUVCoefficients *
+GetYUVCoefficients(int width, int height)
+{
+    switch (SDL_GetYUVConversionModeForResolution(width, height)) {
+    case SDL_YUV_CONVERSION_JPEG:
+        return &YUV_JPEG;
+    case SDL_YUV_CONVERSION_BT709:
+        return &YUV_BT709;
+    default:
+        return &YUV_BT601;
+    }
+}
+
+/* Convert one row. For the 4:2:2 kernels u[i] and v[i] are shared by pixels
+   2i and 2i+1, for the 4:4:4 kernels every pixel has its own chroma. */
+typedef void (*YUVRowFunc)(const Uint8 *y, const Uint8 *u, const Uint8 *v,
+                           void *dst, int width, const YUVCoefficients *c);
+
+static SDL_INLINE Uint8
+YUV_Clamp(int value)
+{
+    value = (value + 32) >> 6;
+    if (value < 0) {
+        return 0;
+    } else if (value > 255) {
+        return 255;
+    }
+    return (Uint8) value;
+}
+
+#define YUV_LUMA(c, Y)  ((((int) (Y) * (c)->y_factor) >> 1) - (c)->y_bias)
+
+#define YUV_CHROMA(c, U, V, cr, cg, cb) \
+    do { \
+        const int du_ = (int) (U) - 128; \
+        const int dv_ = (int) (V) - 128; \
+        cr = dv_ * (c)->v_r; \
+        cg = du_ * (c)->u_g + dv_ * (c)->v_g; \
+        cb = du_ * (c)->u_b; \
+    } while (0)
+
+#define PACK_RGB565(r, g, b)    (Uint16) ((((r) & 0xF8) << 8) | (((g) & 0xFC) << 3) | ((b) >> 3))
+#define PACK_ARGB8888(r, g, b)  (0xFF000000 | ((Uint32) (r) << 16) | ((Uint32) (g) << 8) | (Uint32) (b))
+#define PACK_ABGR8888(r, g, b)  (0xFF000000 | ((Uint32) (b) << 16) | ((Uint32) (g) << 8) | (Uint32) (r))
+
+#define YUV_PIXEL(c, Y, cr, cg, cb, PACK, d) \
+    do { \
+        const int y_ = YUV_LUMA(c, Y); \
+        *(d)++ = PACK(YUV_Clamp(y_ + (cr)), YUV_Clamp(y_ - (cg)), YUV_Clamp(y_ + (cb))); \
+    } while (0)
+
+#define DEFINE_SCALAR_ROWS(NAME, TYPE, PACK) \
+static void \
+YUV422_##NAME##_Scalar(const Uint8 *y, const Uint8 *u, const Uint8 *v, \
+                       void *dst, int width, const YUVCoefficients *c) \
+{ \
+    TYPE *d = (TYPE *) dst; \
+    int cr, cg, cb; \
+    int i; \
+    for (i = 0; i + 1 < width; i += 2) { \
+        YUV_CHROMA(c, u[i / 2], v[i / 2], cr, cg, cb); \
+        YUV_PIXEL(c, y[i], cr, cg, cb, PACK, d); \
+        YUV_PIXEL(c, y[i + 1], cr, cg, cb, PACK, d); \
+    } \
+    if (i < width) { \
+        YUV_CHROMA(c, u[i / 2], v[i / 2], cr, cg, cb); \
+        YUV_PIXEL(c, y[i], cr, cg, cb, PACK, d); \
+    } \
+} \
+\
+static void \
+YUV444_##NAME##_Scalar(const Uint8 *y, const Uint8 *u, const Uint8 *v, \
+                       void *dst, int width, const YUVCoefficients *c) \
+{ \
+    TYPE *d = (TYPE *) dst; \
+    int cr, cg, cb; \
+    int i; \
+    for (i = 0; i < width; ++i) { \
+        YUV_CHROMA(c, u[i], v[i], cr, cg, cb); \
+        YUV_PIXEL(c, y[i], cr, cg, cb, PACK, d); \
+    } \
+}
+
+DEFINE_SCALAR_ROWS(RGB565, Uint16, PACK_RGB565)
+DEFINE_SCALAR_ROWS(ARGB8888, Uint32, PACK_ARGB8888)
+DEFINE_SCALAR_ROWS(ABGR8888, Uint32, PACK_ABGR8888)
+
+
+#if HAVE_SSE2_INTRINSICS
+
+/* 8 pixels at a time, with 16-bit lanes from start to end */
+
+typedef struct
+{
+    __m128i zero;
+    __m128i y_factor;
+    __m128i y_bias;
+    __m128i v_r;
+    __m128i u_g;
+    __m128i v_g;
+    __m128i u_b;
+    __m128i bias128;
+    __m128i round;
+} YUVConstants_SSE2;
+
+static SDL_INLINE void
+YUV_SetupSSE2(YUVConstants_SSE2 *k, const YUVCoefficients *c)
+{
+    k->zero = _mm_setzero_si128();
+    k->y_factor = _mm_set1_epi16((short) c->y_factor);
+    k->y_bias = _mm_set1_epi16((short) c->y_bias);
+    k->v_r = _mm_set1_epi16((short) c->v_r);
+    k->u_g = _mm_set1_epi16((short) c->u_g);
+    k->v_g = _mm_set1_epi16((short) c->v_g);
+    k->u_b = _mm_set1_epi16((short) c->u_b);
+    k->bias128 = _mm_set1_epi16(128);
+    k->round = _mm_set1_epi16(32);
+}
+
+/* y8, u8 and v8 hold 8 samples in their low 8 bytes */
+static SDL_INLINE void
+YUV_PixelsSSE2(const YUVConstants_SSE2 *k, __m128i y8, __m128i u8, __m128i v8,
+               __m128i *r, __m128i *g, __m128i *b)
+{
+    const __m128i y16 = _mm_sub_epi16(_mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(y8, k->zero), k->y_factor), 1), k->y_bias);
+    const __m128i du = _mm_sub_epi16(_mm_unpacklo_epi8(u8, k->zero), k->bias128);
+    const __m128i dv = _mm_sub_epi16(_mm_unpacklo_epi8(v8, k->zero), k->bias128);
+    const __m128i cr = _mm_mullo_epi16(dv, k->v_r);
+    const __m128i cg = _mm_add_epi16(_mm_mullo_epi16(du, k->u_g), _mm_mullo_epi16(dv, k->v_g));
+    const __m128i cb = _mm_mullo_epi16(du, k->u_b);
+
+    /* Saturating adds: anything that saturates is out of range either way */
+    *r = _mm_srai_epi16(_mm_adds_epi16(_mm_adds_epi16(y16, cr), k->round), 6);
+    *g = _mm_srai_epi16(_mm_adds_epi16(_mm_subs_epi16(y16, cg), k->round), 6);
+    *b = _mm_srai_epi16(_mm_adds_epi16(_mm_adds_epi16(y16, cb), k->round), 6);
+}
+
+static SDL_INLINE __m128i
+YUV_Load4SSE2(const Uint8 *p)
+{
+    Uint32 value;
+    SDL_memcpy(&value, p, sizeof (value));
+    return _mm_cvtsi32_si128((int) value);
+}
+
+static SDL_INLINE void
+YUV_StoreRGB565SSE2(Uint8 *d, __m128i r, __m128i g, __m128i b)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi16(255);
+    __m128i p;
+
+    r = _mm_min_epi16(_mm_max_epi16(r, zero), max);
+    g = _mm_min_epi16(_mm_max_epi16(g, zero), max);
+    b = _mm_min_epi16(_mm_max_epi16(b, zero), max);
+    p = _mm_slli_epi16(_mm_and_si128(r, _mm_set1_epi16(0xF8)), 8);
+    p = _mm_or_si128(p, _mm_slli_epi16(_mm_and_si128(g, _mm_set1_epi16(0xFC)), 3));
+    p = _mm_or_si128(p, _mm_srli_epi16(b, 3));
+    _mm_storeu_si128((__m128i *) d, p);
+}
+
+static SDL_INLINE void
+YUV_StoreBGRASSE2(Uint8 *d, __m128i c0, __m128i c1, __m128i c2)
+{
+    /* Byte order c0, c1, c2, 0xFF for each pixel */
+    const __m128i lo = _mm_unpacklo_epi8(_mm_packus_epi16(c0, c0), _mm_packus_epi16(c1, c1));
+    const __m128i hi = _mm_unpacklo_epi8(_mm_packus_epi16(c2, c2), _mm_set1_epi8(-1));
+    _mm_storeu_si128((__m128i *) d, _mm_unpacklo_epi16(lo, hi));
+    _mm_storeu_si128((__m128i *) (d + 16), _mm_unpackhi_epi16(lo, hi));
+}
+
+#define YUV_STORE_RGB565_SSE2(d, r, g, b)   YUV_StoreRGB565SSE2(d, r, g, b)
+#define YUV_STORE_ARGB8888_SSE2(d, r, g, b) YUV_StoreBGRASSE2(d, b, g, r)
+#define YUV_STORE_ABGR8888_SSE2(d, r, g, b) YUV_StoreBGRASSE2(d, r, g, b)
+
+#define DEFINE_SSE2_ROWS(NAME, BPP) \
+static void \
+YUV422_##NAME##_SSE2(const Uint8 *y, const Uint8 *u, const Uint8 *v, \
+                     void *dst, int width, const YUVCoefficients *c) \
+{ \
+    Uint8 *d = (Uint8 *) dst; \
+    YUVConstants_SSE2 k; \
+    int i; \
+    YUV_SetupSSE2(&k, c); \
+    for (i = 0; i + 8 <= width; i += 8) { \
+        __m128i r, g, b; \
+        __m128i u8 = YUV_Load4SSE2(u + i / 2); \
+        __m128i v8 = YUV_Load4SSE2(v + i / 2); \
+        u8 = _mm_unpacklo_epi8(u8, u8); \
+        v8 = _mm_unpacklo_epi8(v8, v8); \
+        YUV_PixelsSSE2(&k, _mm_loadl_epi64((const __m128i *) (y + i)), u8, v8, &r, &g, &b); \
+        YUV_STORE_##NAME##_SSE2(d, r, g, b); \
+        d += 8 * BPP; \
+    } \
+    if (i < width) { \
+        YUV422_##NAME##_Scalar(y + i, u + i / 2, v + i / 2, d, width - i, c); \
+    } \
+} \
+\
+static void \
+YUV444_##NAME##_SSE2(const Uint8 *y, const Uint8 *u, const Uint8 *v, \
+                     void *dst, int width, const YUVCoefficients *c) \
+{ \
+    Uint8 *d = (Uint8 *) dst; \
+    YUVConstants_SSE2 k; \
+    int i; \
+    YUV_SetupSSE2(&k, c); \
+    for (i = 0; i + 8 <= width; i += 8) { \
+        __m128i r, g, b; \
+        YUV_PixelsSSE2(&k, _mm_loadl_epi64((const __m128i *) (y + i)), \
+                       _mm_loadl_epi64((const __m128i *) (u + i)), \
+                       _mm_loadl_epi64((const __m128i *) (v + i)), &r, &g, &b); \
+        YUV_STORE_##NAME##_SSE2(d, r, g, b); \
+        d += 8 * BPP; \
+    } \
+    if (i < width) { \
+        YUV444_##NAME##_Scalar(y + i, u + i, v + i, d, width - i, c); \
+    } \
+}
+
+DEFINE_SSE2_ROWS(RGB565, 2)
+DEFINE_SSE2_ROWS(ARGB8888, 4)
+DEFINE_SSE2_ROWS(ABGR8888, 4)
+
+#endif /* HAVE_SSE2_INTRINSICS */
+
+
+#if HAVE_NEON_INTRINSICS
+
+/* 8 pixels at a time in 16-bit lanes, 16 per iteration for 4:2:2 */
+
+static SDL_INLINE int
+hasNEON()
+{
+    static int val = -1;
+    if (val != -1) {
+        return val;
+    }
+    val = SDL_HasNEON();
+    return val;
+}
+
+typedef struct
+{
+    uint8x8_t y_factor;
+    int16x8_t y_bias;
+    uint8x8_t bias128;
+    int16_t v_r;
+    int16_t u_g;
+    int16_t v_g;
+    int16_t u_b;
+} YUVConstants_NEON;
+
+static SDL_INLINE void
+YUV_SetupNEON(YUVConstants_NEON *k, const YUVCoefficients *c)
+{
+    k->y_factor = vdup_n_u8((uint8_t) c->y_factor);
+    k->y_bias = vdupq_n_s16((int16_t) c->y_bias);
+    k->bias128 = vdup_n_u8(128);
+    k->v_r = (int16_t) c->v_r;
+    k->u_g = (int16_t) c->u_g;
+    k->v_g = (int16_t) c->v_g;
+    k->u_b = (int16_t) c->u_b;
+}
+
+static SDL_INLINE void
+YUV_ChromaNEON(const YUVConstants_NEON *k, uint8x8_t u8, uint8x8_t v8,
+               int16x8_t *cr, int16x8_t *cg, int16x8_t *cb)
+{
+    const int16x8_t du = vreinterpretq_s16_u16(vsubl_u8(u8, k->bias128));
+    const int16x8_t dv = vreinterpretq_s16_u16(vsubl_u8(v8, k->bias128));
+    *cr = vmulq_n_s16(dv, k->v_r);
+    *cg = vmlaq_n_s16(vmulq_n_s16(du, k->u_g), dv, k->v_g);
+    *cb = vmulq_n_s16(du, k->u_b);
+}
+
+/* Saturating adds: anything that saturates is out of range either way */
+static SDL_INLINE void
+YUV_PixelsNEON(const YUVConstants_NEON *k, uint8x8_t y8, int16x8_t cr, int16x8_t cg, int16x8_t cb,
+               uint8x8_t *r, uint8x8_t *g, uint8x8_t *b)
+{
+    const int16x8_t y16 = vsubq_s16(vreinterpretq_s16_u16(vshrq_n_u16(vmull_u8(y8, k->y_factor), 1)), k->y_bias);
+    *r = vqrshrun_n_s16(vqaddq_s16(y16, cr), 6);
+    *g = vqrshrun_n_s16(vqsubq_s16(y16, cg), 6);
+    *b = vqrshrun_n_s16(vqaddq_s16(y16, cb), 6);
+}
+
+static SDL_INLINE void
+YUV_StoreRGB565NEON(Uint8 *d, uint8x8_t r, uint8x8_t g, uint8x8_t b)
+{
+    uint16x8_t p = vshll_n_u8(r, 8);
+    p = vsriq_n_u16(p, vshll_n_u8(g, 8), 5);
+    p = vsriq_n_u16(p, vshll_n_u8(b, 8), 11);
+    vst1q_u16((uint16_t *) d, p);
+}
+
+static SDL_INLINE void
+YUV_StoreBGRANEON(Uint8 *d, uint8x8_t c0, uint8x8_t c1, uint8x8_t c2)
+{
+    uint8x8x4_t p;
+    p.val[0] = c0;
+    p.val[1] = c1;
+    p.val[2] = c2;
+    p.val[3] = vdup_n_u8(0xFF);
+    vst4_u8(d, p);
+}
+
+#define YUV_STORE_RGB565_NEON(d, r, g, b)   YUV_StoreRGB565NEON(d, r, g, b)
+#define YUV_STORE_ARGB8888_NEON(d, r, g, b) YUV_StoreBGRANEON(d, b, g, r)
+#define YUV_STORE_ABGR8888_NEON(d, r, g, b) YUV_StoreBGRANEON(d, r, g, b)
+
+#define DEFINE_NEON_ROWS(NAME, BPP) \
+static void \
+YUV422_##NAME##_NEON(const Uint8 *y, const Uint8 *u, const Uint8 *v, \
+                     void *dst, int width, const YUVCoefficients *c) \
+{ \
+    Uint8 *d = (Uint8 *) dst; \
+    YUVConstants_NEON k; \
+    int i; \
+    YUV_SetupNEON(&k, c); \
+    for (i = 0; i + 16 <= width; i += 16) { \
+        const uint8x16_t y16 = vld1q_u8(y + i); \
+        int16x8_t cr, cg, cb; \
+        int16x8x2_t zr, zg, zb; \
+        uint8x8_t r, g, b; \
+        YUV_ChromaNEON(&k, vld1_u8(u + i / 2), vld1_u8(v + i / 2), &cr, &cg, &cb); \
+        zr = vzipq_s16(cr, cr); \
+        zg = vzipq_s16(cg, cg); \
+        zb = vzipq_s16(cb, cb); \
+        YUV_PixelsNEON(&k, vget_low_u8(y16), zr.val[0], zg.val[0], zb.val[0], &r, &g, &b); \
+        YUV_STORE_##NAME##_NEON(d, r, g, b); \
+        YUV_PixelsNEON(&k, vget_high_u8(y16), zr.val[1], zg.val[1], zb.val[1], &r, &g, &b); \
+        YUV_STORE_##NAME##_NEON(d + 8 * BPP, r, g, b); \
+        d += 16 * BPP; \
+    } \
+    if (i < width) { \
+        YUV422_##NAME##_Scalar(y + i, u + i / 2, v + i / 2, d, width - i, c); \
+    } \
+} \
+\
+static void \
+YUV444_##NAME##_NEON(const Uint8 *y, const Uint8 *u, const Uint8 *v, \
+                     void *dst, int width, const YUVCoefficients *c) \
+{ \
+    Uint8 *d = (Uint8 *) dst; \
+    YUVConstants_NEON k; \
+    int i; \
+    YUV_SetupNEON(&k, c); \
+    for (i = 0; i + 8 <= width; i += 8) { \
+        int16x8_t cr, cg, cb; \
+        uint8x8_t r, g, b; \
+        YUV_ChromaNEON(&k, vld1_u8(u + i), vld1_u8(v + i), &cr, &cg, &cb); \
+        YUV_PixelsNEON(&k, vld1_u8(y + i), cr, cg, cb, &r, &g, &b); \
+        YUV_STORE_##NAME##_NEON(d, r, g, b); \
+        d += 8 * BPP; \
+    } \
+    if (i < width) { \
+        YUV444_##NAME##_Scalar(y + i, u + i, v + i, d, width - i, c); \
+    } \
+}
+
+DEFINE_NEON_ROWS(RGB565, 2)
+DEFINE_NEON_ROWS(ARGB8888, 4)
+DEFINE_NEON_ROWS(ABGR8888, 4)
+
+#endif /* HAVE_NEON_INTRINSICS */
+
+
+/* Pick the row kernels writing dst_format, if there are any */
+static SDL_bool
+GetYUVRowFuncs(Uint32 dst_format, YUVRowFunc *row422, YUVRowFunc *row444)
+{
+#if HAVE_NEON_INTRINSICS
+#define YUV_ROW_FUNCS_NEON(NAME) \
+    if (hasNEON()) { \
+        *row422 = YUV422_##NAME##_NEON; \
+        *row444 = YUV444_##NAME##_NEON; \
+        return SDL_TRUE; \
+    }
+#else
+#define YUV_ROW_FUNCS_NEON(NAME)
+#endif
+#if HAVE_SSE2_INTRINSICS
+#define YUV_ROW_FUNCS_SSE2(NAME) \
+    if (SDL_HasSSE2()) { \
+        *row422 = YUV422_##NAME##_SSE2; \
+        *row444 = YUV444_##NAME##_SSE2; \
+        return SDL_TRUE; \
+    }
+#else
+#define YUV_ROW_FUNCS_SSE2(NAME)
+#endif
+#define YUV_ROW_FUNCS(NAME) \
+    YUV_ROW_FUNCS_NEON(NAME) \
+    YUV_ROW_FUNCS_SSE2(NAME) \
+    *row422 = YUV422_##NAME##_Scalar; \
+    *row444 = YUV444_##NAME##_Scalar; \
+    return SDL_TRUE
+
+    switch (dst_format) {
+    case SDL_PIXELFORMAT_RGB565:
+        YUV_ROW_FUNCS(RGB565);
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_RGB888:
+        YUV_ROW_FUNCS(ARGB8888);
+    case SDL_PIXELFORMAT_ABGR8888:
+    case SDL_PIXELFORMAT_BGR888:
+        YUV_ROW_FUNCS(ABGR8888);
+    default:
+        return SDL_FALSE;
+    }
+
+#undef YUV_ROW_FUNCS
+#undef YUV_ROW_FUNCS_SSE2
+#undef YUV_ROW_FUNCS_NEON
+}
+
+/* Copy every step'th byte of src to dst */
+static void
+GatherSamples(const Uint8 *src, int step, Uint8 *dst, int count)
+{
+    int i = 0;
+
+#if HAVE_NEON_INTRINSICS
+    if (hasNEON()) {
+        if (step == 2) {
+            for (; i + 16 <= count; i += 16) {
+                vst1q_u8(dst + i, vld2q_u8(src + 2 * i).val[0]);
+            }
+        } else if (step == 4) {
+            for (; i + 16 <= count; i += 16) {
+                vst1q_u8(dst + i, vld4q_u8(src + 4 * i).val[0]);
+            }
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] = src[i * step];
+    }
+}
+
+/* Same size conversion, starting at an even column so pixel pairs share chroma */
+static int
+ConvertYUVRows(const YUVPlanes *planes, const YUVCoefficients *c, YUVRowFunc row422,
+               const SDL_Rect *srcrect, Uint8 *dst, int dst_pitch)
+{
+    const int width = srcrect->w;
+    const int chroma_x = srcrect->x / 2;
+    const int chroma_width = (width + 1) / 2;
+    Uint8 *scratch = NULL;
+    Uint8 *ybuf = NULL, *ubuf = NULL, *vbuf = NULL;
+    int last_chroma_row = -1;
+    int row;
+
+    if (planes->y_step != 1 || planes->uv_step != 1) {
+        scratch = (Uint8 *) SDL_malloc((size_t) width + 2 * (size_t) chroma_width);
+        if (!scratch) {
+            return SDL_OutOfMemory();
+        }
+        ybuf = scratch;
+        ubuf = ybuf + width;
+        vbuf = ubuf + chroma_width;
+    }
+
+    for (row = 0; row < srcrect->h; ++row) {
+        const int sy = srcrect->y + row;
+        const int chroma_row = sy >> planes->uv_shift;
+        const Uint8 *y = planes->y + (size_t) sy * planes->y_pitch + (size_t) srcrect->x * planes->y_step;
+        const Uint8 *u = planes->u + (size_t) chroma_row * planes->uv_pitch + (size_t) chroma_x * planes->uv_step;
+        const Uint8 *v = planes->v + (size_t) chroma_row * planes->uv_pitch + (size_t) chroma_x * planes->uv_step;
+
+        if (planes->y_step != 1) {
+            GatherSamples(y, planes->y_step, ybuf, width);
+            y = ybuf;
+        }
+        if (planes->uv_step != 1) {
+            /* 4:2:0 images share each chroma row between two luma rows */
+            if (chroma_row != last_chroma_row) {
+                GatherSamples(u, planes->uv_step, ubuf, chroma_width);
+                GatherSamples(v, planes->uv_step, vbuf, chroma_width);
+                last_chroma_row = chroma_row;
+            }
+            u = ubuf;
+            v = vbuf;
+        }
+        row422(y, u, v, dst, width, c);
+        dst += dst_pitch;
+    }
+
+    SDL_free(scratch);
+    return 0;
+}
+
+/* Nearest neighbour scaling: gather the samples of each destination row, then
+   convert them in one pass. Rows that repeat a source row are copied. */
+static int
+ConvertYUVRowsScaled(const YUVPlanes *planes, const YUVCoefficients *c, YUVRowFunc row444, int bpp,
+                     const SDL_Rect *srcrect, int dst_w, int dst_h, Uint8 *dst, int dst_pitch)
+{
+    int *y_offsets, *uv_offsets;
+    Uint8 *ybuf, *ubuf, *vbuf;
+    void *scratch;
+    int last_row = -1, last_chroma_row = -1;
+    int i, row;
+
+    scratch = SDL_malloc((size_t) dst_w * (2 * sizeof (int) + 3));
+    if (!scratch) {
+        return SDL_OutOfMemory();
+    }
+    y_offsets = (int *) scratch;
+    uv_offsets = y_offsets + dst_w;
+    ybuf = (Uint8 *) (uv_offsets + dst_w);
+    ubuf = ybuf + dst_w;
+    vbuf = ubuf + dst_w;
+
+    /* Sample at the centre of each destination pixel */
+    for (i = 0; i < dst_w; ++i) {
+        const int sx = srcrect->x + (int) (((Sint64) (2 * i + 1) * srcrect->w) / (2 * (Sint64) dst_w));
+        y_offsets[i] = sx * planes->y_step;
+        uv_offsets[i] = (sx / 2) * planes->uv_step;
+    }
+
+    for (row = 0; row < dst_h; ++row) {
+        const int sy = srcrect->y + (int) (((Sint64) (2 * row + 1) * srcrect->h) / (2 * (Sint64) dst_h));
+        const int chroma_row = sy >> planes->uv_shift;
+
+        if (sy == last_row) {
+            SDL_memcpy(dst, dst - dst_pitch, (size_t) dst_w * bpp);
+        } else {
+            const Uint8 *y = planes->y + (size_t) sy * planes->y_pitch;
+            for (i = 0; i < dst_w; ++i) {
+                ybuf[i] = y[y_offsets[i]];
+            }
+            if (chroma_row != last_chroma_row) {
+                const Uint8 *u = planes->u + (size_t) chroma_row * planes->uv_pitch;
+                const Uint8 *v = planes->v + (size_t) chroma_row * planes->uv_pitch;
+                for (i = 0; i < dst_w; ++i) {
+                    ubuf[i] = u[uv_offsets[i]];
+                    vbuf[i] = v[uv_offsets[i]];
+                }
+                last_chroma_row = chroma_row;
+            }
+            row444(ybuf, ubuf, vbuf, dst, dst_w, c);
+            last_row = sy;
+        }
+        dst += dst_pitch;
+    }
+
+    SDL_free(scratch);
+    return 0;
+}
+
+static int
+ConvertYUVToRGB(const YUVPlanes *planes, const YUVCoefficients *c, Uint32 dst_format,
+                const SDL_Rect *srcrect, int dst_w, int dst_h, void *dst, int dst_pitch)
+{
+    YUVRowFunc row422, row444;
+
+    if (!GetYUVRowFuncs(dst_format, &row422, &row444)) {
+        /* Go through ARGB8888 for the formats without their own kernels */
+        const int tmp_pitch = dst_w * 4;
+        void *tmp;
+        int retval;
+
+        tmp = SDL_malloc((size_t) dst_h * tmp_pitch);
+        if (!tmp) {
+            return SDL_OutOfMemory();
+        }
+        retval = ConvertYUVToRGB(planes, c, SDL_PIXELFORMAT_ARGB8888, srcrect, dst_w, dst_h, tmp, tmp_pitch);
+        if (retval == 0) {
+            retval = SDL_ConvertPixels(dst_w, dst_h, SDL_PIXELFORMAT_ARGB8888, tmp, tmp_pitch,
+                                       dst_format, dst, dst_pitch);
+        }
+        SDL_free(tmp);
+        return retval;
+    }
+
+    if (dst_w == srcrect->w && dst_h == srcrect->h && !(srcrect->x & 1)) {
+        return ConvertYUVRows(planes, c, row422, srcrect, (Uint8 *) dst, dst_pitch);
+    }
+    return ConvertYUVRowsScaled(planes, c, row444, SDL_BYTESPERPIXEL(dst_format),
+                                srcrect, dst_w, dst_h, (Uint8 *) dst, dst_pitch);
+}
+
+int
+SDL_ConvertPixels_YUV_to_RGB_Scaled(int src_w, int src_h, Uint32 src_format, const void *src, int src_pitch,
+                                    const SDL_Rect *srcrect,
+                                    int dst_w, int dst_h, Uint32 dst_format, void *dst, int dst_pitch)
+{
+    YUVPlanes planes;
+
+    if (srcrect->x < 0 || srcrect->y < 0 || srcrect->w <= 0 || srcrect->h <= 0 ||
+        srcrect->w > src_w - srcrect->x || srcrect->h > src_h - srcrect->y) {
+        return SDL_InvalidParamError("srcrect");
+    }
+    if (SDL_ISPIXELFORMAT_FOURCC(dst_format) || SDL_ISPIXELFORMAT_INDEXED(dst_format)) {
+        return SDL_SetError("Unsupported YUV conversion to %s", SDL_GetPixelFormatName(dst_format));
+    }
+    if (dst_w <= 0 || dst_h <= 0) {
+        return 0;
+    }
+    if (GetYUVPlanes(src_h, src_format, src, src_pitch, &planes) < 0) {
+        return -1;
+    }
+    return ConvertYUVToRGB(&planes, GetYUVCoefficients(src_w, src_h), dst_format,
+                           srcrect, dst_w, dst_h, dst, dst_pitch);
+}
+
+int
+SDL_ConvertPixels_YUV_to_RGB(int width, int height,
+                             Uint32 src_format, const void *src, int src_pitch,
+                             Uint32 dst_format, void *dst, int dst_pitch)
+{
+    SDL_Rect srcrect;
+
+    srcrect.x = 0;
+    srcrect.y = 0;
+    srcrect.w = width;
+    srcrect.h = height;
+    return SDL_ConvertPixels_YUV_to_RGB_Scaled(width, height, src_format, src, src_pitch,
+                                               &srcrect, width, height, dst_format, dst, dst_pitch);
+}
+
+static void
+CopyPlane(int length, int rows, const Uint8 *src, int src_pitch, Uint8 *dst, int dst_pitch)
+{
+    while (rows--) {
+        SDL_memcpy(dst, src, length);
+        src += src_pitch;
+        dst += dst_pitch;
+    }
+}
+
+int
+SDL_ConvertPixels_YUV_to_YUV(int width, int height,
+                             Uint32 src_format, const void *src, int src_pitch,
+                             Uint32 dst_format, void *dst, int dst_pitch)
+{
+    const Uint8 *s = (const Uint8 *) src;
+    Uint8 *d = (Uint8 *) dst;
+    const int chroma_w = (width + 1) / 2;
+    const int chroma_h = (height + 1) / 2;
+
+    if (src_format != dst_format) {
+        return SDL_SetError("Unsupported YUV conversion from %s to %s",
+                            SDL_GetPixelFormatName(src_format), SDL_GetPixelFormatName(dst_format));
+    }
+
+    switch (src_format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+    {
+        const int src_uv_pitch = (src_pitch + 1) / 2;
+        const int dst_uv_pitch = (dst_pitch + 1) / 2;
+
+        CopyPlane(width, height, s, src_pitch, d, dst_pitch);
+        s += (size_t) height * src_pitch;
+        d += (size_t) height * dst_pitch;
+        CopyPlane(chroma_w, chroma_h, s, src_uv_pitch, d, dst_uv_pitch);
+        s += (size_t) chroma_h * src_uv_pitch;
+        d += (size_t) chroma_h * dst_uv_pitch;
+        CopyPlane(chroma_w, chroma_h, s, src_uv_pitch, d, dst_uv_pitch);
+        return 0;
+    }
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        CopyPlane(width, height, s, src_pitch, d, dst_pitch);
+        s += (size_t) height * src_pitch;
+        d += (size_t) height * dst_pitch;
+        CopyPlane(2 * chroma_w, chroma_h, s, 2 * ((src_pitch + 1) / 2), d, 2 * ((dst_pitch + 1) / 2));
+        return 0;
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+        CopyPlane(4 * chroma_w, height, s, src_pitch, d, dst_pitch);
+        return 0;
+    default:
+        return SDL_SetError("Unsupported YUV format: %s", SDL_GetPixelFormatName(src_format));
+    }
+}
+
+/* vi: set ts=4 sw=4 expandtab: */